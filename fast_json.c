@@ -17,11 +17,22 @@
 #include <string.h>
 #include <unistd.h>
 #include <math.h>
-#include <locale.h>
 #include <errno.h>
+#include <float.h>
+#ifndef WIN
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <pthread.h>
+#ifndef MAP_ANONYMOUS
+#define	MAP_ANONYMOUS		MAP_ANON
+#endif
+#endif
 #include "fast_json.h"
-#if USE_FAST_CONVERT
-#include "fast_convert.h"
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(__TINYC__)
+#define	FAST_JSON_SIMD		(1)
+#include <immintrin.h>
 #endif
 
 #ifdef __attribute__
@@ -40,8 +51,93 @@
 
 #define	FAST_JSON_INITIAL_SIZE	(8)	/* must be power of 2 */
 #define	FAST_JSON_BUFFER_SIZE	(BUFSIZ)
-#define	FAST_JSON_BIG_SIZE	(FAST_JSON_BUFFER_SIZE / \
+#define	FAST_JSON_BIG_BLOCK	(4096)	/* aligned block, must be power of 2 */
+#define	FAST_JSON_BIG_BLOCKS	(32)	/* aligned blocks in a big alloc */
+#define	FAST_JSON_BIG_SIZE	(FAST_JSON_BIG_BLOCK / \
 				 sizeof (struct fast_json_data_struct))
+#define	FAST_JSON_SIMD_BLOCK	(64)	/* bits in a simd block mask */
+#define	FAST_JSON_STRING_SLACK	(8)	/* max bytes of one decode step */
+#define	FAST_JSON_WINDOW_SIZE	(16 * FAST_JSON_BUFFER_SIZE)
+#define	FAST_JSON_POW10_MIN	(-342)
+#define	FAST_JSON_POW10_MAX	(308)
+#define	FAST_JSON_DECIMAL_DIGITS (800)	/* digits used by exact strtod */
+#define	FAST_JSON_NDJSON_CHUNK	(64 * 1024)	/* min bytes per ndjson chunk */
+#define	FAST_JSON_INT_SIZE	(20)	/* "-9223372036854775808" */
+#define	FAST_JSON_STACK_SIZE	(16)	/* initial container stack size */
+#define	FAST_JSON_PATH_ALL	((size_t) -1)	/* index of a [*] path step */
+#define	FAST_JSON_ARENA_SIZE	(64 * 1024)	/* bytes in an arena chunk */
+#define	FAST_JSON_TAPE_NAME	(7)	/* tape type of an object name */
+#define	FAST_JSON_TAPE_END	(8)	/* tape type of an array or object end */
+#define	FAST_JSON_TAPE_MASK	((UINT64_C (1) << 56) - 1)
+
+/* States of the value boundary scanner of the block reader */
+#define	FAST_JSON_SCAN_VALUE	(0)
+#define	FAST_JSON_SCAN_SCALAR	(1)
+#define	FAST_JSON_SCAN_STRING	(2)
+#define	FAST_JSON_SCAN_ESCAPE	(3)
+#define	FAST_JSON_SCAN_SLASH	(4)
+#define	FAST_JSON_SCAN_LINE	(5)
+#define	FAST_JSON_SCAN_COMMENT	(6)
+#define	FAST_JSON_SCAN_STAR	(7)
+
+/* States of the pull tokenizer */
+#define	FAST_JSON_TOKEN_STATE_VALUE	(0)
+#define	FAST_JSON_TOKEN_STATE_FIRST	(1)
+#define	FAST_JSON_TOKEN_STATE_NAME	(2)
+#define	FAST_JSON_TOKEN_STATE_NEXT	(3)
+#define	FAST_JSON_TOKEN_STATE_DONE	(4)
+
+/* Where the text of a string is kept (is_str of a value). For objects
+ * FAST_JSON_STR_INSITU means the names point into the parsed buffer.
+ */
+#define	FAST_JSON_STR_MALLOC		(0)
+#define	FAST_JSON_STR_INLINE		(1)
+#define	FAST_JSON_STR_INSITU		(2)
+
+/* str_len of a string that is too long for the field. The length is
+ * then found with strlen.
+ */
+#define	FAST_JSON_STR_LEN_LONG		(0xFFFFFFFFu)
+
+/* Bytes after the first byte of a value that hold an inline string. The
+ * last byte is the number of unused bytes, so it is the '\0' of a string
+ * that fills all bytes.
+ */
+#define	FAST_JSON_INLINE_SIZE	(sizeof (struct fast_json_data_struct) - 1)
+#define	fast_json_inline(data)	((char *) (data) + 1)
+
+/* Where a value is allocated (alloc of a value) */
+#define	FAST_JSON_ALLOC_MALLOC		(0)
+#define	FAST_JSON_ALLOC_BIG		(1)
+#define	FAST_JSON_ALLOC_ARENA		(2)
+
+/* Object names shorter than this are kept in the object member */
+#define	FAST_JSON_NAME_INLINE		(16)
+#define	fast_json_name(m)	((m)->len < FAST_JSON_NAME_INLINE ? \
+				 (m)->u.i_name : (m)->u.name)
+
+/* States of the array stream. 0 is no stream. */
+#define	FAST_JSON_ARRAY_STATE_FIRST	(1)
+#define	FAST_JSON_ARRAY_STATE_NEXT	(2)
+#define	FAST_JSON_ARRAY_STATE_DONE	(3)
+
+/* Error bits of the utf8 lookup tables (Keiser and Lemire). Each table
+ * gives the errors that are possible for the high or low nibble of the
+ * previous byte or the high nibble of the current byte. A byte pair is
+ * wrong if all three agree.
+ */
+#define	FAST_JSON_UTF8_TOO_SHORT	(1 << 0)	/* 11______ 0_______ */
+#define	FAST_JSON_UTF8_TOO_LONG		(1 << 1)	/* 0_______ 10______ */
+#define	FAST_JSON_UTF8_OVERLONG_3	(1 << 2)	/* 11100000 100_____ */
+#define	FAST_JSON_UTF8_TOO_LARGE	(1 << 3)	/* 11110100 1001____ */
+#define	FAST_JSON_UTF8_SURROGATE	(1 << 4)	/* 11101101 101_____ */
+#define	FAST_JSON_UTF8_OVERLONG_2	(1 << 5)	/* 1100000_ 10______ */
+#define	FAST_JSON_UTF8_TOO_LARGE_1000	(1 << 6)	/* 11110101 1000____ */
+#define	FAST_JSON_UTF8_OVERLONG_4	(1 << 6)	/* 11110000 1000____ */
+#define	FAST_JSON_UTF8_TWO_CONTS	(1 << 7)	/* 10______ 10______ */
+#define	FAST_JSON_UTF8_CARRY		(FAST_JSON_UTF8_TOO_SHORT | \
+					 FAST_JSON_UTF8_TOO_LONG | \
+					 FAST_JSON_UTF8_TWO_CONTS)
 
 #define SSORT(S_base,S_nel,S_width,S_comp)                              \
 {                                                                       \
@@ -81,6 +177,7 @@
 #define	fast_json_isxdigit(c)	(((c) >= '0' && (c) <= '9') || \
 				 ((c) >= 'a' && (c) <= 'f') || \
 			  	 ((c) >= 'A' && (c) <= 'F'))
+#define	fast_json_xdigit_value(c) ((c) <= '9' ? (c) - '0' : ((c) | 0x20) - 'a' + 10)
 #define	fast_json_isalpha(c)	(((c) >= 'a' && (c) <= 'z') || \
 				 ((c) >= 'A' && (c) <= 'Z'))
 #define	fast_json_isspace(c)	((c) == ' ' || (c) == '\t' || \
@@ -88,16 +185,77 @@
 #define	fast_json5_isspace(c)	((c) == ' ' || (c) == '\t' || \
 				 (c) == '\n' || (c) == '\r' || \
 			         (c) == '\f' || (c) == '\v')
+#define	fast_json_tape_entry(t, p) (((uint64_t) (t) << 56) | (uint64_t) (p))
+#define	fast_json_tape_type(e)	((unsigned int) ((e) >> 56))
+#define	fast_json_tape_payload(e) ((size_t) ((e) & FAST_JSON_TAPE_MASK))
+
+typedef struct fast_json_decimal_struct
+{
+  int nd;
+  int dp;
+  unsigned int trunc;
+  char d[FAST_JSON_DECIMAL_DIGITS + 24];
+} FAST_JSON_DECIMAL_TYPE;
+
+/* Container stack entry of the non recursive parsers */
+typedef union fast_json_stack_union
+{
+  FAST_JSON_DATA_TYPE value;
+  int close;
+} FAST_JSON_STACK_TYPE;
+
+/* Step of a key path from fast_json_create_paths. The children of a step
+ * are the steps that follow it in the paths. name is NULL for an array
+ * index.
+ */
+struct fast_json_path_struct
+{
+  struct fast_json_path_struct *child;
+  struct fast_json_path_struct *next;
+  char *name;
+  size_t len;
+  size_t index;
+  unsigned int leaf;
+};
+
+/* Flat tape of fast_json_parse_tape. Every entry has its type in the high
+ * 8 bits. An array or object is a start entry with the position of its end
+ * entry, an entry with the number of elements, the elements and the end
+ * entry. Object elements are a name entry and the value. Integers and
+ * doubles are followed by an entry with the value. Strings and names have
+ * the offset of their length and characters in strings.
+ */
+struct fast_json_tape_struct
+{
+  uint64_t *tape;
+  size_t n_tape;
+  size_t max_tape;
+  char *strings;
+  size_t n_strings;
+  size_t max_strings;
+};
 
+/* Big alloc of FAST_JSON_BIG_ALLOC. The aligned blocks follow the header.
+ * The first value of every block points to the header, so the header of a
+ * value is found from its address. count is the number of values that are
+ * in use or on the reuse list.
+ */
 typedef struct fast_json_big_struct
 {
+  struct fast_json_big_struct *next;
+  struct fast_json_big_struct *prev;
   size_t count;
-  struct fast_json_big_struct *data;
 } FAST_JSON_BIG_TYPE;
 
+/* Chunk of the arena of FAST_JSON_ARENA. The memory follows the header. */
+typedef struct fast_json_arena_struct
+{
+  struct fast_json_arena_struct *next;
+  size_t size;
+} FAST_JSON_ARENA_TYPE;
+
 struct fast_json_struct
 {
-  char decimal_point;
   FAST_JSON_ERROR_ENUM error;
   unsigned int options;
   fast_json_malloc_type my_malloc;
@@ -143,6 +301,33 @@ struct fast_json_struct
   size_t n_save;
   size_t max_save;
   char *save;
+  size_t n_string;
+  size_t max_string;
+  char *string;
+  unsigned int insitu;
+  char *insitu_string;
+  FAST_JSON_ARENA_TYPE *arena;
+  char *arena_ptr;
+  char *arena_end;
+  struct
+  {
+    fast_json_block_func block;
+    void *block_data;
+    FILE *fp;
+    int fd;
+    unsigned int active;
+    unsigned int feed;
+    unsigned int array;
+    unsigned int eof;
+    int state;
+    int quote;
+    size_t depth;
+    size_t scan;
+    size_t start;
+    size_t len;
+    size_t max;
+    char *buffer;
+  } window;
   size_t line;
   size_t column;
   size_t last_column;
@@ -150,18 +335,42 @@ struct fast_json_struct
   size_t max_reuse;
   size_t n_reuse;
   struct fast_json_data_struct *json_reuse;
-  size_t n_big_malloc;
   FAST_JSON_BIG_TYPE *big_malloc;
-  FAST_JSON_BIG_TYPE *big_malloc_free;
+  const char *json_end;
+  unsigned int simd;
+  const char *simd_block;
+  uint64_t simd_space;
+  size_t max_depth;
+  size_t max_stack;
+  FAST_JSON_STACK_TYPE *stack;
+  size_t max_walk;
+  struct fast_json_walk_struct *walk;
+  struct
+  {
+    unsigned int string;
+    int state;
+    int c;
+    size_t depth;
+    const char *ptr;
+  } token;
   char error_str[1000];
 };
 
+/* Member of an object. Names shorter than FAST_JSON_NAME_INLINE are kept
+ * in the member (see fast_json_name). next and hash_table are the index of
+ * a member plus 1 or 0 for the end of the hash chain.
+ */
 typedef struct fast_json_name_value_struct
 {
-  struct fast_json_name_value_struct *next;
-  struct fast_json_name_value_struct *hash_table;
-  char *name;
+  unsigned int next;
+  unsigned int hash_table;
   FAST_JSON_DATA_TYPE value;
+  size_t len;			/* strlen (name) */
+  union
+  {
+    char *name;
+    char i_name[FAST_JSON_NAME_INLINE];
+  } u;
 } FAST_JSON_NAME_VALUE_TYPE;
 
 typedef struct fast_json_object_struct
@@ -178,28 +387,109 @@ typedef struct fast_json_array_struct
   FAST_JSON_DATA_TYPE values[1];
 } FAST_JSON_ARRAY_TYPE;
 
+/* Open array or object of the non recursive print, copy, compare and loop
+ * check functions. index is the next element.
+ */
+typedef struct fast_json_walk_struct
+{
+  FAST_JSON_DATA_TYPE value;
+  union
+  {
+    FAST_JSON_DATA_TYPE other;	/* copy or value compared with */
+    FAST_JSON_NAME_VALUE_TYPE *sorted;	/* sorted members when printing */
+  } u;
+  size_t index;
+} FAST_JSON_WALK_TYPE;
+
+/* A value is 16 bytes. The first byte has the type and flags. An inline
+ * string uses all other bytes (see fast_json_inline).
+ */
 struct fast_json_data_struct
 {
-  unsigned char type;		/* FAST_JSON_VALUE_TYPE type */
-  unsigned char is_str;
-  unsigned short used;
-  unsigned int index;
+  unsigned char type:3;		/* FAST_JSON_VALUE_TYPE type */
+  unsigned char is_str:2;	/* FAST_JSON_STR_... */
+  unsigned char used:1;
+  unsigned char alloc:2;	/* FAST_JSON_ALLOC_... */
+  unsigned int str_len;		/* Length of string or FAST_JSON_STR_LEN_LONG */
   union
   {
     unsigned int boolean_value;
     fast_json_int_64 int_value;
     double double_value;
     char *string_value;
-    char i_string_value[8];
     FAST_JSON_OBJECT_TYPE *object;
     FAST_JSON_ARRAY_TYPE *array;
     FAST_JSON_DATA_TYPE next;
   } u;
 };
 
+/* Part of the input of fast_json_parse_ndjson or fast_json_parse_parallel.
+ * The values of the chunk are kept until all threads are done. For the
+ * members of an object names has the malloced names. If a line has an
+ * error error_json is the json object of the thread with the error
+ * information and lines is the number of lines before the bad line.
+ */
+typedef struct fast_json_ndjson_chunk_struct
+{
+  const char *start;
+  const char *end;
+  size_t lines;
+  size_t n;
+  size_t max;
+  FAST_JSON_DATA_TYPE *values;
+  char **names;
+  const char *error_line;
+  FAST_JSON_TYPE error_json;
+} FAST_JSON_NDJSON_CHUNK_TYPE;
+
+/* State shared by the threads of fast_json_parse_ndjson. Chunks are handed
+ * out in input order. No chunk after the first chunk with an error is
+ * started. close is ']' or '}' if the chunks are elements of a top level
+ * array or object (fast_json_parse_parallel) and 0 for lines.
+ */
+typedef struct fast_json_ndjson_struct
+{
+  const char *end;
+  int close;
+  size_t n_chunks;
+  size_t next;
+  size_t failed;
+  FAST_JSON_NDJSON_CHUNK_TYPE *chunks;
+#ifndef WIN
+  pthread_mutex_t lock;
+#endif
+} FAST_JSON_NDJSON_TYPE;
+
+typedef struct fast_json_ndjson_worker_struct
+{
+  FAST_JSON_NDJSON_TYPE *nd;
+  FAST_JSON_TYPE json;
+  size_t max_line;
+  char *line;
+#ifndef WIN
+  pthread_t thread;
+  int started;
+#endif
+} FAST_JSON_NDJSON_WORKER_TYPE;
+
 static double fast_json_nan (unsigned int sign);
 static double fast_json_inf (unsigned int sign);
 static char *fast_json_strdup (FAST_JSON_TYPE json, const char *str);
+static char *fast_json_memdup (FAST_JSON_TYPE json, const char *str,
+			       size_t len);
+static void *fast_json_arena_grow (FAST_JSON_TYPE json, size_t size);
+static void *fast_json_data_alloc (FAST_JSON_TYPE json,
+				   FAST_JSON_DATA_TYPE data, size_t size);
+static void *fast_json_data_realloc (FAST_JSON_TYPE json,
+				     FAST_JSON_DATA_TYPE data, void *ptr,
+				     size_t old_size, size_t size);
+static void fast_json_data_release (FAST_JSON_TYPE json,
+				    FAST_JSON_DATA_TYPE data, void *ptr);
+static char *fast_json_data_memdup (FAST_JSON_TYPE json,
+				    FAST_JSON_DATA_TYPE data, const char *str,
+				    size_t len);
+static void fast_json_arena_move (FAST_JSON_TYPE json, FAST_JSON_TYPE from);
+static FAST_JSON_DATA_TYPE fast_json_big_alloc (FAST_JSON_TYPE json);
 static FAST_JSON_DATA_TYPE fast_json_data_create (FAST_JSON_TYPE json);
 static void fast_json_data_free (FAST_JSON_TYPE json,
 				 FAST_JSON_DATA_TYPE ptr);
@@ -210,6 +500,7 @@ static int fast_json_getc_string (void *user_data);
 static int fast_json_getc_string_len (void *user_data);
 static int fast_json_getc_file (void *user_data);
 static int fast_json_getc_fd (void *user_date);
+static int fast_json_read_again (int fd);
 static int fast_json_getc (FAST_JSON_TYPE json);
 static void fast_json_ungetc (FAST_JSON_TYPE json, int c);
 static int fast_json_getc_save (FAST_JSON_TYPE json);
@@ -219,23 +510,201 @@ static FAST_JSON_ERROR_ENUM fast_json_skip_whitespace (FAST_JSON_TYPE json,
 						       int *next);
 static unsigned int fast_json_hex (FAST_JSON_TYPE json, const char **buf,
 				   unsigned int n);
+static double fast_json_make_double (uint64_t bits, unsigned int sign);
+static int fast_json_eisel_lemire (uint64_t mantissa, int exp10,
+				   uint64_t * bits);
+static void fast_json_decimal_trim (FAST_JSON_DECIMAL_TYPE * dec);
+static void fast_json_decimal_left_shift (FAST_JSON_DECIMAL_TYPE * dec,
+					  unsigned int k);
+static void fast_json_decimal_right_shift (FAST_JSON_DECIMAL_TYPE * dec,
+					   unsigned int k);
+static void fast_json_decimal_shift (FAST_JSON_DECIMAL_TYPE * dec, int k);
+static uint64_t fast_json_decimal_round (FAST_JSON_DECIMAL_TYPE * dec);
+static double fast_json_decimal_strtod (const char *str,
+					unsigned int *erange);
+static double fast_json_hex_strtod (const char *cp, unsigned int sign,
+				   const char **endp, unsigned int *erange);
+static double fast_json_strtod (const char *str, const char **endp,
+				unsigned int *erange);
+static uint64_t fast_json_ryu (uint64_t ieee_mantissa,
+			       unsigned int ieee_exponent, int *exp10);
+static unsigned int fast_json_dtoa (double d, char *buf);
+static unsigned int fast_json_ndigits (uint64_t u);
+static unsigned int fast_json_itoa (fast_json_int_64 value, char *buf);
+#if FAST_JSON_SIMD
+static size_t fast_json_copy_plain_sse2 (const char *ptr, const char *end,
+					 char *out);
+static size_t fast_json_copy_plain_avx2 (const char *ptr, const char *end,
+					 char *out);
+static size_t fast_json_print_plain_sse2 (const char *ptr, const char *end,
+					  unsigned int escape);
+static __m256i fast_json_utf8_block_avx2 (__m256i v, __m256i prev);
+static size_t fast_json_copy_utf8_avx2 (const char *ptr, const char *end,
+					char *out);
+#endif
+static FAST_JSON_ERROR_ENUM fast_json_string_grow (FAST_JSON_TYPE json);
+static FAST_JSON_ERROR_ENUM fast_json_insitu_move (FAST_JSON_TYPE json,
+						   char **ptr2, char **limit);
 static FAST_JSON_ERROR_ENUM fast_json_check_string (FAST_JSON_TYPE json,
-						    const char *save,
+						    const char **buf,
 						    const char *end,
-						    char *out,
 						    int sep);
+static FAST_JSON_ERROR_ENUM fast_json_string_store (FAST_JSON_TYPE json,
+						    FAST_JSON_DATA_TYPE data);
+static FAST_JSON_DATA_TYPE fast_json_string_value (FAST_JSON_TYPE json);
+static char *fast_json_string_name (FAST_JSON_TYPE json, char *buf,
+				    size_t size);
+static FAST_JSON_ERROR_ENUM fast_json_parse_scalar (FAST_JSON_TYPE json,
+						    int c,
+						    FAST_JSON_DATA_TYPE v);
 static FAST_JSON_DATA_TYPE fast_json_parse_value (FAST_JSON_TYPE json, int c);
+static FAST_JSON_ERROR_ENUM fast_json_check_name (FAST_JSON_TYPE json, int c);
+static char *fast_json_parse_name (FAST_JSON_TYPE json, int c, char *buf,
+				   size_t size);
+static FAST_JSON_ERROR_ENUM fast_json_stack_check (FAST_JSON_TYPE json,
+						   size_t depth);
+static FAST_JSON_ERROR_ENUM fast_json_walk_check (FAST_JSON_TYPE json,
+						  size_t depth);
+static size_t fast_json_container_len (FAST_JSON_DATA_TYPE value);
+static FAST_JSON_DATA_TYPE fast_json_container_element (FAST_JSON_DATA_TYPE
+							value, size_t index);
+static int fast_json_value_equal_one (FAST_JSON_DATA_TYPE value1,
+				      FAST_JSON_DATA_TYPE value2);
+static FAST_JSON_DATA_TYPE fast_json_value_copy_one (FAST_JSON_TYPE json,
+						     FAST_JSON_DATA_TYPE
+						     value);
+static void fast_json_value_free_push (FAST_JSON_TYPE json,
+				       FAST_JSON_DATA_TYPE value,
+				       FAST_JSON_DATA_TYPE * pending);
+static FAST_JSON_DATA_TYPE fast_json_parse_nested (FAST_JSON_TYPE json,
+						   int c);
 static FAST_JSON_DATA_TYPE fast_json_parse_all (FAST_JSON_TYPE json,
 						unsigned int next);
+static int fast_json_events_scalar (FAST_JSON_TYPE json,
+				   const FAST_JSON_EVENTS_TYPE * events,
+				   void *user_data, FAST_JSON_DATA_TYPE v);
+static FAST_JSON_ERROR_ENUM fast_json_parse_events_value (FAST_JSON_TYPE json,
+							  const
+							  FAST_JSON_EVENTS_TYPE
+							  * events,
+							  void *user_data,
+							  int c);
+static FAST_JSON_ERROR_ENUM fast_json_parse_events_all (FAST_JSON_TYPE json,
+							const
+							FAST_JSON_EVENTS_TYPE
+							* events,
+							void *user_data);
 static FAST_JSON_ERROR_ENUM fast_json_skip_whitespace2 (FAST_JSON_TYPE json,
 							const char **buf);
 static void fast_json_store_error2 (FAST_JSON_TYPE json,
 				    FAST_JSON_ERROR_ENUM error,
 				    const char *cp, const char *sep);
+#if FAST_JSON_SIMD
+static void fast_json_simd_classify_sse2 (const char *cp, uint64_t * space);
+static void fast_json_simd_classify_avx2 (const char *cp, uint64_t * space);
+static void fast_json_simd_classify (FAST_JSON_TYPE json, const char *cp);
+#endif
+static const char *fast_json_skip_space2 (FAST_JSON_TYPE json,
+					  const char *cp);
+static FAST_JSON_ERROR_ENUM fast_json_parse_scalar2 (FAST_JSON_TYPE json,
+						      const char **buf,
+						      FAST_JSON_DATA_TYPE v);
 static FAST_JSON_DATA_TYPE fast_json_parse_value2 (FAST_JSON_TYPE json,
 						   const char **buf);
+static FAST_JSON_ERROR_ENUM fast_json_check_name2 (FAST_JSON_TYPE json,
+						   const char **buf);
+static char *fast_json_parse_name2 (FAST_JSON_TYPE json, const char **buf,
+				    char *name, size_t size);
+static FAST_JSON_DATA_TYPE fast_json_parse_nested2 (FAST_JSON_TYPE json,
+						    const char **buf);
+static void fast_json_count_position (FAST_JSON_TYPE json, const char *s,
+				      const char *e);
 static FAST_JSON_DATA_TYPE fast_json_parse_all2 (FAST_JSON_TYPE json,
 						 unsigned int next);
+static const char *fast_json_skip_string2 (FAST_JSON_TYPE json,
+					   const char *cp, int quote);
+static FAST_JSON_ERROR_ENUM fast_json_skip_value2 (FAST_JSON_TYPE json,
+						   const char **buf,
+						   size_t base);
+static void fast_json_cursor_bind (FAST_JSON_TYPE json,
+				   const FAST_JSON_CURSOR_TYPE * cursor);
+static FAST_JSON_ERROR_ENUM fast_json_cursor_element (FAST_JSON_TYPE json,
+						      FAST_JSON_CURSOR_TYPE *
+						      cursor,
+						      const char *cp);
+static FAST_JSON_PATHS_TYPE fast_json_path_step (FAST_JSON_TYPE json,
+						 FAST_JSON_PATHS_TYPE path,
+						 const char *name, size_t len,
+						 size_t index);
+static FAST_JSON_ERROR_ENUM fast_json_parse_paths2 (FAST_JSON_TYPE json,
+						    const char **buf,
+						    FAST_JSON_PATHS_TYPE path,
+						    FAST_JSON_DATA_TYPE *
+						    value);
+static void fast_json_token_init (FAST_JSON_TYPE json, unsigned int string);
+static FAST_JSON_ERROR_ENUM fast_json_token_peek (FAST_JSON_TYPE json,
+						  int *c);
+static void fast_json_token_take (FAST_JSON_TYPE json);
+static FAST_JSON_ERROR_ENUM fast_json_token_error (FAST_JSON_TYPE json,
+						   FAST_JSON_ERROR_ENUM error);
+static void fast_json_token_close (FAST_JSON_TYPE json,
+				   FAST_JSON_TOKEN_TYPE * token, int close);
+static FAST_JSON_ERROR_ENUM fast_json_tape_reserve (FAST_JSON_TYPE json,
+						    FAST_JSON_TAPE_TYPE tape,
+						    size_t len);
+static size_t fast_json_tape_skip (const uint64_t * t, size_t pos);
+static size_t fast_json_tape_member (FAST_JSON_TAPE_TYPE tape, size_t pos,
+				     size_t index);
+static FAST_JSON_ERROR_ENUM fast_json_window_fill (FAST_JSON_TYPE json);
+#if FAST_JSON_SIMD
+static size_t fast_json_scan_plain_sse2 (const char *ptr, const char *end);
+static size_t fast_json_scan_plain_avx2 (const char *ptr, const char *end);
+#endif
+static size_t fast_json_scan_plain (FAST_JSON_TYPE json, const char *ptr,
+				    const char *end);
+static int fast_json_window_scan (FAST_JSON_TYPE json, size_t *end);
+static FAST_JSON_DATA_TYPE fast_json_parse_window (FAST_JSON_TYPE json,
+						   unsigned int next);
+static FAST_JSON_ERROR_ENUM fast_json_feed_add (FAST_JSON_TYPE json,
+						const char *buf, size_t len);
+static FAST_JSON_DATA_TYPE fast_json_feed_value (FAST_JSON_TYPE json,
+						 unsigned int eof);
+static void fast_json_array_advance (FAST_JSON_TYPE json, const char *cp);
+static FAST_JSON_ERROR_ENUM fast_json_array_peek (FAST_JSON_TYPE json,
+						  int *c);
+static FAST_JSON_DATA_TYPE fast_json_array_element (FAST_JSON_TYPE json);
+static FAST_JSON_ERROR_ENUM fast_json_array_start (FAST_JSON_TYPE json);
+#ifndef WIN
+static int fast_json_parse_map (FAST_JSON_TYPE json, const char *name,
+				FAST_JSON_DATA_TYPE * v);
+#endif
+static FAST_JSON_ERROR_ENUM fast_json_ndjson_chunk (FAST_JSON_NDJSON_WORKER_TYPE
+						    * w,
+						    FAST_JSON_NDJSON_CHUNK_TYPE
+						    * chunk);
+static FAST_JSON_ERROR_ENUM fast_json_parallel_chunk (FAST_JSON_NDJSON_WORKER_TYPE
+						      * w,
+						      FAST_JSON_NDJSON_CHUNK_TYPE
+						      * chunk);
+static FAST_JSON_ERROR_ENUM fast_json_ndjson_add (FAST_JSON_TYPE json,
+						  FAST_JSON_NDJSON_CHUNK_TYPE
+						  * chunk, char *name,
+						  FAST_JSON_DATA_TYPE v);
+static void *fast_json_ndjson_worker (void *data);
+static unsigned int fast_json_ndjson_threads (unsigned int n_threads);
+static FAST_JSON_NDJSON_WORKER_TYPE *fast_json_ndjson_run (FAST_JSON_TYPE
+							   json,
+							   FAST_JSON_NDJSON_TYPE
+							   * nd,
+							   unsigned int
+							   *n_threads);
+static FAST_JSON_DATA_TYPE fast_json_ndjson_array (FAST_JSON_TYPE json,
+						   FAST_JSON_NDJSON_TYPE *
+						   nd);
+static void fast_json_ndjson_free (FAST_JSON_TYPE json,
+				   FAST_JSON_NDJSON_TYPE * nd,
+				   FAST_JSON_NDJSON_WORKER_TYPE * workers,
+				   unsigned int n_threads);
 static int fast_json_puts_string (void *user_data, const char *str,
 				  unsigned int len);
 static int fast_json_puts_string_len (void *user_data, const char *str,
@@ -250,13 +719,17 @@ static int fast_json_puts (FAST_JSON_TYPE json, const char *str,
 			   unsigned int len);
 static int fast_json_last_puts (FAST_JSON_TYPE json, const char *str,
 				unsigned int len);
-static int fast_json_print_string_value (FAST_JSON_TYPE json, const char *s);
+static int fast_json_print_string_value (FAST_JSON_TYPE json, const char *s,
+					 size_t len);
 static int fast_json_print_spaces (FAST_JSON_TYPE json, unsigned int n);
 static int fast_json_compare_object (const void *a, const void *b);
+static int fast_json_print_one (FAST_JSON_TYPE json,
+				FAST_JSON_DATA_TYPE value, unsigned int nice);
 static int fast_json_print_buffer (FAST_JSON_TYPE json,
 				   FAST_JSON_DATA_TYPE value,
-				   unsigned int n, unsigned int nice);
-static unsigned int fast_json_check_loop (FAST_JSON_DATA_TYPE data,
+				   unsigned int nice);
+static unsigned int fast_json_check_loop (FAST_JSON_TYPE json,
+					  FAST_JSON_DATA_TYPE data,
 					  FAST_JSON_DATA_TYPE value);
 static FAST_JSON_ERROR_ENUM fast_json_add_array_end (FAST_JSON_TYPE json,
 						     FAST_JSON_DATA_TYPE
@@ -264,16 +737,27 @@ static FAST_JSON_ERROR_ENUM fast_json_add_array_end (FAST_JSON_TYPE json,
 						     FAST_JSON_DATA_TYPE
 						     value);
 static void fast_json_init_hash (FAST_JSON_OBJECT_TYPE * o);
+static FAST_JSON_ERROR_ENUM fast_json_object_own_names (FAST_JSON_TYPE json,
+							FAST_JSON_DATA_TYPE
+							object);
 static FAST_JSON_ERROR_ENUM fast_json_add_object_end (FAST_JSON_TYPE json,
 						      FAST_JSON_DATA_TYPE
 						      object,
 						      const char *name,
+						      size_t len,
 						      FAST_JSON_DATA_TYPE
 						      value);
-static void fast_json_update_crc64 (uint64_t * crc, const char *str);
+static void fast_json_update_crc64 (uint64_t * crc, const char *str,
+				    size_t len);
 static void fast_json_update_crc32 (unsigned int *crc, const char *str);
 static FAST_JSON_ERROR_ENUM fast_json_parse_crc (FAST_JSON_TYPE json,
 						 unsigned int *crc, int c);
+static FAST_JSON_ERROR_ENUM fast_json_parse_crc_name (FAST_JSON_TYPE json,
+						      unsigned int *crc,
+						      int c);
+static FAST_JSON_ERROR_ENUM fast_json_parse_crc_nested (FAST_JSON_TYPE json,
+							unsigned int *crc,
+							int c);
 static FAST_JSON_ERROR_ENUM fast_json_calc_crc_all (FAST_JSON_TYPE json,
 						    unsigned int *res_crc,
 						    unsigned int next);
@@ -297,6 +781,28 @@ static const char fast_json_utf8_size[256] = {
   4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
+/* Bytes the value scanners have to look at: '\0', '"', '\'', '/', '[',
+ * '\\', ']', '{' and '}'.
+ */
+static const char fast_json_scan_special[256] = {
+  1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
 static const char fast_json5_space[256] = {
   0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0,
   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -345,78 +851,211 @@ fast_json_inf (unsigned int sign)
 static char *
 fast_json_strdup (FAST_JSON_TYPE json, const char *str)
 {
-  size_t len = strlen (str) + 1;
-  void *ret = (*json->my_malloc) (len);
+  return fast_json_memdup (json, str, strlen (str));
+}
+
+/* Copy the len bytes of str and the '\0' after them. */
+static char *
+fast_json_memdup (FAST_JSON_TYPE json, const char *str, size_t len)
+{
+  void *ret = (*json->my_malloc) (len + 1);
 
   if (LIKELY (ret != NULL)) {
-    memcpy (ret, str, len);
+    memcpy (ret, str, len + 1);
   }
   return (char *) ret;
 }
 
+/* Allocate size bytes from the arena. */
+static ALWAYS_INLINE void *
+fast_json_arena_alloc (FAST_JSON_TYPE json, size_t size)
+{
+  char *ptr = json->arena_ptr;
+
+  size = (size + 7) & ~(size_t) 7;
+  if (UNLIKELY ((size_t) (json->arena_end - ptr) < size)) {
+    return fast_json_arena_grow (json, size);
+  }
+  json->arena_ptr = ptr + size;
+  return ptr;
+}
+
+/* Add a chunk to the arena for an allocation of size bytes. A large
+ * allocation gets its own chunk so the current chunk can still be used.
+ */
+static void *
+fast_json_arena_grow (FAST_JSON_TYPE json, size_t size)
+{
+  size_t chunk_size =
+    size > FAST_JSON_ARENA_SIZE / 4 ? size : FAST_JSON_ARENA_SIZE;
+  FAST_JSON_ARENA_TYPE *a =
+    (FAST_JSON_ARENA_TYPE *) (*json->my_malloc) (sizeof (*a) + chunk_size);
+  char *ptr;
+
+  if (a == NULL) {
+    return NULL;
+  }
+  a->size = chunk_size;
+  ptr = (char *) (a + 1);
+  if (chunk_size != FAST_JSON_ARENA_SIZE && json->arena) {
+    a->next = json->arena->next;
+    json->arena->next = a;
+  }
+  else {
+    a->next = json->arena;
+    json->arena = a;
+    json->arena_ptr = ptr + size;
+    json->arena_end = ptr + chunk_size;
+  }
+  return ptr;
+}
+
+/* Add the arena chunks of from to json. */
+static void
+fast_json_arena_move (FAST_JSON_TYPE json, FAST_JSON_TYPE from)
+{
+  FAST_JSON_ARENA_TYPE *last = from->arena;
+
+  if (last) {
+    while (last->next) {
+      last = last->next;
+    }
+    if (json->arena) {
+      last->next = json->arena->next;
+      json->arena->next = from->arena;
+    }
+    else {
+      json->arena = from->arena;
+    }
+    from->arena = NULL;
+    from->arena_ptr = NULL;
+    from->arena_end = NULL;
+  }
+}
+
+/* Allocate size bytes for the array, object or string of data. Values in
+ * the arena use arena memory.
+ */
+static void *
+fast_json_data_alloc (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE data,
+		      size_t size)
+{
+  if (data->alloc == FAST_JSON_ALLOC_ARENA) {
+    return fast_json_arena_alloc (json, size);
+  }
+  return (*json->my_malloc) (size);
+}
+
+/* Grow ptr of data from old_size to size bytes. Arena memory is copied. */
+static void *
+fast_json_data_realloc (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE data,
+			void *ptr, size_t old_size, size_t size)
+{
+  void *ret;
+
+  if (data->alloc != FAST_JSON_ALLOC_ARENA) {
+    return (*json->my_realloc) (ptr, size);
+  }
+  ret = fast_json_arena_alloc (json, size);
+  if (ret) {
+    memcpy (ret, ptr, old_size);
+  }
+  return ret;
+}
+
+/* Free ptr of data. Arena memory is only freed with the arena. */
+static void
+fast_json_data_release (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE data,
+			void *ptr)
+{
+  if (data->alloc != FAST_JSON_ALLOC_ARENA) {
+    (*json->my_free) (ptr);
+  }
+}
+
+/* Copy the len bytes of str and the '\0' after them for data. */
+static char *
+fast_json_data_memdup (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE data,
+		       const char *str, size_t len)
+{
+  char *ret;
+
+  if (data->alloc != FAST_JSON_ALLOC_ARENA) {
+    return fast_json_memdup (json, str, len);
+  }
+  ret = (char *) fast_json_arena_alloc (json, len + 1);
+  if (ret) {
+    memcpy (ret, str, len + 1);
+  }
+  return ret;
+}
+
+/* Allocate FAST_JSON_BIG_BLOCKS aligned blocks of values. The values are
+ * put on the reuse list and one of them is returned.
+ */
+static FAST_JSON_DATA_TYPE
+fast_json_big_alloc (FAST_JSON_TYPE json)
+{
+  FAST_JSON_BIG_TYPE *b;
+  FAST_JSON_DATA_TYPE v;
+  char *block;
+  size_t i;
+  size_t j;
+
+  b = (FAST_JSON_BIG_TYPE *)
+    (*json->my_malloc) (sizeof (*b) +
+			(FAST_JSON_BIG_BLOCKS + 1) * FAST_JSON_BIG_BLOCK);
+  if (b == NULL) {
+    return NULL;
+  }
+  b->prev = NULL;
+  b->next = json->big_malloc;
+  if (b->next) {
+    b->next->prev = b;
+  }
+  json->big_malloc = b;
+  b->count = FAST_JSON_BIG_BLOCKS * (FAST_JSON_BIG_SIZE - 1);
+  block = (char *) (((uintptr_t) (b + 1) + FAST_JSON_BIG_BLOCK - 1) &
+		    ~(uintptr_t) (FAST_JSON_BIG_BLOCK - 1));
+  for (i = 0; i < FAST_JSON_BIG_BLOCKS; i++) {
+    v = (FAST_JSON_DATA_TYPE) block;
+    *(FAST_JSON_BIG_TYPE **) block = b;
+    for (j = 1; j < FAST_JSON_BIG_SIZE; j++) {
+      v[j].alloc = FAST_JSON_ALLOC_BIG;
+      v[j].u.next = json->json_reuse;
+      json->json_reuse = &v[j];
+    }
+    block += FAST_JSON_BIG_BLOCK;
+  }
+  json->n_reuse += b->count - 1;
+  v = json->json_reuse;
+  json->json_reuse = v->u.next;
+  return v;
+}
+
 static FAST_JSON_DATA_TYPE
 fast_json_data_create (FAST_JSON_TYPE json)
 {
   FAST_JSON_DATA_TYPE v;
 
-  if (json->n_reuse) {
+  if (json->options & FAST_JSON_ARENA) {
+    v = (FAST_JSON_DATA_TYPE) fast_json_arena_alloc (json, sizeof (*v));
+    if (LIKELY (v != NULL)) {
+      v->alloc = FAST_JSON_ALLOC_ARENA;
+    }
+  }
+  else if (json->n_reuse) {
     json->n_reuse--;
     v = json->json_reuse;
     json->json_reuse = json->json_reuse->u.next;
   }
   else if ((json->options & FAST_JSON_BIG_ALLOC) != 0) {
-    v =
-      (FAST_JSON_DATA_TYPE) (*json->my_malloc) (FAST_JSON_BIG_SIZE *
-						sizeof (*v));
-    if (v) {
-      size_t i;
-      size_t index;
-      FAST_JSON_BIG_TYPE *b = json->big_malloc_free;
-
-      if (b == NULL) {
-	size_t size = json->n_big_malloc == 0 ? 1 : json->n_big_malloc * 2;
-
-	b =
-	  (FAST_JSON_BIG_TYPE *) (*json->my_realloc) (json->big_malloc,
-						      size * sizeof (*b));
-	if (b == NULL) {
-	  (*json->my_free) (v);
-	  return NULL;
-	}
-	for (i = json->n_big_malloc + 1; i < size; i++) {
-	  b[i].count = i;
-	  b[i].data = json->big_malloc_free;
-	  json->big_malloc_free = &b[i];
-	}
-	index = json->n_big_malloc;
-	b[index].count = FAST_JSON_BIG_SIZE;
-	b[index].data = (FAST_JSON_BIG_TYPE *) v;
-	json->n_big_malloc = size;
-	json->big_malloc = b;
-      }
-      else {
-	json->big_malloc_free = json->big_malloc_free->data;
-	index = b->count;
-	json->big_malloc[index].count = FAST_JSON_BIG_SIZE;
-	json->big_malloc[index].data = (FAST_JSON_BIG_TYPE *) v;
-      }
-      for (i = 0; i < FAST_JSON_BIG_SIZE; i++) {
-	FAST_JSON_DATA_TYPE ptr = &v[i];
-
-	json->n_reuse++;
-	ptr->index = index;
-	ptr->u.next = json->json_reuse;
-	json->json_reuse = ptr;
-      }
-      json->n_reuse--;
-      v = json->json_reuse;
-      json->json_reuse = json->json_reuse->u.next;
-    }
+    v = fast_json_big_alloc (json);
   }
   else {
     v = (FAST_JSON_DATA_TYPE) (*json->my_malloc) (sizeof (*v));
     if (LIKELY (v != NULL)) {
-      v->index = 0xFFFFFFFFu;
+      v->alloc = FAST_JSON_ALLOC_MALLOC;
     }
   }
   return v;
@@ -426,15 +1065,24 @@ static void
 fast_json_data_free (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE ptr)
 {
   if (LIKELY (ptr != NULL)) {
-    size_t index = ptr->index;
-
-    if (ptr->index != 0xFFFFFFFFu) {
-      if (UNLIKELY (--json->big_malloc[ptr->index].count == 0)) {
+    if (ptr->alloc == FAST_JSON_ALLOC_ARENA) {
+      /* Freed with the arena */
+    }
+    else if (ptr->alloc == FAST_JSON_ALLOC_BIG) {
+      FAST_JSON_BIG_TYPE *b = *(FAST_JSON_BIG_TYPE **)
+	((uintptr_t) ptr & ~(uintptr_t) (FAST_JSON_BIG_BLOCK - 1));
 
-	(*json->my_free) (json->big_malloc[index].data);
-	json->big_malloc[index].count = index;
-	json->big_malloc[index].data = json->big_malloc_free;
-	json->big_malloc_free = &json->big_malloc[index];
+      if (UNLIKELY (--b->count == 0)) {
+	if (b->prev) {
+	  b->prev->next = b->next;
+	}
+	else {
+	  json->big_malloc = b->next;
+	}
+	if (b->next) {
+	  b->next->prev = b->prev;
+	}
+	(*json->my_free) (b);
       }
     }
     else {
@@ -497,6 +1145,32 @@ fast_json_getc_file (void *user_data)
   return getc (json->u_parse.fp);
 }
 
+/* Return 1 if a failed read should be tried again. A non blocking
+ * descriptor without data is waited for with poll instead of calling read
+ * in a loop.
+ */
+static int
+fast_json_read_again (int fd)
+{
+  if (errno == EINTR) {
+    return 1;
+  }
+  if (errno == EWOULDBLOCK || errno == EAGAIN) {
+#ifndef WIN
+    struct pollfd pfd;
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll (&pfd, 1, -1) >= 0 || errno == EINTR;
+#else
+    (void) fd;
+    return 1;
+#endif
+  }
+  return 0;
+}
+
 static int
 fast_json_getc_fd (void *user_data)
 {
@@ -509,8 +1183,7 @@ fast_json_getc_fd (void *user_data)
       len =
 	read (json->u_parse.fd.fd, json->u_parse.fd.buffer,
 	      sizeof (json->u_parse.fd.buffer));
-    } while (len < 0 &&
-	     (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR));
+    } while (len < 0 && fast_json_read_again (json->u_parse.fd.fd));
 
     if (len <= 0) {
       return FAST_JSON_EOF;
@@ -599,18 +1272,21 @@ static void
 fast_json_getc_save_start (FAST_JSON_TYPE json, int c)
 {
   json->n_save = 0;
+  /* Allocate the buffer also at the end of the input. The caller stores
+   * the terminating null character with fast_json_ungetc_save.
+   */
+  if (UNLIKELY (json->max_save == 0)) {
+    size_t new_max = FAST_JSON_BUFFER_SIZE;
+    char *new_save;
+
+    new_save = (char *) json->my_realloc (json->save, new_max);
+    if (new_save == NULL) {
+      return;
+    }
+    json->max_save = new_max;
+    json->save = new_save;
+  }
   if (LIKELY (c > 0)) {
-    if (UNLIKELY (json->max_save == 0)) {
-      size_t new_max = FAST_JSON_BUFFER_SIZE;
-      char *new_save;
-
-      new_save = (char *) json->my_realloc (json->save, new_max);
-      if (new_save == NULL) {
-	return;
-      }
-      json->max_save = new_max;
-      json->save = new_save;
-    }
     json->save[json->n_save++] = c;
   }
 }
@@ -624,6 +1300,10 @@ fast_json_ungetc_save (FAST_JSON_TYPE json, int c)
       json->n_save--;
     }
   }
+  if (UNLIKELY (json->save == NULL)) {
+    /* fast_json_getc_save_start could not allocate the buffer */
+    return (char *) "";
+  }
   json->save[json->n_save] = 0;
   return json->save;
 }
@@ -781,1922 +1461,8277 @@ fast_json_hex (FAST_JSON_TYPE json, const char **buf, unsigned int n)
   return h;
 }
 
-static FAST_JSON_ERROR_ENUM
-fast_json_check_string (FAST_JSON_TYPE json, const char *save,
-			const char *end, char *out, int sep)
+#if 0
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define	N	(64)
+#define	M	(2000)
+
+static int
+nbits (const uint32_t * x)
 {
-  const char *ptr;
-  const char *save_ptr;
-  char *ptr2;
-  unsigned int uc;
+  int i = N - 1;
 
-  ptr = save;
-  ptr2 = out;
-  while (ptr < end) {
-    static const char special1[256] = {
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      0, 0, '"', 0, 0, 0, 0, '\'', 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
-    };
-    if (LIKELY (special1[*ptr & 0xFFu] == 0)) {
-      *ptr2++ = *ptr++;
-    }
-    else if ((*ptr & 0x80u) != 0) {
-      unsigned char u = *ptr;
-      unsigned char size = 0;
-      unsigned int error = 1;
+  while (i >= 0 && x[i] == 0) {
+    i--;
+  }
+  return i < 0 ? 0 : i * 32 + 32 - __builtin_clz (x[i]);
+}
 
-      switch (fast_json_utf8_size[u]) {
-      case 0:			/* FALLTHRU */
-      case 1:
-	/* u >= 0x00u && u <= 0x7Fu not possible */
-	/* u >= 0x80u && u <= 0xBFu should be size 2 */
-	/* u >= 0xC0u && u <= 0xC1u remapped 0x00u..0x7Fu */
-	/* u >= 0xF5u && u <= 0xFFu not valid */
-	break;
-      case 2:
-	if (ptr[1]) {
-	  unsigned char u1 = ptr[1];
+static uint64_t
+get64 (const uint32_t * x, int shift)
+{
+  uint64_t r = 0;
+  int i;
 
-	  if (u1 >= 0x80u && u1 <= 0xBFu) {
-	    size = 2;
-	    uc = ((u & 0x1Fu) << 6) | (u1 & 0x3Fu);
-	    error = uc < 0x80u;
-	  }
-	}
-	break;
-      case 3:
-	if (ptr[1] && ptr[2]) {
-	  unsigned char u1 = ptr[1];
-	  unsigned char u2 = ptr[2];
+  for (i = 63; i >= 0; i--) {
+    int b = shift + i;
 
-	  if (u1 >= 0x80u && u1 <= 0xBFu && u2 >= 0x80u && u2 <= 0xBFu) {
-	    size = 3;
-	    uc = ((u & 0x0Fu) << 12) | ((u1 & 0x3Fu) << 6) | (u2 & 0x3Fu);
-	    error = uc < 0x800u || (uc >= 0xD800u && uc <= 0xDFFFu);
-	  }
-	}
+    r <<= 1;
+    if (b >= 0 && b < N * 32) {
+      r |= (x[b / 32] >> (b % 32)) & 1;
+    }
+  }
+  return r;
+}
+
+int
+main (void)
+{
+  static uint64_t neg[343][2];
+  uint32_t x[N];
+  uint32_t t[N];
+  uint64_t r;
+  int q;
+  int i;
+
+  /* 5^-q is calculated as floor (2^M / 5^q) */
+  memset (x, 0, sizeof (x));
+  x[M / 32] = 1u << (M % 32);
+  for (q = 1; q <= 342; q++) {
+    int z;
+    int b;
+
+    for (r = 0, i = N - 1; i >= 0; i--) {
+      r = (r << 32) | x[i];
+      x[i] = (uint32_t) (r / 5);
+      r %= 5;
+    }
+    z = M + 1 - nbits (x);
+    b = q <= 27 ? z + 127 : 2 * z + 128;
+    for (i = 0; i < N; i += 2) {
+      r = get64 (x, M - b + i * 32);
+      t[i] = (uint32_t) r;
+      t[i + 1] = (uint32_t) (r >> 32);
+    }
+    for (i = 0; i < N && ++t[i] == 0; i++) {
+    }
+    neg[q][0] = get64 (t, nbits (t) - 64);
+    neg[q][1] = get64 (t, nbits (t) - 128);
+  }
+  for (q = 342; q >= 1; q--) {
+    printf ("  {UINT64_C (0x%016llX), UINT64_C (0x%016llX)},\n",
+	    (unsigned long long) neg[q][0], (unsigned long long) neg[q][1]);
+  }
+  memset (x, 0, sizeof (x));
+  x[0] = 1;
+  for (q = 0; q <= 308; q++) {
+    printf ("  {UINT64_C (0x%016llX), UINT64_C (0x%016llX)},\n",
+	    (unsigned long long) get64 (x, nbits (x) - 64),
+	    (unsigned long long) get64 (x, nbits (x) - 128));
+    for (r = 0, i = 0; i < N; i++) {
+      r += (uint64_t) x[i] * 5;
+      x[i] = (uint32_t) r;
+      r >>= 32;
+    }
+  }
+  return 0;
+}
+#endif
+/* 128 bit approximations of 10^-342 .. 10^308 for the Eisel-Lemire
+ * algorithm. Generated with the program above.
+ */
+static const uint64_t fast_json_pow10[FAST_JSON_POW10_MAX - FAST_JSON_POW10_MIN + 1][2] = {
+  {UINT64_C (0xEEF453D6923BD65A), UINT64_C (0x113FAA2906A13B3F)},
+  {UINT64_C (0x9558B4661B6565F8), UINT64_C (0x4AC7CA59A424C507)},
+  {UINT64_C (0xBAAEE17FA23EBF76), UINT64_C (0x5D79BCF00D2DF649)},
+  {UINT64_C (0xE95A99DF8ACE6F53), UINT64_C (0xF4D82C2C107973DC)},
+  {UINT64_C (0x91D8A02BB6C10594), UINT64_C (0x79071B9B8A4BE869)},
+  {UINT64_C (0xB64EC836A47146F9), UINT64_C (0x9748E2826CDEE284)},
+  {UINT64_C (0xE3E27A444D8D98B7), UINT64_C (0xFD1B1B2308169B25)},
+  {UINT64_C (0x8E6D8C6AB0787F72), UINT64_C (0xFE30F0F5E50E20F7)},
+  {UINT64_C (0xB208EF855C969F4F), UINT64_C (0xBDBD2D335E51A935)},
+  {UINT64_C (0xDE8B2B66B3BC4723), UINT64_C (0xAD2C788035E61382)},
+  {UINT64_C (0x8B16FB203055AC76), UINT64_C (0x4C3BCB5021AFCC31)},
+  {UINT64_C (0xADDCB9E83C6B1793), UINT64_C (0xDF4ABE242A1BBF3D)},
+  {UINT64_C (0xD953E8624B85DD78), UINT64_C (0xD71D6DAD34A2AF0D)},
+  {UINT64_C (0x87D4713D6F33AA6B), UINT64_C (0x8672648C40E5AD68)},
+  {UINT64_C (0xA9C98D8CCB009506), UINT64_C (0x680EFDAF511F18C2)},
+  {UINT64_C (0xD43BF0EFFDC0BA48), UINT64_C (0x0212BD1B2566DEF2)},
+  {UINT64_C (0x84A57695FE98746D), UINT64_C (0x014BB630F7604B57)},
+  {UINT64_C (0xA5CED43B7E3E9188), UINT64_C (0x419EA3BD35385E2D)},
+  {UINT64_C (0xCF42894A5DCE35EA), UINT64_C (0x52064CAC828675B9)},
+  {UINT64_C (0x818995CE7AA0E1B2), UINT64_C (0x7343EFEBD1940993)},
+  {UINT64_C (0xA1EBFB4219491A1F), UINT64_C (0x1014EBE6C5F90BF8)},
+  {UINT64_C (0xCA66FA129F9B60A6), UINT64_C (0xD41A26E077774EF6)},
+  {UINT64_C (0xFD00B897478238D0), UINT64_C (0x8920B098955522B4)},
+  {UINT64_C (0x9E20735E8CB16382), UINT64_C (0x55B46E5F5D5535B0)},
+  {UINT64_C (0xC5A890362FDDBC62), UINT64_C (0xEB2189F734AA831D)},
+  {UINT64_C (0xF712B443BBD52B7B), UINT64_C (0xA5E9EC7501D523E4)},
+  {UINT64_C (0x9A6BB0AA55653B2D), UINT64_C (0x47B233C92125366E)},
+  {UINT64_C (0xC1069CD4EABE89F8), UINT64_C (0x999EC0BB696E840A)},
+  {UINT64_C (0xF148440A256E2C76), UINT64_C (0xC00670EA43CA250D)},
+  {UINT64_C (0x96CD2A865764DBCA), UINT64_C (0x380406926A5E5728)},
+  {UINT64_C (0xBC807527ED3E12BC), UINT64_C (0xC605083704F5ECF2)},
+  {UINT64_C (0xEBA09271E88D976B), UINT64_C (0xF7864A44C633682E)},
+  {UINT64_C (0x93445B8731587EA3), UINT64_C (0x7AB3EE6AFBE0211D)},
+  {UINT64_C (0xB8157268FDAE9E4C), UINT64_C (0x5960EA05BAD82964)},
+  {UINT64_C (0xE61ACF033D1A45DF), UINT64_C (0x6FB92487298E33BD)},
+  {UINT64_C (0x8FD0C16206306BAB), UINT64_C (0xA5D3B6D479F8E056)},
+  {UINT64_C (0xB3C4F1BA87BC8696), UINT64_C (0x8F48A4899877186C)},
+  {UINT64_C (0xE0B62E2929ABA83C), UINT64_C (0x331ACDABFE94DE87)},
+  {UINT64_C (0x8C71DCD9BA0B4925), UINT64_C (0x9FF0C08B7F1D0B14)},
+  {UINT64_C (0xAF8E5410288E1B6F), UINT64_C (0x07ECF0AE5EE44DD9)},
+  {UINT64_C (0xDB71E91432B1A24A), UINT64_C (0xC9E82CD9F69D6150)},
+  {UINT64_C (0x892731AC9FAF056E), UINT64_C (0xBE311C083A225CD2)},
+  {UINT64_C (0xAB70FE17C79AC6CA), UINT64_C (0x6DBD630A48AAF406)},
+  {UINT64_C (0xD64D3D9DB981787D), UINT64_C (0x092CBBCCDAD5B108)},
+  {UINT64_C (0x85F0468293F0EB4E), UINT64_C (0x25BBF56008C58EA5)},
+  {UINT64_C (0xA76C582338ED2621), UINT64_C (0xAF2AF2B80AF6F24E)},
+  {UINT64_C (0xD1476E2C07286FAA), UINT64_C (0x1AF5AF660DB4AEE1)},
+  {UINT64_C (0x82CCA4DB847945CA), UINT64_C (0x50D98D9FC890ED4D)},
+  {UINT64_C (0xA37FCE126597973C), UINT64_C (0xE50FF107BAB528A0)},
+  {UINT64_C (0xCC5FC196FEFD7D0C), UINT64_C (0x1E53ED49A96272C8)},
+  {UINT64_C (0xFF77B1FCBEBCDC4F), UINT64_C (0x25E8E89C13BB0F7A)},
+  {UINT64_C (0x9FAACF3DF73609B1), UINT64_C (0x77B191618C54E9AC)},
+  {UINT64_C (0xC795830D75038C1D), UINT64_C (0xD59DF5B9EF6A2417)},
+  {UINT64_C (0xF97AE3D0D2446F25), UINT64_C (0x4B0573286B44AD1D)},
+  {UINT64_C (0x9BECCE62836AC577), UINT64_C (0x4EE367F9430AEC32)},
+  {UINT64_C (0xC2E801FB244576D5), UINT64_C (0x229C41F793CDA73F)},
+  {UINT64_C (0xF3A20279ED56D48A), UINT64_C (0x6B43527578C1110F)},
+  {UINT64_C (0x9845418C345644D6), UINT64_C (0x830A13896B78AAA9)},
+  {UINT64_C (0xBE5691EF416BD60C), UINT64_C (0x23CC986BC656D553)},
+  {UINT64_C (0xEDEC366B11C6CB8F), UINT64_C (0x2CBFBE86B7EC8AA8)},
+  {UINT64_C (0x94B3A202EB1C3F39), UINT64_C (0x7BF7D71432F3D6A9)},
+  {UINT64_C (0xB9E08A83A5E34F07), UINT64_C (0xDAF5CCD93FB0CC53)},
+  {UINT64_C (0xE858AD248F5C22C9), UINT64_C (0xD1B3400F8F9CFF68)},
+  {UINT64_C (0x91376C36D99995BE), UINT64_C (0x23100809B9C21FA1)},
+  {UINT64_C (0xB58547448FFFFB2D), UINT64_C (0xABD40A0C2832A78A)},
+  {UINT64_C (0xE2E69915B3FFF9F9), UINT64_C (0x16C90C8F323F516C)},
+  {UINT64_C (0x8DD01FAD907FFC3B), UINT64_C (0xAE3DA7D97F6792E3)},
+  {UINT64_C (0xB1442798F49FFB4A), UINT64_C (0x99CD11CFDF41779C)},
+  {UINT64_C (0xDD95317F31C7FA1D), UINT64_C (0x40405643D711D583)},
+  {UINT64_C (0x8A7D3EEF7F1CFC52), UINT64_C (0x482835EA666B2572)},
+  {UINT64_C (0xAD1C8EAB5EE43B66), UINT64_C (0xDA3243650005EECF)},
+  {UINT64_C (0xD863B256369D4A40), UINT64_C (0x90BED43E40076A82)},
+  {UINT64_C (0x873E4F75E2224E68), UINT64_C (0x5A7744A6E804A291)},
+  {UINT64_C (0xA90DE3535AAAE202), UINT64_C (0x711515D0A205CB36)},
+  {UINT64_C (0xD3515C2831559A83), UINT64_C (0x0D5A5B44CA873E03)},
+  {UINT64_C (0x8412D9991ED58091), UINT64_C (0xE858790AFE9486C2)},
+  {UINT64_C (0xA5178FFF668AE0B6), UINT64_C (0x626E974DBE39A872)},
+  {UINT64_C (0xCE5D73FF402D98E3), UINT64_C (0xFB0A3D212DC8128F)},
+  {UINT64_C (0x80FA687F881C7F8E), UINT64_C (0x7CE66634BC9D0B99)},
+  {UINT64_C (0xA139029F6A239F72), UINT64_C (0x1C1FFFC1EBC44E80)},
+  {UINT64_C (0xC987434744AC874E), UINT64_C (0xA327FFB266B56220)},
+  {UINT64_C (0xFBE9141915D7A922), UINT64_C (0x4BF1FF9F0062BAA8)},
+  {UINT64_C (0x9D71AC8FADA6C9B5), UINT64_C (0x6F773FC3603DB4A9)},
+  {UINT64_C (0xC4CE17B399107C22), UINT64_C (0xCB550FB4384D21D3)},
+  {UINT64_C (0xF6019DA07F549B2B), UINT64_C (0x7E2A53A146606A48)},
+  {UINT64_C (0x99C102844F94E0FB), UINT64_C (0x2EDA7444CBFC426D)},
+  {UINT64_C (0xC0314325637A1939), UINT64_C (0xFA911155FEFB5308)},
+  {UINT64_C (0xF03D93EEBC589F88), UINT64_C (0x793555AB7EBA27CA)},
+  {UINT64_C (0x96267C7535B763B5), UINT64_C (0x4BC1558B2F3458DE)},
+  {UINT64_C (0xBBB01B9283253CA2), UINT64_C (0x9EB1AAEDFB016F16)},
+  {UINT64_C (0xEA9C227723EE8BCB), UINT64_C (0x465E15A979C1CADC)},
+  {UINT64_C (0x92A1958A7675175F), UINT64_C (0x0BFACD89EC191EC9)},
+  {UINT64_C (0xB749FAED14125D36), UINT64_C (0xCEF980EC671F667B)},
+  {UINT64_C (0xE51C79A85916F484), UINT64_C (0x82B7E12780E7401A)},
+  {UINT64_C (0x8F31CC0937AE58D2), UINT64_C (0xD1B2ECB8B0908810)},
+  {UINT64_C (0xB2FE3F0B8599EF07), UINT64_C (0x861FA7E6DCB4AA15)},
+  {UINT64_C (0xDFBDCECE67006AC9), UINT64_C (0x67A791E093E1D49A)},
+  {UINT64_C (0x8BD6A141006042BD), UINT64_C (0xE0C8BB2C5C6D24E0)},
+  {UINT64_C (0xAECC49914078536D), UINT64_C (0x58FAE9F773886E18)},
+  {UINT64_C (0xDA7F5BF590966848), UINT64_C (0xAF39A475506A899E)},
+  {UINT64_C (0x888F99797A5E012D), UINT64_C (0x6D8406C952429603)},
+  {UINT64_C (0xAAB37FD7D8F58178), UINT64_C (0xC8E5087BA6D33B83)},
+  {UINT64_C (0xD5605FCDCF32E1D6), UINT64_C (0xFB1E4A9A90880A64)},
+  {UINT64_C (0x855C3BE0A17FCD26), UINT64_C (0x5CF2EEA09A55067F)},
+  {UINT64_C (0xA6B34AD8C9DFC06F), UINT64_C (0xF42FAA48C0EA481E)},
+  {UINT64_C (0xD0601D8EFC57B08B), UINT64_C (0xF13B94DAF124DA26)},
+  {UINT64_C (0x823C12795DB6CE57), UINT64_C (0x76C53D08D6B70858)},
+  {UINT64_C (0xA2CB1717B52481ED), UINT64_C (0x54768C4B0C64CA6E)},
+  {UINT64_C (0xCB7DDCDDA26DA268), UINT64_C (0xA9942F5DCF7DFD09)},
+  {UINT64_C (0xFE5D54150B090B02), UINT64_C (0xD3F93B35435D7C4C)},
+  {UINT64_C (0x9EFA548D26E5A6E1), UINT64_C (0xC47BC5014A1A6DAF)},
+  {UINT64_C (0xC6B8E9B0709F109A), UINT64_C (0x359AB6419CA1091B)},
+  {UINT64_C (0xF867241C8CC6D4C0), UINT64_C (0xC30163D203C94B62)},
+  {UINT64_C (0x9B407691D7FC44F8), UINT64_C (0x79E0DE63425DCF1D)},
+  {UINT64_C (0xC21094364DFB5636), UINT64_C (0x985915FC12F542E4)},
+  {UINT64_C (0xF294B943E17A2BC4), UINT64_C (0x3E6F5B7B17B2939D)},
+  {UINT64_C (0x979CF3CA6CEC5B5A), UINT64_C (0xA705992CEECF9C42)},
+  {UINT64_C (0xBD8430BD08277231), UINT64_C (0x50C6FF782A838353)},
+  {UINT64_C (0xECE53CEC4A314EBD), UINT64_C (0xA4F8BF5635246428)},
+  {UINT64_C (0x940F4613AE5ED136), UINT64_C (0x871B7795E136BE99)},
+  {UINT64_C (0xB913179899F68584), UINT64_C (0x28E2557B59846E3F)},
+  {UINT64_C (0xE757DD7EC07426E5), UINT64_C (0x331AEADA2FE589CF)},
+  {UINT64_C (0x9096EA6F3848984F), UINT64_C (0x3FF0D2C85DEF7621)},
+  {UINT64_C (0xB4BCA50B065ABE63), UINT64_C (0x0FED077A756B53A9)},
+  {UINT64_C (0xE1EBCE4DC7F16DFB), UINT64_C (0xD3E8495912C62894)},
+  {UINT64_C (0x8D3360F09CF6E4BD), UINT64_C (0x64712DD7ABBBD95C)},
+  {UINT64_C (0xB080392CC4349DEC), UINT64_C (0xBD8D794D96AACFB3)},
+  {UINT64_C (0xDCA04777F541C567), UINT64_C (0xECF0D7A0FC5583A0)},
+  {UINT64_C (0x89E42CAAF9491B60), UINT64_C (0xF41686C49DB57244)},
+  {UINT64_C (0xAC5D37D5B79B6239), UINT64_C (0x311C2875C522CED5)},
+  {UINT64_C (0xD77485CB25823AC7), UINT64_C (0x7D633293366B828B)},
+  {UINT64_C (0x86A8D39EF77164BC), UINT64_C (0xAE5DFF9C02033197)},
+  {UINT64_C (0xA8530886B54DBDEB), UINT64_C (0xD9F57F830283FDFC)},
+  {UINT64_C (0xD267CAA862A12D66), UINT64_C (0xD072DF63C324FD7B)},
+  {UINT64_C (0x8380DEA93DA4BC60), UINT64_C (0x4247CB9E59F71E6D)},
+  {UINT64_C (0xA46116538D0DEB78), UINT64_C (0x52D9BE85F074E608)},
+  {UINT64_C (0xCD795BE870516656), UINT64_C (0x67902E276C921F8B)},
+  {UINT64_C (0x806BD9714632DFF6), UINT64_C (0x00BA1CD8A3DB53B6)},
+  {UINT64_C (0xA086CFCD97BF97F3), UINT64_C (0x80E8A40ECCD228A4)},
+  {UINT64_C (0xC8A883C0FDAF7DF0), UINT64_C (0x6122CD128006B2CD)},
+  {UINT64_C (0xFAD2A4B13D1B5D6C), UINT64_C (0x796B805720085F81)},
+  {UINT64_C (0x9CC3A6EEC6311A63), UINT64_C (0xCBE3303674053BB0)},
+  {UINT64_C (0xC3F490AA77BD60FC), UINT64_C (0xBEDBFC4411068A9C)},
+  {UINT64_C (0xF4F1B4D515ACB93B), UINT64_C (0xEE92FB5515482D44)},
+  {UINT64_C (0x991711052D8BF3C5), UINT64_C (0x751BDD152D4D1C4A)},
+  {UINT64_C (0xBF5CD54678EEF0B6), UINT64_C (0xD262D45A78A0635D)},
+  {UINT64_C (0xEF340A98172AACE4), UINT64_C (0x86FB897116C87C34)},
+  {UINT64_C (0x9580869F0E7AAC0E), UINT64_C (0xD45D35E6AE3D4DA0)},
+  {UINT64_C (0xBAE0A846D2195712), UINT64_C (0x8974836059CCA109)},
+  {UINT64_C (0xE998D258869FACD7), UINT64_C (0x2BD1A438703FC94B)},
+  {UINT64_C (0x91FF83775423CC06), UINT64_C (0x7B6306A34627DDCF)},
+  {UINT64_C (0xB67F6455292CBF08), UINT64_C (0x1A3BC84C17B1D542)},
+  {UINT64_C (0xE41F3D6A7377EECA), UINT64_C (0x20CABA5F1D9E4A93)},
+  {UINT64_C (0x8E938662882AF53E), UINT64_C (0x547EB47B7282EE9C)},
+  {UINT64_C (0xB23867FB2A35B28D), UINT64_C (0xE99E619A4F23AA43)},
+  {UINT64_C (0xDEC681F9F4C31F31), UINT64_C (0x6405FA00E2EC94D4)},
+  {UINT64_C (0x8B3C113C38F9F37E), UINT64_C (0xDE83BC408DD3DD04)},
+  {UINT64_C (0xAE0B158B4738705E), UINT64_C (0x9624AB50B148D445)},
+  {UINT64_C (0xD98DDAEE19068C76), UINT64_C (0x3BADD624DD9B0957)},
+  {UINT64_C (0x87F8A8D4CFA417C9), UINT64_C (0xE54CA5D70A80E5D6)},
+  {UINT64_C (0xA9F6D30A038D1DBC), UINT64_C (0x5E9FCF4CCD211F4C)},
+  {UINT64_C (0xD47487CC8470652B), UINT64_C (0x7647C3200069671F)},
+  {UINT64_C (0x84C8D4DFD2C63F3B), UINT64_C (0x29ECD9F40041E073)},
+  {UINT64_C (0xA5FB0A17C777CF09), UINT64_C (0xF468107100525890)},
+  {UINT64_C (0xCF79CC9DB955C2CC), UINT64_C (0x7182148D4066EEB4)},
+  {UINT64_C (0x81AC1FE293D599BF), UINT64_C (0xC6F14CD848405530)},
+  {UINT64_C (0xA21727DB38CB002F), UINT64_C (0xB8ADA00E5A506A7C)},
+  {UINT64_C (0xCA9CF1D206FDC03B), UINT64_C (0xA6D90811F0E4851C)},
+  {UINT64_C (0xFD442E4688BD304A), UINT64_C (0x908F4A166D1DA663)},
+  {UINT64_C (0x9E4A9CEC15763E2E), UINT64_C (0x9A598E4E043287FE)},
+  {UINT64_C (0xC5DD44271AD3CDBA), UINT64_C (0x40EFF1E1853F29FD)},
+  {UINT64_C (0xF7549530E188C128), UINT64_C (0xD12BEE59E68EF47C)},
+  {UINT64_C (0x9A94DD3E8CF578B9), UINT64_C (0x82BB74F8301958CE)},
+  {UINT64_C (0xC13A148E3032D6E7), UINT64_C (0xE36A52363C1FAF01)},
+  {UINT64_C (0xF18899B1BC3F8CA1), UINT64_C (0xDC44E6C3CB279AC1)},
+  {UINT64_C (0x96F5600F15A7B7E5), UINT64_C (0x29AB103A5EF8C0B9)},
+  {UINT64_C (0xBCB2B812DB11A5DE), UINT64_C (0x7415D448F6B6F0E7)},
+  {UINT64_C (0xEBDF661791D60F56), UINT64_C (0x111B495B3464AD21)},
+  {UINT64_C (0x936B9FCEBB25C995), UINT64_C (0xCAB10DD900BEEC34)},
+  {UINT64_C (0xB84687C269EF3BFB), UINT64_C (0x3D5D514F40EEA742)},
+  {UINT64_C (0xE65829B3046B0AFA), UINT64_C (0x0CB4A5A3112A5112)},
+  {UINT64_C (0x8FF71A0FE2C2E6DC), UINT64_C (0x47F0E785EABA72AB)},
+  {UINT64_C (0xB3F4E093DB73A093), UINT64_C (0x59ED216765690F56)},
+  {UINT64_C (0xE0F218B8D25088B8), UINT64_C (0x306869C13EC3532C)},
+  {UINT64_C (0x8C974F7383725573), UINT64_C (0x1E414218C73A13FB)},
+  {UINT64_C (0xAFBD2350644EEACF), UINT64_C (0xE5D1929EF90898FA)},
+  {UINT64_C (0xDBAC6C247D62A583), UINT64_C (0xDF45F746B74ABF39)},
+  {UINT64_C (0x894BC396CE5DA772), UINT64_C (0x6B8BBA8C328EB783)},
+  {UINT64_C (0xAB9EB47C81F5114F), UINT64_C (0x066EA92F3F326564)},
+  {UINT64_C (0xD686619BA27255A2), UINT64_C (0xC80A537B0EFEFEBD)},
+  {UINT64_C (0x8613FD0145877585), UINT64_C (0xBD06742CE95F5F36)},
+  {UINT64_C (0xA798FC4196E952E7), UINT64_C (0x2C48113823B73704)},
+  {UINT64_C (0xD17F3B51FCA3A7A0), UINT64_C (0xF75A15862CA504C5)},
+  {UINT64_C (0x82EF85133DE648C4), UINT64_C (0x9A984D73DBE722FB)},
+  {UINT64_C (0xA3AB66580D5FDAF5), UINT64_C (0xC13E60D0D2E0EBBA)},
+  {UINT64_C (0xCC963FEE10B7D1B3), UINT64_C (0x318DF905079926A8)},
+  {UINT64_C (0xFFBBCFE994E5C61F), UINT64_C (0xFDF17746497F7052)},
+  {UINT64_C (0x9FD561F1FD0F9BD3), UINT64_C (0xFEB6EA8BEDEFA633)},
+  {UINT64_C (0xC7CABA6E7C5382C8), UINT64_C (0xFE64A52EE96B8FC0)},
+  {UINT64_C (0xF9BD690A1B68637B), UINT64_C (0x3DFDCE7AA3C673B0)},
+  {UINT64_C (0x9C1661A651213E2D), UINT64_C (0x06BEA10CA65C084E)},
+  {UINT64_C (0xC31BFA0FE5698DB8), UINT64_C (0x486E494FCFF30A62)},
+  {UINT64_C (0xF3E2F893DEC3F126), UINT64_C (0x5A89DBA3C3EFCCFA)},
+  {UINT64_C (0x986DDB5C6B3A76B7), UINT64_C (0xF89629465A75E01C)},
+  {UINT64_C (0xBE89523386091465), UINT64_C (0xF6BBB397F1135823)},
+  {UINT64_C (0xEE2BA6C0678B597F), UINT64_C (0x746AA07DED582E2C)},
+  {UINT64_C (0x94DB483840B717EF), UINT64_C (0xA8C2A44EB4571CDC)},
+  {UINT64_C (0xBA121A4650E4DDEB), UINT64_C (0x92F34D62616CE413)},
+  {UINT64_C (0xE896A0D7E51E1566), UINT64_C (0x77B020BAF9C81D17)},
+  {UINT64_C (0x915E2486EF32CD60), UINT64_C (0x0ACE1474DC1D122E)},
+  {UINT64_C (0xB5B5ADA8AAFF80B8), UINT64_C (0x0D819992132456BA)},
+  {UINT64_C (0xE3231912D5BF60E6), UINT64_C (0x10E1FFF697ED6C69)},
+  {UINT64_C (0x8DF5EFABC5979C8F), UINT64_C (0xCA8D3FFA1EF463C1)},
+  {UINT64_C (0xB1736B96B6FD83B3), UINT64_C (0xBD308FF8A6B17CB2)},
+  {UINT64_C (0xDDD0467C64BCE4A0), UINT64_C (0xAC7CB3F6D05DDBDE)},
+  {UINT64_C (0x8AA22C0DBEF60EE4), UINT64_C (0x6BCDF07A423AA96B)},
+  {UINT64_C (0xAD4AB7112EB3929D), UINT64_C (0x86C16C98D2C953C6)},
+  {UINT64_C (0xD89D64D57A607744), UINT64_C (0xE871C7BF077BA8B7)},
+  {UINT64_C (0x87625F056C7C4A8B), UINT64_C (0x11471CD764AD4972)},
+  {UINT64_C (0xA93AF6C6C79B5D2D), UINT64_C (0xD598E40D3DD89BCF)},
+  {UINT64_C (0xD389B47879823479), UINT64_C (0x4AFF1D108D4EC2C3)},
+  {UINT64_C (0x843610CB4BF160CB), UINT64_C (0xCEDF722A585139BA)},
+  {UINT64_C (0xA54394FE1EEDB8FE), UINT64_C (0xC2974EB4EE658828)},
+  {UINT64_C (0xCE947A3DA6A9273E), UINT64_C (0x733D226229FEEA32)},
+  {UINT64_C (0x811CCC668829B887), UINT64_C (0x0806357D5A3F525F)},
+  {UINT64_C (0xA163FF802A3426A8), UINT64_C (0xCA07C2DCB0CF26F7)},
+  {UINT64_C (0xC9BCFF6034C13052), UINT64_C (0xFC89B393DD02F0B5)},
+  {UINT64_C (0xFC2C3F3841F17C67), UINT64_C (0xBBAC2078D443ACE2)},
+  {UINT64_C (0x9D9BA7832936EDC0), UINT64_C (0xD54B944B84AA4C0D)},
+  {UINT64_C (0xC5029163F384A931), UINT64_C (0x0A9E795E65D4DF11)},
+  {UINT64_C (0xF64335BCF065D37D), UINT64_C (0x4D4617B5FF4A16D5)},
+  {UINT64_C (0x99EA0196163FA42E), UINT64_C (0x504BCED1BF8E4E45)},
+  {UINT64_C (0xC06481FB9BCF8D39), UINT64_C (0xE45EC2862F71E1D6)},
+  {UINT64_C (0xF07DA27A82C37088), UINT64_C (0x5D767327BB4E5A4C)},
+  {UINT64_C (0x964E858C91BA2655), UINT64_C (0x3A6A07F8D510F86F)},
+  {UINT64_C (0xBBE226EFB628AFEA), UINT64_C (0x890489F70A55368B)},
+  {UINT64_C (0xEADAB0ABA3B2DBE5), UINT64_C (0x2B45AC74CCEA842E)},
+  {UINT64_C (0x92C8AE6B464FC96F), UINT64_C (0x3B0B8BC90012929D)},
+  {UINT64_C (0xB77ADA0617E3BBCB), UINT64_C (0x09CE6EBB40173744)},
+  {UINT64_C (0xE55990879DDCAABD), UINT64_C (0xCC420A6A101D0515)},
+  {UINT64_C (0x8F57FA54C2A9EAB6), UINT64_C (0x9FA946824A12232D)},
+  {UINT64_C (0xB32DF8E9F3546564), UINT64_C (0x47939822DC96ABF9)},
+  {UINT64_C (0xDFF9772470297EBD), UINT64_C (0x59787E2B93BC56F7)},
+  {UINT64_C (0x8BFBEA76C619EF36), UINT64_C (0x57EB4EDB3C55B65A)},
+  {UINT64_C (0xAEFAE51477A06B03), UINT64_C (0xEDE622920B6B23F1)},
+  {UINT64_C (0xDAB99E59958885C4), UINT64_C (0xE95FAB368E45ECED)},
+  {UINT64_C (0x88B402F7FD75539B), UINT64_C (0x11DBCB0218EBB414)},
+  {UINT64_C (0xAAE103B5FCD2A881), UINT64_C (0xD652BDC29F26A119)},
+  {UINT64_C (0xD59944A37C0752A2), UINT64_C (0x4BE76D3346F0495F)},
+  {UINT64_C (0x857FCAE62D8493A5), UINT64_C (0x6F70A4400C562DDB)},
+  {UINT64_C (0xA6DFBD9FB8E5B88E), UINT64_C (0xCB4CCD500F6BB952)},
+  {UINT64_C (0xD097AD07A71F26B2), UINT64_C (0x7E2000A41346A7A7)},
+  {UINT64_C (0x825ECC24C873782F), UINT64_C (0x8ED400668C0C28C8)},
+  {UINT64_C (0xA2F67F2DFA90563B), UINT64_C (0x728900802F0F32FA)},
+  {UINT64_C (0xCBB41EF979346BCA), UINT64_C (0x4F2B40A03AD2FFB9)},
+  {UINT64_C (0xFEA126B7D78186BC), UINT64_C (0xE2F610C84987BFA8)},
+  {UINT64_C (0x9F24B832E6B0F436), UINT64_C (0x0DD9CA7D2DF4D7C9)},
+  {UINT64_C (0xC6EDE63FA05D3143), UINT64_C (0x91503D1C79720DBB)},
+  {UINT64_C (0xF8A95FCF88747D94), UINT64_C (0x75A44C6397CE912A)},
+  {UINT64_C (0x9B69DBE1B548CE7C), UINT64_C (0xC986AFBE3EE11ABA)},
+  {UINT64_C (0xC24452DA229B021B), UINT64_C (0xFBE85BADCE996168)},
+  {UINT64_C (0xF2D56790AB41C2A2), UINT64_C (0xFAE27299423FB9C3)},
+  {UINT64_C (0x97C560BA6B0919A5), UINT64_C (0xDCCD879FC967D41A)},
+  {UINT64_C (0xBDB6B8E905CB600F), UINT64_C (0x5400E987BBC1C920)},
+  {UINT64_C (0xED246723473E3813), UINT64_C (0x290123E9AAB23B68)},
+  {UINT64_C (0x9436C0760C86E30B), UINT64_C (0xF9A0B6720AAF6521)},
+  {UINT64_C (0xB94470938FA89BCE), UINT64_C (0xF808E40E8D5B3E69)},
+  {UINT64_C (0xE7958CB87392C2C2), UINT64_C (0xB60B1D1230B20E04)},
+  {UINT64_C (0x90BD77F3483BB9B9), UINT64_C (0xB1C6F22B5E6F48C2)},
+  {UINT64_C (0xB4ECD5F01A4AA828), UINT64_C (0x1E38AEB6360B1AF3)},
+  {UINT64_C (0xE2280B6C20DD5232), UINT64_C (0x25C6DA63C38DE1B0)},
+  {UINT64_C (0x8D590723948A535F), UINT64_C (0x579C487E5A38AD0E)},
+  {UINT64_C (0xB0AF48EC79ACE837), UINT64_C (0x2D835A9DF0C6D851)},
+  {UINT64_C (0xDCDB1B2798182244), UINT64_C (0xF8E431456CF88E65)},
+  {UINT64_C (0x8A08F0F8BF0F156B), UINT64_C (0x1B8E9ECB641B58FF)},
+  {UINT64_C (0xAC8B2D36EED2DAC5), UINT64_C (0xE272467E3D222F3F)},
+  {UINT64_C (0xD7ADF884AA879177), UINT64_C (0x5B0ED81DCC6ABB0F)},
+  {UINT64_C (0x86CCBB52EA94BAEA), UINT64_C (0x98E947129FC2B4E9)},
+  {UINT64_C (0xA87FEA27A539E9A5), UINT64_C (0x3F2398D747B36224)},
+  {UINT64_C (0xD29FE4B18E88640E), UINT64_C (0x8EEC7F0D19A03AAD)},
+  {UINT64_C (0x83A3EEEEF9153E89), UINT64_C (0x1953CF68300424AC)},
+  {UINT64_C (0xA48CEAAAB75A8E2B), UINT64_C (0x5FA8C3423C052DD7)},
+  {UINT64_C (0xCDB02555653131B6), UINT64_C (0x3792F412CB06794D)},
+  {UINT64_C (0x808E17555F3EBF11), UINT64_C (0xE2BBD88BBEE40BD0)},
+  {UINT64_C (0xA0B19D2AB70E6ED6), UINT64_C (0x5B6ACEAEAE9D0EC4)},
+  {UINT64_C (0xC8DE047564D20A8B), UINT64_C (0xF245825A5A445275)},
+  {UINT64_C (0xFB158592BE068D2E), UINT64_C (0xEED6E2F0F0D56712)},
+  {UINT64_C (0x9CED737BB6C4183D), UINT64_C (0x55464DD69685606B)},
+  {UINT64_C (0xC428D05AA4751E4C), UINT64_C (0xAA97E14C3C26B886)},
+  {UINT64_C (0xF53304714D9265DF), UINT64_C (0xD53DD99F4B3066A8)},
+  {UINT64_C (0x993FE2C6D07B7FAB), UINT64_C (0xE546A8038EFE4029)},
+  {UINT64_C (0xBF8FDB78849A5F96), UINT64_C (0xDE98520472BDD033)},
+  {UINT64_C (0xEF73D256A5C0F77C), UINT64_C (0x963E66858F6D4440)},
+  {UINT64_C (0x95A8637627989AAD), UINT64_C (0xDDE7001379A44AA8)},
+  {UINT64_C (0xBB127C53B17EC159), UINT64_C (0x5560C018580D5D52)},
+  {UINT64_C (0xE9D71B689DDE71AF), UINT64_C (0xAAB8F01E6E10B4A6)},
+  {UINT64_C (0x9226712162AB070D), UINT64_C (0xCAB3961304CA70E8)},
+  {UINT64_C (0xB6B00D69BB55C8D1), UINT64_C (0x3D607B97C5FD0D22)},
+  {UINT64_C (0xE45C10C42A2B3B05), UINT64_C (0x8CB89A7DB77C506A)},
+  {UINT64_C (0x8EB98A7A9A5B04E3), UINT64_C (0x77F3608E92ADB242)},
+  {UINT64_C (0xB267ED1940F1C61C), UINT64_C (0x55F038B237591ED3)},
+  {UINT64_C (0xDF01E85F912E37A3), UINT64_C (0x6B6C46DEC52F6688)},
+  {UINT64_C (0x8B61313BBABCE2C6), UINT64_C (0x2323AC4B3B3DA015)},
+  {UINT64_C (0xAE397D8AA96C1B77), UINT64_C (0xABEC975E0A0D081A)},
+  {UINT64_C (0xD9C7DCED53C72255), UINT64_C (0x96E7BD358C904A21)},
+  {UINT64_C (0x881CEA14545C7575), UINT64_C (0x7E50D64177DA2E54)},
+  {UINT64_C (0xAA242499697392D2), UINT64_C (0xDDE50BD1D5D0B9E9)},
+  {UINT64_C (0xD4AD2DBFC3D07787), UINT64_C (0x955E4EC64B44E864)},
+  {UINT64_C (0x84EC3C97DA624AB4), UINT64_C (0xBD5AF13BEF0B113E)},
+  {UINT64_C (0xA6274BBDD0FADD61), UINT64_C (0xECB1AD8AEACDD58E)},
+  {UINT64_C (0xCFB11EAD453994BA), UINT64_C (0x67DE18EDA5814AF2)},
+  {UINT64_C (0x81CEB32C4B43FCF4), UINT64_C (0x80EACF948770CED7)},
+  {UINT64_C (0xA2425FF75E14FC31), UINT64_C (0xA1258379A94D028D)},
+  {UINT64_C (0xCAD2F7F5359A3B3E), UINT64_C (0x096EE45813A04330)},
+  {UINT64_C (0xFD87B5F28300CA0D), UINT64_C (0x8BCA9D6E188853FC)},
+  {UINT64_C (0x9E74D1B791E07E48), UINT64_C (0x775EA264CF55347E)},
+  {UINT64_C (0xC612062576589DDA), UINT64_C (0x95364AFE032A819E)},
+  {UINT64_C (0xF79687AED3EEC551), UINT64_C (0x3A83DDBD83F52205)},
+  {UINT64_C (0x9ABE14CD44753B52), UINT64_C (0xC4926A9672793543)},
+  {UINT64_C (0xC16D9A0095928A27), UINT64_C (0x75B7053C0F178294)},
+  {UINT64_C (0xF1C90080BAF72CB1), UINT64_C (0x5324C68B12DD6339)},
+  {UINT64_C (0x971DA05074DA7BEE), UINT64_C (0xD3F6FC16EBCA5E04)},
+  {UINT64_C (0xBCE5086492111AEA), UINT64_C (0x88F4BB1CA6BCF585)},
+  {UINT64_C (0xEC1E4A7DB69561A5), UINT64_C (0x2B31E9E3D06C32E6)},
+  {UINT64_C (0x9392EE8E921D5D07), UINT64_C (0x3AFF322E62439FD0)},
+  {UINT64_C (0xB877AA3236A4B449), UINT64_C (0x09BEFEB9FAD487C3)},
+  {UINT64_C (0xE69594BEC44DE15B), UINT64_C (0x4C2EBE687989A9B4)},
+  {UINT64_C (0x901D7CF73AB0ACD9), UINT64_C (0x0F9D37014BF60A11)},
+  {UINT64_C (0xB424DC35095CD80F), UINT64_C (0x538484C19EF38C95)},
+  {UINT64_C (0xE12E13424BB40E13), UINT64_C (0x2865A5F206B06FBA)},
+  {UINT64_C (0x8CBCCC096F5088CB), UINT64_C (0xF93F87B7442E45D4)},
+  {UINT64_C (0xAFEBFF0BCB24AAFE), UINT64_C (0xF78F69A51539D749)},
+  {UINT64_C (0xDBE6FECEBDEDD5BE), UINT64_C (0xB573440E5A884D1C)},
+  {UINT64_C (0x89705F4136B4A597), UINT64_C (0x31680A88F8953031)},
+  {UINT64_C (0xABCC77118461CEFC), UINT64_C (0xFDC20D2B36BA7C3E)},
+  {UINT64_C (0xD6BF94D5E57A42BC), UINT64_C (0x3D32907604691B4D)},
+  {UINT64_C (0x8637BD05AF6C69B5), UINT64_C (0xA63F9A49C2C1B110)},
+  {UINT64_C (0xA7C5AC471B478423), UINT64_C (0x0FCF80DC33721D54)},
+  {UINT64_C (0xD1B71758E219652B), UINT64_C (0xD3C36113404EA4A9)},
+  {UINT64_C (0x83126E978D4FDF3B), UINT64_C (0x645A1CAC083126EA)},
+  {UINT64_C (0xA3D70A3D70A3D70A), UINT64_C (0x3D70A3D70A3D70A4)},
+  {UINT64_C (0xCCCCCCCCCCCCCCCC), UINT64_C (0xCCCCCCCCCCCCCCCD)},
+  {UINT64_C (0x8000000000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xA000000000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xC800000000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xFA00000000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x9C40000000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xC350000000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xF424000000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x9896800000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xBEBC200000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xEE6B280000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x9502F90000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xBA43B74000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xE8D4A51000000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x9184E72A00000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xB5E620F480000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xE35FA931A0000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x8E1BC9BF04000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xB1A2BC2EC5000000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xDE0B6B3A76400000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x8AC7230489E80000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xAD78EBC5AC620000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xD8D726B7177A8000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x878678326EAC9000), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xA968163F0A57B400), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xD3C21BCECCEDA100), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x84595161401484A0), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xA56FA5B99019A5C8), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0xCECB8F27F4200F3A), UINT64_C (0x0000000000000000)},
+  {UINT64_C (0x813F3978F8940984), UINT64_C (0x4000000000000000)},
+  {UINT64_C (0xA18F07D736B90BE5), UINT64_C (0x5000000000000000)},
+  {UINT64_C (0xC9F2C9CD04674EDE), UINT64_C (0xA400000000000000)},
+  {UINT64_C (0xFC6F7C4045812296), UINT64_C (0x4D00000000000000)},
+  {UINT64_C (0x9DC5ADA82B70B59D), UINT64_C (0xF020000000000000)},
+  {UINT64_C (0xC5371912364CE305), UINT64_C (0x6C28000000000000)},
+  {UINT64_C (0xF684DF56C3E01BC6), UINT64_C (0xC732000000000000)},
+  {UINT64_C (0x9A130B963A6C115C), UINT64_C (0x3C7F400000000000)},
+  {UINT64_C (0xC097CE7BC90715B3), UINT64_C (0x4B9F100000000000)},
+  {UINT64_C (0xF0BDC21ABB48DB20), UINT64_C (0x1E86D40000000000)},
+  {UINT64_C (0x96769950B50D88F4), UINT64_C (0x1314448000000000)},
+  {UINT64_C (0xBC143FA4E250EB31), UINT64_C (0x17D955A000000000)},
+  {UINT64_C (0xEB194F8E1AE525FD), UINT64_C (0x5DCFAB0800000000)},
+  {UINT64_C (0x92EFD1B8D0CF37BE), UINT64_C (0x5AA1CAE500000000)},
+  {UINT64_C (0xB7ABC627050305AD), UINT64_C (0xF14A3D9E40000000)},
+  {UINT64_C (0xE596B7B0C643C719), UINT64_C (0x6D9CCD05D0000000)},
+  {UINT64_C (0x8F7E32CE7BEA5C6F), UINT64_C (0xE4820023A2000000)},
+  {UINT64_C (0xB35DBF821AE4F38B), UINT64_C (0xDDA2802C8A800000)},
+  {UINT64_C (0xE0352F62A19E306E), UINT64_C (0xD50B2037AD200000)},
+  {UINT64_C (0x8C213D9DA502DE45), UINT64_C (0x4526F422CC340000)},
+  {UINT64_C (0xAF298D050E4395D6), UINT64_C (0x9670B12B7F410000)},
+  {UINT64_C (0xDAF3F04651D47B4C), UINT64_C (0x3C0CDD765F114000)},
+  {UINT64_C (0x88D8762BF324CD0F), UINT64_C (0xA5880A69FB6AC800)},
+  {UINT64_C (0xAB0E93B6EFEE0053), UINT64_C (0x8EEA0D047A457A00)},
+  {UINT64_C (0xD5D238A4ABE98068), UINT64_C (0x72A4904598D6D880)},
+  {UINT64_C (0x85A36366EB71F041), UINT64_C (0x47A6DA2B7F864750)},
+  {UINT64_C (0xA70C3C40A64E6C51), UINT64_C (0x999090B65F67D924)},
+  {UINT64_C (0xD0CF4B50CFE20765), UINT64_C (0xFFF4B4E3F741CF6D)},
+  {UINT64_C (0x82818F1281ED449F), UINT64_C (0xBFF8F10E7A8921A4)},
+  {UINT64_C (0xA321F2D7226895C7), UINT64_C (0xAFF72D52192B6A0D)},
+  {UINT64_C (0xCBEA6F8CEB02BB39), UINT64_C (0x9BF4F8A69F764490)},
+  {UINT64_C (0xFEE50B7025C36A08), UINT64_C (0x02F236D04753D5B4)},
+  {UINT64_C (0x9F4F2726179A2245), UINT64_C (0x01D762422C946590)},
+  {UINT64_C (0xC722F0EF9D80AAD6), UINT64_C (0x424D3AD2B7B97EF5)},
+  {UINT64_C (0xF8EBAD2B84E0D58B), UINT64_C (0xD2E0898765A7DEB2)},
+  {UINT64_C (0x9B934C3B330C8577), UINT64_C (0x63CC55F49F88EB2F)},
+  {UINT64_C (0xC2781F49FFCFA6D5), UINT64_C (0x3CBF6B71C76B25FB)},
+  {UINT64_C (0xF316271C7FC3908A), UINT64_C (0x8BEF464E3945EF7A)},
+  {UINT64_C (0x97EDD871CFDA3A56), UINT64_C (0x97758BF0E3CBB5AC)},
+  {UINT64_C (0xBDE94E8E43D0C8EC), UINT64_C (0x3D52EEED1CBEA317)},
+  {UINT64_C (0xED63A231D4C4FB27), UINT64_C (0x4CA7AAA863EE4BDD)},
+  {UINT64_C (0x945E455F24FB1CF8), UINT64_C (0x8FE8CAA93E74EF6A)},
+  {UINT64_C (0xB975D6B6EE39E436), UINT64_C (0xB3E2FD538E122B44)},
+  {UINT64_C (0xE7D34C64A9C85D44), UINT64_C (0x60DBBCA87196B616)},
+  {UINT64_C (0x90E40FBEEA1D3A4A), UINT64_C (0xBC8955E946FE31CD)},
+  {UINT64_C (0xB51D13AEA4A488DD), UINT64_C (0x6BABAB6398BDBE41)},
+  {UINT64_C (0xE264589A4DCDAB14), UINT64_C (0xC696963C7EED2DD1)},
+  {UINT64_C (0x8D7EB76070A08AEC), UINT64_C (0xFC1E1DE5CF543CA2)},
+  {UINT64_C (0xB0DE65388CC8ADA8), UINT64_C (0x3B25A55F43294BCB)},
+  {UINT64_C (0xDD15FE86AFFAD912), UINT64_C (0x49EF0EB713F39EBE)},
+  {UINT64_C (0x8A2DBF142DFCC7AB), UINT64_C (0x6E3569326C784337)},
+  {UINT64_C (0xACB92ED9397BF996), UINT64_C (0x49C2C37F07965404)},
+  {UINT64_C (0xD7E77A8F87DAF7FB), UINT64_C (0xDC33745EC97BE906)},
+  {UINT64_C (0x86F0AC99B4E8DAFD), UINT64_C (0x69A028BB3DED71A3)},
+  {UINT64_C (0xA8ACD7C0222311BC), UINT64_C (0xC40832EA0D68CE0C)},
+  {UINT64_C (0xD2D80DB02AABD62B), UINT64_C (0xF50A3FA490C30190)},
+  {UINT64_C (0x83C7088E1AAB65DB), UINT64_C (0x792667C6DA79E0FA)},
+  {UINT64_C (0xA4B8CAB1A1563F52), UINT64_C (0x577001B891185938)},
+  {UINT64_C (0xCDE6FD5E09ABCF26), UINT64_C (0xED4C0226B55E6F86)},
+  {UINT64_C (0x80B05E5AC60B6178), UINT64_C (0x544F8158315B05B4)},
+  {UINT64_C (0xA0DC75F1778E39D6), UINT64_C (0x696361AE3DB1C721)},
+  {UINT64_C (0xC913936DD571C84C), UINT64_C (0x03BC3A19CD1E38E9)},
+  {UINT64_C (0xFB5878494ACE3A5F), UINT64_C (0x04AB48A04065C723)},
+  {UINT64_C (0x9D174B2DCEC0E47B), UINT64_C (0x62EB0D64283F9C76)},
+  {UINT64_C (0xC45D1DF942711D9A), UINT64_C (0x3BA5D0BD324F8394)},
+  {UINT64_C (0xF5746577930D6500), UINT64_C (0xCA8F44EC7EE36479)},
+  {UINT64_C (0x9968BF6ABBE85F20), UINT64_C (0x7E998B13CF4E1ECB)},
+  {UINT64_C (0xBFC2EF456AE276E8), UINT64_C (0x9E3FEDD8C321A67E)},
+  {UINT64_C (0xEFB3AB16C59B14A2), UINT64_C (0xC5CFE94EF3EA101E)},
+  {UINT64_C (0x95D04AEE3B80ECE5), UINT64_C (0xBBA1F1D158724A12)},
+  {UINT64_C (0xBB445DA9CA61281F), UINT64_C (0x2A8A6E45AE8EDC97)},
+  {UINT64_C (0xEA1575143CF97226), UINT64_C (0xF52D09D71A3293BD)},
+  {UINT64_C (0x924D692CA61BE758), UINT64_C (0x593C2626705F9C56)},
+  {UINT64_C (0xB6E0C377CFA2E12E), UINT64_C (0x6F8B2FB00C77836C)},
+  {UINT64_C (0xE498F455C38B997A), UINT64_C (0x0B6DFB9C0F956447)},
+  {UINT64_C (0x8EDF98B59A373FEC), UINT64_C (0x4724BD4189BD5EAC)},
+  {UINT64_C (0xB2977EE300C50FE7), UINT64_C (0x58EDEC91EC2CB657)},
+  {UINT64_C (0xDF3D5E9BC0F653E1), UINT64_C (0x2F2967B66737E3ED)},
+  {UINT64_C (0x8B865B215899F46C), UINT64_C (0xBD79E0D20082EE74)},
+  {UINT64_C (0xAE67F1E9AEC07187), UINT64_C (0xECD8590680A3AA11)},
+  {UINT64_C (0xDA01EE641A708DE9), UINT64_C (0xE80E6F4820CC9495)},
+  {UINT64_C (0x884134FE908658B2), UINT64_C (0x3109058D147FDCDD)},
+  {UINT64_C (0xAA51823E34A7EEDE), UINT64_C (0xBD4B46F0599FD415)},
+  {UINT64_C (0xD4E5E2CDC1D1EA96), UINT64_C (0x6C9E18AC7007C91A)},
+  {UINT64_C (0x850FADC09923329E), UINT64_C (0x03E2CF6BC604DDB0)},
+  {UINT64_C (0xA6539930BF6BFF45), UINT64_C (0x84DB8346B786151C)},
+  {UINT64_C (0xCFE87F7CEF46FF16), UINT64_C (0xE612641865679A63)},
+  {UINT64_C (0x81F14FAE158C5F6E), UINT64_C (0x4FCB7E8F3F60C07E)},
+  {UINT64_C (0xA26DA3999AEF7749), UINT64_C (0xE3BE5E330F38F09D)},
+  {UINT64_C (0xCB090C8001AB551C), UINT64_C (0x5CADF5BFD3072CC5)},
+  {UINT64_C (0xFDCB4FA002162A63), UINT64_C (0x73D9732FC7C8F7F6)},
+  {UINT64_C (0x9E9F11C4014DDA7E), UINT64_C (0x2867E7FDDCDD9AFA)},
+  {UINT64_C (0xC646D63501A1511D), UINT64_C (0xB281E1FD541501B8)},
+  {UINT64_C (0xF7D88BC24209A565), UINT64_C (0x1F225A7CA91A4226)},
+  {UINT64_C (0x9AE757596946075F), UINT64_C (0x3375788DE9B06958)},
+  {UINT64_C (0xC1A12D2FC3978937), UINT64_C (0x0052D6B1641C83AE)},
+  {UINT64_C (0xF209787BB47D6B84), UINT64_C (0xC0678C5DBD23A49A)},
+  {UINT64_C (0x9745EB4D50CE6332), UINT64_C (0xF840B7BA963646E0)},
+  {UINT64_C (0xBD176620A501FBFF), UINT64_C (0xB650E5A93BC3D898)},
+  {UINT64_C (0xEC5D3FA8CE427AFF), UINT64_C (0xA3E51F138AB4CEBE)},
+  {UINT64_C (0x93BA47C980E98CDF), UINT64_C (0xC66F336C36B10137)},
+  {UINT64_C (0xB8A8D9BBE123F017), UINT64_C (0xB80B0047445D4184)},
+  {UINT64_C (0xE6D3102AD96CEC1D), UINT64_C (0xA60DC059157491E5)},
+  {UINT64_C (0x9043EA1AC7E41392), UINT64_C (0x87C89837AD68DB2F)},
+  {UINT64_C (0xB454E4A179DD1877), UINT64_C (0x29BABE4598C311FB)},
+  {UINT64_C (0xE16A1DC9D8545E94), UINT64_C (0xF4296DD6FEF3D67A)},
+  {UINT64_C (0x8CE2529E2734BB1D), UINT64_C (0x1899E4A65F58660C)},
+  {UINT64_C (0xB01AE745B101E9E4), UINT64_C (0x5EC05DCFF72E7F8F)},
+  {UINT64_C (0xDC21A1171D42645D), UINT64_C (0x76707543F4FA1F73)},
+  {UINT64_C (0x899504AE72497EBA), UINT64_C (0x6A06494A791C53A8)},
+  {UINT64_C (0xABFA45DA0EDBDE69), UINT64_C (0x0487DB9D17636892)},
+  {UINT64_C (0xD6F8D7509292D603), UINT64_C (0x45A9D2845D3C42B6)},
+  {UINT64_C (0x865B86925B9BC5C2), UINT64_C (0x0B8A2392BA45A9B2)},
+  {UINT64_C (0xA7F26836F282B732), UINT64_C (0x8E6CAC7768D7141E)},
+  {UINT64_C (0xD1EF0244AF2364FF), UINT64_C (0x3207D795430CD926)},
+  {UINT64_C (0x8335616AED761F1F), UINT64_C (0x7F44E6BD49E807B8)},
+  {UINT64_C (0xA402B9C5A8D3A6E7), UINT64_C (0x5F16206C9C6209A6)},
+  {UINT64_C (0xCD036837130890A1), UINT64_C (0x36DBA887C37A8C0F)},
+  {UINT64_C (0x802221226BE55A64), UINT64_C (0xC2494954DA2C9789)},
+  {UINT64_C (0xA02AA96B06DEB0FD), UINT64_C (0xF2DB9BAA10B7BD6C)},
+  {UINT64_C (0xC83553C5C8965D3D), UINT64_C (0x6F92829494E5ACC7)},
+  {UINT64_C (0xFA42A8B73ABBF48C), UINT64_C (0xCB772339BA1F17F9)},
+  {UINT64_C (0x9C69A97284B578D7), UINT64_C (0xFF2A760414536EFB)},
+  {UINT64_C (0xC38413CF25E2D70D), UINT64_C (0xFEF5138519684ABA)},
+  {UINT64_C (0xF46518C2EF5B8CD1), UINT64_C (0x7EB258665FC25D69)},
+  {UINT64_C (0x98BF2F79D5993802), UINT64_C (0xEF2F773FFBD97A61)},
+  {UINT64_C (0xBEEEFB584AFF8603), UINT64_C (0xAAFB550FFACFD8FA)},
+  {UINT64_C (0xEEAABA2E5DBF6784), UINT64_C (0x95BA2A53F983CF38)},
+  {UINT64_C (0x952AB45CFA97A0B2), UINT64_C (0xDD945A747BF26183)},
+  {UINT64_C (0xBA756174393D88DF), UINT64_C (0x94F971119AEEF9E4)},
+  {UINT64_C (0xE912B9D1478CEB17), UINT64_C (0x7A37CD5601AAB85D)},
+  {UINT64_C (0x91ABB422CCB812EE), UINT64_C (0xAC62E055C10AB33A)},
+  {UINT64_C (0xB616A12B7FE617AA), UINT64_C (0x577B986B314D6009)},
+  {UINT64_C (0xE39C49765FDF9D94), UINT64_C (0xED5A7E85FDA0B80B)},
+  {UINT64_C (0x8E41ADE9FBEBC27D), UINT64_C (0x14588F13BE847307)},
+  {UINT64_C (0xB1D219647AE6B31C), UINT64_C (0x596EB2D8AE258FC8)},
+  {UINT64_C (0xDE469FBD99A05FE3), UINT64_C (0x6FCA5F8ED9AEF3BB)},
+  {UINT64_C (0x8AEC23D680043BEE), UINT64_C (0x25DE7BB9480D5854)},
+  {UINT64_C (0xADA72CCC20054AE9), UINT64_C (0xAF561AA79A10AE6A)},
+  {UINT64_C (0xD910F7FF28069DA4), UINT64_C (0x1B2BA1518094DA04)},
+  {UINT64_C (0x87AA9AFF79042286), UINT64_C (0x90FB44D2F05D0842)},
+  {UINT64_C (0xA99541BF57452B28), UINT64_C (0x353A1607AC744A53)},
+  {UINT64_C (0xD3FA922F2D1675F2), UINT64_C (0x42889B8997915CE8)},
+  {UINT64_C (0x847C9B5D7C2E09B7), UINT64_C (0x69956135FEBADA11)},
+  {UINT64_C (0xA59BC234DB398C25), UINT64_C (0x43FAB9837E699095)},
+  {UINT64_C (0xCF02B2C21207EF2E), UINT64_C (0x94F967E45E03F4BB)},
+  {UINT64_C (0x8161AFB94B44F57D), UINT64_C (0x1D1BE0EEBAC278F5)},
+  {UINT64_C (0xA1BA1BA79E1632DC), UINT64_C (0x6462D92A69731732)},
+  {UINT64_C (0xCA28A291859BBF93), UINT64_C (0x7D7B8F7503CFDCFE)},
+  {UINT64_C (0xFCB2CB35E702AF78), UINT64_C (0x5CDA735244C3D43E)},
+  {UINT64_C (0x9DEFBF01B061ADAB), UINT64_C (0x3A0888136AFA64A7)},
+  {UINT64_C (0xC56BAEC21C7A1916), UINT64_C (0x088AAA1845B8FDD0)},
+  {UINT64_C (0xF6C69A72A3989F5B), UINT64_C (0x8AAD549E57273D45)},
+  {UINT64_C (0x9A3C2087A63F6399), UINT64_C (0x36AC54E2F678864B)},
+  {UINT64_C (0xC0CB28A98FCF3C7F), UINT64_C (0x84576A1BB416A7DD)},
+  {UINT64_C (0xF0FDF2D3F3C30B9F), UINT64_C (0x656D44A2A11C51D5)},
+  {UINT64_C (0x969EB7C47859E743), UINT64_C (0x9F644AE5A4B1B325)},
+  {UINT64_C (0xBC4665B596706114), UINT64_C (0x873D5D9F0DDE1FEE)},
+  {UINT64_C (0xEB57FF22FC0C7959), UINT64_C (0xA90CB506D155A7EA)},
+  {UINT64_C (0x9316FF75DD87CBD8), UINT64_C (0x09A7F12442D588F2)},
+  {UINT64_C (0xB7DCBF5354E9BECE), UINT64_C (0x0C11ED6D538AEB2F)},
+  {UINT64_C (0xE5D3EF282A242E81), UINT64_C (0x8F1668C8A86DA5FA)},
+  {UINT64_C (0x8FA475791A569D10), UINT64_C (0xF96E017D694487BC)},
+  {UINT64_C (0xB38D92D760EC4455), UINT64_C (0x37C981DCC395A9AC)},
+  {UINT64_C (0xE070F78D3927556A), UINT64_C (0x85BBE253F47B1417)},
+  {UINT64_C (0x8C469AB843B89562), UINT64_C (0x93956D7478CCEC8E)},
+  {UINT64_C (0xAF58416654A6BABB), UINT64_C (0x387AC8D1970027B2)},
+  {UINT64_C (0xDB2E51BFE9D0696A), UINT64_C (0x06997B05FCC0319E)},
+  {UINT64_C (0x88FCF317F22241E2), UINT64_C (0x441FECE3BDF81F03)},
+  {UINT64_C (0xAB3C2FDDEEAAD25A), UINT64_C (0xD527E81CAD7626C3)},
+  {UINT64_C (0xD60B3BD56A5586F1), UINT64_C (0x8A71E223D8D3B074)},
+  {UINT64_C (0x85C7056562757456), UINT64_C (0xF6872D5667844E49)},
+  {UINT64_C (0xA738C6BEBB12D16C), UINT64_C (0xB428F8AC016561DB)},
+  {UINT64_C (0xD106F86E69D785C7), UINT64_C (0xE13336D701BEBA52)},
+  {UINT64_C (0x82A45B450226B39C), UINT64_C (0xECC0024661173473)},
+  {UINT64_C (0xA34D721642B06084), UINT64_C (0x27F002D7F95D0190)},
+  {UINT64_C (0xCC20CE9BD35C78A5), UINT64_C (0x31EC038DF7B441F4)},
+  {UINT64_C (0xFF290242C83396CE), UINT64_C (0x7E67047175A15271)},
+  {UINT64_C (0x9F79A169BD203E41), UINT64_C (0x0F0062C6E984D386)},
+  {UINT64_C (0xC75809C42C684DD1), UINT64_C (0x52C07B78A3E60868)},
+  {UINT64_C (0xF92E0C3537826145), UINT64_C (0xA7709A56CCDF8A82)},
+  {UINT64_C (0x9BBCC7A142B17CCB), UINT64_C (0x88A66076400BB691)},
+  {UINT64_C (0xC2ABF989935DDBFE), UINT64_C (0x6ACFF893D00EA435)},
+  {UINT64_C (0xF356F7EBF83552FE), UINT64_C (0x0583F6B8C4124D43)},
+  {UINT64_C (0x98165AF37B2153DE), UINT64_C (0xC3727A337A8B704A)},
+  {UINT64_C (0xBE1BF1B059E9A8D6), UINT64_C (0x744F18C0592E4C5C)},
+  {UINT64_C (0xEDA2EE1C7064130C), UINT64_C (0x1162DEF06F79DF73)},
+  {UINT64_C (0x9485D4D1C63E8BE7), UINT64_C (0x8ADDCB5645AC2BA8)},
+  {UINT64_C (0xB9A74A0637CE2EE1), UINT64_C (0x6D953E2BD7173692)},
+  {UINT64_C (0xE8111C87C5C1BA99), UINT64_C (0xC8FA8DB6CCDD0437)},
+  {UINT64_C (0x910AB1D4DB9914A0), UINT64_C (0x1D9C9892400A22A2)},
+  {UINT64_C (0xB54D5E4A127F59C8), UINT64_C (0x2503BEB6D00CAB4B)},
+  {UINT64_C (0xE2A0B5DC971F303A), UINT64_C (0x2E44AE64840FD61D)},
+  {UINT64_C (0x8DA471A9DE737E24), UINT64_C (0x5CEAECFED289E5D2)},
+  {UINT64_C (0xB10D8E1456105DAD), UINT64_C (0x7425A83E872C5F47)},
+  {UINT64_C (0xDD50F1996B947518), UINT64_C (0xD12F124E28F77719)},
+  {UINT64_C (0x8A5296FFE33CC92F), UINT64_C (0x82BD6B70D99AAA6F)},
+  {UINT64_C (0xACE73CBFDC0BFB7B), UINT64_C (0x636CC64D1001550B)},
+  {UINT64_C (0xD8210BEFD30EFA5A), UINT64_C (0x3C47F7E05401AA4E)},
+  {UINT64_C (0x8714A775E3E95C78), UINT64_C (0x65ACFAEC34810A71)},
+  {UINT64_C (0xA8D9D1535CE3B396), UINT64_C (0x7F1839A741A14D0D)},
+  {UINT64_C (0xD31045A8341CA07C), UINT64_C (0x1EDE48111209A050)},
+  {UINT64_C (0x83EA2B892091E44D), UINT64_C (0x934AED0AAB460432)},
+  {UINT64_C (0xA4E4B66B68B65D60), UINT64_C (0xF81DA84D5617853F)},
+  {UINT64_C (0xCE1DE40642E3F4B9), UINT64_C (0x36251260AB9D668E)},
+  {UINT64_C (0x80D2AE83E9CE78F3), UINT64_C (0xC1D72B7C6B426019)},
+  {UINT64_C (0xA1075A24E4421730), UINT64_C (0xB24CF65B8612F81F)},
+  {UINT64_C (0xC94930AE1D529CFC), UINT64_C (0xDEE033F26797B627)},
+  {UINT64_C (0xFB9B7CD9A4A7443C), UINT64_C (0x169840EF017DA3B1)},
+  {UINT64_C (0x9D412E0806E88AA5), UINT64_C (0x8E1F289560EE864E)},
+  {UINT64_C (0xC491798A08A2AD4E), UINT64_C (0xF1A6F2BAB92A27E2)},
+  {UINT64_C (0xF5B5D7EC8ACB58A2), UINT64_C (0xAE10AF696774B1DB)},
+  {UINT64_C (0x9991A6F3D6BF1765), UINT64_C (0xACCA6DA1E0A8EF29)},
+  {UINT64_C (0xBFF610B0CC6EDD3F), UINT64_C (0x17FD090A58D32AF3)},
+  {UINT64_C (0xEFF394DCFF8A948E), UINT64_C (0xDDFC4B4CEF07F5B0)},
+  {UINT64_C (0x95F83D0A1FB69CD9), UINT64_C (0x4ABDAF101564F98E)},
+  {UINT64_C (0xBB764C4CA7A4440F), UINT64_C (0x9D6D1AD41ABE37F1)},
+  {UINT64_C (0xEA53DF5FD18D5513), UINT64_C (0x84C86189216DC5ED)},
+  {UINT64_C (0x92746B9BE2F8552C), UINT64_C (0x32FD3CF5B4E49BB4)},
+  {UINT64_C (0xB7118682DBB66A77), UINT64_C (0x3FBC8C33221DC2A1)},
+  {UINT64_C (0xE4D5E82392A40515), UINT64_C (0x0FABAF3FEAA5334A)},
+  {UINT64_C (0x8F05B1163BA6832D), UINT64_C (0x29CB4D87F2A7400E)},
+  {UINT64_C (0xB2C71D5BCA9023F8), UINT64_C (0x743E20E9EF511012)},
+  {UINT64_C (0xDF78E4B2BD342CF6), UINT64_C (0x914DA9246B255416)},
+  {UINT64_C (0x8BAB8EEFB6409C1A), UINT64_C (0x1AD089B6C2F7548E)},
+  {UINT64_C (0xAE9672ABA3D0C320), UINT64_C (0xA184AC2473B529B1)},
+  {UINT64_C (0xDA3C0F568CC4F3E8), UINT64_C (0xC9E5D72D90A2741E)},
+  {UINT64_C (0x8865899617FB1871), UINT64_C (0x7E2FA67C7A658892)},
+  {UINT64_C (0xAA7EEBFB9DF9DE8D), UINT64_C (0xDDBB901B98FEEAB7)},
+  {UINT64_C (0xD51EA6FA85785631), UINT64_C (0x552A74227F3EA565)},
+  {UINT64_C (0x8533285C936B35DE), UINT64_C (0xD53A88958F87275F)},
+  {UINT64_C (0xA67FF273B8460356), UINT64_C (0x8A892ABAF368F137)},
+  {UINT64_C (0xD01FEF10A657842C), UINT64_C (0x2D2B7569B0432D85)},
+  {UINT64_C (0x8213F56A67F6B29B), UINT64_C (0x9C3B29620E29FC73)},
+  {UINT64_C (0xA298F2C501F45F42), UINT64_C (0x8349F3BA91B47B8F)},
+  {UINT64_C (0xCB3F2F7642717713), UINT64_C (0x241C70A936219A73)},
+  {UINT64_C (0xFE0EFB53D30DD4D7), UINT64_C (0xED238CD383AA0110)},
+  {UINT64_C (0x9EC95D1463E8A506), UINT64_C (0xF4363804324A40AA)},
+  {UINT64_C (0xC67BB4597CE2CE48), UINT64_C (0xB143C6053EDCD0D5)},
+  {UINT64_C (0xF81AA16FDC1B81DA), UINT64_C (0xDD94B7868E94050A)},
+  {UINT64_C (0x9B10A4E5E9913128), UINT64_C (0xCA7CF2B4191C8326)},
+  {UINT64_C (0xC1D4CE1F63F57D72), UINT64_C (0xFD1C2F611F63A3F0)},
+  {UINT64_C (0xF24A01A73CF2DCCF), UINT64_C (0xBC633B39673C8CEC)},
+  {UINT64_C (0x976E41088617CA01), UINT64_C (0xD5BE0503E085D813)},
+  {UINT64_C (0xBD49D14AA79DBC82), UINT64_C (0x4B2D8644D8A74E18)},
+  {UINT64_C (0xEC9C459D51852BA2), UINT64_C (0xDDF8E7D60ED1219E)},
+  {UINT64_C (0x93E1AB8252F33B45), UINT64_C (0xCABB90E5C942B503)},
+  {UINT64_C (0xB8DA1662E7B00A17), UINT64_C (0x3D6A751F3B936243)},
+  {UINT64_C (0xE7109BFBA19C0C9D), UINT64_C (0x0CC512670A783AD4)},
+  {UINT64_C (0x906A617D450187E2), UINT64_C (0x27FB2B80668B24C5)},
+  {UINT64_C (0xB484F9DC9641E9DA), UINT64_C (0xB1F9F660802DEDF6)},
+  {UINT64_C (0xE1A63853BBD26451), UINT64_C (0x5E7873F8A0396973)},
+  {UINT64_C (0x8D07E33455637EB2), UINT64_C (0xDB0B487B6423E1E8)},
+  {UINT64_C (0xB049DC016ABC5E5F), UINT64_C (0x91CE1A9A3D2CDA62)},
+  {UINT64_C (0xDC5C5301C56B75F7), UINT64_C (0x7641A140CC7810FB)},
+  {UINT64_C (0x89B9B3E11B6329BA), UINT64_C (0xA9E904C87FCB0A9D)},
+  {UINT64_C (0xAC2820D9623BF429), UINT64_C (0x546345FA9FBDCD44)},
+  {UINT64_C (0xD732290FBACAF133), UINT64_C (0xA97C177947AD4095)},
+  {UINT64_C (0x867F59A9D4BED6C0), UINT64_C (0x49ED8EABCCCC485D)},
+  {UINT64_C (0xA81F301449EE8C70), UINT64_C (0x5C68F256BFFF5A74)},
+  {UINT64_C (0xD226FC195C6A2F8C), UINT64_C (0x73832EEC6FFF3111)},
+  {UINT64_C (0x83585D8FD9C25DB7), UINT64_C (0xC831FD53C5FF7EAB)},
+  {UINT64_C (0xA42E74F3D032F525), UINT64_C (0xBA3E7CA8B77F5E55)},
+  {UINT64_C (0xCD3A1230C43FB26F), UINT64_C (0x28CE1BD2E55F35EB)},
+  {UINT64_C (0x80444B5E7AA7CF85), UINT64_C (0x7980D163CF5B81B3)},
+  {UINT64_C (0xA0555E361951C366), UINT64_C (0xD7E105BCC332621F)},
+  {UINT64_C (0xC86AB5C39FA63440), UINT64_C (0x8DD9472BF3FEFAA7)},
+  {UINT64_C (0xFA856334878FC150), UINT64_C (0xB14F98F6F0FEB951)},
+  {UINT64_C (0x9C935E00D4B9D8D2), UINT64_C (0x6ED1BF9A569F33D3)},
+  {UINT64_C (0xC3B8358109E84F07), UINT64_C (0x0A862F80EC4700C8)},
+  {UINT64_C (0xF4A642E14C6262C8), UINT64_C (0xCD27BB612758C0FA)},
+  {UINT64_C (0x98E7E9CCCFBD7DBD), UINT64_C (0x8038D51CB897789C)},
+  {UINT64_C (0xBF21E44003ACDD2C), UINT64_C (0xE0470A63E6BD56C3)},
+  {UINT64_C (0xEEEA5D5004981478), UINT64_C (0x1858CCFCE06CAC74)},
+  {UINT64_C (0x95527A5202DF0CCB), UINT64_C (0x0F37801E0C43EBC8)},
+  {UINT64_C (0xBAA718E68396CFFD), UINT64_C (0xD30560258F54E6BA)},
+  {UINT64_C (0xE950DF20247C83FD), UINT64_C (0x47C6B82EF32A2069)},
+  {UINT64_C (0x91D28B7416CDD27E), UINT64_C (0x4CDC331D57FA5441)},
+  {UINT64_C (0xB6472E511C81471D), UINT64_C (0xE0133FE4ADF8E952)},
+  {UINT64_C (0xE3D8F9E563A198E5), UINT64_C (0x58180FDDD97723A6)},
+  {UINT64_C (0x8E679C2F5E44FF8F), UINT64_C (0x570F09EAA7EA7648)},
+};
+
+/* Powers of 10 that are exact doubles */
+static const double fast_json_exact_pow10[23] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Binary shifts used to scale a decimal with dp digits to [0.5, 1) */
+static const int fast_json_decimal_powtab[9] = {
+  1, 3, 6, 9, 13, 16, 19, 23, 26
+};
+
+static ALWAYS_INLINE unsigned int
+fast_json_clz64 (uint64_t v)
+{
+#if defined(__GNUC__) && !defined(__TINYC__)
+  return __builtin_clzll (v);
+#else
+  unsigned int n = 0;
+
+  while ((v & UINT64_C (0x8000000000000000)) == 0) {
+    v <<= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+/* Return the high 64 bits of a * b and store the low 64 bits in lo */
+static ALWAYS_INLINE uint64_t
+fast_json_mul128 (uint64_t a, uint64_t b, uint64_t * lo)
+{
+#if defined(__SIZEOF_INT128__)
+  __extension__ unsigned __int128 r = (unsigned __int128) a * b;
+
+  *lo = (uint64_t) r;
+  return (uint64_t) (r >> 64);
+#else
+  uint64_t a_lo = a & 0xFFFFFFFFu;
+  uint64_t a_hi = a >> 32;
+  uint64_t b_lo = b & 0xFFFFFFFFu;
+  uint64_t b_hi = b >> 32;
+  uint64_t p0 = a_lo * b_lo;
+  uint64_t p1 = a_lo * b_hi;
+  uint64_t p2 = a_hi * b_lo;
+  uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+
+  *lo = (mid << 32) | (p0 & 0xFFFFFFFFu);
+  return a_hi * b_hi + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+}
+
+static double
+fast_json_make_double (uint64_t bits, unsigned int sign)
+{
+  union
+  {
+    uint64_t u;
+    double d;
+  } td;
+
+  td.u = bits | (sign ? UINT64_C (0x8000000000000000) : 0);
+  return td.d;
+}
+
+/* Eisel-Lemire: convert mantissa * 10^exp10 to the bits of a double.
+ * Returns 0 if the result can not be decided with 128 bits or when it is
+ * not a normal number.
+ */
+static int
+fast_json_eisel_lemire (uint64_t mantissa, int exp10, uint64_t * bits)
+{
+  const uint64_t *pow10 = fast_json_pow10[exp10 - FAST_JSON_POW10_MIN];
+  unsigned int clz = fast_json_clz64 (mantissa);
+  uint64_t exp2 = (uint64_t) (((217706 * exp10) >> 16) + 64 + 1023) - clz;
+  uint64_t x_hi;
+  uint64_t x_lo;
+  uint64_t msb;
+  uint64_t m;
+
+  mantissa <<= clz;
+  x_hi = fast_json_mul128 (mantissa, pow10[0], &x_lo);
+  if ((x_hi & 0x1FF) == 0x1FF && x_lo + mantissa < mantissa) {
+    uint64_t y_lo;
+    uint64_t y_hi = fast_json_mul128 (mantissa, pow10[1], &y_lo);
+    uint64_t merged_hi = x_hi;
+    uint64_t merged_lo = x_lo + y_hi;
+
+    if (merged_lo < x_lo) {
+      merged_hi++;
+    }
+    if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 &&
+	y_lo + mantissa < mantissa) {
+      return 0;
+    }
+    x_hi = merged_hi;
+    x_lo = merged_lo;
+  }
+  msb = x_hi >> 63;
+  m = x_hi >> (msb + 9);
+  exp2 -= 1 ^ msb;
+  /* Possible halfway case */
+  if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (m & 3) == 1) {
+    return 0;
+  }
+  m += m & 1;
+  m >>= 1;
+  if (m >> 53) {
+    m >>= 1;
+    exp2++;
+  }
+  if (exp2 - 1 >= 0x7FF - 1) {
+    return 0;
+  }
+  *bits = (exp2 << 52) | (m & UINT64_C (0x000FFFFFFFFFFFFF));
+  return 1;
+}
+
+/* The exact conversion below works on a decimal digit string. The value
+ * is 0.d[0]d[1]...d[nd-1] * 10^dp. Digits are stored as 0..9.
+ */
+static void
+fast_json_decimal_trim (FAST_JSON_DECIMAL_TYPE * dec)
+{
+  while (dec->nd > 0 && dec->d[dec->nd - 1] == 0) {
+    dec->nd--;
+  }
+  if (dec->nd == 0) {
+    dec->dp = 0;
+  }
+}
+
+static void
+fast_json_decimal_left_shift (FAST_JSON_DECIMAL_TYPE * dec, unsigned int k)
+{
+  int delta = ((k * 1233) >> 12) + 2;	/* more than the digits of 2^k */
+  int r = dec->nd;
+  int w = dec->nd + delta;
+  uint64_t n = 0;
+
+  while (r > 0) {
+    n += (uint64_t) dec->d[--r] << k;
+    dec->d[--w] = (char) (n % 10);
+    n /= 10;
+  }
+  while (n > 0) {
+    dec->d[--w] = (char) (n % 10);
+    n /= 10;
+  }
+  delta -= w;
+  if (w) {
+    memmove (dec->d, &dec->d[w], dec->nd + delta);
+  }
+  dec->nd += delta;
+  dec->dp += delta;
+  while (dec->nd > FAST_JSON_DECIMAL_DIGITS) {
+    if (dec->d[--dec->nd]) {
+      dec->trunc = 1;
+    }
+  }
+  fast_json_decimal_trim (dec);
+}
+
+static void
+fast_json_decimal_right_shift (FAST_JSON_DECIMAL_TYPE * dec, unsigned int k)
+{
+  uint64_t mask = (UINT64_C (1) << k) - 1;
+  uint64_t n = 0;
+  int r = 0;
+  int w = 0;
+
+  for (; (n >> k) == 0; r++) {
+    if (r >= dec->nd) {
+      if (n == 0) {
+	dec->nd = 0;
+	return;
+      }
+      while ((n >> k) == 0) {
+	n *= 10;
+	r++;
+      }
+      break;
+    }
+    n = n * 10 + dec->d[r];
+  }
+  dec->dp -= r - 1;
+  for (; r < dec->nd; r++) {
+    unsigned int c = dec->d[r];
+
+    dec->d[w++] = (char) (n >> k);
+    n = (n & mask) * 10 + c;
+  }
+  while (n > 0) {
+    unsigned int c = (unsigned int) (n >> k);
+
+    if (w < FAST_JSON_DECIMAL_DIGITS) {
+      dec->d[w++] = (char) c;
+    }
+    else if (c > 0) {
+      dec->trunc = 1;
+    }
+    n = (n & mask) * 10;
+  }
+  dec->nd = w;
+  fast_json_decimal_trim (dec);
+}
+
+static void
+fast_json_decimal_shift (FAST_JSON_DECIMAL_TYPE * dec, int k)
+{
+  if (dec->nd == 0) {
+    return;
+  }
+  while (k > 60) {
+    fast_json_decimal_left_shift (dec, 60);
+    k -= 60;
+  }
+  while (k < -60) {
+    fast_json_decimal_right_shift (dec, 60);
+    k += 60;
+  }
+  if (k > 0) {
+    fast_json_decimal_left_shift (dec, k);
+  }
+  else if (k < 0) {
+    fast_json_decimal_right_shift (dec, -k);
+  }
+}
+
+/* Return the integer part of the decimal rounded to nearest even */
+static uint64_t
+fast_json_decimal_round (FAST_JSON_DECIMAL_TYPE * dec)
+{
+  uint64_t n = 0;
+  int i;
+
+  for (i = 0; i < dec->dp; i++) {
+    n = n * 10 + (i < dec->nd ? dec->d[i] : 0);
+  }
+  if (dec->dp >= 0 && dec->dp < dec->nd) {
+    if (dec->d[dec->dp] == 5 && dec->dp + 1 == dec->nd) {
+      if (dec->trunc || (dec->dp > 0 && (dec->d[dec->dp - 1] & 1))) {
+	n++;
+      }
+    }
+    else if (dec->d[dec->dp] >= 5) {
+      n++;
+    }
+  }
+  return n;
+}
+
+/* Exact conversion of the decimal number in str. Slow but only used when
+ * the Eisel-Lemire algorithm can not decide.
+ */
+static double
+fast_json_decimal_strtod (const char *str, unsigned int *erange)
+{
+  FAST_JSON_DECIMAL_TYPE dec;
+  const char *cp = str;
+  unsigned int sign = 0;
+  unsigned int dot = 0;
+  int ndigit = 0;
+  int exp2 = 0;
+  uint64_t m;
+
+  if (*cp == '-' || *cp == '+') {
+    sign = *cp++ == '-';
+  }
+  dec.nd = 0;
+  dec.dp = 0;
+  dec.trunc = 0;
+  for (;; cp++) {
+    if (*cp == '.' && !dot) {
+      dot = 1;
+      dec.dp = ndigit;
+    }
+    else if (fast_json_isdigit (*cp)) {
+      if (*cp == '0' && ndigit == 0) {
+	dec.dp -= dot;
+      }
+      else {
+	if (dec.nd < FAST_JSON_DECIMAL_DIGITS) {
+	  dec.d[dec.nd++] = *cp - '0';
+	}
+	else if (*cp != '0') {
+	  dec.trunc = 1;
+	}
+	ndigit++;
+      }
+    }
+    else {
+      break;
+    }
+  }
+  if (!dot) {
+    dec.dp = ndigit;
+  }
+  if (*cp == 'e' || *cp == 'E') {
+    unsigned int esign = 0;
+    int e = 0;
+
+    cp++;
+    if (*cp == '-' || *cp == '+') {
+      esign = *cp++ == '-';
+    }
+    while (fast_json_isdigit (*cp)) {
+      if (e < 100000) {
+	e = e * 10 + *cp - '0';
+      }
+      cp++;
+    }
+    dec.dp += esign ? -e : e;
+  }
+  fast_json_decimal_trim (&dec);
+  if (dec.nd == 0) {
+    return fast_json_make_double (0, sign);
+  }
+  if (dec.dp > 310) {
+    *erange = 1;
+    return fast_json_inf (sign);
+  }
+  if (dec.dp < -330) {
+    *erange = 1;
+    return fast_json_make_double (0, sign);
+  }
+  /* Scale to [0.5, 1) */
+  while (dec.dp > 0) {
+    int n = dec.dp >= 9 ? 27 : fast_json_decimal_powtab[dec.dp];
+
+    fast_json_decimal_shift (&dec, -n);
+    exp2 += n;
+  }
+  while (dec.dp < 0 || (dec.dp == 0 && dec.d[0] < 5)) {
+    int n = -dec.dp >= 9 ? 27 : fast_json_decimal_powtab[-dec.dp];
+
+    fast_json_decimal_shift (&dec, n);
+    exp2 -= n;
+  }
+  exp2--;
+  /* Like strtod report values below the smallest normal number */
+  if (exp2 < -1022) {
+    *erange = 1;
+    return fast_json_make_double (0, sign);
+  }
+  if (exp2 > 1023) {
+    *erange = 1;
+    return fast_json_inf (sign);
+  }
+  fast_json_decimal_shift (&dec, 53);
+  m = fast_json_decimal_round (&dec);
+  if (m == UINT64_C (1) << 53) {
+    m >>= 1;
+    exp2++;
+    if (exp2 > 1023) {
+      *erange = 1;
+      return fast_json_inf (sign);
+    }
+  }
+  return fast_json_make_double (((uint64_t) (exp2 + 1023) << 52) |
+				(m & UINT64_C (0x000FFFFFFFFFFFFF)), sign);
+}
+
+/* Hex floating point number. cp points to the "0x" */
+static double
+fast_json_hex_strtod (const char *cp, unsigned int sign, const char **endp,
+		      unsigned int *erange)
+{
+  const char *start = cp + 1;
+  unsigned int dot = 0;
+  unsigned int ndigit = 0;
+  unsigned int sticky = 0;
+  unsigned int n = 0;
+  uint64_t m = 0;
+  uint64_t rest;
+  int exp2 = 0;
+
+  for (cp += 2;; cp++) {
+    if (*cp == '.' && !dot) {
+      dot = 1;
+    }
+    else if (fast_json_isxdigit (*cp)) {
+      ndigit++;
+      if (n < 16) {
+	m = (m << 4) + fast_json_xdigit_value (*cp);
+	n += m != 0;
+	exp2 -= dot ? 4 : 0;
+      }
+      else {
+	sticky |= *cp != '0';
+	exp2 += dot ? 0 : 4;
+      }
+    }
+    else {
+      break;
+    }
+  }
+  if (ndigit == 0) {
+    /* Only the "0" is a number */
+    *endp = start;
+    return fast_json_make_double (0, sign);
+  }
+  if (*cp == 'p' || *cp == 'P') {
+    const char *ep = cp + 1;
+    unsigned int esign = 0;
+    int e = 0;
+
+    if (*ep == '-' || *ep == '+') {
+      esign = *ep++ == '-';
+    }
+    if (fast_json_isdigit (*ep)) {
+      do {
+	if (e < 100000) {
+	  e = e * 10 + *ep - '0';
+	}
+	ep++;
+      } while (fast_json_isdigit (*ep));
+      exp2 += esign ? -e : e;
+      cp = ep;
+    }
+  }
+  *endp = cp;
+  if (m == 0) {
+    return fast_json_make_double (0, sign);
+  }
+  n = fast_json_clz64 (m);
+  m <<= n;
+  m |= sticky;
+  exp2 += 63 - (int) n;
+  if (exp2 < -1022) {
+    /* Like strtod only report inexact subnormal numbers */
+    n = 11 + (-1022 - exp2);
+    if (n >= 64) {
+      *erange = 1;
+      return fast_json_make_double (0, sign);
+    }
+    rest = m & ((UINT64_C (1) << n) - 1);
+    m >>= n;
+    if (rest > (UINT64_C (1) << (n - 1)) ||
+	(rest == (UINT64_C (1) << (n - 1)) && (m & 1))) {
+      m++;
+    }
+    *erange = rest != 0;
+    return fast_json_make_double (m, sign);
+  }
+  rest = m & 0x7FF;
+  m >>= 11;
+  if (rest > 0x400 || (rest == 0x400 && (m & 1))) {
+    m++;
+    if (m == UINT64_C (1) << 53) {
+      m >>= 1;
+      exp2++;
+    }
+  }
+  if (exp2 > 1023) {
+    *erange = 1;
+    return fast_json_inf (sign);
+  }
+  return fast_json_make_double (((uint64_t) (exp2 + 1023) << 52) |
+				(m & UINT64_C (0x000FFFFFFFFFFFFF)), sign);
+}
+
+/* Locale independent strtod. The number is correctly rounded. erange is
+ * set like errno is set to ERANGE by strtod for numbers that are too large
+ * or smaller than the smallest normal number.
+ */
+static double
+fast_json_strtod (const char *str, const char **endp, unsigned int *erange)
+{
+  const char *cp = str;
+  const char *digits;
+  unsigned int sign = 0;
+  unsigned int trunc = 0;
+  unsigned int ndigit = 0;
+  uint64_t mantissa = 0;
+  uint64_t bits;
+  uint64_t bits1;
+  int exp10 = 0;
+
+  *erange = 0;
+  if (*cp == '-' || *cp == '+') {
+    sign = *cp++ == '-';
+  }
+  if (cp[0] == '0' && (cp[1] == 'x' || cp[1] == 'X')) {
+    return fast_json_hex_strtod (cp, sign, endp, erange);
+  }
+  digits = cp;
+  while (*cp == '0') {
+    cp++;
+  }
+  for (; fast_json_isdigit (*cp); cp++) {
+    if (ndigit < 19) {
+      mantissa = mantissa * 10 + (*cp - '0');
+      ndigit++;
+    }
+    else {
+      trunc |= *cp != '0';
+      exp10++;
+    }
+  }
+  if (*cp == '.') {
+    cp++;
+    if (ndigit == 0) {
+      while (*cp == '0') {
+	cp++;
+	exp10--;
+      }
+    }
+    for (; fast_json_isdigit (*cp); cp++) {
+      if (ndigit < 19) {
+	mantissa = mantissa * 10 + (*cp - '0');
+	ndigit++;
+	exp10--;
+      }
+      else {
+	trunc |= *cp != '0';
+      }
+    }
+  }
+  if (cp == digits || (cp == digits + 1 && *digits == '.')) {
+    *endp = str;
+    return 0.0;
+  }
+  if (*cp == 'e' || *cp == 'E') {
+    const char *ep = cp + 1;
+    unsigned int esign = 0;
+    int e = 0;
+
+    if (*ep == '-' || *ep == '+') {
+      esign = *ep++ == '-';
+    }
+    if (fast_json_isdigit (*ep)) {
+      do {
+	if (e < 100000) {
+	  e = e * 10 + *ep - '0';
+	}
+	ep++;
+      } while (fast_json_isdigit (*ep));
+      exp10 += esign ? -e : e;
+      cp = ep;
+    }
+  }
+  *endp = cp;
+  if (mantissa == 0) {
+    return fast_json_make_double (0, sign);
+  }
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  if (!trunc && mantissa <= (UINT64_C (1) << 53) &&
+      exp10 >= -22 && exp10 <= 22) {
+    double d = (double) mantissa;
+
+    d = exp10 < 0 ? d / fast_json_exact_pow10[-exp10] :
+      d * fast_json_exact_pow10[exp10];
+    return sign ? -d : d;
+  }
+#endif
+  if (exp10 < FAST_JSON_POW10_MIN) {
+    *erange = 1;
+    return fast_json_make_double (0, sign);
+  }
+  if (exp10 > FAST_JSON_POW10_MAX) {
+    *erange = 1;
+    return fast_json_inf (sign);
+  }
+  /* With truncated digits the result must be the same for the next
+   * mantissa. The smallest normal number may have been rounded up from a
+   * smaller value.
+   */
+  if (fast_json_eisel_lemire (mantissa, exp10, &bits) &&
+      (!trunc || (fast_json_eisel_lemire (mantissa + 1, exp10, &bits1) &&
+		  bits == bits1)) &&
+      bits != UINT64_C (0x0010000000000000)) {
+    return fast_json_make_double (bits, sign);
+  }
+  return fast_json_decimal_strtod (str, erange);
+}
+
+#if 0
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define	N	(64)
+#define	M	(1200)
+
+static int
+nbits (const uint32_t * x)
+{
+  int i = N - 1;
+
+  while (i >= 0 && x[i] == 0) {
+    i--;
+  }
+  return i < 0 ? 0 : i * 32 + 32 - __builtin_clz (x[i]);
+}
+
+static uint64_t
+get64 (const uint32_t * x, int shift)
+{
+  uint64_t r = 0;
+  int i;
+
+  for (i = 63; i >= 0; i--) {
+    int b = shift + i;
+
+    r <<= 1;
+    if (b >= 0 && b < N * 32) {
+      r |= (x[b / 32] >> (b % 32)) & 1;
+    }
+  }
+  return r;
+}
+
+int
+main (void)
+{
+  uint32_t x[N];
+  uint32_t y[N];
+  uint64_t r;
+  int q;
+  int i;
+
+  /* floor (2^(bits (5^q) - 1 + 125) / 5^q) + 1 */
+  memset (x, 0, sizeof (x));
+  memset (y, 0, sizeof (y));
+  x[M / 32] = 1u << (M % 32);
+  y[0] = 1;
+  for (q = 0; q < 342; q++) {
+    int s = M - (nbits (y) - 1 + 125);
+    uint64_t lo = get64 (x, s);
+    uint64_t hi = get64 (x, s + 64);
+
+    if (++lo == 0) {
+      hi++;
+    }
+    printf ("  {UINT64_C (0x%016llX), UINT64_C (0x%016llX)},\n",
+	    (unsigned long long) lo, (unsigned long long) hi);
+    for (r = 0, i = N - 1; i >= 0; i--) {
+      r = (r << 32) | x[i];
+      x[i] = (uint32_t) (r / 5);
+      r %= 5;
+    }
+    for (r = 0, i = 0; i < N; i++) {
+      r += (uint64_t) y[i] * 5;
+      y[i] = (uint32_t) r;
+      r >>= 32;
+    }
+  }
+  printf ("\n");
+  /* 5^q with 125 bits */
+  memset (y, 0, sizeof (y));
+  y[0] = 1;
+  for (q = 0; q < 326; q++) {
+    int s = nbits (y) - 125;
+
+    printf ("  {UINT64_C (0x%016llX), UINT64_C (0x%016llX)},\n",
+	    (unsigned long long) get64 (y, s),
+	    (unsigned long long) get64 (y, s + 64));
+    for (r = 0, i = 0; i < N; i++) {
+      r += (uint64_t) y[i] * 5;
+      y[i] = (uint32_t) r;
+      r >>= 32;
+    }
+  }
+  return 0;
+}
+#endif
+/* Tables for the Ryu shortest double printer. Generated with the program
+ * above. The values are (low, high) pairs.
+ */
+static const uint64_t fast_json_pow5_inv_split[342][2] = {
+  {UINT64_C (0x0000000000000001), UINT64_C (0x2000000000000000)},
+  {UINT64_C (0x999999999999999A), UINT64_C (0x1999999999999999)},
+  {UINT64_C (0x47AE147AE147AE15), UINT64_C (0x147AE147AE147AE1)},
+  {UINT64_C (0x6C8B4395810624DE), UINT64_C (0x10624DD2F1A9FBE7)},
+  {UINT64_C (0x7A786C226809D496), UINT64_C (0x1A36E2EB1C432CA5)},
+  {UINT64_C (0x61F9F01B866E43AB), UINT64_C (0x14F8B588E368F084)},
+  {UINT64_C (0xB4C7F34938583622), UINT64_C (0x10C6F7A0B5ED8D36)},
+  {UINT64_C (0x87A6520EC08D236A), UINT64_C (0x1AD7F29ABCAF4857)},
+  {UINT64_C (0x9FB841A566D74F88), UINT64_C (0x15798EE2308C39DF)},
+  {UINT64_C (0xE62D01511F12A607), UINT64_C (0x112E0BE826D694B2)},
+  {UINT64_C (0xD6AE6881CB5109A4), UINT64_C (0x1B7CDFD9D7BDBAB7)},
+  {UINT64_C (0xDEF1ED34A2A73AEA), UINT64_C (0x15FD7FE17964955F)},
+  {UINT64_C (0x7F27F0F6E885C8BB), UINT64_C (0x119799812DEA1119)},
+  {UINT64_C (0x650CB4BE40D60DF8), UINT64_C (0x1C25C268497681C2)},
+  {UINT64_C (0xEA70909833DE7193), UINT64_C (0x16849B86A12B9B01)},
+  {UINT64_C (0x21F3A6E0297EC143), UINT64_C (0x1203AF9EE756159B)},
+  {UINT64_C (0x6985D7CD0F313537), UINT64_C (0x1CD2B297D889BC2B)},
+  {UINT64_C (0x2137DFD73F5A90F9), UINT64_C (0x170EF54646D49689)},
+  {UINT64_C (0xE75FE645CC4873FA), UINT64_C (0x12725DD1D243ABA0)},
+  {UINT64_C (0xA5663D3C7A0D865D), UINT64_C (0x1D83C94FB6D2AC34)},
+  {UINT64_C (0x511E976394D79EB1), UINT64_C (0x179CA10C9242235D)},
+  {UINT64_C (0xDA7EDF82DD794BC1), UINT64_C (0x12E3B40A0E9B4F7D)},
+  {UINT64_C (0x2A6498D1625BAC68), UINT64_C (0x1E392010175EE596)},
+  {UINT64_C (0xEEB6E0A781E2F053), UINT64_C (0x182DB34012B25144)},
+  {UINT64_C (0x58924D52CE4F26A9), UINT64_C (0x1357C299A88EA76A)},
+  {UINT64_C (0x27507BB7B07EA441), UINT64_C (0x1EF2D0F5DA7DD8AA)},
+  {UINT64_C (0x52A6C95FC0655034), UINT64_C (0x18C240C4AECB13BB)},
+  {UINT64_C (0x0EEBD44C99EAA690), UINT64_C (0x13CE9A36F23C0FC9)},
+  {UINT64_C (0xB17953ADC3110A80), UINT64_C (0x1FB0F6BE50601941)},
+  {UINT64_C (0xC12DDC8B02740867), UINT64_C (0x195A5EFEA6B34767)},
+  {UINT64_C (0x3424B06F3529A052), UINT64_C (0x14484BFEEBC29F86)},
+  {UINT64_C (0x901D59F290EE19DB), UINT64_C (0x1039D66589687F9E)},
+  {UINT64_C (0x4CFBC31DB4B0295F), UINT64_C (0x19F623D5A8A73297)},
+  {UINT64_C (0x3D9635B15D59BAB2), UINT64_C (0x14C4E977BA1F5BAC)},
+  {UINT64_C (0x97AB5E277DE16228), UINT64_C (0x109D8792FB4C4956)},
+  {UINT64_C (0xF2ABC9D8C9689D0D), UINT64_C (0x1A95A5B7F87A0EF0)},
+  {UINT64_C (0x5BBCA17A3ABA173E), UINT64_C (0x154484932D2E725A)},
+  {UINT64_C (0xAFCA1AC82EFB45CB), UINT64_C (0x11039D428A8B8EAE)},
+  {UINT64_C (0xB2DCF7A6B1920945), UINT64_C (0x1B38FB9DAA78E44A)},
+  {UINT64_C (0xF57D92EBC141A104), UINT64_C (0x15C72FB1552D836E)},
+  {UINT64_C (0xC46475896767B403), UINT64_C (0x116C262777579C58)},
+  {UINT64_C (0x6D6D88DBD8A5ECD2), UINT64_C (0x1BE03D0BF225C6F4)},
+  {UINT64_C (0x8ABE071646EB23DB), UINT64_C (0x164CFDA3281E38C3)},
+  {UINT64_C (0x6EFE6C11D255B649), UINT64_C (0x11D7314F534B609C)},
+  {UINT64_C (0xB197134FB6EF8A0E), UINT64_C (0x1C8B821885456760)},
+  {UINT64_C (0x27AC0F72F8BFA1A5), UINT64_C (0x16D601AD376AB91A)},
+  {UINT64_C (0xB95672C260994E1E), UINT64_C (0x1244CE242C5560E1)},
+  {UINT64_C (0xF5571E03CDC21695), UINT64_C (0x1D3AE36D13BBCE35)},
+  {UINT64_C (0x2AAC18030B01ABAB), UINT64_C (0x17624F8A762FD82B)},
+  {UINT64_C (0xBBBCE0026F348956), UINT64_C (0x12B50C6EC4F31355)},
+  {UINT64_C (0x92C7CCD0B1EDA889), UINT64_C (0x1DEE7A4AD4B81EEF)},
+  {UINT64_C (0xDBD30A408E57BA07), UINT64_C (0x17F1FB6F10934BF2)},
+  {UINT64_C (0x7CA8D50071DFC806), UINT64_C (0x1327FC58DA0F6FF5)},
+  {UINT64_C (0xFAA7BB33E9660CD6), UINT64_C (0x1EA6608E29B24CBB)},
+  {UINT64_C (0x9552FC298784D711), UINT64_C (0x18851A0B548EA3C9)},
+  {UINT64_C (0xAAA8C9BAD2D0AC0E), UINT64_C (0x139DAE6F76D88307)},
+  {UINT64_C (0xDDDADC5E1E1AACE3), UINT64_C (0x1F62B0B257C0D1A5)},
+  {UINT64_C (0x7E48B04B4B488A4F), UINT64_C (0x191BC08EAC9A4151)},
+  {UINT64_C (0xCB6D59D5D5D3A1D9), UINT64_C (0x141633A556E1CDDA)},
+  {UINT64_C (0x3C577B1177DC817B), UINT64_C (0x1011C2EAABE7D7E2)},
+  {UINT64_C (0xC6F25E825960CF2A), UINT64_C (0x19B604AAACA62636)},
+  {UINT64_C (0x6BF518684780A5BB), UINT64_C (0x14919D5556EB51C5)},
+  {UINT64_C (0x232A79ED06008496), UINT64_C (0x10747DDDDF22A7D1)},
+  {UINT64_C (0xD1DD8FE1A3340756), UINT64_C (0x1A53FC9631D10C81)},
+  {UINT64_C (0xA7E4731AE8F66C45), UINT64_C (0x150FFD44F4A73D34)},
+  {UINT64_C (0x531D28E253F8569E), UINT64_C (0x10D9976A5D52975D)},
+  {UINT64_C (0xEB61DB03B98D5762), UINT64_C (0x1AF5BF109550F22E)},
+  {UINT64_C (0xBC4E48CFC7A445E8), UINT64_C (0x159165A6DDDA5B58)},
+  {UINT64_C (0x6371D3D96C836B20), UINT64_C (0x11411E1F17E1E2AD)},
+  {UINT64_C (0x9F1C8628AD9F11CD), UINT64_C (0x1B9B6364F3030448)},
+  {UINT64_C (0xE5B06B53BE18DB0B), UINT64_C (0x1615E91D8F359D06)},
+  {UINT64_C (0xEAF3890FCB4715A2), UINT64_C (0x11AB20E472914A6B)},
+  {UINT64_C (0x44B8DB4C7871BC37), UINT64_C (0x1C45016D841BAA46)},
+  {UINT64_C (0x03C715D6C6C1635F), UINT64_C (0x169D9ABE03495505)},
+  {UINT64_C (0x3638DE456BCDE919), UINT64_C (0x1217AEFE69077737)},
+  {UINT64_C (0x56C163A2461641C1), UINT64_C (0x1CF2B1970E725858)},
+  {UINT64_C (0xDF011C81D1AB67CE), UINT64_C (0x17288E1271F51379)},
+  {UINT64_C (0x7F3416CE4155ECA5), UINT64_C (0x1286D80EC190DC61)},
+  {UINT64_C (0x6520247D3556476E), UINT64_C (0x1DA48CE468E7C702)},
+  {UINT64_C (0xEA801D30F7783925), UINT64_C (0x17B6D71D20B96C01)},
+  {UINT64_C (0xBB99B0F3F92CFA84), UINT64_C (0x12F8AC174D612334)},
+  {UINT64_C (0x5F5C4E532847F739), UINT64_C (0x1E5AACF215683854)},
+  {UINT64_C (0x7F7D0B75B9D32C2E), UINT64_C (0x18488A5B44536043)},
+  {UINT64_C (0x9930D5F7C7DC2358), UINT64_C (0x136D3B7C36A919CF)},
+  {UINT64_C (0x8EB4898C72F9D226), UINT64_C (0x1F152BF9F10E8FB2)},
+  {UINT64_C (0x722A07A38F2E41B8), UINT64_C (0x18DDBCC7F40BA628)},
+  {UINT64_C (0xC1BB394FA5BE9AFA), UINT64_C (0x13E497065CD61E86)},
+  {UINT64_C (0x9C5EC2190930F7F6), UINT64_C (0x1FD424D6FAF030D7)},
+  {UINT64_C (0x49E56814075A5FF8), UINT64_C (0x197683DF2F268D79)},
+  {UINT64_C (0x6E51201005E1E660), UINT64_C (0x145ECFE5BF520AC7)},
+  {UINT64_C (0xF1DA800CD181851A), UINT64_C (0x104BD984990E6F05)},
+  {UINT64_C (0x4FC400148268D4F5), UINT64_C (0x1A12F5A0F4E3E4D6)},
+  {UINT64_C (0xD96999AA01ED772B), UINT64_C (0x14DBF7B3F71CB711)},
+  {UINT64_C (0xADEE1488018AC5BC), UINT64_C (0x10AFF95CC5B09274)},
+  {UINT64_C (0x497CEDA668DE092C), UINT64_C (0x1AB328946F80EA54)},
+  {UINT64_C (0x3ACA57B853E4D424), UINT64_C (0x155C2076BF9A5510)},
+  {UINT64_C (0x623B7960431D7683), UINT64_C (0x1116805EFFAEAA73)},
+  {UINT64_C (0x9D2BF566D1C8BD9E), UINT64_C (0x1B5733CB32B110B8)},
+  {UINT64_C (0x7DBCC452416D647F), UINT64_C (0x15DF5CA28EF40D60)},
+  {UINT64_C (0xCAFD69DB678AB6CC), UINT64_C (0x117F7D4ED8C33DE6)},
+  {UINT64_C (0xAB2F0FC572778ADF), UINT64_C (0x1BFF2EE48E052FD7)},
+  {UINT64_C (0x88F273045B92D580), UINT64_C (0x1665BF1D3E6A8CAC)},
+  {UINT64_C (0xD3F528D049424466), UINT64_C (0x11EAFF4A98553D56)},
+  {UINT64_C (0xB988414D4203A0A3), UINT64_C (0x1CAB3210F3BB9557)},
+  {UINT64_C (0x6139CDD76802E6E9), UINT64_C (0x16EF5B40C2FC7779)},
+  {UINT64_C (0xE761717920025254), UINT64_C (0x125915CD68C9F92D)},
+  {UINT64_C (0xA568B58E999D5086), UINT64_C (0x1D5B561574765B7C)},
+  {UINT64_C (0x5120913EE14AA6D2), UINT64_C (0x177C44DDF6C515FD)},
+  {UINT64_C (0xA74D40FF1AA21F0E), UINT64_C (0x12C9D0B1923744CA)},
+  {UINT64_C (0x0BAECE64F769CB4A), UINT64_C (0x1E0FB44F50586E11)},
+  {UINT64_C (0x3C8BD850C5EE3C3B), UINT64_C (0x180C903F7379F1A7)},
+  {UINT64_C (0xCA0979DA37F1C9C9), UINT64_C (0x133D4032C2C7F485)},
+  {UINT64_C (0xA9A8C2F6BFE942DB), UINT64_C (0x1EC866B79E0CBA6F)},
+  {UINT64_C (0x2153CF2BCCBA9BE3), UINT64_C (0x18A0522C7E709526)},
+  {UINT64_C (0x1AA9728970954982), UINT64_C (0x13B374F06526DDB8)},
+  {UINT64_C (0xF775840F1A88759D), UINT64_C (0x1F8587E7083E2F8C)},
+  {UINT64_C (0x5F9136727BA05E17), UINT64_C (0x19379FEC0698260A)},
+  {UINT64_C (0x1940F85B9619E4DF), UINT64_C (0x142C7FF0054684D5)},
+  {UINT64_C (0xE100C6AFAB47EA4C), UINT64_C (0x1023998CD1053710)},
+  {UINT64_C (0xCE67A44C453FDD47), UINT64_C (0x19D28F47B4D524E7)},
+  {UINT64_C (0xD852E9D69DCCB106), UINT64_C (0x14A8729FC3DDB71F)},
+  {UINT64_C (0x79DBEE454B0A2738), UINT64_C (0x1086C219697E2C19)},
+  {UINT64_C (0x295FE3A211A9D859), UINT64_C (0x1A71368F0F30468F)},
+  {UINT64_C (0xBAB31C81A7BB137A), UINT64_C (0x15275ED8D8F36BA5)},
+  {UINT64_C (0x6228E39AEC95A92F), UINT64_C (0x10EC4BE0AD8F8951)},
+  {UINT64_C (0x9D0E38F7E0EF7517), UINT64_C (0x1B13AC9AAF4C0EE8)},
+  {UINT64_C (0xB0D82D931A592A79), UINT64_C (0x15A956E225D67253)},
+  {UINT64_C (0x8D79BE0F4847552E), UINT64_C (0x11544581B7DEC1DC)},
+  {UINT64_C (0x158F967EDA0BBB7C), UINT64_C (0x1BBA08CF8C979C94)},
+  {UINT64_C (0x77A611FF14D62F97), UINT64_C (0x162E6D72D6DFB076)},
+  {UINT64_C (0xF951A7FF43DE8C79), UINT64_C (0x11BEBDF578B2F391)},
+  {UINT64_C (0xC21C3FFED2FDAD8E), UINT64_C (0x1C6463225AB7EC1C)},
+  {UINT64_C (0x01B0333242648AD8), UINT64_C (0x16B6B5B5155FF017)},
+  {UINT64_C (0x0159C28E9B83A246), UINT64_C (0x122BC490DDE659AC)},
+  {UINT64_C (0xCEF604175F3903A3), UINT64_C (0x1D12D41AFCA3C2AC)},
+  {UINT64_C (0x725E69AC4C2D9C83), UINT64_C (0x17424348CA1C9BBD)},
+  {UINT64_C (0xF5185489D68AE39C), UINT64_C (0x129B69070816E2FD)},
+  {UINT64_C (0xEE8D540FBDAB05C6), UINT64_C (0x1DC574D80CF16B2F)},
+  {UINT64_C (0xBED77672FE226B05), UINT64_C (0x17D12A4670C1228C)},
+  {UINT64_C (0xFF12C528CB4EBC04), UINT64_C (0x130DBB6B8D674ED6)},
+  {UINT64_C (0xCB513B74787DF9A0), UINT64_C (0x1E7C5F127BD87E24)},
+  {UINT64_C (0x090DC929F9FE614D), UINT64_C (0x18637F41FCAD31B7)},
+  {UINT64_C (0xA0D7D42194CB810A), UINT64_C (0x1382CC34CA2427C5)},
+  {UINT64_C (0x67BFB9CF5478CE77), UINT64_C (0x1F37AD21436D0C6F)},
+  {UINT64_C (0x1FCC94A5DD2D71F9), UINT64_C (0x18F9574DCF8A7059)},
+  {UINT64_C (0x7FD6DD517DBDF4C7), UINT64_C (0x13FAAC3E3FA1F37A)},
+  {UINT64_C (0xFFBE2EE8C92FEE0B), UINT64_C (0x1FF779FD329CB8C3)},
+  {UINT64_C (0x6631BF20A0F324D6), UINT64_C (0x1992C7FDC216FA36)},
+  {UINT64_C (0xB827CC1A1A5C1D78), UINT64_C (0x14756CCB01ABFB5E)},
+  {UINT64_C (0x935309AE7B7CE460), UINT64_C (0x105DF0A267BCC918)},
+  {UINT64_C (0x1EEB42B0C594A099), UINT64_C (0x1A2FE76A3F9474F4)},
+  {UINT64_C (0xE58902270476E6E1), UINT64_C (0x14F31F8832DD2A5C)},
+  {UINT64_C (0xB7A0CE859D2BEBE7), UINT64_C (0x10C27FA028B0EEB0)},
+  {UINT64_C (0x59014A6F61DFDFD8), UINT64_C (0x1AD0CC33744E4AB4)},
+  {UINT64_C (0xE0CDD525E7E64CAD), UINT64_C (0x1573D68F903EA229)},
+  {UINT64_C (0x4D7177518651D6F1), UINT64_C (0x11297872D9CBB4EE)},
+  {UINT64_C (0x7BE8BEE8D6E957E8), UINT64_C (0x1B758D848FAC54B0)},
+  {UINT64_C (0xFCBA3253DF211320), UINT64_C (0x15F7A46A0C89DD59)},
+  {UINT64_C (0x63C8284318E74280), UINT64_C (0x1192E9EE706E4AAE)},
+  {UINT64_C (0x060D0D3827D86A66), UINT64_C (0x1C1E43171A4A1117)},
+  {UINT64_C (0x6B3DA42CECAD21EB), UINT64_C (0x167E9C127B6E7412)},
+  {UINT64_C (0x88FE1CF0BD574E56), UINT64_C (0x11FEE341FC585CDB)},
+  {UINT64_C (0x419694B462254A23), UINT64_C (0x1CCB0536608D615F)},
+  {UINT64_C (0x67ABAA29E81DD4E9), UINT64_C (0x1708D0F84D3DE77F)},
+  {UINT64_C (0xB95621BB2017DD87), UINT64_C (0x126D73F9D764B932)},
+  {UINT64_C (0xC223692B668C95A5), UINT64_C (0x1D7BECC2F23AC1EA)},
+  {UINT64_C (0xCE82BA891ED6DE1D), UINT64_C (0x179657025B6234BB)},
+  {UINT64_C (0xA53562074BDF1818), UINT64_C (0x12DEAC01E2B4F6FC)},
+  {UINT64_C (0x3B889CD87964F359), UINT64_C (0x1E3113363787F194)},
+  {UINT64_C (0xFC6D4A46C783F5E1), UINT64_C (0x18274291C6065ADC)},
+  {UINT64_C (0x30576E9F06032B1A), UINT64_C (0x13529BA7D19EAF17)},
+  {UINT64_C (0x1A257DCB3CD1DE90), UINT64_C (0x1EEA92A61C311825)},
+  {UINT64_C (0x481DFE3C30A7E540), UINT64_C (0x18BBA884E35A79B7)},
+  {UINT64_C (0xD34B31C9C0865100), UINT64_C (0x13C9539D82AEC7C5)},
+  {UINT64_C (0x5211E942CDA3B4CD), UINT64_C (0x1FA885C8D117A609)},
+  {UINT64_C (0x74DB21023E1C90A4), UINT64_C (0x19539E3A40DFB807)},
+  {UINT64_C (0xF715B401CB4A0D50), UINT64_C (0x1442E4FB67196005)},
+  {UINT64_C (0xF8DE299B09080AA7), UINT64_C (0x103583FC527AB337)},
+  {UINT64_C (0x8E304291A80CDDD7), UINT64_C (0x19EF3993B72AB859)},
+  {UINT64_C (0x3E8D020E200A4B13), UINT64_C (0x14BF6142F8EEF9E1)},
+  {UINT64_C (0x653D9B3E80083C0F), UINT64_C (0x10991A9BFA58C7E7)},
+  {UINT64_C (0x6EC8F864000D2CE4), UINT64_C (0x1A8E90F9908E0CA5)},
+  {UINT64_C (0x8BD3F9E999A423EA), UINT64_C (0x153EDA614071A3B7)},
+  {UINT64_C (0x3CA994BAE1501CBB), UINT64_C (0x10FF151A99F482F9)},
+  {UINT64_C (0xC775BAC49BB3612B), UINT64_C (0x1B31BB5DC320D18E)},
+  {UINT64_C (0xD2C4956A16291A89), UINT64_C (0x15C162B168E70E0B)},
+  {UINT64_C (0xDBD0778811BA7BA1), UINT64_C (0x11678227871F3E6F)},
+  {UINT64_C (0x2C80BF401C5D929B), UINT64_C (0x1BD8D03F3E9863E6)},
+  {UINT64_C (0xBD33CC3349E47549), UINT64_C (0x16470CFF6546B651)},
+  {UINT64_C (0xCA8FD68F6E505DD4), UINT64_C (0x11D270CC51055EA7)},
+  {UINT64_C (0x4419574BE3B3C953), UINT64_C (0x1C83E7AD4E6EFDD9)},
+  {UINT64_C (0x0347790982F63AA9), UINT64_C (0x16CFEC8AA52597E1)},
+  {UINT64_C (0xCF6C60D468C4FBBA), UINT64_C (0x123FF06EEA847980)},
+  {UINT64_C (0xE57A34870E07F92A), UINT64_C (0x1D331A4B10D3F59A)},
+  {UINT64_C (0x512E906C0B399422), UINT64_C (0x175C1508DA432AE2)},
+  {UINT64_C (0xDA8BA6BCD5C7A9B5), UINT64_C (0x12B010D3E1CF5581)},
+  {UINT64_C (0x90DF712E22D90F87), UINT64_C (0x1DE6815302E5559C)},
+  {UINT64_C (0xDA4C5A8B4F140C6C), UINT64_C (0x17EB9AA8CF1DDE16)},
+  {UINT64_C (0xAEA37BA2A5A9A38A), UINT64_C (0x1322E220A5B17E78)},
+  {UINT64_C (0x7DD25F6AA2A905A9), UINT64_C (0x1E9E369AA2B59727)},
+  {UINT64_C (0x97DB7F888220D154), UINT64_C (0x187E92154EF7AC1F)},
+  {UINT64_C (0x797C6606CE80A777), UINT64_C (0x139874DDD8C6234C)},
+  {UINT64_C (0x8F2D700AE4010BF1), UINT64_C (0x1F5A549627A36BAD)},
+  {UINT64_C (0x0C2459A25000D65A), UINT64_C (0x191510781FB5EFBE)},
+  {UINT64_C (0x701D1481D99A4515), UINT64_C (0x1410D9F9B2F7F2FE)},
+  {UINT64_C (0xC017439B147B6A77), UINT64_C (0x100D7B2E28C65BFE)},
+  {UINT64_C (0xCCF205C4ED9243F2), UINT64_C (0x19AF2B7D0E0A2CCA)},
+  {UINT64_C (0x0A5B37D0BE0E9CC2), UINT64_C (0x148C22CA71A1BD6F)},
+  {UINT64_C (0x0848F973CB3EE3CE), UINT64_C (0x10701BD527B4978C)},
+  {UINT64_C (0xDA0E5BEC78649FB0), UINT64_C (0x1A4CF9550C5425AC)},
+  {UINT64_C (0x7B3EAFF060507FC0), UINT64_C (0x150A6110D6A9B7BD)},
+  {UINT64_C (0x95CBBFF380406633), UINT64_C (0x10D51A73DEEE2C97)},
+  {UINT64_C (0xEFAC665266CD7052), UINT64_C (0x1AEE90B964B04758)},
+  {UINT64_C (0x2623850EB8A459DB), UINT64_C (0x158BA6FAB6F36C47)},
+  {UINT64_C (0x1E82D0D893B6AE49), UINT64_C (0x113C85955F29236C)},
+  {UINT64_C (0xFD9E1AF41F8AB075), UINT64_C (0x1B9408EEFEA838AC)},
+  {UINT64_C (0x97B1AF29B2D559F7), UINT64_C (0x16100725988693BD)},
+  {UINT64_C (0xAC8E25BAF5777B2C), UINT64_C (0x11A66C1E139EDC97)},
+  {UINT64_C (0x7A7D092B2258C513), UINT64_C (0x1C3D79C9B8FE2DBF)},
+  {UINT64_C (0x61FDA0EF4EAD6A76), UINT64_C (0x169794A160CB57CC)},
+  {UINT64_C (0xE7FE1A590BBDEEC5), UINT64_C (0x1212DD4DE7091309)},
+  {UINT64_C (0xA6635D5B45FCB13A), UINT64_C (0x1CEAFBAFD80E84DC)},
+  {UINT64_C (0x851C4AAF6B308DC8), UINT64_C (0x172262F3133ED0B0)},
+  {UINT64_C (0xD0E36EF2BC26D7D4), UINT64_C (0x1281E8C275CBDA26)},
+  {UINT64_C (0xB49F17EAC6A48C86), UINT64_C (0x1D9CA79D894629D7)},
+  {UINT64_C (0x2A18DFEF0550706B), UINT64_C (0x17B08617A104EE46)},
+  {UINT64_C (0x54E0B3259DD9F389), UINT64_C (0x12F39E794D9D8B6B)},
+  {UINT64_C (0x87CDEB6F62F65274), UINT64_C (0x1E5297287C2F4578)},
+  {UINT64_C (0xD30B22BF825EA85D), UINT64_C (0x18421286C9BF6AC6)},
+  {UINT64_C (0x0F3C1BCC684BB9E4), UINT64_C (0x13680ED23AFF889F)},
+  {UINT64_C (0x18602C7A4079296D), UINT64_C (0x1F0CE4839198DA98)},
+  {UINT64_C (0x46B356C833942124), UINT64_C (0x18D71D360E13E213)},
+  {UINT64_C (0x388F78A029434DB6), UINT64_C (0x13DF4A91A4DCB4DC)},
+  {UINT64_C (0x5A7F2766A86BAF8A), UINT64_C (0x1FCBAA82A1612160)},
+  {UINT64_C (0x153285EBB9EFBFA2), UINT64_C (0x196FBB9BB44DB44D)},
+  {UINT64_C (0xAA8ED189618C994E), UINT64_C (0x145962E2F6A4903D)},
+  {UINT64_C (0xEED8A7A11AD6E10C), UINT64_C (0x1047824F2BB6D9CA)},
+  {UINT64_C (0x7E27729B5E249B45), UINT64_C (0x1A0C03B1DF8AF611)},
+  {UINT64_C (0xFE85F549181D4904), UINT64_C (0x14D6695B193BF80D)},
+  {UINT64_C (0xCB9E5DD4134AA0D0), UINT64_C (0x10AB877C142FF9A4)},
+  {UINT64_C (0xDF63C9535211014D), UINT64_C (0x1AAC0BF9B9E65C3A)},
+  {UINT64_C (0x191CA10F74DA6771), UINT64_C (0x15566FFAFB1EB02F)},
+  {UINT64_C (0xADB080D92A4852C1), UINT64_C (0x1111F32F2F4BC025)},
+  {UINT64_C (0x15E7348EAA0D5134), UINT64_C (0x1B4FEB7EB212CD09)},
+  {UINT64_C (0xAB1F5D3EEE710DC4), UINT64_C (0x15D98932280F0A6D)},
+  {UINT64_C (0xBC1917658B8DA49D), UINT64_C (0x117AD428200C0857)},
+  {UINT64_C (0x2CF4F23C127C3A94), UINT64_C (0x1BF7B9D9CCE00D59)},
+  {UINT64_C (0xF0C3F4FCDB969543), UINT64_C (0x165FC7E170B33DE0)},
+  {UINT64_C (0x5A365D9716121103), UINT64_C (0x11E6398126F5CB1A)},
+  {UINT64_C (0x9056FC24F01CE804), UINT64_C (0x1CA38F350B22DE90)},
+  {UINT64_C (0xD9DF301D8CE3ECD0), UINT64_C (0x16E93F5DA2824BA6)},
+  {UINT64_C (0xE17F59B13D8323DA), UINT64_C (0x125432B14ECEA2EB)},
+  {UINT64_C (0x68CBC2B52F38395C), UINT64_C (0x1D53844EE47DD179)},
+  {UINT64_C (0x53D6355DBF602DE3), UINT64_C (0x177603725064A794)},
+  {UINT64_C (0xA9782AB165E68B1C), UINT64_C (0x12C4CF8EA6B6EC76)},
+  {UINT64_C (0x0F26AAB56FD744FA), UINT64_C (0x1E07B27DD78B13F1)},
+  {UINT64_C (0x3F52222ABFDF6A62), UINT64_C (0x18062864AC6F4327)},
+  {UINT64_C (0x65DB4E88997F884E), UINT64_C (0x1338205089F29C1F)},
+  {UINT64_C (0x6FC54A7428CC0D4A), UINT64_C (0x1EC033B40FEA9365)},
+  {UINT64_C (0x596AA1F68709A43B), UINT64_C (0x1899C2F673220F84)},
+  {UINT64_C (0xADEEE7F86C07B696), UINT64_C (0x13AE3591F5B4D936)},
+  {UINT64_C (0x497E3FF3E00C5756), UINT64_C (0x1F7D228322BAF524)},
+  {UINT64_C (0xD464FFF64CD6AC45), UINT64_C (0x1930E868E89590E9)},
+  {UINT64_C (0x4383FFF83D7889D1), UINT64_C (0x14272053ED4473EE)},
+  {UINT64_C (0xCF9CCCC69793A174), UINT64_C (0x101F4D0FF1038FF1)},
+  {UINT64_C (0x7F6147A425B90252), UINT64_C (0x19CBAE7FE805B31C)},
+  {UINT64_C (0xCC4DD2E9B7C7350F), UINT64_C (0x14A2F1FFECD15C16)},
+  {UINT64_C (0x3D0B0F215FD290D9), UINT64_C (0x10825B3323DAB012)},
+  {UINT64_C (0x61AB4B689950E7C1), UINT64_C (0x1A6A2B85062AB350)},
+  {UINT64_C (0x4E22A2BA1440B967), UINT64_C (0x1521BC6A6B555C40)},
+  {UINT64_C (0x0B4EE894DD009453), UINT64_C (0x10E7C9EEBC4449CD)},
+  {UINT64_C (0x1217DA87C800ED51), UINT64_C (0x1B0C764AC6D3A948)},
+  {UINT64_C (0xDB46486CA000BDDA), UINT64_C (0x15A391D56BDC876C)},
+  {UINT64_C (0x490506BD4CCD64AF), UINT64_C (0x114FA7DDEFE39F8A)},
+  {UINT64_C (0xA8080AC87AE23AB1), UINT64_C (0x1BB2A62FE638FF43)},
+  {UINT64_C (0x5339A239FBE82EF4), UINT64_C (0x162884F31E93FF69)},
+  {UINT64_C (0x75C7B4FB2FECF25D), UINT64_C (0x11BA03F5B20FFF87)},
+  {UINT64_C (0x22D92191E647EA2E), UINT64_C (0x1C5CD322B67FFF3F)},
+  {UINT64_C (0xB57A8141850654F2), UINT64_C (0x16B0A8E891FFFF65)},
+  {UINT64_C (0xC4620101373843F5), UINT64_C (0x1226ED86DB3332B7)},
+  {UINT64_C (0x3A366801F1F39FEE), UINT64_C (0x1D0B15A491EB8459)},
+  {UINT64_C (0xFB5EB99B27F6198B), UINT64_C (0x173C115074BC69E0)},
+  {UINT64_C (0x2F7EFAE2865E7AD6), UINT64_C (0x129674405D6387E7)},
+  {UINT64_C (0xE597F7D0D6FD9156), UINT64_C (0x1DBD86CD6238D971)},
+  {UINT64_C (0x8479930D78CADAAB), UINT64_C (0x17CAD23DE82D7AC1)},
+  {UINT64_C (0xD06142712D6F1556), UINT64_C (0x1308A831868AC89A)},
+  {UINT64_C (0x4D686A4EAF182222), UINT64_C (0x1E74404F3DAADA91)},
+  {UINT64_C (0xA453883EF279B4E8), UINT64_C (0x185D003F6488AEDA)},
+  {UINT64_C (0xE9DC6CFF28615D87), UINT64_C (0x137D99CC506D58AE)},
+  {UINT64_C (0xA960AE650D6895A4), UINT64_C (0x1F2F5C7A1A488DE4)},
+  {UINT64_C (0xBAB3BEB73DED4483), UINT64_C (0x18F2B061AEA07183)},
+  {UINT64_C (0x2EF6322C318A9D36), UINT64_C (0x13F559E7BEE6C136)},
+  {UINT64_C (0xE4BD1D13827761F0), UINT64_C (0x1FEEF63F97D79B89)},
+  {UINT64_C (0x83CA7DA9352C4E5A), UINT64_C (0x198BF832DFDFAFA1)},
+  {UINT64_C (0x9CA1FE20F756A515), UINT64_C (0x146FF9C24CB2F2E7)},
+  {UINT64_C (0x4A1B31B3F9121DAA), UINT64_C (0x1059949B708F28B9)},
+  {UINT64_C (0x435EB5ECC1B695DD), UINT64_C (0x1A28EDC580E50DF5)},
+  {UINT64_C (0x35E55E57015EDE4A), UINT64_C (0x14ED8B04671DA4C4)},
+  {UINT64_C (0xC4B77EAC0118B1D5), UINT64_C (0x10BE08D0527E1D69)},
+  {UINT64_C (0xA12597799B5AB622), UINT64_C (0x1AC9A7B3B7302F0F)},
+  {UINT64_C (0x4DB7AC6149155E81), UINT64_C (0x156E1FC2F8F358D9)},
+  {UINT64_C (0xD7C6238107444B9B), UINT64_C (0x1124E63593F5E0AD)},
+  {UINT64_C (0x593D059B3ED3AC2B), UINT64_C (0x1B6E3D2286563449)},
+  {UINT64_C (0xE0FD9E15CBDC89BC), UINT64_C (0x15F1CA820511C36D)},
+  {UINT64_C (0xB3FE18116FE3A163), UINT64_C (0x118E3B9B37416924)},
+  {UINT64_C (0x866359B57FD29BD1), UINT64_C (0x1C16C5C525357507)},
+  {UINT64_C (0xD1E91491330EE30E), UINT64_C (0x16789E3750F790D2)},
+  {UINT64_C (0x74BA76DA8F3F1C0B), UINT64_C (0x11FA182C40C60D75)},
+  {UINT64_C (0xEDF72490E531C678), UINT64_C (0x1CC359E067A348BB)},
+  {UINT64_C (0x8B2C1D40B75B052D), UINT64_C (0x1702AE4D1FB5D3C9)},
+  {UINT64_C (0x6F567DCD5F7C0424), UINT64_C (0x12688B70E62B0FD4)},
+  {UINT64_C (0x7EF0C94898C66D06), UINT64_C (0x1D74124E3D11B2ED)},
+  {UINT64_C (0x98C0A106E09EBD9F), UINT64_C (0x17900EA4FDA7C257)},
+  {UINT64_C (0x470080D24D4BCAE6), UINT64_C (0x12D9A550CAEC9B79)},
+  {UINT64_C (0xD800CE1D487944A2), UINT64_C (0x1E29088144ADC58E)},
+  {UINT64_C (0x1333D8176D2DD082), UINT64_C (0x1820D39A9D57D13F)},
+  {UINT64_C (0xA8F646792424A6CE), UINT64_C (0x134D76154AACA765)},
+  {UINT64_C (0x74BD3D8EA03AA47D), UINT64_C (0x1EE25688777AA56F)},
+  {UINT64_C (0x5D64313EE6955064), UINT64_C (0x18B51206C5FBB78C)},
+  {UINT64_C (0x4AB68DCBEBAAA6B7), UINT64_C (0x13C40E6BD1962C70)},
+  {UINT64_C (0x1124161312AAA457), UINT64_C (0x1FA01712E8F0471A)},
+  {UINT64_C (0xDA8344DC0EEEE9DF), UINT64_C (0x194CDF4253F36C14)},
+  {UINT64_C (0xE2029D7CD8BF2180), UINT64_C (0x143D7F6843292343)},
+  {UINT64_C (0x4E687DFD7A328133), UINT64_C (0x103132B9CF541C36)},
+  {UINT64_C (0x4A40C9959050CEB8), UINT64_C (0x19E851294BB9C6BD)},
+  {UINT64_C (0x0833D477A6A70BC6), UINT64_C (0x14B9DA876FC7D231)},
+  {UINT64_C (0xA02976C61EEC096B), UINT64_C (0x1094AED2BFD30E8D)},
+  {UINT64_C (0x004257A364ACDBDF), UINT64_C (0x1A877E1DFFB81749)},
+  {UINT64_C (0xCD01DFB5EA23E319), UINT64_C (0x153931B1996012A0)},
+  {UINT64_C (0x70CE4C91881CB5AE), UINT64_C (0x10FA8E27ADE6754D)},
+  {UINT64_C (0x1AE3ADB5A69455E2), UINT64_C (0x1B2A7D0C4970BBAF)},
+  {UINT64_C (0x7BE957C4854377E8), UINT64_C (0x15BB973D078D62F2)},
+  {UINT64_C (0xC987796A0435F987), UINT64_C (0x1162DF64060AB58E)},
+  {UINT64_C (0x75A58F1006BCC271), UINT64_C (0x1BD1656CD67788E4)},
+  {UINT64_C (0xF7B7A5A66BCA3527), UINT64_C (0x16411DF0AB92D3E9)},
+  {UINT64_C (0x5FC61E1EBCA1C41F), UINT64_C (0x11CDB18D560F0FEE)},
+  {UINT64_C (0xFFA363646102D365), UINT64_C (0x1C7C4F4889B1B316)},
+  {UINT64_C (0x32E91C504D9BDC51), UINT64_C (0x16C9D906D48E28DF)},
+  {UINT64_C (0x8F20E37371497D0E), UINT64_C (0x123B140576D820B2)},
+  {UINT64_C (0x7E9B0585820F2E7C), UINT64_C (0x1D2B533BF159CDEA)},
+  {UINT64_C (0xCBAF379E01A5BECA), UINT64_C (0x1755DC2FF447D7EE)},
+  {UINT64_C (0x0958F94B348498A1), UINT64_C (0x12AB168CC36CACBF)},
+};
+
+static const uint64_t fast_json_pow5_split[326][2] = {
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1000000000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1400000000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1900000000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1F40000000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1388000000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x186A000000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1E84800000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1312D00000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x17D7840000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1DCD650000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x12A05F2000000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x174876E800000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1D1A94A200000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x12309CE540000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x16BCC41E90000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1C6BF52634000000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x11C37937E0800000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x16345785D8A00000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1BC16D674EC80000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1158E460913D0000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x15AF1D78B58C4000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1B1AE4D6E2EF5000)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x10F0CF064DD59200)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x152D02C7E14AF680)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x1A784379D99DB420)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x108B2A2C28029094)},
+  {UINT64_C (0x0000000000000000), UINT64_C (0x14ADF4B7320334B9)},
+  {UINT64_C (0x4000000000000000), UINT64_C (0x19D971E4FE8401E7)},
+  {UINT64_C (0x8800000000000000), UINT64_C (0x1027E72F1F128130)},
+  {UINT64_C (0xAA00000000000000), UINT64_C (0x1431E0FAE6D7217C)},
+  {UINT64_C (0xD480000000000000), UINT64_C (0x193E5939A08CE9DB)},
+  {UINT64_C (0xC9A0000000000000), UINT64_C (0x1F8DEF8808B02452)},
+  {UINT64_C (0xBE04000000000000), UINT64_C (0x13B8B5B5056E16B3)},
+  {UINT64_C (0xAD85000000000000), UINT64_C (0x18A6E32246C99C60)},
+  {UINT64_C (0xD8E6400000000000), UINT64_C (0x1ED09BEAD87C0378)},
+  {UINT64_C (0x878FE80000000000), UINT64_C (0x13426172C74D822B)},
+  {UINT64_C (0x6973E20000000000), UINT64_C (0x1812F9CF7920E2B6)},
+  {UINT64_C (0x03D0DA8000000000), UINT64_C (0x1E17B84357691B64)},
+  {UINT64_C (0x8262889000000000), UINT64_C (0x12CED32A16A1B11E)},
+  {UINT64_C (0x22FB2AB400000000), UINT64_C (0x178287F49C4A1D66)},
+  {UINT64_C (0xABB9F56100000000), UINT64_C (0x1D6329F1C35CA4BF)},
+  {UINT64_C (0xCB54395CA0000000), UINT64_C (0x125DFA371A19E6F7)},
+  {UINT64_C (0xBE2947B3C8000000), UINT64_C (0x16F578C4E0A060B5)},
+  {UINT64_C (0x2DB399A0BA000000), UINT64_C (0x1CB2D6F618C878E3)},
+  {UINT64_C (0xFC90400474400000), UINT64_C (0x11EFC659CF7D4B8D)},
+  {UINT64_C (0x7BB4500591500000), UINT64_C (0x166BB7F0435C9E71)},
+  {UINT64_C (0xDAA16406F5A40000), UINT64_C (0x1C06A5EC5433C60D)},
+  {UINT64_C (0xA8A4DE8459868000), UINT64_C (0x118427B3B4A05BC8)},
+  {UINT64_C (0xD2CE16256FE82000), UINT64_C (0x15E531A0A1C872BA)},
+  {UINT64_C (0x87819BAECBE22800), UINT64_C (0x1B5E7E08CA3A8F69)},
+  {UINT64_C (0xF4B1014D3F6D5900), UINT64_C (0x111B0EC57E6499A1)},
+  {UINT64_C (0x71DD41A08F48AF40), UINT64_C (0x1561D276DDFDC00A)},
+  {UINT64_C (0x0E549208B31ADB10), UINT64_C (0x1ABA4714957D300D)},
+  {UINT64_C (0x28F4DB456FF0C8EA), UINT64_C (0x10B46C6CDD6E3E08)},
+  {UINT64_C (0x33321216CBECFB24), UINT64_C (0x14E1878814C9CD8A)},
+  {UINT64_C (0xBFFE969C7EE839ED), UINT64_C (0x1A19E96A19FC40EC)},
+  {UINT64_C (0xF7FF1E21CF512434), UINT64_C (0x105031E2503DA893)},
+  {UINT64_C (0xF5FEE5AA43256D41), UINT64_C (0x14643E5AE44D12B8)},
+  {UINT64_C (0x337E9F14D3EEC892), UINT64_C (0x197D4DF19D605767)},
+  {UINT64_C (0x005E46DA08EA7AB6), UINT64_C (0x1FDCA16E04B86D41)},
+  {UINT64_C (0xA03AEC4845928CB2), UINT64_C (0x13E9E4E4C2F34448)},
+  {UINT64_C (0xC849A75A56F72FDE), UINT64_C (0x18E45E1DF3B0155A)},
+  {UINT64_C (0x7A5C1130ECB4FBD6), UINT64_C (0x1F1D75A5709C1AB1)},
+  {UINT64_C (0xEC798ABE93F11D65), UINT64_C (0x13726987666190AE)},
+  {UINT64_C (0xA797ED6E38ED64BF), UINT64_C (0x184F03E93FF9F4DA)},
+  {UINT64_C (0x517DE8C9C728BDEF), UINT64_C (0x1E62C4E38FF87211)},
+  {UINT64_C (0xD2EEB17E1C7976B5), UINT64_C (0x12FDBB0E39FB474A)},
+  {UINT64_C (0x87AA5DDDA397D462), UINT64_C (0x17BD29D1C87A191D)},
+  {UINT64_C (0xE994F5550C7DC97B), UINT64_C (0x1DAC74463A989F64)},
+  {UINT64_C (0x11FD195527CE9DED), UINT64_C (0x128BC8ABE49F639F)},
+  {UINT64_C (0xD67C5FAA71C24568), UINT64_C (0x172EBAD6DDC73C86)},
+  {UINT64_C (0x8C1B77950E32D6C2), UINT64_C (0x1CFA698C95390BA8)},
+  {UINT64_C (0x57912ABD28DFC639), UINT64_C (0x121C81F7DD43A749)},
+  {UINT64_C (0xAD75756C7317B7C8), UINT64_C (0x16A3A275D494911B)},
+  {UINT64_C (0x98D2D2C78FDDA5BA), UINT64_C (0x1C4C8B1349B9B562)},
+  {UINT64_C (0x9F83C3BCB9EA8794), UINT64_C (0x11AFD6EC0E14115D)},
+  {UINT64_C (0x0764B4ABE8652979), UINT64_C (0x161BCCA7119915B5)},
+  {UINT64_C (0x493DE1D6E27E73D7), UINT64_C (0x1BA2BFD0D5FF5B22)},
+  {UINT64_C (0x6DC6AD264D8F0866), UINT64_C (0x1145B7E285BF98F5)},
+  {UINT64_C (0xC938586FE0F2CA80), UINT64_C (0x159725DB272F7F32)},
+  {UINT64_C (0x7B866E8BD92F7D20), UINT64_C (0x1AFCEF51F0FB5EFF)},
+  {UINT64_C (0xAD34051767BDAE34), UINT64_C (0x10DE1593369D1B5F)},
+  {UINT64_C (0x9881065D41AD19C1), UINT64_C (0x15159AF804446237)},
+  {UINT64_C (0x7EA147F492186032), UINT64_C (0x1A5B01B605557AC5)},
+  {UINT64_C (0x6F24CCF8DB4F3C1F), UINT64_C (0x1078E111C3556CBB)},
+  {UINT64_C (0x4AEE003712230B27), UINT64_C (0x14971956342AC7EA)},
+  {UINT64_C (0xDDA98044D6ABCDF0), UINT64_C (0x19BCDFABC13579E4)},
+  {UINT64_C (0x0A89F02B062B60B6), UINT64_C (0x10160BCB58C16C2F)},
+  {UINT64_C (0xCD2C6C35C7B638E4), UINT64_C (0x141B8EBE2EF1C73A)},
+  {UINT64_C (0x8077874339A3C71D), UINT64_C (0x1922726DBAAE3909)},
+  {UINT64_C (0xE0956914080CB8E4), UINT64_C (0x1F6B0F092959C74B)},
+  {UINT64_C (0x6C5D61AC8507F38E), UINT64_C (0x13A2E965B9D81C8F)},
+  {UINT64_C (0x4774BA17A649F072), UINT64_C (0x188BA3BF284E23B3)},
+  {UINT64_C (0x1951E89D8FDC6C8F), UINT64_C (0x1EAE8CAEF261ACA0)},
+  {UINT64_C (0x0FD3316279E9C3D9), UINT64_C (0x132D17ED577D0BE4)},
+  {UINT64_C (0x13C7FDBB186434CF), UINT64_C (0x17F85DE8AD5C4EDD)},
+  {UINT64_C (0x58B9FD29DE7D4203), UINT64_C (0x1DF67562D8B36294)},
+  {UINT64_C (0xB7743E3A2B0E4942), UINT64_C (0x12BA095DC7701D9C)},
+  {UINT64_C (0xE5514DC8B5D1DB92), UINT64_C (0x17688BB5394C2503)},
+  {UINT64_C (0xDEA5A13AE3465277), UINT64_C (0x1D42AEA2879F2E44)},
+  {UINT64_C (0x0B2784C4CE0BF38A), UINT64_C (0x1249AD2594C37CEB)},
+  {UINT64_C (0xCDF165F6018EF06D), UINT64_C (0x16DC186EF9F45C25)},
+  {UINT64_C (0x416DBF7381F2AC88), UINT64_C (0x1C931E8AB871732F)},
+  {UINT64_C (0x88E497A83137ABD5), UINT64_C (0x11DBF316B346E7FD)},
+  {UINT64_C (0xEB1DBD923D8596CA), UINT64_C (0x1652EFDC6018A1FC)},
+  {UINT64_C (0x25E52CF6CCE6FC7D), UINT64_C (0x1BE7ABD3781ECA7C)},
+  {UINT64_C (0x97AF3C1A40105DCE), UINT64_C (0x1170CB642B133E8D)},
+  {UINT64_C (0xFD9B0B20D0147542), UINT64_C (0x15CCFE3D35D80E30)},
+  {UINT64_C (0x3D01CDE904199292), UINT64_C (0x1B403DCC834E11BD)},
+  {UINT64_C (0x462120B1A28FFB9B), UINT64_C (0x1108269FD210CB16)},
+  {UINT64_C (0xD7A968DE0B33FA82), UINT64_C (0x154A3047C694FDDB)},
+  {UINT64_C (0xCD93C3158E00F923), UINT64_C (0x1A9CBC59B83A3D52)},
+  {UINT64_C (0xC07C59ED78C09BB6), UINT64_C (0x10A1F5B813246653)},
+  {UINT64_C (0xB09B7068D6F0C2A3), UINT64_C (0x14CA732617ED7FE8)},
+  {UINT64_C (0xDCC24C830CACF34C), UINT64_C (0x19FD0FEF9DE8DFE2)},
+  {UINT64_C (0xC9F96FD1E7EC180F), UINT64_C (0x103E29F5C2B18BED)},
+  {UINT64_C (0x3C77CBC661E71E13), UINT64_C (0x144DB473335DEEE9)},
+  {UINT64_C (0x8B95BEB7FA60E598), UINT64_C (0x1961219000356AA3)},
+  {UINT64_C (0x6E7B2E65F8F91EFE), UINT64_C (0x1FB969F40042C54C)},
+  {UINT64_C (0xC50CFCFFBB9BB35F), UINT64_C (0x13D3E2388029BB4F)},
+  {UINT64_C (0xB6503C3FAA82A037), UINT64_C (0x18C8DAC6A0342A23)},
+  {UINT64_C (0xA3E44B4F95234844), UINT64_C (0x1EFB1178484134AC)},
+  {UINT64_C (0xE66EAF11BD360D2B), UINT64_C (0x135CEAEB2D28C0EB)},
+  {UINT64_C (0xE00A5AD62C839075), UINT64_C (0x183425A5F872F126)},
+  {UINT64_C (0x980CF18BB7A47493), UINT64_C (0x1E412F0F768FAD70)},
+  {UINT64_C (0x5F0816F752C6C8DC), UINT64_C (0x12E8BD69AA19CC66)},
+  {UINT64_C (0xF6CA1CB527787B13), UINT64_C (0x17A2ECC414A03F7F)},
+  {UINT64_C (0xF47CA3E2715699D7), UINT64_C (0x1D8BA7F519C84F5F)},
+  {UINT64_C (0xF8CDE66D86D62026), UINT64_C (0x127748F9301D319B)},
+  {UINT64_C (0xF7016008E88BA830), UINT64_C (0x17151B377C247E02)},
+  {UINT64_C (0xB4C1B80B22AE923C), UINT64_C (0x1CDA62055B2D9D83)},
+  {UINT64_C (0x50F91306F5AD1B65), UINT64_C (0x12087D4358FC8272)},
+  {UINT64_C (0xE53757C8B318623F), UINT64_C (0x168A9C942F3BA30E)},
+  {UINT64_C (0x9E852DBADFDE7ACF), UINT64_C (0x1C2D43B93B0A8BD2)},
+  {UINT64_C (0xA3133C94CBEB0CC1), UINT64_C (0x119C4A53C4E69763)},
+  {UINT64_C (0x8BD80BB9FEE5CFF1), UINT64_C (0x16035CE8B6203D3C)},
+  {UINT64_C (0xAECE0EA87E9F43EE), UINT64_C (0x1B843422E3A84C8B)},
+  {UINT64_C (0x4D40C9294F238A75), UINT64_C (0x1132A095CE492FD7)},
+  {UINT64_C (0x2090FB73A2EC6D12), UINT64_C (0x157F48BB41DB7BCD)},
+  {UINT64_C (0x68B53A508BA78856), UINT64_C (0x1ADF1AEA12525AC0)},
+  {UINT64_C (0x417144725748B536), UINT64_C (0x10CB70D24B7378B8)},
+  {UINT64_C (0x51CD958EED1AE283), UINT64_C (0x14FE4D06DE5056E6)},
+  {UINT64_C (0xE640FAF2A8619B24), UINT64_C (0x1A3DE04895E46C9F)},
+  {UINT64_C (0xEFE89CD7A93D00F7), UINT64_C (0x1066AC2D5DAEC3E3)},
+  {UINT64_C (0xEBE2C40D938C4134), UINT64_C (0x14805738B51A74DC)},
+  {UINT64_C (0x26DB7510F86F5181), UINT64_C (0x19A06D06E2611214)},
+  {UINT64_C (0x9849292A9B4592F1), UINT64_C (0x100444244D7CAB4C)},
+  {UINT64_C (0xBE5B73754216F7AD), UINT64_C (0x1405552D60DBD61F)},
+  {UINT64_C (0xADF25052929CB598), UINT64_C (0x1906AA78B912CBA7)},
+  {UINT64_C (0x996EE4673743E2FF), UINT64_C (0x1F485516E7577E91)},
+  {UINT64_C (0xFFE54EC0828A6DDF), UINT64_C (0x138D352E5096AF1A)},
+  {UINT64_C (0xBFDEA270A32D0957), UINT64_C (0x18708279E4BC5AE1)},
+  {UINT64_C (0x2FD64B0CCBF84BAD), UINT64_C (0x1E8CA3185DEB719A)},
+  {UINT64_C (0x5DE5EEE7FF7B2F4C), UINT64_C (0x1317E5EF3AB32700)},
+  {UINT64_C (0x755F6AA1FF59FB1F), UINT64_C (0x17DDDF6B095FF0C0)},
+  {UINT64_C (0x92B7454A7F3079E7), UINT64_C (0x1DD55745CBB7ECF0)},
+  {UINT64_C (0x5BB28B4E8F7E4C30), UINT64_C (0x12A5568B9F52F416)},
+  {UINT64_C (0xF29F2E22335DDF3C), UINT64_C (0x174EAC2E8727B11B)},
+  {UINT64_C (0xEF46F9AAC035570B), UINT64_C (0x1D22573A28F19D62)},
+  {UINT64_C (0xD58C5C0AB8215667), UINT64_C (0x123576845997025D)},
+  {UINT64_C (0x4AEF730D6629AC01), UINT64_C (0x16C2D4256FFCC2F5)},
+  {UINT64_C (0x9DAB4FD0BFB41701), UINT64_C (0x1C73892ECBFBF3B2)},
+  {UINT64_C (0xA28B11E277D08E60), UINT64_C (0x11C835BD3F7D784F)},
+  {UINT64_C (0x8B2DD65B15C4B1F9), UINT64_C (0x163A432C8F5CD663)},
+  {UINT64_C (0x6DF94BF1DB35DE77), UINT64_C (0x1BC8D3F7B3340BFC)},
+  {UINT64_C (0xC4BBCF772901AB0A), UINT64_C (0x115D847AD000877D)},
+  {UINT64_C (0x35EAC354F34215CD), UINT64_C (0x15B4E5998400A95D)},
+  {UINT64_C (0x8365742A30129B40), UINT64_C (0x1B221EFFE500D3B4)},
+  {UINT64_C (0xD21F689A5E0BA108), UINT64_C (0x10F5535FEF208450)},
+  {UINT64_C (0x06A742C0F58E894A), UINT64_C (0x1532A837EAE8A565)},
+  {UINT64_C (0x4851137132F22B9D), UINT64_C (0x1A7F5245E5A2CEBE)},
+  {UINT64_C (0xED32AC26BFD75B42), UINT64_C (0x108F936BAF85C136)},
+  {UINT64_C (0xA87F57306FCD3212), UINT64_C (0x14B378469B673184)},
+  {UINT64_C (0xD29F2CFC8BC07E97), UINT64_C (0x19E056584240FDE5)},
+  {UINT64_C (0xA3A37C1DD7584F1E), UINT64_C (0x102C35F729689EAF)},
+  {UINT64_C (0x8C8C5B254D2E62E6), UINT64_C (0x14374374F3C2C65B)},
+  {UINT64_C (0x6FAF71EEA079FB9F), UINT64_C (0x1945145230B377F2)},
+  {UINT64_C (0x0B9B4E6A48987A87), UINT64_C (0x1F965966BCE055EF)},
+  {UINT64_C (0x674111026D5F4C94), UINT64_C (0x13BDF7E0360C35B5)},
+  {UINT64_C (0xC111554308B71FBA), UINT64_C (0x18AD75D8438F4322)},
+  {UINT64_C (0x7155AA93CAE4E7A8), UINT64_C (0x1ED8D34E547313EB)},
+  {UINT64_C (0x26D58A9C5ECF10C9), UINT64_C (0x13478410F4C7EC73)},
+  {UINT64_C (0xF08AED437682D4FB), UINT64_C (0x1819651531F9E78F)},
+  {UINT64_C (0xECADA89454238A3A), UINT64_C (0x1E1FBE5A7E786173)},
+  {UINT64_C (0x73EC895CB4963664), UINT64_C (0x12D3D6F88F0B3CE8)},
+  {UINT64_C (0x90E7ABB3E1BBC3FD), UINT64_C (0x1788CCB6B2CE0C22)},
+  {UINT64_C (0x352196A0DA2AB4FD), UINT64_C (0x1D6AFFE45F818F2B)},
+  {UINT64_C (0x0134FE24885AB11E), UINT64_C (0x1262DFEEBBB0F97B)},
+  {UINT64_C (0xC1823DADAA715D65), UINT64_C (0x16FB97EA6A9D37D9)},
+  {UINT64_C (0x31E2CD19150DB4BF), UINT64_C (0x1CBA7DE5054485D0)},
+  {UINT64_C (0x1F2DC02FAD2890F7), UINT64_C (0x11F48EAF234AD3A2)},
+  {UINT64_C (0xA6F9303B9872B535), UINT64_C (0x1671B25AEC1D888A)},
+  {UINT64_C (0x50B77C4A7E8F6282), UINT64_C (0x1C0E1EF1A724EAAD)},
+  {UINT64_C (0x5272ADAE8F199D91), UINT64_C (0x1188D357087712AC)},
+  {UINT64_C (0x670F591A32E004F6), UINT64_C (0x15EB082CCA94D757)},
+  {UINT64_C (0x40D32F60BF980633), UINT64_C (0x1B65CA37FD3A0D2D)},
+  {UINT64_C (0x4883FD9C77BF03E0), UINT64_C (0x111F9E62FE44483C)},
+  {UINT64_C (0x5AA4FD0395AEC4D8), UINT64_C (0x156785FBBDD55A4B)},
+  {UINT64_C (0x314E3C447B1A760E), UINT64_C (0x1AC1677AAD4AB0DE)},
+  {UINT64_C (0xDED0E5AACCF089C9), UINT64_C (0x10B8E0ACAC4EAE8A)},
+  {UINT64_C (0x96851F15802CAC3B), UINT64_C (0x14E718D7D7625A2D)},
+  {UINT64_C (0xFC2666DAE037D74A), UINT64_C (0x1A20DF0DCD3AF0B8)},
+  {UINT64_C (0x9D980048CC22E68E), UINT64_C (0x10548B68A044D673)},
+  {UINT64_C (0x84FE005AFF2BA032), UINT64_C (0x1469AE42C8560C10)},
+  {UINT64_C (0xA63D8071BEF6883E), UINT64_C (0x198419D37A6B8F14)},
+  {UINT64_C (0xCFCCE08E2EB42A4E), UINT64_C (0x1FE52048590672D9)},
+  {UINT64_C (0x21E00C58DD309A70), UINT64_C (0x13EF342D37A407C8)},
+  {UINT64_C (0x2A580F6F147CC10D), UINT64_C (0x18EB0138858D09BA)},
+  {UINT64_C (0xB4EE134AD99BF150), UINT64_C (0x1F25C186A6F04C28)},
+  {UINT64_C (0x7114CC0EC80176D2), UINT64_C (0x137798F428562F99)},
+  {UINT64_C (0xCD59FF127A01D486), UINT64_C (0x18557F31326BBB7F)},
+  {UINT64_C (0xC0B07ED7188249A8), UINT64_C (0x1E6ADEFD7F06AA5F)},
+  {UINT64_C (0xD86E4F466F516E09), UINT64_C (0x1302CB5E6F642A7B)},
+  {UINT64_C (0xCE89E3180B25C98B), UINT64_C (0x17C37E360B3D351A)},
+  {UINT64_C (0x822C5BDE0DEF3BEE), UINT64_C (0x1DB45DC38E0C8261)},
+  {UINT64_C (0xF15BB96AC8B58575), UINT64_C (0x1290BA9A38C7D17C)},
+  {UINT64_C (0x2DB2A7C57AE2E6D2), UINT64_C (0x1734E940C6F9C5DC)},
+  {UINT64_C (0x391F51B6D99BA086), UINT64_C (0x1D022390F8B83753)},
+  {UINT64_C (0x03B3931248014454), UINT64_C (0x1221563A9B732294)},
+  {UINT64_C (0x04A077D6DA019569), UINT64_C (0x16A9ABC9424FEB39)},
+  {UINT64_C (0x45C895CC9081FAC3), UINT64_C (0x1C5416BB92E3E607)},
+  {UINT64_C (0x8B9D5D9FDA513CBA), UINT64_C (0x11B48E353BCE6FC4)},
+  {UINT64_C (0xAE84B507D0E58BE8), UINT64_C (0x1621B1C28AC20BB5)},
+  {UINT64_C (0x1A25E249C51EEEE3), UINT64_C (0x1BAA1E332D728EA3)},
+  {UINT64_C (0xF057AD6E1B33554D), UINT64_C (0x114A52DFFC679925)},
+  {UINT64_C (0x6C6D98C9A2002AA1), UINT64_C (0x159CE797FB817F6F)},
+  {UINT64_C (0x4788FEFC0A803549), UINT64_C (0x1B04217DFA61DF4B)},
+  {UINT64_C (0x0CB59F5D8690214E), UINT64_C (0x10E294EEBC7D2B8F)},
+  {UINT64_C (0xCFE30734E83429A1), UINT64_C (0x151B3A2A6B9C7672)},
+  {UINT64_C (0x83DBC9022241340A), UINT64_C (0x1A6208B50683940F)},
+  {UINT64_C (0xB2695DA15568C086), UINT64_C (0x107D457124123C89)},
+  {UINT64_C (0x1F03B509AAC2F0A7), UINT64_C (0x149C96CD6D16CBAC)},
+  {UINT64_C (0x26C4A24C1573ACD1), UINT64_C (0x19C3BC80C85C7E97)},
+  {UINT64_C (0x783AE56F8D684C03), UINT64_C (0x101A55D07D39CF1E)},
+  {UINT64_C (0x16499ECB70C25F03), UINT64_C (0x1420EB449C8842E6)},
+  {UINT64_C (0x9BDC067E4CF2F6C4), UINT64_C (0x19292615C3AA539F)},
+  {UINT64_C (0x82D3081DE02FB476), UINT64_C (0x1F736F9B3494E887)},
+  {UINT64_C (0xB1C3E512AC1DD0C9), UINT64_C (0x13A825C100DD1154)},
+  {UINT64_C (0xDE34DE57572544FC), UINT64_C (0x18922F31411455A9)},
+  {UINT64_C (0x55C215ED2CEE963B), UINT64_C (0x1EB6BAFD91596B14)},
+  {UINT64_C (0xB5994DB43C151DE5), UINT64_C (0x133234DE7AD7E2EC)},
+  {UINT64_C (0xE2FFA1214B1A655E), UINT64_C (0x17FEC216198DDBA7)},
+  {UINT64_C (0xDBBF89699DE0FEB6), UINT64_C (0x1DFE729B9FF15291)},
+  {UINT64_C (0x2957B5E202AC9F31), UINT64_C (0x12BF07A143F6D39B)},
+  {UINT64_C (0xF3ADA35A8357C6FE), UINT64_C (0x176EC98994F48881)},
+  {UINT64_C (0x70990C31242DB8BD), UINT64_C (0x1D4A7BEBFA31AAA2)},
+  {UINT64_C (0x865FA79EB69C9376), UINT64_C (0x124E8D737C5F0AA5)},
+  {UINT64_C (0xE7F791866443B854), UINT64_C (0x16E230D05B76CD4E)},
+  {UINT64_C (0xA1F575E7FD54A669), UINT64_C (0x1C9ABD04725480A2)},
+  {UINT64_C (0xA53969B0FE54E801), UINT64_C (0x11E0B622C774D065)},
+  {UINT64_C (0x0E87C41D3DEA2202), UINT64_C (0x1658E3AB7952047F)},
+  {UINT64_C (0xD229B5248D64AA82), UINT64_C (0x1BEF1C9657A6859E)},
+  {UINT64_C (0x435A1136D85EEA91), UINT64_C (0x117571DDF6C81383)},
+  {UINT64_C (0x143095848E76A536), UINT64_C (0x15D2CE55747A1864)},
+  {UINT64_C (0x193CBAE5B2144E83), UINT64_C (0x1B4781EAD1989E7D)},
+  {UINT64_C (0x2FC5F4CF8F4CB112), UINT64_C (0x110CB132C2FF630E)},
+  {UINT64_C (0xBBB77203731FDD56), UINT64_C (0x154FDD7F73BF3BD1)},
+  {UINT64_C (0x2AA54E844FE7D4AC), UINT64_C (0x1AA3D4DF50AF0AC6)},
+  {UINT64_C (0xDAA75112B1F0E4EB), UINT64_C (0x10A6650B926D66BB)},
+  {UINT64_C (0xD15125575E6D1E26), UINT64_C (0x14CFFE4E7708C06A)},
+  {UINT64_C (0x85A56EAD360865B0), UINT64_C (0x1A03FDE214CAF085)},
+  {UINT64_C (0x7387652C41C53F8E), UINT64_C (0x10427EAD4CFED653)},
+  {UINT64_C (0x50693E7752368F71), UINT64_C (0x14531E58A03E8BE8)},
+  {UINT64_C (0x64838E1526C4334E), UINT64_C (0x1967E5EEC84E2EE2)},
+  {UINT64_C (0xFDA4719A70754022), UINT64_C (0x1FC1DF6A7A61BA9A)},
+  {UINT64_C (0xDE86C70086494815), UINT64_C (0x13D92BA28C7D14A0)},
+  {UINT64_C (0x162878C0A7DB9A1A), UINT64_C (0x18CF768B2F9C59C9)},
+  {UINT64_C (0x5BB296F0D1D280A1), UINT64_C (0x1F03542DFB83703B)},
+  {UINT64_C (0x194F9E5683239064), UINT64_C (0x1362149CBD322625)},
+  {UINT64_C (0x5FA385EC23EC747E), UINT64_C (0x183A99C3EC7EAFAE)},
+  {UINT64_C (0xF78C67672CE7919D), UINT64_C (0x1E494034E79E5B99)},
+  {UINT64_C (0x3AB7C0A07C10BB02), UINT64_C (0x12EDC82110C2F940)},
+  {UINT64_C (0x4965B0C89B14E9C3), UINT64_C (0x17A93A2954F3B790)},
+  {UINT64_C (0x5BBF1CFAC1DA2433), UINT64_C (0x1D9388B3AA30A574)},
+  {UINT64_C (0xB957721CB92856A0), UINT64_C (0x127C35704A5E6768)},
+  {UINT64_C (0xE7AD4EA3E7726C48), UINT64_C (0x171B42CC5CF60142)},
+  {UINT64_C (0xA198A24CE14F075A), UINT64_C (0x1CE2137F74338193)},
+  {UINT64_C (0x44FF65700CD16498), UINT64_C (0x120D4C2FA8A030FC)},
+  {UINT64_C (0x563F3ECC1005BDBE), UINT64_C (0x16909F3B92C83D3B)},
+  {UINT64_C (0x2BCF0E7F14072D2E), UINT64_C (0x1C34C70A777A4C8A)},
+  {UINT64_C (0x5B61690F6C847C3D), UINT64_C (0x11A0FC668AAC6FD6)},
+  {UINT64_C (0xF239C35347A59B4C), UINT64_C (0x16093B802D578BCB)},
+  {UINT64_C (0xEEC83428198F021F), UINT64_C (0x1B8B8A6038AD6EBE)},
+  {UINT64_C (0x553D20990FF96153), UINT64_C (0x1137367C236C6537)},
+  {UINT64_C (0x2A8C68BF53F7B9A8), UINT64_C (0x1585041B2C477E85)},
+  {UINT64_C (0x752F82EF28F5A812), UINT64_C (0x1AE64521F7595E26)},
+  {UINT64_C (0x093DB1D57999890B), UINT64_C (0x10CFEB353A97DAD8)},
+  {UINT64_C (0x0B8D1E4AD7FFEB4E), UINT64_C (0x1503E602893DD18E)},
+  {UINT64_C (0x8E7065DD8DFFE622), UINT64_C (0x1A44DF832B8D45F1)},
+  {UINT64_C (0xF9063FAA78BFEFD5), UINT64_C (0x106B0BB1FB384BB6)},
+  {UINT64_C (0xB747CF9516EFEBCA), UINT64_C (0x1485CE9E7A065EA4)},
+  {UINT64_C (0xE519C37A5CABE6BD), UINT64_C (0x19A742461887F64D)},
+  {UINT64_C (0xAF301A2C79EB7036), UINT64_C (0x1008896BCF54F9F0)},
+  {UINT64_C (0xDAFC20B798664C43), UINT64_C (0x140AABC6C32A386C)},
+  {UINT64_C (0x11BB28E57E7FDF54), UINT64_C (0x190D56B873F4C688)},
+  {UINT64_C (0x1629F31EDE1FD72A), UINT64_C (0x1F50AC6690F1F82A)},
+  {UINT64_C (0x4DDA37F34AD3E67A), UINT64_C (0x13926BC01A973B1A)},
+  {UINT64_C (0xE150C5F01D88E019), UINT64_C (0x187706B0213D09E0)},
+  {UINT64_C (0x19A4F76C24EB181F), UINT64_C (0x1E94C85C298C4C59)},
+  {UINT64_C (0xB0071AA39712EF13), UINT64_C (0x131CFD3999F7AFB7)},
+  {UINT64_C (0x9C08E14C7CD7AAD8), UINT64_C (0x17E43C8800759BA5)},
+  {UINT64_C (0x030B199F9C0D958E), UINT64_C (0x1DDD4BAA0093028F)},
+  {UINT64_C (0x61E6F003C1887D79), UINT64_C (0x12AA4F4A405BE199)},
+  {UINT64_C (0xBA60AC04B1EA9CD7), UINT64_C (0x1754E31CD072D9FF)},
+  {UINT64_C (0xA8F8D705DE65440D), UINT64_C (0x1D2A1BE4048F907F)},
+  {UINT64_C (0xC99B8663AAFF4A88), UINT64_C (0x123A516E82D9BA4F)},
+  {UINT64_C (0xBC0267FC95BF1D2A), UINT64_C (0x16C8E5CA239028E3)},
+  {UINT64_C (0xAB0301FBBB2EE474), UINT64_C (0x1C7B1F3CAC74331C)},
+  {UINT64_C (0xEAE1E13D54FD4EC9), UINT64_C (0x11CCF385EBC89FF1)},
+  {UINT64_C (0x659A598CAA3CA27B), UINT64_C (0x1640306766BAC7EE)},
+  {UINT64_C (0xFF00EFEFD4CBCB1A), UINT64_C (0x1BD03C81406979E9)},
+  {UINT64_C (0x3F6095F5E4FF5EF0), UINT64_C (0x116225D0C841EC32)},
+  {UINT64_C (0xCF38BB735E3F36AC), UINT64_C (0x15BAAF44FA52673E)},
+  {UINT64_C (0x8306EA5035CF0457), UINT64_C (0x1B295B1638E7010E)},
+  {UINT64_C (0x11E4527221A162B6), UINT64_C (0x10F9D8EDE39060A9)},
+  {UINT64_C (0x565D670EAA09BB64), UINT64_C (0x15384F295C7478D3)},
+  {UINT64_C (0x2BF4C0D2548C2A3D), UINT64_C (0x1A8662F3B3919708)},
+  {UINT64_C (0x1B78F88374D79A66), UINT64_C (0x1093FDD8503AFE65)},
+  {UINT64_C (0x625736A4520D8100), UINT64_C (0x14B8FD4E6449BDFE)},
+  {UINT64_C (0xFAED044D6690E140), UINT64_C (0x19E73CA1FD5C2D7D)},
+  {UINT64_C (0xBCD422B0601A8CC8), UINT64_C (0x103085E53E599C6E)},
+  {UINT64_C (0x6C092B5C78212FFA), UINT64_C (0x143CA75E8DF0038A)},
+  {UINT64_C (0x070B763396297BF8), UINT64_C (0x194BD136316C046D)},
+  {UINT64_C (0x48CE53C07BB3DAF6), UINT64_C (0x1F9EC583BDC70588)},
+  {UINT64_C (0x2D80F4584D5068DA), UINT64_C (0x13C33B72569C6375)},
+  {UINT64_C (0x78E1316E60A48310), UINT64_C (0x18B40A4EEC437C52)},
+};
+
+/* Return (m * mul) >> j. mul is a 128 bit value (low, high) */
+static ALWAYS_INLINE uint64_t
+fast_json_mul_shift (uint64_t m, const uint64_t * mul, int j)
+{
+  uint64_t low0;
+  uint64_t low1;
+  uint64_t high0 = fast_json_mul128 (m, mul[0], &low0);
+  uint64_t high1 = fast_json_mul128 (m, mul[1], &low1);
+  uint64_t sum = high0 + low1;
+
+  if (sum < high0) {
+    high1++;
+  }
+  j -= 64;
+  return (high1 << (64 - j)) | (sum >> j);
+}
+
+static ALWAYS_INLINE unsigned int
+fast_json_pow5_factor (uint64_t value)
+{
+  unsigned int count = 0;
+
+  while (value % 5 == 0) {
+    value /= 5;
+    count++;
+  }
+  return count;
+}
+
+/* Ryu: find the shortest decimal mantissa * 10^exp10 that converts back
+ * to the double with the given ieee mantissa and exponent.
+ */
+static uint64_t
+fast_json_ryu (uint64_t ieee_mantissa, unsigned int ieee_exponent,
+	       int *exp10)
+{
+  unsigned int even;
+  unsigned int mm_shift;
+  unsigned int vm_trailing_zeros = 0;
+  unsigned int vr_trailing_zeros = 0;
+  unsigned int last_removed_digit = 0;
+  uint64_t m2;
+  uint64_t mv;
+  uint64_t vr;
+  uint64_t vp;
+  uint64_t vm;
+  int removed = 0;
+  int e2;
+
+  if (ieee_exponent == 0) {
+    e2 = 1 - 1023 - 52 - 2;
+    m2 = ieee_mantissa;
+  }
+  else {
+    e2 = (int) ieee_exponent - 1023 - 52 - 2;
+    m2 = (UINT64_C (1) << 52) | ieee_mantissa;
+  }
+  even = (m2 & 1) == 0;
+  mv = 4 * m2;
+  mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+  /* Calculate vr, vp and vm: the value and the bounds of the rounding
+   * interval times a power of 10.
+   */
+  if (e2 >= 0) {
+    unsigned int q = ((e2 * 78913) >> 18) - (e2 > 3);
+    int k = 125 + (int) ((q * 1217359) >> 19) + 1 - 1;
+    int i = -e2 + (int) q + k;
+    const uint64_t *mul = fast_json_pow5_inv_split[q];
+
+    *exp10 = (int) q;
+    vr = fast_json_mul_shift (4 * m2, mul, i);
+    vp = fast_json_mul_shift (4 * m2 + 2, mul, i);
+    vm = fast_json_mul_shift (4 * m2 - 1 - mm_shift, mul, i);
+    if (q <= 21) {
+      if (mv % 5 == 0) {
+	vr_trailing_zeros = fast_json_pow5_factor (mv) >= q;
+      }
+      else if (even) {
+	vm_trailing_zeros = fast_json_pow5_factor (mv - 1 - mm_shift) >= q;
+      }
+      else {
+	vp -= fast_json_pow5_factor (mv + 2) >= q;
+      }
+    }
+  }
+  else {
+    unsigned int q = ((-e2 * 732923) >> 20) - (-e2 > 1);
+    int i = -e2 - (int) q;
+    int k = (int) ((i * 1217359) >> 19) + 1 - 125;
+    int j = (int) q - k;
+    const uint64_t *mul = fast_json_pow5_split[i];
+
+    *exp10 = (int) q + e2;
+    vr = fast_json_mul_shift (4 * m2, mul, j);
+    vp = fast_json_mul_shift (4 * m2 + 2, mul, j);
+    vm = fast_json_mul_shift (4 * m2 - 1 - mm_shift, mul, j);
+    if (q <= 1) {
+      vr_trailing_zeros = 1;
+      if (even) {
+	vm_trailing_zeros = mm_shift == 1;
+      }
+      else {
+	vp--;
+      }
+    }
+    else if (q < 63) {
+      vr_trailing_zeros = (mv & ((UINT64_C (1) << q) - 1)) == 0;
+    }
+  }
+
+  /* Remove digits while vp and vm differ */
+  if (vm_trailing_zeros || vr_trailing_zeros) {
+    while (vp / 10 > vm / 10) {
+      vm_trailing_zeros &= vm % 10 == 0;
+      vr_trailing_zeros &= last_removed_digit == 0;
+      last_removed_digit = (unsigned int) (vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      removed++;
+    }
+    if (vm_trailing_zeros) {
+      while (vm % 10 == 0) {
+	vr_trailing_zeros &= last_removed_digit == 0;
+	last_removed_digit = (unsigned int) (vr % 10);
+	vr /= 10;
+	vp /= 10;
+	vm /= 10;
+	removed++;
+      }
+    }
+    if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+      /* Round to even */
+      last_removed_digit = 4;
+    }
+    vr += (vr == vm && (!even || !vm_trailing_zeros)) ||
+      last_removed_digit >= 5;
+  }
+  else {
+    unsigned int round_up = 0;
+
+    if (vp / 100 > vm / 100) {
+      round_up = vr % 100 >= 50;
+      vr /= 100;
+      vp /= 100;
+      vm /= 100;
+      removed += 2;
+    }
+    while (vp / 10 > vm / 10) {
+      round_up = vr % 10 >= 5;
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      removed++;
+    }
+    vr += vr == vm || round_up;
+  }
+  *exp10 += removed;
+  return vr;
+}
+
+static const char fast_json_digit_pairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+static ALWAYS_INLINE unsigned int
+fast_json_ndigits (uint64_t u)
+{
+  unsigned int n = 1;
+
+  for (;;) {
+    if (u < 10) {
+      return n;
+    }
+    if (u < 100) {
+      return n + 1;
+    }
+    if (u < 1000) {
+      return n + 2;
+    }
+    if (u < 10000) {
+      return n + 3;
+    }
+    u /= 10000;
+    n += 4;
+  }
+}
+
+/* Print a signed 64 bits integer in buf. At most FAST_JSON_INT_SIZE
+ * characters are written. No '\0' is added. Returns the length.
+ */
+static ALWAYS_INLINE unsigned int
+fast_json_itoa (fast_json_int_64 value, char *buf)
+{
+  uint64_t u = value;
+  unsigned int sign = (unsigned int) (u >> 63);
+  unsigned int n;
+  char *cp;
+
+  if (sign) {
+    *buf++ = '-';
+    u = 0 - u;
+  }
+  n = fast_json_ndigits (u);
+  cp = buf + n;
+  while (u >= 100) {
+    unsigned int i = (unsigned int) (u % 100) * 2;
+
+    u /= 100;
+    *--cp = fast_json_digit_pairs[i + 1];
+    *--cp = fast_json_digit_pairs[i];
+  }
+  if (u >= 10) {
+    *--cp = fast_json_digit_pairs[u * 2 + 1];
+    *--cp = fast_json_digit_pairs[u * 2];
+  }
+  else {
+    *--cp = (char) ('0' + u);
+  }
+  return sign + n;
+}
+
+/* Print the shortest representation of d that reads back as d. The layout
+ * is the same as "%.17g" and a ".0" is added to integral values.
+ */
+static unsigned int
+fast_json_dtoa (double d, char *buf)
+{
+  union
+  {
+    uint64_t u;
+    double d;
+  } td;
+  uint64_t ieee_mantissa;
+  unsigned int ieee_exponent;
+  uint64_t output;
+  char digits[20];
+  char *cp = buf;
+  int ndigits;
+  int exp10;
+  int i;
+
+  td.d = d;
+  ieee_mantissa = td.u & UINT64_C (0x000FFFFFFFFFFFFF);
+  ieee_exponent = (unsigned int) (td.u >> 52) & 0x7FF;
+  if (td.u >> 63) {
+    *cp++ = '-';
+  }
+  if (ieee_exponent == 0x7FF) {
+    memcpy (cp, ieee_mantissa ? "nan" : "inf", 4);
+    return (unsigned int) (cp - buf) + 3;
+  }
+  if (ieee_exponent == 0 && ieee_mantissa == 0) {
+    memcpy (cp, "0.0", 4);
+    return (unsigned int) (cp - buf) + 3;
+  }
+  output = fast_json_ryu (ieee_mantissa, ieee_exponent, &exp10);
+  ndigits = 0;
+  do {
+    digits[ndigits++] = (char) ('0' + output % 10);
+    output /= 10;
+  } while (output);
+  /* Decimal exponent of the first digit */
+  exp10 += ndigits - 1;
+  if (exp10 < -4 || exp10 >= 17) {
+    *cp++ = digits[--ndigits];
+    if (ndigits) {
+      *cp++ = '.';
+      while (ndigits) {
+	*cp++ = digits[--ndigits];
+      }
+    }
+    *cp++ = 'e';
+    if (exp10 < 0) {
+      *cp++ = '-';
+      exp10 = -exp10;
+    }
+    else {
+      *cp++ = '+';
+    }
+    if (exp10 >= 100) {
+      *cp++ = (char) ('0' + exp10 / 100);
+      exp10 %= 100;
+    }
+    *cp++ = (char) ('0' + exp10 / 10);
+    *cp++ = (char) ('0' + exp10 % 10);
+  }
+  else if (exp10 < 0) {
+    *cp++ = '0';
+    *cp++ = '.';
+    for (i = -1; i > exp10; i--) {
+      *cp++ = '0';
+    }
+    while (ndigits) {
+      *cp++ = digits[--ndigits];
+    }
+  }
+  else {
+    for (i = 0; i <= exp10; i++) {
+      *cp++ = ndigits ? digits[--ndigits] : '0';
+    }
+    *cp++ = '.';
+    if (ndigits) {
+      while (ndigits) {
+	*cp++ = digits[--ndigits];
+      }
+    }
+    else {
+      *cp++ = '0';
+    }
+  }
+  *cp = '\0';
+  return (unsigned int) (cp - buf);
+}
+
+#if FAST_JSON_SIMD
+/* Copy the bytes from ptr that need no checking to out and return the
+ * number of bytes copied. A byte needs checking if it is a control
+ * character, '"', '\'', '\\' or a byte >= 0x80. Complete vectors are stored
+ * so out must have room for end - ptr bytes. If out is NULL only the
+ * number of bytes is returned.
+ */
+static size_t
+fast_json_copy_plain_sse2 (const char *ptr, const char *end, char *out)
+{
+  const __m128i space = _mm_set1_epi8 (' ');
+  const __m128i quote = _mm_set1_epi8 ('"');
+  const __m128i squote = _mm_set1_epi8 ('\'');
+  const __m128i bs = _mm_set1_epi8 ('\\');
+  const char *start = ptr;
+
+  while (end - ptr >= 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) ptr);
+    __m128i s = _mm_or_si128 (_mm_or_si128 (_mm_cmplt_epi8 (v, space),
+					    _mm_cmpeq_epi8 (v, quote)),
+			      _mm_or_si128 (_mm_cmpeq_epi8 (v, squote),
+					    _mm_cmpeq_epi8 (v, bs)));
+    unsigned int m = _mm_movemask_epi8 (s);
+
+    if (out) {
+      _mm_storeu_si128 ((__m128i *) (out + (ptr - start)), v);
+    }
+    if (m) {
+      return (ptr - start) + __builtin_ctz (m);
+    }
+    ptr += 16;
+  }
+  return ptr - start;
+}
+
+__attribute ((target ("avx2")))
+static size_t
+fast_json_copy_plain_avx2 (const char *ptr, const char *end, char *out)
+{
+  const __m256i space = _mm256_set1_epi8 (' ');
+  const __m256i quote = _mm256_set1_epi8 ('"');
+  const __m256i squote = _mm256_set1_epi8 ('\'');
+  const __m256i bs = _mm256_set1_epi8 ('\\');
+  const char *start = ptr;
+
+  while (end - ptr >= 32) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) ptr);
+    __m256i s =
+      _mm256_or_si256 (_mm256_or_si256 (_mm256_cmpgt_epi8 (space, v),
+					_mm256_cmpeq_epi8 (v, quote)),
+		       _mm256_or_si256 (_mm256_cmpeq_epi8 (v, squote),
+					_mm256_cmpeq_epi8 (v, bs)));
+    unsigned int m = _mm256_movemask_epi8 (s);
+
+    if (out) {
+      _mm256_storeu_si256 ((__m256i *) (out + (ptr - start)), v);
+    }
+    if (m) {
+      return (ptr - start) + __builtin_ctz (m);
+    }
+    ptr += 32;
+  }
+  return (ptr - start) +
+    fast_json_copy_plain_sse2 (ptr, end, out ? out + (ptr - start) : NULL);
+}
+
+/* Return the number of bytes from ptr that can be printed as they are. A
+ * byte must be escaped if it is a control character or '/'. If escape is
+ * set bytes >= 0x80 are printed as unicode escapes.
+ */
+static size_t
+fast_json_print_plain_sse2 (const char *ptr, const char *end,
+			    unsigned int escape)
+{
+  const __m128i space = _mm_set1_epi8 (' ');
+  const __m128i slash = _mm_set1_epi8 ('/');
+  const char *start = ptr;
+
+  while (end - ptr >= 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) ptr);
+    unsigned int m =
+      _mm_movemask_epi8 (_mm_or_si128 (_mm_cmplt_epi8 (v, space),
+				       _mm_cmpeq_epi8 (v, slash)));
+
+    if (escape == 0) {
+      m &= ~_mm_movemask_epi8 (v);
+    }
+    if (m) {
+      return (ptr - start) + __builtin_ctz (m);
+    }
+    ptr += 16;
+  }
+  return ptr - start;
+}
+
+/* Validate the utf8 of a 32 byte block. prev is the block before it.
+ * Returns non zero bytes for errors. Sequences that continue in the
+ * next block are not checked.
+ */
+__attribute ((target ("avx2")))
+static __m256i
+fast_json_utf8_block_avx2 (__m256i v, __m256i prev)
+{
+  static const char byte_1_high[16] = {
+    FAST_JSON_UTF8_TOO_LONG, FAST_JSON_UTF8_TOO_LONG,
+    FAST_JSON_UTF8_TOO_LONG, FAST_JSON_UTF8_TOO_LONG,
+    FAST_JSON_UTF8_TOO_LONG, FAST_JSON_UTF8_TOO_LONG,
+    FAST_JSON_UTF8_TOO_LONG, FAST_JSON_UTF8_TOO_LONG,
+    (char) FAST_JSON_UTF8_TWO_CONTS, (char) FAST_JSON_UTF8_TWO_CONTS,
+    (char) FAST_JSON_UTF8_TWO_CONTS, (char) FAST_JSON_UTF8_TWO_CONTS,
+    FAST_JSON_UTF8_TOO_SHORT | FAST_JSON_UTF8_OVERLONG_2,
+    FAST_JSON_UTF8_TOO_SHORT,
+    FAST_JSON_UTF8_TOO_SHORT | FAST_JSON_UTF8_OVERLONG_3 |
+      FAST_JSON_UTF8_SURROGATE,
+    FAST_JSON_UTF8_TOO_SHORT | FAST_JSON_UTF8_TOO_LARGE |
+      FAST_JSON_UTF8_TOO_LARGE_1000 | FAST_JSON_UTF8_OVERLONG_4
+  };
+  static const char byte_1_low[16] = {
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_OVERLONG_3 |
+	    FAST_JSON_UTF8_OVERLONG_2 | FAST_JSON_UTF8_OVERLONG_4),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_OVERLONG_2),
+    (char) FAST_JSON_UTF8_CARRY, (char) FAST_JSON_UTF8_CARRY,
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000 | FAST_JSON_UTF8_SURROGATE),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000),
+    (char) (FAST_JSON_UTF8_CARRY | FAST_JSON_UTF8_TOO_LARGE |
+	    FAST_JSON_UTF8_TOO_LARGE_1000)
+  };
+  static const char byte_2_high[16] = {
+    FAST_JSON_UTF8_TOO_SHORT, FAST_JSON_UTF8_TOO_SHORT,
+    FAST_JSON_UTF8_TOO_SHORT, FAST_JSON_UTF8_TOO_SHORT,
+    FAST_JSON_UTF8_TOO_SHORT, FAST_JSON_UTF8_TOO_SHORT,
+    FAST_JSON_UTF8_TOO_SHORT, FAST_JSON_UTF8_TOO_SHORT,
+    (char) (FAST_JSON_UTF8_TOO_LONG | FAST_JSON_UTF8_OVERLONG_2 |
+	    FAST_JSON_UTF8_TWO_CONTS | FAST_JSON_UTF8_OVERLONG_3 |
+	    FAST_JSON_UTF8_TOO_LARGE_1000 | FAST_JSON_UTF8_OVERLONG_4),
+    (char) (FAST_JSON_UTF8_TOO_LONG | FAST_JSON_UTF8_OVERLONG_2 |
+	    FAST_JSON_UTF8_TWO_CONTS | FAST_JSON_UTF8_OVERLONG_3 |
+	    FAST_JSON_UTF8_TOO_LARGE),
+    (char) (FAST_JSON_UTF8_TOO_LONG | FAST_JSON_UTF8_OVERLONG_2 |
+	    FAST_JSON_UTF8_TWO_CONTS | FAST_JSON_UTF8_SURROGATE |
+	    FAST_JSON_UTF8_TOO_LARGE),
+    (char) (FAST_JSON_UTF8_TOO_LONG | FAST_JSON_UTF8_OVERLONG_2 |
+	    FAST_JSON_UTF8_TWO_CONTS | FAST_JSON_UTF8_SURROGATE |
+	    FAST_JSON_UTF8_TOO_LARGE),
+    FAST_JSON_UTF8_TOO_SHORT, FAST_JSON_UTF8_TOO_SHORT,
+    FAST_JSON_UTF8_TOO_SHORT, FAST_JSON_UTF8_TOO_SHORT
+  };
+  const __m256i nibble = _mm256_set1_epi8 (0x0F);
+  __m256i shift = _mm256_permute2x128_si256 (prev, v, 0x21);
+  __m256i prev1 = _mm256_alignr_epi8 (v, shift, 15);
+  __m256i prev2 = _mm256_alignr_epi8 (v, shift, 14);
+  __m256i prev3 = _mm256_alignr_epi8 (v, shift, 13);
+  __m256i t1 = _mm256_broadcastsi128_si256 (_mm_loadu_si128
+					    ((const __m128i *) byte_1_high));
+  __m256i t2 = _mm256_broadcastsi128_si256 (_mm_loadu_si128
+					    ((const __m128i *) byte_1_low));
+  __m256i t3 = _mm256_broadcastsi128_si256 (_mm_loadu_si128
+					    ((const __m128i *) byte_2_high));
+  __m256i special;
+  __m256i must23;
+
+  special = _mm256_and_si256
+    (_mm256_and_si256
+     (_mm256_shuffle_epi8
+      (t1, _mm256_and_si256 (_mm256_srli_epi16 (prev1, 4), nibble)),
+      _mm256_shuffle_epi8 (t2, _mm256_and_si256 (prev1, nibble))),
+     _mm256_shuffle_epi8
+     (t3, _mm256_and_si256 (_mm256_srli_epi16 (v, 4), nibble)));
+  /* The third and fourth bytes of a sequence must be continuations */
+  must23 = _mm256_or_si256 (_mm256_subs_epu8 (prev2,
+					      _mm256_set1_epi8 (0xE0 - 0x80)),
+			    _mm256_subs_epu8 (prev3,
+					      _mm256_set1_epi8 (0xF0 - 0x80)));
+  must23 = _mm256_and_si256 (must23, _mm256_set1_epi8 ((char) 0x80));
+  return _mm256_xor_si256 (must23, special);
+}
+
+/* Validate and copy the utf8 and the bytes that need no checking from ptr
+ * to out in blocks of 32 bytes. Returns the number of bytes copied. Copying
+ * stops before a control character, '"', '\'' or '\\' and never inside a
+ * utf8 sequence. If a block has a utf8 error the bytes before it are
+ * returned so the caller finds the error. If out is NULL only the number
+ * of bytes is returned.
+ */
+__attribute ((target ("avx2")))
+static size_t
+fast_json_copy_utf8_avx2 (const char *ptr, const char *end, char *out)
+{
+  const __m256i control = _mm256_set1_epi8 (0x1F);
+  const __m256i quote = _mm256_set1_epi8 ('"');
+  const __m256i squote = _mm256_set1_epi8 ('\'');
+  const __m256i bs = _mm256_set1_epi8 ('\\');
+  const __m256i index = _mm256_setr_epi8 (0, 1, 2, 3, 4, 5, 6, 7, 8, 9,
+					  10, 11, 12, 13, 14, 15, 16, 17,
+					  18, 19, 20, 21, 22, 23, 24, 25,
+					  26, 27, 28, 29, 30, 31);
+  __m256i prev = _mm256_setzero_si256 ();
+  const char *start = ptr;
+  size_t n;
+  size_t i;
+
+  while (end - ptr >= 32) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) ptr);
+    __m256i s =
+      _mm256_or_si256 (_mm256_or_si256
+		       (_mm256_cmpeq_epi8 (_mm256_min_epu8 (v, control), v),
+			_mm256_cmpeq_epi8 (v, quote)),
+		       _mm256_or_si256 (_mm256_cmpeq_epi8 (v, squote),
+					_mm256_cmpeq_epi8 (v, bs)));
+    unsigned int m = _mm256_movemask_epi8 (s);
+    unsigned int len = 32;
+    __m256i error;
+
+    if (m) {
+      /* The bytes from the special character on are seen as ascii, so a
+       * sequence that ends there is an error.
+       */
+      len = __builtin_ctz (m);
+      v = _mm256_and_si256 (v, _mm256_cmpgt_epi8 (_mm256_set1_epi8 (len),
+						  index));
+    }
+    error = fast_json_utf8_block_avx2 (v, prev);
+    if (!_mm256_testz_si256 (error, error)) {
+      break;
+    }
+    if (out) {
+      _mm256_storeu_si256 ((__m256i *) (out + (ptr - start)), v);
+    }
+    if (len != 32) {
+      return (ptr - start) + len;
+    }
+    prev = v;
+    ptr += 32;
+  }
+
+  /* Do not stop inside a sequence */
+  n = ptr - start;
+  for (i = 1; i <= 3 && i <= n; i++) {
+    unsigned char u = start[n - i];
+
+    if ((u & 0xC0u) != 0x80u) {
+      if ((u >= 0xF0u && i < 4) || (u >= 0xE0u && i < 3) ||
+	  (u >= 0xC0u && i < 2)) {
+	n -= i;
+      }
+      break;
+    }
+  }
+  return n;
+}
+#endif
+
+static FAST_JSON_ERROR_ENUM
+fast_json_string_grow (FAST_JSON_TYPE json)
+{
+  size_t new_max =
+    json->max_string ? json->max_string * 2 : FAST_JSON_BUFFER_SIZE;
+  char *new_string;
+
+  new_string = (char *) json->my_realloc (json->string, new_max);
+  if (new_string == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    return FAST_JSON_MALLOC_ERROR;
+  }
+  json->max_string = new_max;
+  json->string = new_string;
+  return FAST_JSON_OK;
+}
+
+/* Move the part of a string that is decoded in place to json->string when
+ * the decoded text would get ahead of the input. This only happens for
+ * some json5 strings. *ptr2 and *limit are set for json->string.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_insitu_move (FAST_JSON_TYPE json, char **ptr2, char **limit)
+{
+  size_t n = *ptr2 - json->insitu_string;
+
+  while (json->max_string < n + FAST_JSON_STRING_SLACK + 1) {
+    if (fast_json_string_grow (json) != FAST_JSON_OK) {
+      return json->error;
+    }
+  }
+  memcpy (json->string, json->insitu_string, n);
+  json->insitu_string = NULL;
+  *ptr2 = json->string + n;
+  *limit = json->string + json->max_string - FAST_JSON_STRING_SLACK;
+  return FAST_JSON_OK;
+}
+
+/* Validate, unescape and copy the string at *buf to json->string in one
+ * pass. Decoding stops at end or at an unescaped sep. *buf is set to the
+ * position where decoding stopped. For fast_json_parse_insitu the string
+ * is decoded in place to json->insitu_string, one byte before *buf. The
+ * output stays behind the input, so the terminating 0 does not overwrite
+ * the end of the string. If that is not possible json->insitu_string is
+ * set to NULL and the string is in json->string.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_check_string (FAST_JSON_TYPE json, const char **buf,
+			const char *end, int sep)
+{
+  const char *ptr;
+  const char *save_ptr;
+  char *ptr2;
+  char *limit;
+  unsigned int uc;
+  unsigned int insitu = json->insitu;
+
+  ptr = *buf;
+  if (insitu) {
+    ptr2 = json->insitu_string = (char *) ptr - 1;
+    limit = (char *) end;
+  }
+  else {
+    if (UNLIKELY (json->max_string == 0)) {
+      if (fast_json_string_grow (json) != FAST_JSON_OK) {
+	return json->error;
+      }
+    }
+    ptr2 = json->string;
+    limit = json->string + json->max_string - FAST_JSON_STRING_SLACK;
+  }
+  while (ptr < end) {
+    static const char special1[256] = {
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      0, 0, '"', 0, 0, 0, 0, '\'', 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+    };
+    if (UNLIKELY (ptr2 >= limit)) {
+      size_t n = ptr2 - json->string;
+
+      if (fast_json_string_grow (json) != FAST_JSON_OK) {
+	return json->error;
+      }
+      ptr2 = json->string + n;
+      limit = json->string + json->max_string - FAST_JSON_STRING_SLACK;
+    }
+    if (LIKELY (special1[*ptr & 0xFFu] == 0)) {
+#if FAST_JSON_SIMD
+      if (end - ptr >= 16) {
+	size_t n = (limit + FAST_JSON_STRING_SLACK) - ptr2;
+	const char *e = (size_t) (end - ptr) < n ? end : ptr + n;
+	char *out = insitu ? NULL : ptr2;
+
+	n = json->simd == 2 ?
+	  fast_json_copy_plain_avx2 (ptr, e, out) :
+	  fast_json_copy_plain_sse2 (ptr, e, out);
+	if (n) {
+	  if (out == NULL) {
+	    memmove (ptr2, ptr, n);
+	  }
+	  ptr += n;
+	  ptr2 += n;
+	  continue;
+	}
+      }
+#endif
+      *ptr2++ = *ptr++;
+    }
+    else if ((*ptr & 0x80u) != 0) {
+      unsigned char u = *ptr;
+      unsigned char size = 0;
+      unsigned int error = 1;
+
+#if FAST_JSON_SIMD
+      if (json->simd == 2 && end - ptr >= 32) {
+	size_t n = (limit + FAST_JSON_STRING_SLACK) - ptr2;
+	const char *e = (size_t) (end - ptr) < n ? end : ptr + n;
+	char *out = insitu ? NULL : ptr2;
+
+	n = fast_json_copy_utf8_avx2 (ptr, e, out);
+	if (n) {
+	  if (out == NULL) {
+	    memmove (ptr2, ptr, n);
+	  }
+	  ptr += n;
+	  ptr2 += n;
+	  continue;
+	}
+      }
+#endif
+      switch (fast_json_utf8_size[u]) {
+      case 0:			/* FALLTHRU */
+      case 1:
+	/* u >= 0x00u && u <= 0x7Fu not possible */
+	/* u >= 0x80u && u <= 0xBFu should be size 2 */
+	/* u >= 0xC0u && u <= 0xC1u remapped 0x00u..0x7Fu */
+	/* u >= 0xF5u && u <= 0xFFu not valid */
+	break;
+      case 2:
+	if (ptr[1]) {
+	  unsigned char u1 = ptr[1];
+
+	  if (u1 >= 0x80u && u1 <= 0xBFu) {
+	    size = 2;
+	    uc = ((u & 0x1Fu) << 6) | (u1 & 0x3Fu);
+	    error = uc < 0x80u;
+	  }
+	}
+	break;
+      case 3:
+	if (ptr[1] && ptr[2]) {
+	  unsigned char u1 = ptr[1];
+	  unsigned char u2 = ptr[2];
+
+	  if (u1 >= 0x80u && u1 <= 0xBFu && u2 >= 0x80u && u2 <= 0xBFu) {
+	    size = 3;
+	    uc = ((u & 0x0Fu) << 12) | ((u1 & 0x3Fu) << 6) | (u2 & 0x3Fu);
+	    error = uc < 0x800u || (uc >= 0xD800u && uc <= 0xDFFFu);
+	  }
+	}
+	break;
+      case 4:
+	if (ptr[1] && ptr[2] && ptr[3]) {
+	  unsigned char u1 = ptr[1];
+	  unsigned char u2 = ptr[2];
+	  unsigned char u3 = ptr[3];
+
+	  if (u1 >= 0x80u && u1 <= 0xBFu &&
+	      u2 >= 0x80u && u2 <= 0xBFu && u3 >= 0x80u && u3 <= 0xBFu) {
+	    size = 4;
+	    uc = ((u & 0x7u) << 18) | ((u1 & 0x3Fu) << 12) |
+	      ((u2 & 0x3Fu) << 6) | (u3 & 0x3Fu);
+	    error = uc < 0x10000 || uc > 0x10FFFFu;
+	  }
+	}
+	break;
+      }
+      if (error) {
+	fast_json_store_error (json, FAST_JSON_UTF8_ERROR, ptr);
+	return FAST_JSON_UTF8_ERROR;
+      }
+      while (size--) {
+	*ptr2++ = *ptr++;
+      }
+    }
+    else if (*ptr == '\\') {
+      static const char special2[256] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '/',
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, '\b', 0, 0, 0, '\f', 0, 0, 0, 0, 0, 0, 0, '\n', 0,
+	0, 0, '\r', 0, '\t', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+      };
+      ptr++;
+      if (special2[*ptr & 0xFFu]) {
+	*ptr2++ = special2[*ptr++ & 0xFFu];
+      }
+      else if (*ptr == 'u') {
+	save_ptr = ptr - 1;
+	ptr++;
+	uc = fast_json_hex (json, &ptr, 4);
+	if (uc == 0xFFFFFFFFu) {
+	  return json->error;
+	}
+	if (uc >= 0xD800u && uc <= 0xDBFFu) {
+	  if (*ptr == '\\' && ptr[1] == 'u') {
+	    unsigned int uc2;
+	    ptr += 2;
+
+	    uc2 = fast_json_hex (json, &ptr, 4);
+	    if (uc2 == 0xFFFFFFFFu) {
+	      return json->error;
+	    }
+	    if (uc2 >= 0xDC00u && uc2 <= 0xDFFFu) {
+	      uc = ((uc - 0xD800u) << 10) + (uc2 - 0xDC00u) + 0x10000u;
+	    }
+	    else {
+	      fast_json_store_error (json, FAST_JSON_UNICODE_ERROR, save_ptr);
+	      return FAST_JSON_UNICODE_ERROR;
+	    }
+	  }
+	  else {
+	    fast_json_store_error (json, FAST_JSON_UNICODE_ERROR, save_ptr);
+	    return FAST_JSON_UNICODE_ERROR;
+	  }
+	}
+	if (uc >= 0xDC00u && uc <= 0xDFFFu) {
+	  fast_json_store_error (json, FAST_JSON_UNICODE_ERROR, save_ptr);
+	  return FAST_JSON_UNICODE_ERROR;
+	}
+	if (uc < 0x80u) {
+	  if (uc == 0) {
+	    *ptr2++ = '\\';
+	    *ptr2++ = 'u';
+	    *ptr2++ = '0';
+	    *ptr2++ = '0';
+	    *ptr2++ = '0';
+	    *ptr2++ = '0';
+	  }
+	  else {
+	    if (uc == '\\' || uc == '"') {
+	      *ptr2++ = '\\';
+	    }
+	    *ptr2++ = uc;
+	  }
+	}
+	else if (uc < 0x800u) {
+	  *ptr2++ = ((uc >> 6) & 0x1Fu) | 0xC0u;
+	  *ptr2++ = ((uc >> 0) & 0x3Fu) | 0x80u;
+	}
+	else if (uc < 0x10000u) {
+	  *ptr2++ = ((uc >> 12) & 0x0Fu) | 0xE0u;
+	  *ptr2++ = ((uc >> 6) & 0x3Fu) | 0x80u;
+	  *ptr2++ = ((uc >> 0) & 0x3Fu) | 0x80u;
+	}
+	else if (uc <= 0x10FFFFu) {
+	  *ptr2++ = ((uc >> 18) & 0x07u) | 0xF0u;
+	  *ptr2++ = ((uc >> 12) & 0x3Fu) | 0x80u;
+	  *ptr2++ = ((uc >> 6) & 0x3Fu) | 0x80u;
+	  *ptr2++ = ((uc >> 0) & 0x3Fu) | 0x80u;
+	}
+	else {
+	  /* Not possible */
+	  fast_json_store_error (json, FAST_JSON_UNICODE_ERROR, save_ptr);
+	  return FAST_JSON_UNICODE_ERROR;
+	}
+      }
+      else if ((json->options & FAST_JSON_ALLOW_JSON5) && *ptr == 'x') {
+        ptr++;
+	uc = fast_json_hex (json, &ptr, 2);
+	if (uc == 0xFFFFFFFFu) {
+	  return json->error;
+	}
+	if (uc < 0x80u) {
+	  if (uc == 0) {
+	    if (UNLIKELY (insitu && ptr2 + 6 >= ptr)) {
+	      if (fast_json_insitu_move (json, &ptr2, &limit) != FAST_JSON_OK) {
+		return json->error;
+	      }
+	      insitu = 0;
+	    }
+	    *ptr2++ = '\\';
+	    *ptr2++ = 'u';
+	    *ptr2++ = '0';
+	    *ptr2++ = '0';
+	    *ptr2++ = '0';
+	    *ptr2++ = '0';
+	  }
+	  else {
+	    if (uc == '\\' || uc == '"') {
+	      *ptr2++ = '\\';
+	    }
+	    *ptr2++ = uc;
+	  }
+	}
+	else {
+	  *ptr2++ = ((uc >> 6) & 0x1Fu) | 0xC0u;
+	  *ptr2++ = ((uc >> 0) & 0x3Fu) | 0x80u;
+	}
+      }
+      else if (*ptr == '\\' || *ptr == sep) {
+	*ptr2++ = '\\';
+	*ptr2++ = *ptr++;
+      }
+      else if ((json->options & FAST_JSON_ALLOW_JSON5) &&
+               fast_json_isalpha (*ptr)) {
+	*ptr2++ = *ptr++;
+      }
+      else if ((json->options & FAST_JSON_ALLOW_JSON5) && *ptr == '0') {
+	ptr++;
+	if (UNLIKELY (insitu && ptr2 + 6 >= ptr)) {
+	  if (fast_json_insitu_move (json, &ptr2, &limit) != FAST_JSON_OK) {
+	    return json->error;
+	  }
+	  insitu = 0;
+	}
+	*ptr2++ = '\\';
+	*ptr2++ = 'u';
+	*ptr2++ = '0';
+	*ptr2++ = '0';
+	*ptr2++ = '0';
+	*ptr2++ = '0';
+      }
+      else {
+	const unsigned char *uc = (const unsigned char *) ptr;
+
+	if ((json->options & FAST_JSON_ALLOW_JSON5) &&
+            (*uc == '\n' ||
+             *uc == '\r' ||
+	     (*uc == '\r' && uc[1] == '\n') ||
+             (*uc == 0xe2 && uc[1] == 0x80 &&
+	      (uc[2] == 0xa8 || uc[2] == 0xa9)))) {
+          if (*uc == '\r' && uc[1] == '\n') {
+	    ptr += 2;
+          }
+          else if (*uc == 0xe2) {
+	    ptr += 3;
+	  }
+	  else {
+            ptr++;
+	  }
+        }
+        else {
+	  fast_json_store_error (json, FAST_JSON_ESCAPE_CHARACTER_ERROR, ptr);
+	  return FAST_JSON_ESCAPE_CHARACTER_ERROR;
+	}
+      }
+    }
+    else if (*ptr == '"' || *ptr == '\'') {
+      if (*ptr == sep) {
+	break;
+      }
+      if (*ptr == '\"') {
+	if (UNLIKELY (insitu && ptr2 + 1 >= ptr)) {
+	  if (fast_json_insitu_move (json, &ptr2, &limit) != FAST_JSON_OK) {
+	    return json->error;
+	  }
+	  insitu = 0;
+	}
+	*ptr2++ = '\\';
+      }
+      *ptr2++ = *ptr++;
+    }
+    else {
+      fast_json_store_error (json, FAST_JSON_CONTROL_CHARACTER_ERROR, ptr);
+      return FAST_JSON_CONTROL_CHARACTER_ERROR;
+    }
+  }
+  *ptr2 = 0;
+  json->n_string = ptr2 - (insitu ? json->insitu_string : json->string);
+  *buf = ptr;
+  return FAST_JSON_OK;
+}
+
+static ALWAYS_INLINE void
+fast_json_set_str_len (FAST_JSON_DATA_TYPE data, size_t len)
+{
+  data->str_len = len < FAST_JSON_STR_LEN_LONG ? len : FAST_JSON_STR_LEN_LONG;
+}
+
+/* Return the text of the string value data and its length in *len. */
+static ALWAYS_INLINE const char *
+fast_json_str (FAST_JSON_DATA_TYPE data, size_t *len)
+{
+  const char *str;
+
+  if (data->is_str == FAST_JSON_STR_INLINE) {
+    str = fast_json_inline (data);
+    *len = FAST_JSON_INLINE_SIZE - 1 -
+      (unsigned char) str[FAST_JSON_INLINE_SIZE - 1];
+    return str;
+  }
+  str = data->u.string_value;
+  *len = data->str_len != FAST_JSON_STR_LEN_LONG ? data->str_len :
+    strlen (str);
+  return str;
+}
+
+/* Move the string in json->string to data. */
+static FAST_JSON_ERROR_ENUM
+fast_json_string_store (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE data)
+{
+  if (json->n_string < FAST_JSON_INLINE_SIZE) {
+    char *str = fast_json_inline (data);
+
+    if (data->is_str == FAST_JSON_STR_MALLOC) {
+      fast_json_data_release (json, data, data->u.string_value);
+    }
+    data->is_str = FAST_JSON_STR_INLINE;
+    /* The string buffer is always larger than a value */
+    memcpy (str, json->string, FAST_JSON_INLINE_SIZE - 1);
+    str[FAST_JSON_INLINE_SIZE - 1] =
+      (char) (FAST_JSON_INLINE_SIZE - 1 - json->n_string);
+  }
+  else {
+    char *s = fast_json_data_memdup (json, data, json->string,
+				     json->n_string);
+
+    if (s == NULL) {
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    if (data->is_str == FAST_JSON_STR_MALLOC) {
+      fast_json_data_release (json, data, data->u.string_value);
+    }
+    data->is_str = FAST_JSON_STR_MALLOC;
+    data->u.string_value = s;
+    fast_json_set_str_len (data, json->n_string);
+  }
+  return FAST_JSON_OK;
+}
+
+static FAST_JSON_DATA_TYPE
+fast_json_string_value (FAST_JSON_TYPE json)
+{
+  FAST_JSON_DATA_TYPE v = fast_json_data_create (json);
+
+  if (v) {
+    v->type = FAST_JSON_STRING;
+    v->is_str = FAST_JSON_STR_INLINE;
+    v->used = 0;
+    if (json->insitu && json->insitu_string) {
+      v->is_str = FAST_JSON_STR_INSITU;
+      v->u.string_value = json->insitu_string;
+      fast_json_set_str_len (v, json->n_string);
+    }
+    else if (fast_json_string_store (json, v) != FAST_JSON_OK) {
+      fast_json_data_free (json, v);
+      v = NULL;
+    }
+  }
+  return v;
+}
+
+/* Copy the string in json->string to buf or to allocated memory if it
+ * does not fit. An in place decoded name is not copied.
+ */
+static char *
+fast_json_string_name (FAST_JSON_TYPE json, char *buf, size_t size)
+{
+  char *out = buf;
+
+  if (json->insitu && json->insitu_string) {
+    return json->insitu_string;
+  }
+  if (json->n_string >= size) {
+    out = (char *) (*json->my_malloc) (json->n_string + 1);
+    if (out == NULL) {
+      return NULL;
+    }
+  }
+  memcpy (out, json->string, json->n_string + 1);
+  return out;
+}
+
+/* Parse the scalar value that starts with c into v. The text of a string
+ * is left decoded in json->string.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_parse_scalar (FAST_JSON_TYPE json, int c, FAST_JSON_DATA_TYPE v)
+{
+  char *save;
+
+  fast_json_getc_save_start (json, c);
+  switch (c) {
+  case 'n':			/* FALLTHRU */
+  case 'N':
+    while (fast_json_isalpha (c)) {
+      c = fast_json_getc_save (json);
+    }
+    save = fast_json_ungetc_save (json, c);
+    if (json->n_save == 4 &&
+	save[1] == 'u' && save[2] == 'l' && save[3] == 'l') {
+      v->type = FAST_JSON_NULL;
+    }
+    else if ((json->options & FAST_JSON_INF_NAN) != 0 &&
+	     strcasecmp (save, "nan") == 0) {
+      c = fast_json_getc_save (json);
+      if (c == '(') {
+	c = fast_json_getc_save (json);
+	while (fast_json_isalpha (c) || fast_json_isdigit (c) || c == '_') {
+	  c = fast_json_getc_save (json);
+	}
+	if (c != ')') {
+	  save = fast_json_ungetc_save (json, 0);
+	  fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+	  return FAST_JSON_NUMBER_ERROR;
+	}
+      }
+      else {
+	fast_json_ungetc (json, c);
+      }
+      v->type = FAST_JSON_DOUBLE;
+      v->u.double_value = fast_json_nan (0);
+    }
+    else {
+      fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
+      return FAST_JSON_VALUE_ERROR;
+    }
+    break;
+  case 'f':
+    while (fast_json_isalpha (c)) {
+      c = fast_json_getc_save (json);
+    }
+    save = fast_json_ungetc_save (json, c);
+    if (json->n_save == 5 &&
+	save[1] == 'a' && save[2] == 'l' && save[3] == 's' &&
+	save[4] == 'e') {
+      v->type = FAST_JSON_BOOLEAN;
+      v->u.boolean_value = 0;
+    }
+    else {
+      fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
+      return FAST_JSON_VALUE_ERROR;
+    }
+    break;
+  case 't':
+    while (fast_json_isalpha (c)) {
+      c = fast_json_getc_save (json);
+    }
+    save = fast_json_ungetc_save (json, c);
+    if (json->n_save == 4 &&
+	save[1] == 'r' && save[2] == 'u' && save[3] == 'e') {
+      v->type = FAST_JSON_BOOLEAN;
+      v->u.boolean_value = 1;
+    }
+    else {
+      fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
+      return FAST_JSON_VALUE_ERROR;
+    }
+    break;
+  case 'i':			/* FALLTHRU */
+  case 'I':
+    while (fast_json_isalpha (c)) {
+      c = fast_json_getc_save (json);
+    }
+    save = fast_json_ungetc_save (json, c);
+    if ((json->options & FAST_JSON_INF_NAN) != 0 &&
+	(strcasecmp (save, "inf") == 0 ||
+	 strcasecmp (save, "infinity") == 0)) {
+      v->type = FAST_JSON_DOUBLE;
+      v->u.double_value = fast_json_inf (0);
+    }
+    else {
+      fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
+      return FAST_JSON_VALUE_ERROR;
+    }
+    break;
+  case '\'':
+  case '"':
+    {
+      const char *cp;
+      int sep = c;
+
+      c = fast_json_getc (json);
+      fast_json_getc_save_start (json, c);
+      while (c > 0 && c != sep) {
+	if (c == '\\') {
+	  c = fast_json_getc_save (json);
+	}
+	c = fast_json_getc_save (json);
+      }
+      save = fast_json_ungetc_save (json, c);
+      cp = save;
+      if (fast_json_check_string (json, &cp, save + json->n_save, sep) !=
+	  FAST_JSON_OK) {
+	return json->error;
+      }
+      c = fast_json_getc (json);
+      if (c != sep) {
+	fast_json_store_error (json, FAST_JSON_STRING_END_ERROR, save);
+	return FAST_JSON_STRING_END_ERROR;
+      }
+      v->type = FAST_JSON_STRING;
+    }
+    break;
+  case '.':
+    if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
+      save = fast_json_ungetc_save (json, 0);
+      fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+      return FAST_JSON_NUMBER_ERROR;
+    }
+    /* FALLTHRU */
+  case '+':			/* FALLTHRU */
+  case '-':			/* FALLTHRU */
+  case '0':			/* FALLTHRU */
+  case '1':			/* FALLTHRU */
+  case '2':			/* FALLTHRU */
+  case '3':			/* FALLTHRU */
+  case '4':			/* FALLTHRU */
+  case '5':			/* FALLTHRU */
+  case '6':			/* FALLTHRU */
+  case '7':			/* FALLTHRU */
+  case '8':			/* FALLTHRU */
+  case '9':
+    {
+      unsigned int integer = 1;
+      unsigned int hex = 0;
+      unsigned int sign = 0;
+      unsigned int ndigit = 0;
+      unsigned int overflow = 0;
+      uint64_t uval = 0;
+      unsigned int erange;
+      const char *end;
+      double n;
+
+      fast_json_getc_save_start (json, c);
+      if (UNLIKELY (c == '+')) {
+	if ((json->options & FAST_JSON_INF_NAN) != 0) {
+	  c = fast_json_getc_save (json);
+	}
+      }
+      else if (c == '-') {
+	sign = 1;
+	c = fast_json_getc_save (json);
+      }
+      if (c == '0') {
+	ndigit++;
+	c = fast_json_getc_save (json);
+	if ((json->options & FAST_JSON_ALLOW_OCT_HEX) != 0) {
+	  if (c == 'x' || c == 'X') {
+	    hex = 1;
+	    c = fast_json_getc_save (json);
+	    /* Let strtod report an error for 0x without digits */
+	    overflow = !fast_json_isxdigit (c);
+	    while (fast_json_isxdigit (c)) {
+	      overflow |= (uval >> 60) != 0;
+	      uval = (uval << 4) + fast_json_xdigit_value (c);
+	      ndigit++;
+	      c = fast_json_getc_save (json);
+	    }
+	  }
+	  else {
+	    while (c >= '0' && c <= '7') {
+	      overflow |= (uval >> 61) != 0;
+	      uval = (uval << 3) + (c - '0');
+	      ndigit++;
+	      c = fast_json_getc_save (json);
+	    }
+	  }
+	}
+      }
+      else if (LIKELY (fast_json_isdigit (c))) {
+	do {
+	  uval = uval * 10 + (c - '0');
+	  ndigit++;
+	  c = fast_json_getc_save (json);
+	} while (fast_json_isdigit (c));
+	overflow = ndigit > 19;
+      }
+      else if ((json->options & FAST_JSON_ALLOW_JSON5) && c == '.') {
+      }
+      else {
+	size_t last_n_save = json->n_save > 0 ? json->n_save - 1 : 0;
+
+	while (fast_json_isalpha (c)) {
+	  c = fast_json_getc_save (json);
+	}
+	fast_json_ungetc_save (json, c);
+	if ((json->options & FAST_JSON_INF_NAN) != 0) {
+	  if (strcasecmp (&json->save[last_n_save], "inf") == 0 ||
+	      strcasecmp (&json->save[last_n_save], "infinity") == 0) {
+	    v->type = FAST_JSON_DOUBLE;
+	    v->u.double_value = fast_json_inf (sign);
+	    return FAST_JSON_OK;
+	  }
+	  else if (strcasecmp (&json->save[last_n_save], "nan") == 0) {
+	    c = fast_json_getc_save (json);
+	    if (c == '(') {
+	      c = fast_json_getc_save (json);
+	      while (fast_json_isalpha (c) || fast_json_isdigit (c) ||
+		     c == '_') {
+		c = fast_json_getc_save (json);
+	      }
+	      if (c != ')') {
+		save = fast_json_ungetc_save (json, 0);
+		fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+		return FAST_JSON_NUMBER_ERROR;
+	      }
+	    }
+	    else {
+	      fast_json_ungetc (json, c);
+	    }
+	    v->type = FAST_JSON_DOUBLE;
+	    v->u.double_value = fast_json_nan (sign);
+	    return FAST_JSON_OK;
+	  }
+	}
+	fast_json_getc_save (json);
+	save = fast_json_ungetc_save (json, 0);
+	fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+	return FAST_JSON_NUMBER_ERROR;
+      }
+      if (c == '.') {
+	c = fast_json_getc_save (json);
+	integer = 0;
+	if (UNLIKELY (hex)) {
+	  if (fast_json_isxdigit (c)) {
+	    do {
+	      ndigit++;
+	      c = fast_json_getc_save (json);
+	    } while (fast_json_isxdigit (c));
+	  }
+	  else if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
+	    save = fast_json_ungetc_save (json, 0);
+	    fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+	    return FAST_JSON_NUMBER_ERROR;
+	  }
+	}
+	else {
+	  if (fast_json_isdigit (c)) {
+	    do {
+	      ndigit++;
+	      c = fast_json_getc_save (json);
+	    } while (fast_json_isdigit (c));
+	  }
+	  else if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
+	    save = fast_json_ungetc_save (json, 0);
+	    fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+	    return FAST_JSON_NUMBER_ERROR;
+	  }
+	}
+      }
+      if (c == 'e' || c == 'E' || (hex && (c == 'p' || c == 'P'))) {
+	integer = 0;
+	c = fast_json_getc_save (json);
+	if (c == '+' || c == '-') {
+	  c = fast_json_getc_save (json);
+	}
+	if (fast_json_isdigit (c)) {
+	  do {
+	    c = fast_json_getc_save (json);
+	  } while (fast_json_isdigit (c));
+	}
+	else {
+	  save = fast_json_ungetc_save (json, 0);
+	  fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+	  return FAST_JSON_NUMBER_ERROR;
+	}
+      }
+      save = fast_json_ungetc_save (json, c);
+      if (ndigit == 0) {
+	save = fast_json_ungetc_save (json, 0);
+	fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+	return FAST_JSON_NUMBER_ERROR;
+      }
+      /* Integers that do not fit in 64 bits are parsed as double */
+      if ((json->options & FAST_JSON_PARSE_INT_AS_DOUBLE) == 0 && integer &&
+	  !overflow && uval <= (uint64_t) INT64_MAX + sign) {
+	v->type = FAST_JSON_INTEGER;
+	v->u.int_value = sign ? 0 - uval : uval;
+	return FAST_JSON_OK;
+      }
+      n = fast_json_strtod (save, &end, &erange);
+      if (*end != '\0' || erange) {
+	fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
+	return FAST_JSON_NUMBER_ERROR;
+      }
+      v->type = FAST_JSON_DOUBLE;
+      v->u.double_value = n;
+    }
+    break;
+  default:
+    save = fast_json_ungetc_save (json, 0);
+    fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
+    return FAST_JSON_VALUE_ERROR;
+  }
+  return FAST_JSON_OK;
+}
+
+static FAST_JSON_DATA_TYPE
+fast_json_parse_value (FAST_JSON_TYPE json, int c)
+{
+  struct fast_json_data_struct scalar;
+  FAST_JSON_DATA_TYPE v;
+
+  if (c == '[' || c == '{') {
+    return fast_json_parse_nested (json, c);
+  }
+  if (fast_json_parse_scalar (json, c, &scalar) != FAST_JSON_OK) {
+    return NULL;
+  }
+  switch (scalar.type) {
+  case FAST_JSON_STRING:
+    v = fast_json_string_value (json);
+    if (v == NULL) {
+      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    }
+    break;
+  case FAST_JSON_INTEGER:
+    v = fast_json_create_integer_value (json, scalar.u.int_value);
+    break;
+  case FAST_JSON_DOUBLE:
+    v = fast_json_create_double_value (json, scalar.u.double_value);
+    break;
+  case FAST_JSON_BOOLEAN:
+    v = scalar.u.boolean_value ? fast_json_create_true (json) :
+      fast_json_create_false (json);
+    break;
+  default:
+    v = fast_json_create_null (json);
+    break;
+  }
+  return v;
+}
+
+/* Validate and decode the object name that starts with c into
+ * json->string.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_check_name (FAST_JSON_TYPE json, int c)
+{
+  char *save;
+  const char *cp;
+
+  if ((json->options & FAST_JSON_ALLOW_JSON5) && c != '"') {
+    fast_json_getc_save_start (json, c);
+    while (c > 0 && c != ':') {
+      if (fast_json5_isspace (c)) {
+	break;
+      }
+      else if (c == 0xc2) {
+	c = fast_json_getc_save (json);
+	if (c == 0xa0) {	/* Non-breaking space */
+	  c = ' ';
+	  json->n_save--;
+	  break;
+	}
+      }
+      else if (c == 0xe2) {
+	c = fast_json_getc_save (json);
+	if (c == 0x80) {
+	  c = fast_json_getc_save (json);
+	  if (c == 0xa8 || c == 0xa9) {
+	    /* Line separator */
+	    /* Paragraph separator */
+	    c = ' ';
+	    json->n_save -= 2;
+	    break;
+	  }
+	}
+      }
+      else if (c == 0xef) {
+	c = fast_json_getc_save (json);
+	if (c == 0xbb) {
+	  c = fast_json_getc_save (json);
+	  if (c == 0xbf) {	/* Byte order mark */
+	    c = ' ';
+	    json->n_save -= 2;
+	    break;
+	  }
+	}
+      }
+      if (c == '\\') {
+	c = fast_json_getc_save (json);
+      }
+      c = fast_json_getc_save (json);
+    }
+    save = fast_json_ungetc_save (json, c);
+    cp = save;
+    if (fast_json_check_string (json, &cp, save + json->n_save, '"') !=
+	FAST_JSON_OK) {
+      return json->error;
+    }
+    if (cp != save + json->n_save) {
+      fast_json_store_error (json, FAST_JSON_ESCAPE_CHARACTER_ERROR, cp);
+      return FAST_JSON_ESCAPE_CHARACTER_ERROR;
+    }
+  }
+  else {
+    if (c != '"') {
+      fast_json_store_error (json, FAST_JSON_STRING_START_ERROR, "");
+      return FAST_JSON_STRING_START_ERROR;
+    }
+    c = fast_json_getc (json);
+    fast_json_getc_save_start (json, c);
+    while (c > 0 && c != '"') {
+      if (c == '\\') {
+	c = fast_json_getc_save (json);
+      }
+      c = fast_json_getc_save (json);
+    }
+    save = fast_json_ungetc_save (json, c);
+    cp = save;
+    if (fast_json_check_string (json, &cp, save + json->n_save, '"') !=
+	FAST_JSON_OK) {
+      return json->error;
+    }
+    c = fast_json_getc (json);
+    if (c != '"') {
+      fast_json_store_error (json, FAST_JSON_STRING_END_ERROR, save);
+      return FAST_JSON_STRING_END_ERROR;
+    }
+  }
+  return FAST_JSON_OK;
+}
+
+/* Parse the object name that starts with c. Returns buf or a malloced copy
+ * if the name does not fit. Returns NULL on error.
+ */
+static char *
+fast_json_parse_name (FAST_JSON_TYPE json, int c, char *buf, size_t size)
+{
+  char *out;
+
+  if (fast_json_check_name (json, c) != FAST_JSON_OK) {
+    return NULL;
+  }
+  out = fast_json_string_name (json, buf, size);
+  if (out == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+  }
+  return out;
+}
+
+/* Make room for container depth on the container stack. */
+static FAST_JSON_ERROR_ENUM
+fast_json_stack_check (FAST_JSON_TYPE json, size_t depth)
+{
+  if (json->max_depth && depth >= json->max_depth) {
+    return FAST_JSON_DEPTH_ERROR;
+  }
+  if (UNLIKELY (depth >= json->max_stack)) {
+    size_t new_max =
+      json->max_stack ? json->max_stack * 2 : FAST_JSON_STACK_SIZE;
+    FAST_JSON_STACK_TYPE *new_stack;
+
+    new_stack = (FAST_JSON_STACK_TYPE *)
+      json->my_realloc (json->stack, new_max * sizeof (FAST_JSON_STACK_TYPE));
+    if (new_stack == NULL) {
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    json->max_stack = new_max;
+    json->stack = new_stack;
+  }
+  return FAST_JSON_OK;
+}
+
+/* Make room for depth on the stack of the non recursive print, copy and
+ * loop check functions. It is not the container stack, so these functions
+ * can be called between calls of fast_json_next_token.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_walk_check (FAST_JSON_TYPE json, size_t depth)
+{
+  if (UNLIKELY (depth >= json->max_walk)) {
+    size_t new_max =
+      json->max_walk ? json->max_walk * 2 : FAST_JSON_STACK_SIZE;
+    FAST_JSON_WALK_TYPE *new_walk;
+
+    new_walk = (FAST_JSON_WALK_TYPE *)
+      json->my_realloc (json->walk, new_max * sizeof (FAST_JSON_WALK_TYPE));
+    if (new_walk == NULL) {
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    json->max_walk = new_max;
+    json->walk = new_walk;
+  }
+  return FAST_JSON_OK;
+}
+
+/* Number of elements of an array or object. 0 for other values. */
+static ALWAYS_INLINE size_t
+fast_json_container_len (FAST_JSON_DATA_TYPE value)
+{
+  if (value->type == FAST_JSON_ARRAY) {
+    return value->u.array ? value->u.array->len : 0;
+  }
+  if (value->type == FAST_JSON_OBJECT) {
+    return value->u.object ? value->u.object->len : 0;
+  }
+  return 0;
+}
+
+/* Element index of an array or the value of member index of an object */
+static ALWAYS_INLINE FAST_JSON_DATA_TYPE
+fast_json_container_element (FAST_JSON_DATA_TYPE value, size_t index)
+{
+  if (value->type == FAST_JSON_ARRAY) {
+    return value->u.array->values[index];
+  }
+  return value->u.object->data[index].value;
+}
+
+/* Parse the array or object that starts with c. Open arrays and objects are
+ * kept on the container stack in json instead of on the call stack. Each
+ * new value is added to its container immediately so on error only the
+ * outermost container has to be freed.
+ */
+static FAST_JSON_DATA_TYPE
+fast_json_parse_nested (FAST_JSON_TYPE json, int c)
+{
+  FAST_JSON_ERROR_ENUM error;
+  FAST_JSON_DATA_TYPE v;
+  FAST_JSON_DATA_TYPE top;
+  size_t depth = 0;
+  char name[16];
+  char *out = &name[0];
+  size_t len = 0;
+  int close;
+
+  for (;;) {
+    /* Parse the value that starts with c and add it to its container */
+    close = c == '[' ? ']' : c == '{' ? '}' : 0;
+    if (close) {
+      error = fast_json_stack_check (json, depth);
+      if (error != FAST_JSON_OK) {
+	fast_json_store_error (json, error, "");
+	break;
+      }
+      v = close == ']' ? fast_json_create_array (json) :
+	fast_json_create_object (json);
+      if (v == NULL) {
+	fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+	break;
+      }
+    }
+    else {
+      v = fast_json_parse_value (json, c);
+      if (v == NULL) {
+	break;
+      }
+    }
+    if (depth) {
+      top = json->stack[depth - 1].value;
+      error = top->type == FAST_JSON_ARRAY ?
+	fast_json_add_array_end (json, top, v) :
+	fast_json_add_object_end (json, top, out, len, v);
+      if (out != &name[0]) {
+	(*json->my_free) (out);
+	out = &name[0];
+      }
+      if (error != FAST_JSON_OK) {
+	fast_json_value_free (json, v);
+	break;
+      }
+    }
+    if (close) {
+      json->stack[depth++].value = v;
+    }
+    if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
+      break;
+    }
+
+    /* Close arrays and objects until the next element is found */
+    if (close == 0 || c == close) {
+      error = FAST_JSON_OK;
+      for (;;) {
+	top = json->stack[depth - 1].value;
+	close = top->type == FAST_JSON_ARRAY ? ']' : '}';
+	if (c == ',') {
+	  error = fast_json_skip_whitespace (json, &c);
+	  if (error != FAST_JSON_OK ||
+	      (json->options & FAST_JSON_ALLOW_JSON5) == 0 || c != close) {
+	    break;
+	  }
+	}
+	if (c != close) {
+	  error = close == ']' ? FAST_JSON_ARRAY_END_ERROR :
+	    FAST_JSON_OBJECT_END_ERROR;
+	  fast_json_store_error (json, error, "");
+	  break;
+	}
+	if (--depth == 0) {
+	  return top;
+	}
+	error = fast_json_skip_whitespace (json, &c);
+	if (error != FAST_JSON_OK) {
+	  break;
+	}
+      }
+      if (error != FAST_JSON_OK) {
+	break;
+      }
+    }
+
+    /* c starts the next element of the container on top of the stack */
+    if (json->stack[depth - 1].value->type == FAST_JSON_OBJECT) {
+      out = fast_json_parse_name (json, c, name, sizeof (name));
+      if (out == NULL) {
+	out = &name[0];
+	break;
+      }
+      len = json->n_string;
+      if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
+	break;
+      }
+      if (c != ':') {
+	fast_json_store_error (json, FAST_JSON_OBJECT_SEPERATOR_ERROR, "");
+	break;
+      }
+      if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
+	break;
+      }
+    }
+  }
+  if (out != &name[0]) {
+    (*json->my_free) (out);
+  }
+  if (depth) {
+    fast_json_value_free (json, json->stack[0].value);
+  }
+  return NULL;
+}
+
+FAST_JSON_TYPE
+fast_json_create (fast_json_malloc_type malloc_fn,
+		  fast_json_realloc_type realloc_fn,
+		  fast_json_free_type free_fn)
+{
+  FAST_JSON_TYPE json =
+    (FAST_JSON_TYPE) (malloc_fn ? malloc_fn : malloc) (sizeof (*json));
+
+  if (json) {
+    memset (json, 0, sizeof (*json));
+    json->my_malloc = malloc_fn ? malloc_fn : malloc;
+    json->my_realloc = malloc_fn ? realloc_fn : realloc;
+    json->my_free = free_fn ? free_fn : free;
+#if FAST_JSON_SIMD
+    __builtin_cpu_init ();
+    json->simd = __builtin_cpu_supports ("avx2") ? 2 : 1;
+#endif
+  }
+  return json;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_options (FAST_JSON_TYPE json, unsigned int value)
+{
+  FAST_JSON_ERROR_ENUM retval = FAST_JSON_VALUE_ERROR;
+
+  if (json) {
+    json->options = value;
+    if (json->options & FAST_JSON_ALLOW_JSON5) {
+      json->options |= FAST_JSON_ALLOW_OCT_HEX |
+		       FAST_JSON_INF_NAN;
+      json->options &= ~FAST_JSON_NO_COMMENT;
+    }
+    retval = FAST_JSON_OK;
+  }
+  return retval;
+}
+
+unsigned int
+fast_json_get_options (FAST_JSON_TYPE json)
+{
+  return json ? json->options : 0;
+}
+
+void
+fast_json_arena_free (FAST_JSON_TYPE json)
+{
+  if (json) {
+    FAST_JSON_ARENA_TYPE *a = json->arena;
+    FAST_JSON_ARENA_TYPE *keep = NULL;
+
+    /* Keep one chunk for the next document */
+    while (a) {
+      FAST_JSON_ARENA_TYPE *next = a->next;
+
+      if (keep == NULL && a->size == FAST_JSON_ARENA_SIZE) {
+	keep = a;
+	keep->next = NULL;
+      }
+      else {
+	(*json->my_free) (a);
+      }
+      a = next;
+    }
+    json->arena = keep;
+    json->arena_ptr = keep ? (char *) (keep + 1) : NULL;
+    json->arena_end = keep ? json->arena_ptr + FAST_JSON_ARENA_SIZE : NULL;
+  }
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_max_reuse (FAST_JSON_TYPE json, size_t n)
+{
+  FAST_JSON_ERROR_ENUM retval = FAST_JSON_VALUE_ERROR;
+
+  if (json) {
+    json->max_reuse = n;
+    retval = FAST_JSON_OK;
+  }
+  return retval;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_max_depth (FAST_JSON_TYPE json, size_t depth)
+{
+  FAST_JSON_ERROR_ENUM retval = FAST_JSON_VALUE_ERROR;
+
+  if (json) {
+    json->max_depth = depth;
+    retval = FAST_JSON_OK;
+  }
+  return retval;
+}
+
+void
+fast_json_free (FAST_JSON_TYPE json)
+{
+  if (json) {
+    while (json->json_reuse) {
+      FAST_JSON_DATA_TYPE next = json->json_reuse->u.next;
+
+      if (json->json_reuse->alloc == FAST_JSON_ALLOC_MALLOC) {
+	(*json->my_free) (json->json_reuse);
+      }
+      json->json_reuse = next;
+    }
+    while (json->big_malloc) {
+      FAST_JSON_BIG_TYPE *next = json->big_malloc->next;
+
+      (*json->my_free) (json->big_malloc);
+      json->big_malloc = next;
+    }
+    while (json->arena) {
+      FAST_JSON_ARENA_TYPE *next = json->arena->next;
+
+      (*json->my_free) (json->arena);
+      json->arena = next;
+    }
+    (*json->my_free) (json->save);
+    (*json->my_free) (json->string);
+    (*json->my_free) (json->window.buffer);
+    (*json->my_free) (json->stack);
+    (*json->my_free) (json->walk);
+    (*json->my_free) (json);
+  }
+}
+
+size_t
+fast_json_parser_line (FAST_JSON_TYPE json)
+{
+  return json ? json->line : 0;
+}
+
+size_t
+fast_json_parser_column (FAST_JSON_TYPE json)
+{
+  return json ? json->column : 0;
+}
+
+size_t
+fast_json_parser_position (FAST_JSON_TYPE json)
+{
+  return json ? json->position : 0;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_parser_error (FAST_JSON_TYPE json)
+{
+  return json ? json->error : FAST_JSON_OK;
+}
+
+const char *
+fast_json_error_str (FAST_JSON_ERROR_ENUM error)
+{
+  switch (error) {
+  case FAST_JSON_OK:
+    return ("OK");
+  case FAST_JSON_MALLOC_ERROR:
+    return ("Malloc error");
+  case FAST_JSON_COMMENT_ERROR:
+    return ("Comment error");
+  case FAST_JSON_NUMBER_ERROR:
+    return ("Number error");
+  case FAST_JSON_CONTROL_CHARACTER_ERROR:
+    return ("Control character error");
+  case FAST_JSON_ESCAPE_CHARACTER_ERROR:
+    return ("Escape character error");
+  case FAST_JSON_UTF8_ERROR:
+    return ("UTF8 character error");
+  case FAST_JSON_UNICODE_ERROR:
+    return ("Unicode error");
+  case FAST_JSON_UNICODE_ESCAPE_ERROR:
+    return ("Unicode escape error");
+  case FAST_JSON_STRING_START_ERROR:
+    return ("String start error");
+  case FAST_JSON_STRING_END_ERROR:
+    return ("String end error");
+  case FAST_JSON_VALUE_ERROR:
+    return ("Value error");
+  case FAST_JSON_ARRAY_END_ERROR:
+    return ("Array end error");
+  case FAST_JSON_OBJECT_SEPERATOR_ERROR:
+    return ("Object seperator error");
+  case FAST_JSON_OBJECT_END_ERROR:
+    return ("Object end error");
+  case FAST_JSON_PARSE_ERROR:
+    return ("Parse error");
+  case FAST_JSON_NO_DATA_ERROR:
+    return ("No data error");
+  case FAST_JSON_INDEX_ERROR:
+    return ("Index error");
+  case FAST_JSON_LOOP_ERROR:
+    return ("Loop error");
+  case FAST_JSON_DEPTH_ERROR:
+    return ("Depth error");
+  case FAST_JSON_USER_ERROR:
+    return ("User error");
+  case FAST_JSON_NEED_MORE_DATA:
+    return ("Need more data");
+  }
+  return NULL;
+}
+
+const char *
+fast_json_parser_error_str (FAST_JSON_TYPE json)
+{
+  return json ? (const char *) json->error_str : "";
+}
+
+static FAST_JSON_DATA_TYPE
+fast_json_parse_all (FAST_JSON_TYPE json, unsigned int next)
+{
+  int c;
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (next == 0) {
+    json->error = FAST_JSON_OK;
+    json->error_str[0] = '\0';
+    json->line = 1;
+    json->column = 0;
+    json->position = 0;
+    json->last_char = 0;
+    json->window.active = 0;
+  }
+  if (fast_json_skip_whitespace (json, &c) == FAST_JSON_OK) {
+    if (c != FAST_JSON_EOF) {
+      v = fast_json_parse_value (json, c);
+      if (v) {
+	if ((json->options & FAST_JSON_NO_EOF_CHECK) == 0) {
+	  if (fast_json_skip_whitespace (json, &c) == FAST_JSON_OK) {
+	    fast_json_ungetc (json, c);
+	    if (c != FAST_JSON_EOF) {
+	      fast_json_store_error (json, FAST_JSON_OBJECT_END_ERROR, "");
+	      fast_json_value_free (json, v);
+	      v = NULL;
+	    }
+	  }
+	  else {
+	    fast_json_value_free (json, v);
+	    v = NULL;
+	  }
+	}
+      }
+    }
+    else {
+      json->error = FAST_JSON_NO_DATA_ERROR;
+    }
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_string (FAST_JSON_TYPE json, const char *json_str)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && json_str) {
+    json->getc = fast_json_getc_string;
+    json->getc_data = (void *) json;
+    json->u_parse.str.string = json_str;
+    json->u_parse.str.pos = 0;
+    v = fast_json_parse_all (json, 0);
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_string_len (FAST_JSON_TYPE json, const char *json_str,
+			    size_t len)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && json_str) {
+    json->getc = fast_json_getc_string_len;
+    json->getc_data = (void *) json;
+    json->u_parse.str.string = json_str;
+    json->u_parse.str.pos = 0;
+    json->u_parse.str.len = len;
+    v = fast_json_parse_all (json, 0);
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_file (FAST_JSON_TYPE json, FILE * fp)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && fp) {
+    json->getc = fast_json_getc_file;
+    json->getc_data = (void *) json;
+    json->u_parse.fp = fp;
+    if (json->options & FAST_JSON_NO_EOF_CHECK) {
+      v = fast_json_parse_all (json, 0);
+    }
+    else {
+      json->window.block = NULL;
+      json->window.fp = fp;
+      v = fast_json_parse_window (json, 0);
+    }
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_file_name (FAST_JSON_TYPE json, const char *name)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && name) {
+    FILE *fp;
+
+#ifndef WIN
+    if (fast_json_parse_map (json, name, &v)) {
+      return v;
+    }
+#endif
+    fp = fopen (name, "r");
+    if (fp) {
+      json->getc = fast_json_getc_file;
+      json->getc_data = (void *) json;
+      json->window.block = NULL;
+      json->window.fp = fp;
+      v = fast_json_parse_window (json, 0);
+      fclose (fp);
+      json->u_parse.fp = NULL;
+      json->window.fp = NULL;
+      json->window.active = 0;
+    }
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_fd (FAST_JSON_TYPE json, int fd)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json) {
+    json->window.block = NULL;
+    json->window.fp = NULL;
+    json->window.fd = fd;
+    v = fast_json_parse_window (json, 0);
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_user (FAST_JSON_TYPE json, fast_json_getc_func getc,
+		      void *user_data)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && getc) {
+    json->getc = getc;
+    json->getc_data = user_data;
+    v = fast_json_parse_all (json, 0);
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_block (FAST_JSON_TYPE json, fast_json_block_func block,
+		       void *user_data)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && block) {
+    json->window.block = block;
+    json->window.block_data = user_data;
+    json->window.fp = NULL;
+    v = fast_json_parse_window (json, 0);
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_next (FAST_JSON_TYPE json)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && json->window.active) {
+    v = fast_json_parse_window (json, 1);
+  }
+  else if (json &&
+	   (json->getc != NULL &&
+	    (json->getc != fast_json_getc_file || json->u_parse.fp != NULL))) {
+    v = fast_json_parse_all (json, 1);
+  }
+  return v;
+}
+
+/* Call the callback for the scalar in v. A string is in json->string. */
+static int
+fast_json_events_scalar (FAST_JSON_TYPE json,
+			 const FAST_JSON_EVENTS_TYPE * events,
+			 void *user_data, FAST_JSON_DATA_TYPE v)
+{
+  switch (v->type) {
+  case FAST_JSON_STRING:
+    return events->string_value ?
+      (*events->string_value) (user_data, json->string, json->n_string) : 0;
+  case FAST_JSON_INTEGER:
+    return events->integer_value ?
+      (*events->integer_value) (user_data, v->u.int_value) : 0;
+  case FAST_JSON_DOUBLE:
+    return events->double_value ?
+      (*events->double_value) (user_data, v->u.double_value) : 0;
+  case FAST_JSON_BOOLEAN:
+    return events->boolean_value ?
+      (*events->boolean_value) (user_data, v->u.boolean_value) : 0;
+  default:
+    return events->null_value ? (*events->null_value) (user_data) : 0;
+  }
+}
+
+/* Parse the value that starts with c and call the callbacks in events
+ * instead of building values. Works like fast_json_parse_nested with the
+ * closing character of each open array and object on the container stack.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_parse_events_value (FAST_JSON_TYPE json,
+			      const FAST_JSON_EVENTS_TYPE * events,
+			      void *user_data, int c)
+{
+  struct fast_json_data_struct scalar;
+  FAST_JSON_ERROR_ENUM error;
+  size_t depth = 0;
+  int close;
+  int stop;
+
+  for (;;) {
+    /* Parse the value that starts with c */
+    close = c == '[' ? ']' : c == '{' ? '}' : 0;
+    if (close) {
+      error = fast_json_stack_check (json, depth);
+      if (error != FAST_JSON_OK) {
+	fast_json_store_error (json, error, "");
+	return error;
+      }
+      json->stack[depth++].close = close;
+      if (close == ']') {
+	stop = events->start_array ? (*events->start_array) (user_data) : 0;
+      }
+      else {
+	stop = events->start_object ? (*events->start_object) (user_data) : 0;
+      }
+    }
+    else {
+      error = fast_json_parse_scalar (json, c, &scalar);
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+      stop = fast_json_events_scalar (json, events, user_data, &scalar);
+    }
+    if (stop) {
+      fast_json_store_error (json, FAST_JSON_USER_ERROR, "");
+      return FAST_JSON_USER_ERROR;
+    }
+    if (depth == 0) {
+      return FAST_JSON_OK;
+    }
+    error = fast_json_skip_whitespace (json, &c);
+    if (error != FAST_JSON_OK) {
+      return error;
+    }
+
+    /* Close arrays and objects until the next element is found */
+    if (close == 0 || c == close) {
+      for (;;) {
+	close = json->stack[depth - 1].close;
+	if (c == ',') {
+	  error = fast_json_skip_whitespace (json, &c);
+	  if (error != FAST_JSON_OK) {
+	    return error;
+	  }
+	  if ((json->options & FAST_JSON_ALLOW_JSON5) == 0 || c != close) {
+	    break;
+	  }
+	}
+	if (c != close) {
+	  error = close == ']' ? FAST_JSON_ARRAY_END_ERROR :
+	    FAST_JSON_OBJECT_END_ERROR;
+	  fast_json_store_error (json, error, "");
+	  return error;
+	}
+	depth--;
+	if (close == ']') {
+	  stop = events->end_array ? (*events->end_array) (user_data) : 0;
+	}
+	else {
+	  stop = events->end_object ? (*events->end_object) (user_data) : 0;
+	}
+	if (stop) {
+	  fast_json_store_error (json, FAST_JSON_USER_ERROR, "");
+	  return FAST_JSON_USER_ERROR;
+	}
+	if (depth == 0) {
+	  return FAST_JSON_OK;
+	}
+	error = fast_json_skip_whitespace (json, &c);
+	if (error != FAST_JSON_OK) {
+	  return error;
+	}
+      }
+    }
+
+    /* c starts the next element of the container on top of the stack */
+    if (json->stack[depth - 1].close == '}') {
+      error = fast_json_check_name (json, c);
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+      if (events->key &&
+	  (*events->key) (user_data, json->string, json->n_string)) {
+	fast_json_store_error (json, FAST_JSON_USER_ERROR, "");
+	return FAST_JSON_USER_ERROR;
+      }
+      error = fast_json_skip_whitespace (json, &c);
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+      if (c != ':') {
+	fast_json_store_error (json, FAST_JSON_OBJECT_SEPERATOR_ERROR, "");
+	return FAST_JSON_OBJECT_SEPERATOR_ERROR;
+      }
+      error = fast_json_skip_whitespace (json, &c);
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+    }
+  }
+}
+
+static FAST_JSON_ERROR_ENUM
+fast_json_parse_events_all (FAST_JSON_TYPE json,
+			    const FAST_JSON_EVENTS_TYPE * events,
+			    void *user_data)
+{
+  int c;
+
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  json->last_char = 0;
+  json->window.active = 0;
+  if (fast_json_skip_whitespace (json, &c) == FAST_JSON_OK) {
+    if (c != FAST_JSON_EOF) {
+      if (fast_json_parse_events_value (json, events, user_data, c) ==
+	  FAST_JSON_OK && (json->options & FAST_JSON_NO_EOF_CHECK) == 0 &&
+	  fast_json_skip_whitespace (json, &c) == FAST_JSON_OK) {
+	fast_json_ungetc (json, c);
+	if (c != FAST_JSON_EOF) {
+	  fast_json_store_error (json, FAST_JSON_OBJECT_END_ERROR, "");
+	}
+      }
+    }
+    else {
+      json->error = FAST_JSON_NO_DATA_ERROR;
+    }
+  }
+  return json->error;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_parse_events_string (FAST_JSON_TYPE json,
+			       const FAST_JSON_EVENTS_TYPE * events,
+			       void *user_data, const char *json_str)
+{
+  FAST_JSON_ERROR_ENUM error = FAST_JSON_VALUE_ERROR;
+
+  if (json && events && json_str) {
+    json->getc = fast_json_getc_string;
+    json->getc_data = (void *) json;
+    json->u_parse.str.string = json_str;
+    json->u_parse.str.pos = 0;
+    error = fast_json_parse_events_all (json, events, user_data);
+  }
+  return error;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_parse_events_file (FAST_JSON_TYPE json,
+			     const FAST_JSON_EVENTS_TYPE * events,
+			     void *user_data, FILE * fp)
+{
+  FAST_JSON_ERROR_ENUM error = FAST_JSON_VALUE_ERROR;
+
+  if (json && events && fp) {
+    json->getc = fast_json_getc_file;
+    json->getc_data = (void *) json;
+    json->u_parse.fp = fp;
+    error = fast_json_parse_events_all (json, events, user_data);
+  }
+  return error;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_parse_events_fd (FAST_JSON_TYPE json,
+			   const FAST_JSON_EVENTS_TYPE * events,
+			   void *user_data, int fd)
+{
+  FAST_JSON_ERROR_ENUM error = FAST_JSON_VALUE_ERROR;
+
+  if (json && events) {
+    json->getc = fast_json_getc_fd;
+    json->getc_data = (void *) json;
+    json->u_parse.fd.fd = fd;
+    json->u_parse.fd.pos = 0;
+    json->u_parse.fd.len = 0;
+    error = fast_json_parse_events_all (json, events, user_data);
+  }
+  return error;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_parse_events_user (FAST_JSON_TYPE json,
+			     const FAST_JSON_EVENTS_TYPE * events,
+			     void *user_data, fast_json_getc_func getc,
+			     void *getc_data)
+{
+  FAST_JSON_ERROR_ENUM error = FAST_JSON_VALUE_ERROR;
+
+  if (json && events && getc) {
+    json->getc = getc;
+    json->getc_data = getc_data;
+    error = fast_json_parse_events_all (json, events, user_data);
+  }
+  return error;
+}
+
+static void
+fast_json_store_error2 (FAST_JSON_TYPE json, FAST_JSON_ERROR_ENUM error,
+			const char *cp, const char *sep)
+{
+  int len = sizeof (json->error_str) - 1;
+  char *rp = json->error_str;
+  const char *s;
+
+  json->error = error;
+  while (len-- && *cp) {
+    *rp++ = *cp++;
+  }
+  *rp = '\0';
+  rp = json->error_str;
+  while (*rp) {
+    s = sep;
+    while (*s) {
+      if (*rp == *s) {
+	*rp = '\0';
+	break;
+      }
+      s++;
+    }
+    if (*rp == '\0') {
+      break;
+    }
+    rp++;
+  }
+  s = json->u_parse.json_str;
+  while (s != cp) {
+    json->position++;
+    json->column += fast_json_utf8_size[*s & 0xFFu] != 0;
+    if (*s == '\n') {
+      json->line++;
+      json->column = 0;
+    }
+    s++;
+  }
+}
+
+#if FAST_JSON_SIMD
+/* Classify 64 bytes at cp. Bit i of space is set if cp[i] is white space. */
+static void
+fast_json_simd_classify_sse2 (const char *cp, uint64_t * space)
+{
+  const __m128i sp = _mm_set1_epi8 (' ');
+  const __m128i tab = _mm_set1_epi8 ('\t');
+  const __m128i nl = _mm_set1_epi8 ('\n');
+  const __m128i cr = _mm_set1_epi8 ('\r');
+  uint64_t s = 0;
+  unsigned int i;
+
+  for (i = 0; i < FAST_JSON_SIMD_BLOCK; i += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (cp + i));
+    __m128i w = _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (v, sp),
+					    _mm_cmpeq_epi8 (v, tab)),
+			      _mm_or_si128 (_mm_cmpeq_epi8 (v, nl),
+					    _mm_cmpeq_epi8 (v, cr)));
+
+    s |= (uint64_t) (unsigned int) _mm_movemask_epi8 (w) << i;
+  }
+  *space = s;
+}
+
+__attribute ((target ("avx2")))
+static void
+fast_json_simd_classify_avx2 (const char *cp, uint64_t * space)
+{
+  const __m256i sp = _mm256_set1_epi8 (' ');
+  const __m256i tab = _mm256_set1_epi8 ('\t');
+  const __m256i nl = _mm256_set1_epi8 ('\n');
+  const __m256i cr = _mm256_set1_epi8 ('\r');
+  uint64_t s = 0;
+  unsigned int i;
+
+  for (i = 0; i < FAST_JSON_SIMD_BLOCK; i += 32) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) (cp + i));
+    __m256i w = _mm256_or_si256 (_mm256_or_si256 (_mm256_cmpeq_epi8 (v, sp),
+						  _mm256_cmpeq_epi8 (v, tab)),
+				 _mm256_or_si256 (_mm256_cmpeq_epi8 (v, nl),
+						  _mm256_cmpeq_epi8 (v, cr)));
+
+    s |= (uint64_t) (unsigned int) _mm256_movemask_epi8 (w) << i;
+  }
+  *space = s;
+}
+
+/* Make the 64 byte block at cp the current block. The caller makes sure
+ * that the block does not extend beyond json->json_end.
+ */
+static ALWAYS_INLINE void
+fast_json_simd_classify (FAST_JSON_TYPE json, const char *cp)
+{
+  if (json->simd == 2) {
+    fast_json_simd_classify_avx2 (cp, &json->simd_space);
+  }
+  else {
+    fast_json_simd_classify_sse2 (cp, &json->simd_space);
+  }
+  json->simd_block = cp;
+}
+#endif
+
+/* Return the first non white space character at or after cp. Long runs of
+ * white space are skipped with the masks of the current simd block.
+ */
+static ALWAYS_INLINE const char *
+fast_json_skip_space2 (FAST_JSON_TYPE json, const char *cp)
+{
+  if (LIKELY (!fast_json_isspace (*cp))) {
+    return cp;
+  }
+  cp++;
+#if FAST_JSON_SIMD
+  while (fast_json_isspace (*cp)) {
+    size_t offset = FAST_JSON_SIMD_BLOCK;
+    uint64_t bits;
+
+    /* simd_block is NULL when there is no block for this buffer yet */
+    if (json->simd_block != NULL) {
+      offset = (size_t) (cp - json->simd_block);
+    }
+    if (offset >= FAST_JSON_SIMD_BLOCK) {
+      if (json->json_end - cp < FAST_JSON_SIMD_BLOCK) {
 	break;
-      case 4:
-	if (ptr[1] && ptr[2] && ptr[3]) {
-	  unsigned char u1 = ptr[1];
-	  unsigned char u2 = ptr[2];
-	  unsigned char u3 = ptr[3];
+      }
+      fast_json_simd_classify (json, cp);
+      offset = 0;
+    }
+    bits = ~json->simd_space >> offset;
+    if (bits) {
+      return cp + __builtin_ctzll (bits);
+    }
+    cp = json->simd_block + FAST_JSON_SIMD_BLOCK;
+  }
+#endif
+  while (fast_json_isspace (*cp)) {
+    cp++;
+  }
+  return cp;
+}
 
-	  if (u1 >= 0x80u && u1 <= 0xBFu &&
-	      u2 >= 0x80u && u2 <= 0xBFu && u3 >= 0x80u && u3 <= 0xBFu) {
-	    size = 4;
-	    uc = ((u & 0x7u) << 18) | ((u1 & 0x3Fu) << 12) |
-	      ((u2 & 0x3Fu) << 6) | (u3 & 0x3Fu);
-	    error = uc < 0x10000 || uc > 0x10FFFFu;
+static FAST_JSON_ERROR_ENUM
+fast_json_skip_whitespace2 (FAST_JSON_TYPE json, const char **buf)
+{
+  FAST_JSON_ERROR_ENUM retval = FAST_JSON_OK;
+  const char *cp = *buf;
+
+  for (;;) {
+    if ((json->options & FAST_JSON_ALLOW_JSON5)) {
+      for (;;) {
+	const unsigned char *uc = (const unsigned char *) cp;
+
+        if (fast_json5_space[*uc & 0xff] == 0) {
+	  break;
+        }
+        if (fast_json5_isspace (*uc)) {
+          cp++;
+        }
+        else if (*uc == 0xc2 && uc[1] == 0xa0) {
+          /* Non-breaking space */
+          cp += 2;
+        }
+        else if ((*uc == 0xe2 && uc[1] == 0x80 &&
+                  (uc[2] == 0xa8 || uc[2] == 0xa9)) ||
+		 (*uc == 0xef && uc[1] == 0xbb && uc[2] == 0xbf)) {
+          /* Line separator */
+          /* Paragraph separator */
+          /* Byte order mark */
+          cp += 3;
+        }
+        else {
+          break;
+        }
+      }
+    }
+    else {
+      cp = fast_json_skip_space2 (json, cp);
+    }
+    if (UNLIKELY (*cp == '/') &&
+        LIKELY ((json->options & FAST_JSON_NO_COMMENT) == 0)) {
+      if (cp[1] == '*') {
+	cp += 2;
+	while (*cp) {
+	  if (*cp == '*' && cp[1] == '/') {
+	    cp += 2;
+	    break;
+	  }
+	  cp++;
+	}
+      }
+      else if (cp[1] == '/') {
+	cp += 2;
+	while (*cp) {
+	  if (*cp == '\n') {
+	    cp++;
+	    break;
 	  }
+	  cp++;
 	}
+      }
+      else {
+	fast_json_store_error2 (json, FAST_JSON_COMMENT_ERROR, cp, ":,]}");
+	retval = FAST_JSON_COMMENT_ERROR;
 	break;
       }
-      if (error) {
-	fast_json_store_error (json, FAST_JSON_UTF8_ERROR, ptr);
-	return FAST_JSON_UTF8_ERROR;
+    }
+    else {
+      break;
+    }
+  }
+  *buf = cp;
+  return retval;
+}
+
+/* Parse the number, string, true, false or null at *buf into v. A string
+ * is left in json->string.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_parse_scalar2 (FAST_JSON_TYPE json, const char **buf,
+			 FAST_JSON_DATA_TYPE v)
+{
+  const char *value = *buf;
+
+  switch (*value) {
+  case 'n':			/* FALLTHRU */
+  case 'N':
+    if (value[1] == 'u' && value[2] == 'l' && value[3] == 'l') {
+      value += strlen ("null");
+      v->type = FAST_JSON_NULL;
+    }
+    else if ((json->options & FAST_JSON_INF_NAN) != 0 &&
+	     strncasecmp (value, "nan", strlen ("nan")) == 0) {
+      const char *cp;
+      const char *save = value;
+
+      value += strlen ("nan");
+      cp = value;
+      if (*cp == '(') {
+	cp++;
+	while (fast_json_isalpha (*cp) || fast_json_isdigit (*cp) ||
+	       *cp == '_') {
+	  cp++;
+	}
+	if (*cp != ')') {
+	  fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
+	  return FAST_JSON_NUMBER_ERROR;
+	}
+	value = cp + 1;
       }
-      while (size--) {
-	*ptr2++ = *ptr++;
+      v->type = FAST_JSON_DOUBLE;
+      v->u.double_value = fast_json_nan (0);
+    }
+    else {
+      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
+      return FAST_JSON_VALUE_ERROR;
+    }
+    break;
+  case 'f':
+    if (value[1] == 'a' && value[2] == 'l' && value[3] == 's' &&
+	value[4] == 'e') {
+      value += strlen ("false");
+      v->type = FAST_JSON_BOOLEAN;
+      v->u.boolean_value = 0;
+    }
+    else {
+      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
+      return FAST_JSON_VALUE_ERROR;
+    }
+    break;
+  case 't':
+    if (value[1] == 'r' && value[2] == 'u' && value[3] == 'e') {
+      value += strlen ("true");
+      v->type = FAST_JSON_BOOLEAN;
+      v->u.boolean_value = 1;
+    }
+    else {
+      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
+      return FAST_JSON_VALUE_ERROR;
+    }
+    break;
+  case 'i':			/* FALLTHRU */
+  case 'I':
+    if ((json->options & FAST_JSON_INF_NAN) != 0 &&
+	strncasecmp (value, "inf", 3) == 0) {
+      value += strlen ("inf");
+      if (strncasecmp (value, "inity", strlen ("inity")) == 0) {
+	value += strlen ("inity");
       }
+      v->type = FAST_JSON_DOUBLE;
+      v->u.double_value = fast_json_inf (0);
     }
-    else if (*ptr == '\\') {
-      static const char special2[256] = {
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '/',
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, '\b', 0, 0, 0, '\f', 0, 0, 0, 0, 0, 0, 0, '\n', 0,
-	0, 0, '\r', 0, '\t', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-      };
-      ptr++;
-      if (special2[*ptr & 0xFFu]) {
-	*ptr2++ = special2[*ptr++ & 0xFFu];
+    else {
+      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
+      return FAST_JSON_VALUE_ERROR;
+    }
+    break;
+  case '\'':
+  case '"':
+    {
+      const char *save;
+      int sep = *value;
+
+      value++;
+      save = value;
+      if (fast_json_check_string (json, &value, json->json_end, sep) !=
+	  FAST_JSON_OK) {
+	fast_json_store_error2 (json, json->error, save, ":,]}");
+	return json->error;
       }
-      else if (*ptr == 'u') {
-	save_ptr = ptr - 1;
-	ptr++;
-	uc = fast_json_hex (json, &ptr, 4);
-	if (uc == 0xFFFFFFFFu) {
-	  return json->error;
-	}
-	if (uc >= 0xD800u && uc <= 0xDBFFu) {
-	  if (*ptr == '\\' && ptr[1] == 'u') {
-	    unsigned int uc2;
-	    ptr += 2;
+      if (*value != sep) {
+	fast_json_store_error2 (json, FAST_JSON_STRING_END_ERROR, value,
+				":,]}");
+	return FAST_JSON_STRING_END_ERROR;
+      }
+      v->type = FAST_JSON_STRING;
+      value++;
+    }
+    break;
+  case '.':
+      if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
+        fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, value, ":,]}");
+        return FAST_JSON_NUMBER_ERROR;
+      }
+      /* FALLTHRU */
+  case '+':			/* FALLTHRU */
+  case '-':			/* FALLTHRU */
+  case '0':			/* FALLTHRU */
+  case '1':			/* FALLTHRU */
+  case '2':			/* FALLTHRU */
+  case '3':			/* FALLTHRU */
+  case '4':			/* FALLTHRU */
+  case '5':			/* FALLTHRU */
+  case '6':			/* FALLTHRU */
+  case '7':			/* FALLTHRU */
+  case '8':			/* FALLTHRU */
+  case '9':
+    {
+      unsigned int integer = 1;
+      unsigned int hex = 0;
+      unsigned int sign = 0;
+      unsigned int ndigit = 0;
+      unsigned int overflow = 0;
+      uint64_t uval = 0;
+      unsigned int erange;
+      const char *save;
+      const char *end;
+      double n;
 
-	    uc2 = fast_json_hex (json, &ptr, 4);
-	    if (uc2 == 0xFFFFFFFFu) {
-	      return json->error;
-	    }
-	    if (uc2 >= 0xDC00u && uc2 <= 0xDFFFu) {
-	      uc = ((uc - 0xD800u) << 10) + (uc2 - 0xDC00u) + 0x10000u;
-	    }
-	    else {
-	      fast_json_store_error (json, FAST_JSON_UNICODE_ERROR, save_ptr);
-	      return FAST_JSON_UNICODE_ERROR;
+      save = value;
+      if (UNLIKELY (*value == '+')) {
+	if ((json->options & FAST_JSON_INF_NAN) != 0) {
+	  value++;
+	}
+      }
+      else if (*value == '-') {
+	sign = 1;
+	value++;
+      }
+      if (*value == '0') {
+	ndigit++;
+	value++;
+	if ((json->options & FAST_JSON_ALLOW_OCT_HEX) != 0) {
+	  if (*value == 'x' || *value == 'X') {
+	    hex = 1;
+	    value++;
+	    /* Let strtod report an error for 0x without digits */
+	    overflow = !fast_json_isxdigit (*value);
+	    while (fast_json_isxdigit (*value)) {
+	      overflow |= (uval >> 60) != 0;
+	      uval = (uval << 4) + fast_json_xdigit_value (*value);
+	      ndigit++;
+	      value++;
 	    }
 	  }
 	  else {
-	    fast_json_store_error (json, FAST_JSON_UNICODE_ERROR, save_ptr);
-	    return FAST_JSON_UNICODE_ERROR;
+	    while (*value >= '0' && *value <= '7') {
+	      overflow |= (uval >> 61) != 0;
+	      uval = (uval << 3) + (*value - '0');
+	      ndigit++;
+	      value++;
+	    }
 	  }
 	}
-	if (uc >= 0xDC00u && uc <= 0xDFFFu) {
-	  fast_json_store_error (json, FAST_JSON_UNICODE_ERROR, save_ptr);
-	  return FAST_JSON_UNICODE_ERROR;
+	else if (fast_json_isdigit (*value) || *value == 'x' || *value == 'X') {
+	  /* Let strtod report the number error */
+	  overflow = 1;
 	}
-	if (uc < 0x80u) {
-	  if (uc == 0) {
-	    *ptr2++ = '\\';
-	    *ptr2++ = 'u';
-	    *ptr2++ = '0';
-	    *ptr2++ = '0';
-	    *ptr2++ = '0';
-	    *ptr2++ = '0';
+      }
+      else if (LIKELY (fast_json_isdigit (*value))) {
+	do {
+	  uval = uval * 10 + (*value - '0');
+	  ndigit++;
+	  value++;
+	} while (fast_json_isdigit (*value));
+	overflow = ndigit > 19;
+      }
+      else if ((json->options & FAST_JSON_ALLOW_JSON5) && *value == '.') {
+      }
+      else {
+	if ((json->options & FAST_JSON_INF_NAN) != 0) {
+	  if (strncasecmp (value, "inf", strlen ("inf")) == 0) {
+	    value += strlen ("inf");
+	    if (strncasecmp (value, "inity", strlen ("inity")) == 0) {
+	      value += strlen ("inity");
+	    }
+	    v->type = FAST_JSON_DOUBLE;
+	    v->u.double_value = fast_json_inf (sign);
+	    break;
 	  }
-	  else {
-	    if (uc == '\\' || uc == '"') {
-	      *ptr2++ = '\\';
+	  else if (strncasecmp (value, "nan", strlen ("nan")) == 0) {
+	    const char *cp;
+
+	    value += strlen ("nan");
+	    cp = value;
+	    if (*cp == '(') {
+	      cp++;
+	      while (fast_json_isalpha (*cp) || fast_json_isdigit (*cp) ||
+		     *cp == '_') {
+		cp++;
+	      }
+	      if (*cp != ')') {
+		fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save,
+					":,]}");
+		return FAST_JSON_NUMBER_ERROR;
+	      }
+	      value = cp + 1;
 	    }
-	    *ptr2++ = uc;
+	    v->type = FAST_JSON_DOUBLE;
+	    v->u.double_value = fast_json_nan (sign);
+	    break;
 	  }
 	}
-	else if (uc < 0x800u) {
-	  *ptr2++ = ((uc >> 6) & 0x1Fu) | 0xC0u;
-	  *ptr2++ = ((uc >> 0) & 0x3Fu) | 0x80u;
-	}
-	else if (uc < 0x10000u) {
-	  *ptr2++ = ((uc >> 12) & 0x0Fu) | 0xE0u;
-	  *ptr2++ = ((uc >> 6) & 0x3Fu) | 0x80u;
-	  *ptr2++ = ((uc >> 0) & 0x3Fu) | 0x80u;
-	}
-	else if (uc <= 0x10FFFFu) {
-	  *ptr2++ = ((uc >> 18) & 0x07u) | 0xF0u;
-	  *ptr2++ = ((uc >> 12) & 0x3Fu) | 0x80u;
-	  *ptr2++ = ((uc >> 6) & 0x3Fu) | 0x80u;
-	  *ptr2++ = ((uc >> 0) & 0x3Fu) | 0x80u;
+	fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
+	return FAST_JSON_NUMBER_ERROR;
+      }
+      if (*value == '.') {
+	value++;
+	integer = 0;
+	if (UNLIKELY (hex)) {
+	  if (fast_json_isxdigit (*value)) {
+	    do {
+	      ndigit++;
+	      value++;
+	    } while (fast_json_isxdigit (*value));
+	  }
+	  else if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
+	    fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save,
+				    ":,]}");
+	    return FAST_JSON_NUMBER_ERROR;
+	  }
 	}
 	else {
-	  /* Not possible */
-	  fast_json_store_error (json, FAST_JSON_UNICODE_ERROR, save_ptr);
-	  return FAST_JSON_UNICODE_ERROR;
+	  if (fast_json_isdigit (*value)) {
+	    do {
+	      ndigit++;
+	      value++;
+	    } while (fast_json_isdigit (*value));
+	  }
+	  else if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
+	    fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save,
+				    ":,]}");
+	    return FAST_JSON_NUMBER_ERROR;
+	  }
 	}
       }
-      else if ((json->options & FAST_JSON_ALLOW_JSON5) && *ptr == 'x') {
-        ptr++;
-	uc = fast_json_hex (json, &ptr, 2);
-	if (uc == 0xFFFFFFFFu) {
-	  return json->error;
+      if (*value == 'e' || *value == 'E' ||
+	  (hex && (*value == 'p' || *value == 'P'))) {
+	integer = 0;
+	value++;
+	if (*value == '+' || *value == '-') {
+	  value++;
 	}
-	if (uc < 0x80u) {
-	  if (uc == 0) {
-	    *ptr2++ = '\\';
-	    *ptr2++ = 'u';
-	    *ptr2++ = '0';
-	    *ptr2++ = '0';
-	    *ptr2++ = '0';
-	    *ptr2++ = '0';
-	  }
-	  else {
-	    if (uc == '\\' || uc == '"') {
-	      *ptr2++ = '\\';
-	    }
-	    *ptr2++ = uc;
-	  }
+	if (fast_json_isdigit (*value)) {
+	  do {
+	    value++;
+	  } while (fast_json_isdigit (*value));
 	}
 	else {
-	  *ptr2++ = ((uc >> 6) & 0x1Fu) | 0xC0u;
-	  *ptr2++ = ((uc >> 0) & 0x3Fu) | 0x80u;
+	  fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
+	  return FAST_JSON_NUMBER_ERROR;
 	}
       }
-      else if (*ptr == '\\' || *ptr == sep) {
-	*ptr2++ = '\\';
-	*ptr2++ = *ptr++;
+      if (ndigit == 0) {
+	fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
+	return FAST_JSON_NUMBER_ERROR;
       }
-      else if ((json->options & FAST_JSON_ALLOW_JSON5) &&
-               fast_json_isalpha (*ptr)) {
-	*ptr2++ = *ptr++;
+      /* Integers that do not fit in 64 bits are parsed as double */
+      if ((json->options & FAST_JSON_PARSE_INT_AS_DOUBLE) == 0 && integer &&
+	  !overflow && uval <= (uint64_t) INT64_MAX + sign) {
+	v->type = FAST_JSON_INTEGER;
+	v->u.int_value = sign ? 0 - uval : uval;
+	break;
       }
-      else if ((json->options & FAST_JSON_ALLOW_JSON5) && *ptr == '0') {
-	ptr++;
-	*ptr2++ = '\\';
-	*ptr2++ = 'u';
-	*ptr2++ = '0';
-	*ptr2++ = '0';
-	*ptr2++ = '0';
-	*ptr2++ = '0';
+      n = fast_json_strtod (save, &end, &erange);
+      if (end != value || erange) {
+	fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
+	return FAST_JSON_NUMBER_ERROR;
       }
-      else {
-	const unsigned char *uc = (const unsigned char *) ptr;
+      v->type = FAST_JSON_DOUBLE;
+      v->u.double_value = n;
+    }
+    break;
+  default:
+    fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
+    return FAST_JSON_VALUE_ERROR;
+  }
+  *buf = value;
+  return FAST_JSON_OK;
+}
 
-	if ((json->options & FAST_JSON_ALLOW_JSON5) &&
-            (*uc == '\n' ||
-             *uc == '\r' ||
-	     (*uc == '\r' && uc[1] == '\n') ||
-             (*uc == 0xe2 && uc[1] == 0x80 &&
-	      (uc[2] == 0xa8 || uc[2] == 0xa9)))) {
-          if (*uc == '\r' && uc[1] == '\n') {
-	    ptr += 2;
-          }
-          else if (*uc == 0xe2) {
-	    ptr += 3;
-	  }
-	  else {
-            ptr++;
-	  }
-        }
-        else {
-	  fast_json_store_error (json, FAST_JSON_ESCAPE_CHARACTER_ERROR, ptr);
-	  return FAST_JSON_ESCAPE_CHARACTER_ERROR;
-	}
-      }
+static FAST_JSON_DATA_TYPE
+fast_json_parse_value2 (FAST_JSON_TYPE json, const char **buf)
+{
+  struct fast_json_data_struct scalar;
+  FAST_JSON_DATA_TYPE v;
+
+  if (**buf == '[' || **buf == '{') {
+    return fast_json_parse_nested2 (json, buf);
+  }
+  if (fast_json_parse_scalar2 (json, buf, &scalar) != FAST_JSON_OK) {
+    return NULL;
+  }
+  switch (scalar.type) {
+  case FAST_JSON_STRING:
+    v = fast_json_string_value (json);
+    if (v == NULL) {
+      fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, *buf - 1,
+			      ":,]}");
     }
-    else if (*ptr == '"' || *ptr == '\'') {
-      if (((json->options & FAST_JSON_ALLOW_JSON5) == 0 && *ptr == '"') ||
-          ((json->options & FAST_JSON_ALLOW_JSON5) && *ptr == sep)) {
-        fast_json_store_error (json, FAST_JSON_ESCAPE_CHARACTER_ERROR, ptr);
-        return FAST_JSON_CONTROL_CHARACTER_ERROR;
+    break;
+  case FAST_JSON_INTEGER:
+    v = fast_json_create_integer_value (json, scalar.u.int_value);
+    break;
+  case FAST_JSON_DOUBLE:
+    v = fast_json_create_double_value (json, scalar.u.double_value);
+    break;
+  case FAST_JSON_BOOLEAN:
+    v = scalar.u.boolean_value ? fast_json_create_true (json) :
+      fast_json_create_false (json);
+    break;
+  default:
+    v = fast_json_create_null (json);
+    break;
+  }
+  return v;
+}
+
+/* Validate and decode the object name at *buf into json->string. */
+static FAST_JSON_ERROR_ENUM
+fast_json_check_name2 (FAST_JSON_TYPE json, const char **buf)
+{
+  const char *value = *buf;
+  const char *save;
+  const char *end;
+
+  if ((json->options & FAST_JSON_ALLOW_JSON5) && *value != '"') {
+    save = value;
+    while (*value && *value != ':') {
+      const unsigned char *uc = (const unsigned char *) value;
+
+      if (fast_json5_isspace (*uc) ||
+	  (*uc == 0xc2 && uc[1] == 0xa0) ||
+	  (*uc == 0xe2 && uc[1] == 0x80 &&
+	   (uc[2] == 0xa8 || uc[2] == 0xa9)) ||
+	  (*uc == 0xef && uc[1] == 0xbb && uc[2] == 0xbf)) {
+	/* Non-breaking space */
+	/* Line separator */
+	/* Paragraph separator */
+	/* Byte order mark */
+	break;
       }
-      if (*ptr == '\"') {
-	*ptr2++ = '\\';
+      if (*value++ == '\\') {
+	if (*value == '\0') {
+	  break;
+	}
+	value++;
       }
-      *ptr2++ = *ptr++;
     }
-    else {
-      fast_json_store_error (json, FAST_JSON_CONTROL_CHARACTER_ERROR, ptr);
-      return FAST_JSON_CONTROL_CHARACTER_ERROR;
+    end = value;
+    value = save;
+    if (fast_json_check_string (json, &value, end, '"') != FAST_JSON_OK) {
+      fast_json_store_error2 (json, json->error, save, ":,]}");
+      return json->error;
+    }
+    if (value != end) {
+      fast_json_store_error2 (json, FAST_JSON_ESCAPE_CHARACTER_ERROR, save,
+			      ":,]}");
+      return FAST_JSON_ESCAPE_CHARACTER_ERROR;
     }
   }
-  *ptr2 = 0;
-  return FAST_JSON_OK;
+  else {
+    if (*value != '"') {
+      /* Do not read beyond the end of the string */
+      fast_json_store_error2 (json, FAST_JSON_STRING_START_ERROR,
+			      *value ? value + 1 : value, ":,]}");
+      return FAST_JSON_STRING_START_ERROR;
+    }
+    value++;
+    save = value;
+    if (fast_json_check_string (json, &value, json->json_end, '"') !=
+	FAST_JSON_OK) {
+      fast_json_store_error2 (json, json->error, save, ":,]}");
+      return json->error;
+    }
+    if (*value != '"') {
+      fast_json_store_error2 (json, FAST_JSON_STRING_END_ERROR, save,
+			      ":,]}");
+      return FAST_JSON_STRING_END_ERROR;
+    }
+    value++;
+  }
+  *buf = value;
+  return FAST_JSON_OK;
+}
+
+/* Parse the object name at *buf. Returns name or a malloced copy if the
+ * name does not fit. Returns NULL on error.
+ */
+static char *
+fast_json_parse_name2 (FAST_JSON_TYPE json, const char **buf, char *name,
+		       size_t size)
+{
+  const char *save = *buf;
+  char *out;
+
+  if (fast_json_check_name2 (json, buf) != FAST_JSON_OK) {
+    return NULL;
+  }
+  out = fast_json_string_name (json, name, size);
+  if (out == NULL) {
+    fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, save, ":,]}");
+  }
+  return out;
 }
 
+/* Parse the array or object at *buf. Works like fast_json_parse_nested. */
 static FAST_JSON_DATA_TYPE
-fast_json_parse_value (FAST_JSON_TYPE json, int c)
+fast_json_parse_nested2 (FAST_JSON_TYPE json, const char **buf)
 {
-  char *save;
+  const char *value = *buf;
+  FAST_JSON_ERROR_ENUM error;
   FAST_JSON_DATA_TYPE v;
+  FAST_JSON_DATA_TYPE top;
+  size_t depth = 0;
+  char name[16];
+  char *out = &name[0];
+  char *key = &name[0];
+  size_t len = 0;
+  int close;
 
-  fast_json_getc_save_start (json, c);
-  switch (c) {
-  case 'n':			/* FALLTHRU */
-  case 'N':
-    while (fast_json_isalpha (c)) {
-      c = fast_json_getc_save (json);
-    }
-    save = fast_json_ungetc_save (json, c);
-    if (json->n_save == 4 &&
-	save[1] == 'u' && save[2] == 'l' && save[3] == 'l') {
-      v = fast_json_create_null (json);
-    }
-    else if ((json->options & FAST_JSON_INF_NAN) != 0 &&
-	     strcasecmp (save, "nan") == 0) {
-      c = fast_json_getc_save (json);
-      if (c == '(') {
-	c = fast_json_getc_save (json);
-	while (fast_json_isalpha (c) || fast_json_isdigit (c) || c == '_') {
-	  c = fast_json_getc_save (json);
-	}
-	if (c != ')') {
-	  save = fast_json_ungetc_save (json, 0);
-	  fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-	  return NULL;
-	}
+  for (;;) {
+    /* Parse the value at value and add it to its container */
+    close = *value == '[' ? ']' : *value == '{' ? '}' : 0;
+    if (close) {
+      error = fast_json_stack_check (json, depth);
+      if (error != FAST_JSON_OK) {
+	fast_json_store_error2 (json, error, value, ":,]}");
+	break;
       }
-      else {
-	fast_json_ungetc (json, c);
+      v = close == ']' ? fast_json_create_array (json) :
+	fast_json_create_object (json);
+      if (v == NULL) {
+	fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, value, ":,]}");
+	break;
       }
-      v = fast_json_create_double_value (json, fast_json_nan (0));
-    }
-    else {
-      fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
-      return NULL;
-    }
-    break;
-  case 'f':
-    while (fast_json_isalpha (c)) {
-      c = fast_json_getc_save (json);
-    }
-    save = fast_json_ungetc_save (json, c);
-    if (json->n_save == 5 &&
-	save[1] == 'a' && save[2] == 'l' && save[3] == 's' &&
-	save[4] == 'e') {
-      v = fast_json_create_false (json);
-    }
-    else {
-      fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
-      return NULL;
-    }
-    break;
-  case 't':
-    while (fast_json_isalpha (c)) {
-      c = fast_json_getc_save (json);
-    }
-    save = fast_json_ungetc_save (json, c);
-    if (json->n_save == 4 &&
-	save[1] == 'r' && save[2] == 'u' && save[3] == 'e') {
-      v = fast_json_create_true (json);
+      if (json->insitu && close == '}') {
+	v->is_str = FAST_JSON_STR_INSITU;
+      }
+      value++;
     }
     else {
-      fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
-      return NULL;
+      v = fast_json_parse_value2 (json, &value);
+      if (v == NULL) {
+	break;
+      }
     }
-    break;
-  case 'i':			/* FALLTHRU */
-  case 'I':
-    while (fast_json_isalpha (c)) {
-      c = fast_json_getc_save (json);
+    if (depth) {
+      top = json->stack[depth - 1].value;
+      error = top->type == FAST_JSON_ARRAY ?
+	fast_json_add_array_end (json, top, v) :
+	fast_json_add_object_end (json, top, key, len, v);
+      if (out != &name[0]) {
+	(*json->my_free) (out);
+	out = &name[0];
+      }
+      if (error != FAST_JSON_OK) {
+	fast_json_value_free (json, v);
+	break;
+      }
     }
-    save = fast_json_ungetc_save (json, c);
-    if ((json->options & FAST_JSON_INF_NAN) != 0 &&
-	(strcasecmp (save, "inf") == 0 ||
-	 strcasecmp (save, "infinity") == 0)) {
-      v = fast_json_create_double_value (json, fast_json_inf (0));
+    if (close) {
+      json->stack[depth++].value = v;
     }
-    else {
-      fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
-      return NULL;
+    if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
+      break;
     }
-    break;
-  case '\'':
-  case '"':
-    {
-      char str[8];
-      char *out = &str[0];
-      int sep = c;
-      int nq = 0;
 
-      c = fast_json_getc (json);
-      fast_json_getc_save_start (json, c);
-      while (c > 0 && c != sep) {
-        nq += (c == '"');
-	if (c == '\\') {
-	  c = fast_json_getc_save (json);
-	  nq += c == 'x' ? 2 : (c == '0' ? 4 : 0);
+    /* Close arrays and objects until the next element is found */
+    if (close == 0 || *value == close) {
+      error = FAST_JSON_OK;
+      for (;;) {
+	top = json->stack[depth - 1].value;
+	close = top->type == FAST_JSON_ARRAY ? ']' : '}';
+	if (*value == ',') {
+	  value++;
+	  error = fast_json_skip_whitespace2 (json, &value);
+	  if (error != FAST_JSON_OK ||
+	      (json->options & FAST_JSON_ALLOW_JSON5) == 0 || *value != close) {
+	    break;
+	  }
 	}
-	c = fast_json_getc_save (json);
-      }
-      save = fast_json_ungetc_save (json, c);
-      if (json->n_save + nq >= sizeof (str)) {
-	out = (char *) (*json->my_malloc) (json->n_save + nq + 1);
-	if (out == NULL) {
-	  json->error = FAST_JSON_MALLOC_ERROR;
-	  return NULL;
+	if (*value != close) {
+	  error = close == ']' ? FAST_JSON_ARRAY_END_ERROR :
+	    FAST_JSON_OBJECT_END_ERROR;
+	  fast_json_store_error2 (json, error, value, ":,]}");
+	  break;
 	}
-      }
-      if (fast_json_check_string (json, save, save + json->n_save, out, sep) !=
-	  FAST_JSON_OK) {
-	if (out != &str[0]) {
-	  (*json->my_free) (out);
+	value++;
+	if (--depth == 0) {
+	  *buf = value;
+	  return top;
+	}
+	error = fast_json_skip_whitespace2 (json, &value);
+	if (error != FAST_JSON_OK) {
+	  break;
 	}
-	return NULL;
       }
-      c = fast_json_getc (json);
-      if (c != sep) {
-	fast_json_store_error (json, FAST_JSON_STRING_END_ERROR, save);
-	if (out != &str[0]) {
-	  (*json->my_free) (out);
+      if (error != FAST_JSON_OK) {
+	break;
+      }
+    }
+
+    /* value starts the next element of the container on top of the stack */
+    if (json->stack[depth - 1].value->type == FAST_JSON_OBJECT) {
+      key = fast_json_parse_name2 (json, &value, name, sizeof (name));
+      if (key == NULL) {
+	break;
+      }
+      len = json->n_string;
+      if ((json->insitu == 0 || key != json->insitu_string) &&
+	  len >= FAST_JSON_NAME_INLINE) {
+	/* The name is not in the buffer, so the object must own its names */
+	out = key;
+	top = json->stack[depth - 1].value;
+	if (top->is_str == FAST_JSON_STR_INSITU &&
+	    fast_json_object_own_names (json, top) != FAST_JSON_OK) {
+	  fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, value, ":,]}");
+	  break;
 	}
-	return NULL;
       }
-      v = fast_json_data_create (json);
+      if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
+	break;
+      }
+      if (*value != ':') {
+	fast_json_store_error2 (json, FAST_JSON_OBJECT_SEPERATOR_ERROR,
+				value, ":,]}");
+	break;
+      }
+      value++;
+      if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
+	break;
+      }
+    }
+  }
+  if (out != &name[0]) {
+    (*json->my_free) (out);
+  }
+  if (depth) {
+    fast_json_value_free (json, json->stack[0].value);
+  }
+  return NULL;
+}
+
+/* Add the text from s to e to the line, column and position. */
+static void
+fast_json_count_position (FAST_JSON_TYPE json, const char *s, const char *e)
+{
+  const char *nl;
+
+  json->position += e - s;
+  while ((nl = (const char *) memchr (s, '\n', e - s))) {
+    json->line++;
+    json->column = 0;
+    s = nl + 1;
+  }
+  while (s != e) {
+    json->column += fast_json_utf8_size[*s & 0xFFu] != 0;
+    s++;
+  }
+}
+
+static FAST_JSON_DATA_TYPE
+fast_json_parse_all2 (FAST_JSON_TYPE json, unsigned int next)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+  const char *json_str = json->u_parse.json_str;
+
+  if (next == 0) {
+    json->error = FAST_JSON_OK;
+    json->error_str[0] = '\0';
+    json->line = 1;
+    json->column = 0;
+    json->position = 0;
+  }
+  if (fast_json_skip_whitespace2 (json, &json_str) == FAST_JSON_OK) {
+    if (*json_str != '\0') {
+      v = fast_json_parse_value2 (json, &json_str);
       if (v) {
-	v->type = FAST_JSON_STRING;
-	v->used = 0;
-	if (out != &str[0]) {
-	  v->is_str = 0;
-	  v->u.string_value = out;
+	if ((json->options & FAST_JSON_NO_EOF_CHECK) == 0) {
+	  if (fast_json_skip_whitespace2 (json, &json_str) == FAST_JSON_OK) {
+	    if (*json_str != '\0') {
+	      fast_json_store_error2 (json, FAST_JSON_OBJECT_END_ERROR,
+				      json_str, ":,]}");
+	      fast_json_value_free (json, v);
+	      v = NULL;
+	    }
+	    else {
+	      json->u_parse.json_str = json_str;
+	    }
+	  }
+	  else {
+	    fast_json_value_free (json, v);
+	    v = NULL;
+	  }
 	}
 	else {
-	  v->is_str = 1;
-	  memcpy (v->u.i_string_value, out, json->n_save + 1);
+	  fast_json_count_position (json, json->u_parse.json_str, json_str);
+	  json->u_parse.json_str = json_str;
 	}
       }
     }
-    break;
-  case '.':
-    if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
-      save = fast_json_ungetc_save (json, 0);
-      fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-      return NULL;
+    else {
+      json->error = FAST_JSON_NO_DATA_ERROR;
     }
-    /* FALLTHRU */
-  case '+':			/* FALLTHRU */
-  case '-':			/* FALLTHRU */
-  case '0':			/* FALLTHRU */
-  case '1':			/* FALLTHRU */
-  case '2':			/* FALLTHRU */
-  case '3':			/* FALLTHRU */
-  case '4':			/* FALLTHRU */
-  case '5':			/* FALLTHRU */
-  case '6':			/* FALLTHRU */
-  case '7':			/* FALLTHRU */
-  case '8':			/* FALLTHRU */
-  case '9':
-    {
-      unsigned int integer = 1;
-      unsigned int hex = 0;
-      unsigned int sign = 0;
-      unsigned int ndigit = 0;
-      char *end;
-      double n;
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_string2 (FAST_JSON_TYPE json, const char *json_str)
+{
+  if (json && json_str) {
+    json->u_parse.json_str = json_str;
+    json->json_end = json_str + strlen (json_str);
+    json->simd_block = NULL;
+    json->window.active = 0;
+    return fast_json_parse_all2 (json, 0);
+  }
+  return NULL;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_string2_next (FAST_JSON_TYPE json)
+{
+  if (json) {
+    return fast_json_parse_all2 (json, 1);
+  }
+  return NULL;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_insitu (FAST_JSON_TYPE json, char *buf, size_t len)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && buf) {
+    json->u_parse.json_str = buf;
+    json->json_end = buf + len;
+    json->simd_block = NULL;
+    json->window.active = 0;
+    json->insitu = 1;
+    v = fast_json_parse_all2 (json, 0);
+    json->insitu = 0;
+  }
+  return v;
+}
+
+/* Skip the string at cp that ends with quote without decoding it. Returns
+ * the position after the string or NULL if there is no end quote.
+ */
+static const char *
+fast_json_skip_string2 (FAST_JSON_TYPE json, const char *cp, int quote)
+{
+  const char *save = cp;
+
+  for (;;) {
+    cp += fast_json_scan_plain (json, cp, json->json_end);
+    while (fast_json_scan_special[*cp & 0xFFu] == 0) {
+      cp++;
+    }
+    if (*cp == quote) {
+      return cp + 1;
+    }
+    if (*cp == '\\' && cp[1] != '\0') {
+      cp++;
+    }
+    else if (*cp == '\0') {
+      fast_json_store_error2 (json, FAST_JSON_STRING_END_ERROR, save, ":,]}");
+      return NULL;
+    }
+    cp++;
+  }
+}
 
-      fast_json_getc_save_start (json, c);
-      if (UNLIKELY (c == '+')) {
-	if ((json->options & FAST_JSON_INF_NAN) != 0) {
-	  c = fast_json_getc_save (json);
-	}
+/* Skip the value at *buf without building it. Only strings and brackets
+ * are checked. The value is checked when it is really parsed. The container
+ * stack is used from entry base on. Inside arrays and objects only quotes,
+ * brackets and comments are looked at. The bytes in between are skipped
+ * with fast_json_scan_plain.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_skip_value2 (FAST_JSON_TYPE json, const char **buf, size_t base)
+{
+  FAST_JSON_ERROR_ENUM error;
+  const char *cp = *buf;
+  size_t depth = base;
+  int c;
+
+  error = fast_json_skip_whitespace2 (json, &cp);
+  if (error != FAST_JSON_OK) {
+    return error;
+  }
+  c = *cp;
+  if (c != '[' && c != '{') {
+    if (c == '"' || c == '\'') {
+      cp = fast_json_skip_string2 (json, cp + 1, c);
+      if (cp == NULL) {
+	return FAST_JSON_STRING_END_ERROR;
       }
-      else if (c == '-') {
-	sign = 1;
-	c = fast_json_getc_save (json);
+    }
+    else if (c == ']' || c == '}' || c == ',' || c == ':' || c == '\0') {
+      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, cp, ":,]}");
+      return FAST_JSON_VALUE_ERROR;
+    }
+    else {
+      do {
+	cp++;
+      } while (*cp && !fast_json5_isspace (*cp) && *cp != ',' &&
+	       *cp != ':' && *cp != '[' && *cp != ']' && *cp != '{' &&
+	       *cp != '}' && *cp != '"' && *cp != '\'' && *cp != '/');
+    }
+    *buf = cp;
+    return FAST_JSON_OK;
+  }
+  for (;;) {
+    c = *cp;
+    switch (c) {
+    case '\'':			/* FALLTHRU */
+    case '"':
+      cp = fast_json_skip_string2 (json, cp + 1, c);
+      if (cp == NULL) {
+	return FAST_JSON_STRING_END_ERROR;
       }
-      if (c == '0') {
-	ndigit++;
-	c = fast_json_getc_save (json);
-	if ((json->options & FAST_JSON_ALLOW_OCT_HEX) != 0) {
-	  if (c == 'x' || c == 'X') {
-	    hex = 1;
-	    c = fast_json_getc_save (json);
-	    while (fast_json_isxdigit (c)) {
-	      ndigit++;
-	      c = fast_json_getc_save (json);
-	    }
-	  }
-	  else {
-	    while (c >= '0' && c <= '7') {
-	      ndigit++;
-	      c = fast_json_getc_save (json);
-	    }
-	  }
-	}
+      break;
+    case '[':			/* FALLTHRU */
+    case '{':
+      error = fast_json_stack_check (json, depth);
+      if (error != FAST_JSON_OK) {
+	fast_json_store_error2 (json, error, cp, ":,]}");
+	return error;
       }
-      else if (LIKELY (fast_json_isdigit (c))) {
-	do {
-	  ndigit++;
-	  c = fast_json_getc_save (json);
-	} while (fast_json_isdigit (c));
+      json->stack[depth++].close = c == '[' ? ']' : '}';
+      cp++;
+      break;
+    case ']':			/* FALLTHRU */
+    case '}':
+      if (json->stack[depth - 1].close != c) {
+	error = json->stack[depth - 1].close == ']' ?
+	  FAST_JSON_ARRAY_END_ERROR : FAST_JSON_OBJECT_END_ERROR;
+	fast_json_store_error2 (json, error, cp, ":,]}");
+	return error;
       }
-      else if ((json->options & FAST_JSON_ALLOW_JSON5) && c == '.') {
+      cp++;
+      if (--depth == base) {
+	*buf = cp;
+	return FAST_JSON_OK;
       }
-      else {
-	size_t last_n_save = json->n_save > 0 ? json->n_save - 1 : 0;
+      break;
+    case '/':
+      {
+	const char *save = cp;
 
-	while (fast_json_isalpha (c)) {
-	  c = fast_json_getc_save (json);
+	error = fast_json_skip_whitespace2 (json, &cp);
+	if (error != FAST_JSON_OK) {
+	  return error;
 	}
-	fast_json_ungetc_save (json, c);
-	if ((json->options & FAST_JSON_INF_NAN) != 0) {
-	  if (strcasecmp (&json->save[last_n_save], "inf") == 0 ||
-	      strcasecmp (&json->save[last_n_save], "infinity") == 0) {
-	    return fast_json_create_double_value (json, fast_json_inf (sign));
-	  }
-	  else if (strcasecmp (&json->save[last_n_save], "nan") == 0) {
-	    c = fast_json_getc_save (json);
-	    if (c == '(') {
-	      c = fast_json_getc_save (json);
-	      while (fast_json_isalpha (c) || fast_json_isdigit (c) ||
-		     c == '_') {
-		c = fast_json_getc_save (json);
-	      }
-	      if (c != ')') {
-		save = fast_json_ungetc_save (json, 0);
-		fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-		return NULL;
-	      }
-	    }
-	    else {
-	      fast_json_ungetc (json, c);
-	    }
-	    return fast_json_create_double_value (json, fast_json_nan (sign));
-	  }
+	if (cp == save) {
+	  /* Comments are not allowed */
+	  cp++;
 	}
-	fast_json_getc_save (json);
-	save = fast_json_ungetc_save (json, 0);
-	fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-	return NULL;
       }
-      if (c == '.') {
-	json->save[json->n_save - 1] = json->decimal_point;
-	c = fast_json_getc_save (json);
-	integer = 0;
-	if (UNLIKELY (hex)) {
-	  if (fast_json_isxdigit (c)) {
-	    do {
-	      ndigit++;
-	      c = fast_json_getc_save (json);
-	    } while (fast_json_isxdigit (c));
-	  }
-	  else if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
-	    save = fast_json_ungetc_save (json, 0);
-	    fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-	    return NULL;
-	  }
-	}
-	else {
-	  if (fast_json_isdigit (c)) {
-	    do {
-	      ndigit++;
-	      c = fast_json_getc_save (json);
-	    } while (fast_json_isdigit (c));
-	  }
-	  else if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
-	    save = fast_json_ungetc_save (json, 0);
-	    fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-	    return NULL;
-	  }
+      break;
+    case '\0':
+      error = json->stack[depth - 1].close == ']' ?
+	FAST_JSON_ARRAY_END_ERROR : FAST_JSON_OBJECT_END_ERROR;
+      fast_json_store_error2 (json, error, cp, ":,]}");
+      return error;
+    default:
+      cp++;
+      break;
+    }
+    cp += fast_json_scan_plain (json, cp, json->json_end);
+    while (fast_json_scan_special[*cp & 0xFFu] == 0) {
+      cp++;
+    }
+  }
+}
+
+const char *
+fast_json_skip_value (FAST_JSON_TYPE json, const char *json_str,
+		      const char *json_end)
+{
+  const char *cp = json_str;
+
+  if (json == NULL || json_str == NULL) {
+    return NULL;
+  }
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  json->u_parse.json_str = json_str;
+  json->json_end = json_end ? json_end : json_str + strlen (json_str);
+  json->simd_block = NULL;
+  json->window.active = 0;
+  if (fast_json_skip_value2 (json, &cp, 0) != FAST_JSON_OK) {
+    return NULL;
+  }
+  return cp;
+}
+
+/* Reset the error information and let the parser work on the document of
+ * cursor. Error positions are relative to the start of the document.
+ */
+static void
+fast_json_cursor_bind (FAST_JSON_TYPE json,
+		       const FAST_JSON_CURSOR_TYPE * cursor)
+{
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  if (json->u_parse.json_str != cursor->doc ||
+      json->json_end != cursor->end) {
+    json->u_parse.json_str = cursor->doc;
+    json->json_end = cursor->end;
+    json->simd_block = NULL;
+    json->window.active = 0;
+  }
+}
+
+/* Move cursor to the array or object element at cp. The name of an object
+ * element is left decoded in json->string.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_cursor_element (FAST_JSON_TYPE json,
+			  FAST_JSON_CURSOR_TYPE * cursor, const char *cp)
+{
+  FAST_JSON_ERROR_ENUM error;
+
+  cursor->next = NULL;
+  cursor->name = NULL;
+  if (cursor->close == '}') {
+    cursor->name = cp;
+    error = fast_json_check_name2 (json, &cp);
+    if (error != FAST_JSON_OK) {
+      return error;
+    }
+    error = fast_json_skip_whitespace2 (json, &cp);
+    if (error != FAST_JSON_OK) {
+      return error;
+    }
+    if (*cp != ':') {
+      fast_json_store_error2 (json, FAST_JSON_OBJECT_SEPERATOR_ERROR, cp,
+			      ":,]}");
+      return FAST_JSON_OBJECT_SEPERATOR_ERROR;
+    }
+    cp++;
+    error = fast_json_skip_whitespace2 (json, &cp);
+    if (error != FAST_JSON_OK) {
+      return error;
+    }
+  }
+  cursor->value = cp;
+  return FAST_JSON_OK;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_cursor_start (FAST_JSON_TYPE json, const char *json_str,
+			FAST_JSON_CURSOR_TYPE * cursor)
+{
+  FAST_JSON_ERROR_ENUM error;
+  const char *cp = json_str;
+
+  if (json == NULL || json_str == NULL || cursor == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  memset (cursor, 0, sizeof (*cursor));
+  cursor->doc = json_str;
+  cursor->end = json_str + strlen (json_str);
+  fast_json_cursor_bind (json, cursor);
+  error = fast_json_skip_whitespace2 (json, &cp);
+  if (error != FAST_JSON_OK) {
+    return error;
+  }
+  if (*cp == '\0') {
+    json->error = FAST_JSON_NO_DATA_ERROR;
+    return FAST_JSON_NO_DATA_ERROR;
+  }
+  cursor->value = cp;
+  return FAST_JSON_OK;
+}
+
+FAST_JSON_VALUE_TYPE
+fast_json_cursor_type (FAST_JSON_TYPE json, FAST_JSON_CURSOR_TYPE * cursor)
+{
+  FAST_JSON_VALUE_TYPE type = FAST_JSON_NULL;
+
+  if (json && cursor && cursor->value) {
+    switch (*cursor->value) {
+    case '{':
+      type = FAST_JSON_OBJECT;
+      break;
+    case '[':
+      type = FAST_JSON_ARRAY;
+      break;
+    case '"':
+      type = FAST_JSON_STRING;
+      break;
+    default:
+      {
+	/* Scalars are small. Just parse them. */
+	FAST_JSON_DATA_TYPE v = fast_json_cursor_value (json, cursor);
+
+	if (v) {
+	  type = (FAST_JSON_VALUE_TYPE) v->type;
+	  fast_json_value_free (json, v);
 	}
       }
-      if (c == 'e' || c == 'E' || (hex && (c == 'p' || c == 'P'))) {
-	integer = 0;
-	c = fast_json_getc_save (json);
-	if (c == '+' || c == '-') {
-	  c = fast_json_getc_save (json);
+      break;
+    }
+  }
+  return type;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_cursor_child (FAST_JSON_TYPE json, FAST_JSON_CURSOR_TYPE * cursor,
+			FAST_JSON_CURSOR_TYPE * child)
+{
+  FAST_JSON_ERROR_ENUM error;
+  const char *cp;
+
+  if (json == NULL || cursor == NULL || child == NULL ||
+      cursor->value == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  fast_json_cursor_bind (json, cursor);
+  cp = cursor->value;
+  if (*cp != '[' && *cp != '{') {
+    fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, cp, ":,]}");
+    return FAST_JSON_VALUE_ERROR;
+  }
+  child->doc = cursor->doc;
+  child->end = cursor->end;
+  child->start = cp;
+  child->parent = cursor;
+  child->close = *cp == '[' ? ']' : '}';
+  cp++;
+  error = fast_json_skip_whitespace2 (json, &cp);
+  if (error != FAST_JSON_OK) {
+    return error;
+  }
+  if (*cp == child->close) {
+    child->value = NULL;
+    child->close = 0;
+    cursor->next = cp + 1;
+    json->error = FAST_JSON_NO_DATA_ERROR;
+    return FAST_JSON_NO_DATA_ERROR;
+  }
+  return fast_json_cursor_element (json, child, cp);
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_cursor_next (FAST_JSON_TYPE json, FAST_JSON_CURSOR_TYPE * cursor)
+{
+  FAST_JSON_ERROR_ENUM error;
+  const char *cp;
+
+  if (json == NULL || cursor == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  fast_json_cursor_bind (json, cursor);
+  if (cursor->close == 0) {
+    json->error = FAST_JSON_NO_DATA_ERROR;
+    return FAST_JSON_NO_DATA_ERROR;
+  }
+  cp = cursor->next;
+  if (cp == NULL) {
+    cp = cursor->value;
+    error = fast_json_skip_value2 (json, &cp, 0);
+    if (error != FAST_JSON_OK) {
+      return error;
+    }
+  }
+  error = fast_json_skip_whitespace2 (json, &cp);
+  if (error != FAST_JSON_OK) {
+    return error;
+  }
+  if (*cp == ',') {
+    cp++;
+    error = fast_json_skip_whitespace2 (json, &cp);
+    if (error != FAST_JSON_OK) {
+      return error;
+    }
+    if ((json->options & FAST_JSON_ALLOW_JSON5) == 0 || *cp != cursor->close) {
+      return fast_json_cursor_element (json, cursor, cp);
+    }
+  }
+  if (*cp != cursor->close) {
+    error = cursor->close == ']' ? FAST_JSON_ARRAY_END_ERROR :
+      FAST_JSON_OBJECT_END_ERROR;
+    fast_json_store_error2 (json, error, cp, ":,]}");
+    return error;
+  }
+  /* Let the parent continue after this array or object */
+  if (cursor->parent && cursor->parent->value == cursor->start) {
+    cursor->parent->next = cp + 1;
+  }
+  cursor->value = NULL;
+  cursor->name = NULL;
+  cursor->close = 0;
+  json->error = FAST_JSON_NO_DATA_ERROR;
+  return FAST_JSON_NO_DATA_ERROR;
+}
+
+const char *
+fast_json_cursor_name (FAST_JSON_TYPE json,
+		       const FAST_JSON_CURSOR_TYPE * cursor)
+{
+  const char *cp;
+
+  if (json == NULL || cursor == NULL || cursor->name == NULL) {
+    return NULL;
+  }
+  fast_json_cursor_bind (json, cursor);
+  cp = cursor->name;
+  return fast_json_check_name2 (json, &cp) == FAST_JSON_OK ?
+    json->string : NULL;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_cursor_find (FAST_JSON_TYPE json, FAST_JSON_CURSOR_TYPE * cursor,
+		       const char *name, FAST_JSON_CURSOR_TYPE * child)
+{
+  FAST_JSON_ERROR_ENUM error;
+
+  if (json == NULL || cursor == NULL || name == NULL || child == NULL ||
+      cursor->value == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  if (*cursor->value != '{') {
+    fast_json_cursor_bind (json, cursor);
+    fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, cursor->value,
+			    ":,]}");
+    return FAST_JSON_VALUE_ERROR;
+  }
+  /* The name of each element is still decoded in json->string */
+  error = fast_json_cursor_child (json, cursor, child);
+  while (error == FAST_JSON_OK && strcmp (json->string, name) != 0) {
+    error = fast_json_cursor_next (json, child);
+  }
+  return error;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_cursor_value (FAST_JSON_TYPE json, FAST_JSON_CURSOR_TYPE * cursor)
+{
+  FAST_JSON_DATA_TYPE v;
+  const char *cp;
+
+  if (json == NULL || cursor == NULL || cursor->value == NULL) {
+    return NULL;
+  }
+  fast_json_cursor_bind (json, cursor);
+  cp = cursor->value;
+  v = fast_json_parse_value2 (json, &cp);
+  if (v) {
+    cursor->next = cp;
+  }
+  return v;
+}
+
+const char *
+fast_json_cursor_get_string (FAST_JSON_TYPE json,
+			     FAST_JSON_CURSOR_TYPE * cursor)
+{
+  const char *cp;
+  const char *save;
+  int sep;
+
+  if (json == NULL || cursor == NULL || cursor->value == NULL) {
+    return NULL;
+  }
+  fast_json_cursor_bind (json, cursor);
+  cp = cursor->value;
+  sep = *cp;
+  if (sep != '"' &&
+      (sep != '\'' || (json->options & FAST_JSON_ALLOW_JSON5) == 0)) {
+    fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, cp, ":,]}");
+    return NULL;
+  }
+  save = ++cp;
+  if (fast_json_check_string (json, &cp, json->json_end, sep) !=
+      FAST_JSON_OK) {
+    fast_json_store_error2 (json, json->error, save, ":,]}");
+    return NULL;
+  }
+  if (*cp != sep) {
+    fast_json_store_error2 (json, FAST_JSON_STRING_END_ERROR, cp, ":,]}");
+    return NULL;
+  }
+  cursor->next = cp + 1;
+  return json->string;
+}
+
+/* Return the child of path with name or with index if name is NULL. The
+ * child is added if it does not exist.
+ */
+static FAST_JSON_PATHS_TYPE
+fast_json_path_step (FAST_JSON_TYPE json, FAST_JSON_PATHS_TYPE path,
+		     const char *name, size_t len, size_t index)
+{
+  FAST_JSON_PATHS_TYPE *last = &path->child;
+  FAST_JSON_PATHS_TYPE p;
+
+  for (p = path->child; p; p = p->next) {
+    if (name ? p->name && p->len == len && memcmp (p->name, name, len) == 0 :
+	p->name == NULL && p->index == index) {
+      return p;
+    }
+    last = &p->next;
+  }
+  p = (FAST_JSON_PATHS_TYPE) (*json->my_malloc) (sizeof (*p));
+  if (p) {
+    p->child = NULL;
+    p->next = NULL;
+    p->name = NULL;
+    p->len = len;
+    p->index = index;
+    p->leaf = 0;
+    if (name) {
+      p->name = (char *) (*json->my_malloc) (len + 1);
+      if (p->name == NULL) {
+	(*json->my_free) (p);
+	return NULL;
+      }
+      memcpy (p->name, name, len);
+      p->name[len] = '\0';
+    }
+    *last = p;
+  }
+  return p;
+}
+
+FAST_JSON_PATHS_TYPE
+fast_json_create_paths (FAST_JSON_TYPE json, const char **paths, size_t n)
+{
+  FAST_JSON_ERROR_ENUM error = FAST_JSON_OK;
+  FAST_JSON_PATHS_TYPE root;
+  const char *cp = "";
+  size_t i;
+
+  if (json == NULL || paths == NULL) {
+    return NULL;
+  }
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  root = (FAST_JSON_PATHS_TYPE) (*json->my_malloc) (sizeof (*root));
+  if (root == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    return NULL;
+  }
+  root->child = NULL;
+  root->next = NULL;
+  root->name = NULL;
+  root->len = 0;
+  root->index = 0;
+  root->leaf = 0;
+  for (i = 0; i < n; i++) {
+    FAST_JSON_PATHS_TYPE p = root;
+
+    cp = paths[i];
+    if (cp == NULL) {
+      cp = "";
+      error = FAST_JSON_PARSE_ERROR;
+      break;
+    }
+    for (;;) {
+      if (*cp == '[') {
+	size_t index = 0;
+
+	cp++;
+	if (*cp == '*') {
+	  index = FAST_JSON_PATH_ALL;
+	  cp++;
 	}
-	if (fast_json_isdigit (c)) {
+	else if (fast_json_isdigit (*cp)) {
 	  do {
-	    c = fast_json_getc_save (json);
-	  } while (fast_json_isdigit (c));
+	    index = index * 10 + (*cp++ - '0');
+	  } while (fast_json_isdigit (*cp));
 	}
 	else {
-	  save = fast_json_ungetc_save (json, 0);
-	  fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-	  return NULL;
+	  error = FAST_JSON_PARSE_ERROR;
+	  break;
 	}
+	if (*cp != ']') {
+	  error = FAST_JSON_PARSE_ERROR;
+	  break;
+	}
+	cp++;
+	p = fast_json_path_step (json, p, NULL, 0, index);
       }
-      save = fast_json_ungetc_save (json, c);
-      if (ndigit == 0) {
-	save = fast_json_ungetc_save (json, 0);
-	fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-	return NULL;
-      }
-      if ((json->options & FAST_JSON_PARSE_INT_AS_DOUBLE) == 0 && integer) {
-	fast_json_int_64 int_value;
+      else {
+	const char *name = cp;
 
-	errno = 0;
-#if USE_FAST_CONVERT
-	int_value = fast_strtos64 (save, &end, 0);
-#else
-#if __WORDSIZE == 64
-	int_value = strtol (save, &end, 0);
-#else
-	int_value = strtoll (save, &end, 0);
-#endif
-#endif
-	if (*end == '\0' && errno != ERANGE) {
-	  return fast_json_create_integer_value (json, int_value);
+	while (*cp && *cp != '.' && *cp != '[') {
+	  cp++;
+	}
+	if (cp == name) {
+	  error = FAST_JSON_PARSE_ERROR;
+	  break;
 	}
+	p = fast_json_path_step (json, p, name, cp - name, 0);
       }
-      errno = 0;
-#if USE_FAST_CONVERT
-      n = fast_strtod (save, &end);
-#else
-      n = strtod (save, &end);
-#endif
-      if (*end != '\0' || errno == ERANGE) {
-	fast_json_store_error (json, FAST_JSON_NUMBER_ERROR, save);
-	return NULL;
+      if (p == NULL) {
+	error = FAST_JSON_MALLOC_ERROR;
+	break;
+      }
+      if (*cp == '.' && cp[1] != '[') {
+	cp++;
+      }
+      else if (*cp != '[') {
+	break;
       }
-      return fast_json_create_double_value (json, n);
     }
-    break;
-  case '[':
-    if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
-      return NULL;
+    if (error == FAST_JSON_OK && *cp) {
+      error = FAST_JSON_PARSE_ERROR;
     }
-    v = fast_json_create_array (json);
-    if (v == NULL) {
+    if (error != FAST_JSON_OK) {
+      break;
+    }
+    p->leaf = 1;
+  }
+  if (error != FAST_JSON_OK) {
+    fast_json_free_paths (json, root);
+    if (error == FAST_JSON_MALLOC_ERROR) {
       fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
-      return NULL;
     }
-    if (c == ']') {
-      return v;
+    else {
+      /* error_str is the bad path and column the offset of the error */
+      json->column = (size_t) (cp - (paths[i] ? paths[i] : cp));
+      json->position = json->column;
+      fast_json_store_error (json, FAST_JSON_PARSE_ERROR,
+			     paths[i] ? paths[i] : "");
     }
-    for (;;) {
-      FAST_JSON_DATA_TYPE n = fast_json_parse_value (json, c);
+    return NULL;
+  }
+  return root;
+}
 
-      if (n == NULL) {
-	fast_json_value_free (json, v);
-	return NULL;
+void
+fast_json_free_paths (FAST_JSON_TYPE json, FAST_JSON_PATHS_TYPE paths)
+{
+  if (json) {
+    while (paths) {
+      FAST_JSON_PATHS_TYPE next = paths->next;
+
+      fast_json_free_paths (json, paths->child);
+      if (paths->name) {
+	(*json->my_free) (paths->name);
       }
-      if (fast_json_add_array_end (json, v, n) != FAST_JSON_OK) {
-	fast_json_value_free (json, n);
-	fast_json_value_free (json, v);
-	return NULL;
+      (*json->my_free) (paths);
+      paths = next;
+    }
+  }
+}
+
+/* Parse the value at *buf and keep only the members and elements that are
+ * selected by the children of path. The rest is skipped. *value is NULL
+ * if the value does not fit the path. Only the path is followed
+ * recursively so the recursion depth is limited by the path length.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_parse_paths2 (FAST_JSON_TYPE json, const char **buf,
+			FAST_JSON_PATHS_TYPE path, FAST_JSON_DATA_TYPE * value)
+{
+  FAST_JSON_ERROR_ENUM error;
+  FAST_JSON_PATHS_TYPE p;
+  FAST_JSON_DATA_TYPE result;
+  FAST_JSON_DATA_TYPE v;
+  const char *cp = *buf;
+  size_t index = 0;
+  int close;
+
+  *value = NULL;
+  if (path->leaf) {
+    *value = fast_json_parse_value2 (json, buf);
+    return *value ? FAST_JSON_OK : json->error;
+  }
+  close = *cp == '[' ? ']' : *cp == '{' ? '}' : 0;
+  for (p = path->child; p && (p->name != NULL) != (close == '}');
+       p = p->next) {
+  }
+  if (close == 0 || p == NULL) {
+    return fast_json_skip_value2 (json, buf, 0);
+  }
+  result = close == ']' ? fast_json_create_array (json) :
+    fast_json_create_object (json);
+  if (result == NULL) {
+    fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, cp, ":,]}");
+    return FAST_JSON_MALLOC_ERROR;
+  }
+  cp++;
+  error = fast_json_skip_whitespace2 (json, &cp);
+  if (error == FAST_JSON_OK && *cp == close) {
+    *buf = cp + 1;
+    *value = result;
+    return FAST_JSON_OK;
+  }
+  while (error == FAST_JSON_OK) {
+    /* Find the step of the next member or element */
+    if (close == '}') {
+      error = fast_json_check_name2 (json, &cp);
+      if (error != FAST_JSON_OK) {
+	break;
       }
-      if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
-	fast_json_value_free (json, v);
-	return NULL;
+      for (p = path->child;
+	   p && (p->name == NULL || p->len != json->n_string ||
+		 memcmp (p->name, json->string, p->len) != 0); p = p->next) {
       }
-      if (c != ',') {
+      error = fast_json_skip_whitespace2 (json, &cp);
+      if (error != FAST_JSON_OK) {
 	break;
       }
-      if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
-	fast_json_value_free (json, v);
-	return NULL;
-      }
-      if ((json->options & FAST_JSON_ALLOW_JSON5) && c == ']') {
-        break;
+      if (*cp != ':') {
+	error = FAST_JSON_OBJECT_SEPERATOR_ERROR;
+	fast_json_store_error2 (json, error, cp, ":,]}");
+	break;
       }
+      cp++;
     }
-    if (c != ']') {
-      fast_json_store_error (json, FAST_JSON_ARRAY_END_ERROR, "");
-      fast_json_value_free (json, v);
-      return NULL;
-    }
-    break;
-  case '{':
-    if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
-      return NULL;
-    }
-    v = fast_json_create_object (json);
-    if (v == NULL) {
-      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
-      return NULL;
+    else {
+      FAST_JSON_PATHS_TYPE all = NULL;
+
+      /* An index step is used before [*] */
+      for (p = path->child; p && (p->name || p->index != index);
+	   p = p->next) {
+	if (p->name == NULL && p->index == FAST_JSON_PATH_ALL) {
+	  all = p;
+	}
+      }
+      if (p == NULL) {
+	p = all;
+      }
+      index++;
     }
-    if (c == '}') {
-      return v;
+    error = fast_json_skip_whitespace2 (json, &cp);
+    if (error != FAST_JSON_OK) {
+      break;
     }
-    for (;;) {
-      char name[16];
-      char *out = &name[0];
-      FAST_JSON_DATA_TYPE n;
-      unsigned int nq = 0;
-
-      if ((json->options & FAST_JSON_ALLOW_JSON5) && c != '"') {
-        fast_json_getc_save_start (json, c);
-        while (c > 0 && c != ':') {
-	  if (fast_json5_isspace (c)) {
-	    break;
-	  }
-	  else if (c == 0xc2) {
-	    c = fast_json_getc_save (json);
-	    if (c == 0xa0) { /* Non-breaking space */
-	      c = ' ';
-	      json->n_save--;
-	      break;
-	    }
-	  }
-	  else if (c == 0xe2) {
-	    c = fast_json_getc_save (json);
-	    if (c == 0x80) {
-	      c = fast_json_getc_save (json);
-	      if (c == 0xa8 || c == 0xa9) {
-		/* Line separator */
-		/* Paragraph separator */
-	        c = ' ';
-	        json->n_save -= 2;
-	        break;
-	      }
-	    }
-	  }
-	  else if (c == 0xef) {
-	    c = fast_json_getc_save (json);
-	    if (c == 0xbb) {
-	      c = fast_json_getc_save (json);
-	      if (c == 0xbf) { /* Byte order mark */
-	        c = ' ';
-	        json->n_save -= 2;
-	        break;
-	      }
-	    }
-	  }
-          nq += (c == '"');
-	  if (c == '\\') {
-	    c = fast_json_getc_save (json);
-	    nq += c == 'x' ? 2 : (c == '0' ? 4 : 0);
-	  }
-	  c = fast_json_getc_save (json);
-        }
-        save = fast_json_ungetc_save (json, c);
-        if (json->n_save + nq >= sizeof (name)) {
-	  out = (char *) (*json->my_malloc) (json->n_save + nq + 1);
-	  if (out == NULL) {
-	    json->error = FAST_JSON_MALLOC_ERROR;
-	    fast_json_value_free (json, v);
-	    return NULL;
-	  }
-        }
-        if (fast_json_check_string (json, save, save + json->n_save, out, '"') !=
-	    FAST_JSON_OK) {
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
-	  fast_json_value_free (json, v);
-	  return NULL;
-        }
-      }
-      else {
-        if (c != '"') {
-	  fast_json_store_error (json, FAST_JSON_STRING_START_ERROR, "");
-	  fast_json_value_free (json, v);
-	  return NULL;
-        }
-        c = fast_json_getc (json);
-        fast_json_getc_save_start (json, c);
-        while (c > 0 && c != '"') {
-          nq += (c == '"');
-	  if (c == '\\') {
-	    c = fast_json_getc_save (json);
-	    nq += c == 'x' ? 2 : (c == '0' ? 4 : 0);
-	  }
-	  c = fast_json_getc_save (json);
-        }
-        save = fast_json_ungetc_save (json, c);
-        if (json->n_save + nq >= sizeof (name)) {
-	  out = (char *) (*json->my_malloc) (json->n_save + nq + 1);
-	  if (out == NULL) {
-	    json->error = FAST_JSON_MALLOC_ERROR;
-	    fast_json_value_free (json, v);
-	    return NULL;
-	  }
-        }
-        if (fast_json_check_string (json, save, save + json->n_save, out, '"') !=
-	    FAST_JSON_OK) {
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
-	  fast_json_value_free (json, v);
-	  return NULL;
-        }
-        c = fast_json_getc (json);
-        if (c != '"') {
-	  fast_json_store_error (json, FAST_JSON_STRING_END_ERROR, save);
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
+    if (p) {
+      error = fast_json_parse_paths2 (json, &cp, p, &v);
+      if (error == FAST_JSON_OK && v) {
+	error = close == ']' ? fast_json_add_array_end (json, result, v) :
+	  fast_json_add_object_end (json, result, p->name, p->len, v);
+	if (error != FAST_JSON_OK) {
 	  fast_json_value_free (json, v);
-	  return NULL;
-        }
-      }
-      if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
-	if (out != &name[0]) {
-	  (*json->my_free) (out);
+	  fast_json_store_error2 (json, error, cp, ":,]}");
 	}
-	fast_json_value_free (json, v);
-	return NULL;
       }
-      if (c != ':') {
-	fast_json_store_error (json, FAST_JSON_OBJECT_SEPERATOR_ERROR, "");
-	if (out != &name[0]) {
-	  (*json->my_free) (out);
-	}
-	fast_json_value_free (json, v);
-	return NULL;
+    }
+    else {
+      error = fast_json_skip_value2 (json, &cp, 0);
+    }
+    if (error != FAST_JSON_OK) {
+      break;
+    }
+
+    /* Go to the next member or element or to the end */
+    error = fast_json_skip_whitespace2 (json, &cp);
+    if (error != FAST_JSON_OK) {
+      break;
+    }
+    if (*cp == ',') {
+      cp++;
+      error = fast_json_skip_whitespace2 (json, &cp);
+      if (error == FAST_JSON_OK && *cp == close &&
+	  (json->options & FAST_JSON_ALLOW_JSON5)) {
+	break;
       }
-      if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
-	if (out != &name[0]) {
-	  (*json->my_free) (out);
-	}
-	fast_json_value_free (json, v);
-	return NULL;
+    }
+    else {
+      if (*cp != close) {
+	error = close == ']' ? FAST_JSON_ARRAY_END_ERROR :
+	  FAST_JSON_OBJECT_END_ERROR;
+	fast_json_store_error2 (json, error, cp, ":,]}");
       }
-      n = fast_json_parse_value (json, c);
-      if (n == NULL) {
-	if (out != &name[0]) {
-	  (*json->my_free) (out);
-	}
-	fast_json_value_free (json, v);
-	return NULL;
+      break;
+    }
+  }
+  if (error != FAST_JSON_OK) {
+    fast_json_value_free (json, result);
+    return error;
+  }
+  *buf = cp + 1;
+  *value = result;
+  return FAST_JSON_OK;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_paths (FAST_JSON_TYPE json, FAST_JSON_PATHS_TYPE paths,
+		       const char *json_str)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+  const char *cp = json_str;
+
+  if (json == NULL || paths == NULL || json_str == NULL) {
+    return NULL;
+  }
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  json->u_parse.json_str = json_str;
+  json->json_end = json_str + strlen (json_str);
+  json->simd_block = NULL;
+  json->window.active = 0;
+  if (fast_json_skip_whitespace2 (json, &cp) == FAST_JSON_OK) {
+    if (*cp == '\0') {
+      json->error = FAST_JSON_NO_DATA_ERROR;
+    }
+    else if (fast_json_parse_paths2 (json, &cp, paths, &v) == FAST_JSON_OK) {
+      if (v == NULL) {
+	json->error = FAST_JSON_NO_DATA_ERROR;
       }
-      if (fast_json_add_object_end (json, v, out, n) != FAST_JSON_OK) {
-	fast_json_value_free (json, n);
-	if (out != &name[0]) {
-	  (*json->my_free) (out);
+      else if ((json->options & FAST_JSON_NO_EOF_CHECK) == 0 &&
+	       (fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK ||
+		*cp != '\0')) {
+	if (json->error == FAST_JSON_OK) {
+	  fast_json_store_error2 (json, FAST_JSON_OBJECT_END_ERROR, cp,
+				  ":,]}");
 	}
 	fast_json_value_free (json, v);
-	return NULL;
-      }
-      if (out != &name[0]) {
-	(*json->my_free) (out);
-      }
-      if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
-	fast_json_value_free (json, v);
-	return NULL;
-      }
-      if (c != ',') {
-	break;
-      }
-      if (fast_json_skip_whitespace (json, &c) != FAST_JSON_OK) {
-	fast_json_value_free (json, v);
-	return NULL;
+	v = NULL;
       }
-      if ((json->options & FAST_JSON_ALLOW_JSON5) && c == '}') {
-        break;
-      }
-    }
-    if (c != '}') {
-      fast_json_store_error (json, FAST_JSON_OBJECT_END_ERROR, "");
-      fast_json_value_free (json, v);
-      return NULL;
     }
-    break;
-  default:
-    save = fast_json_ungetc_save (json, 0);
-    fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
-    return NULL;
   }
   return v;
 }
 
-FAST_JSON_TYPE
-fast_json_create (fast_json_malloc_type malloc_fn,
-		  fast_json_realloc_type realloc_fn,
-		  fast_json_free_type free_fn)
+/* Reset the error information and the state of the pull tokenizer. */
+static void
+fast_json_token_init (FAST_JSON_TYPE json, unsigned int string)
 {
-  FAST_JSON_TYPE json =
-    (FAST_JSON_TYPE) (malloc_fn ? malloc_fn : malloc) (sizeof (*json));
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  json->last_char = 0;
+  json->window.active = 0;
+  json->token.string = string;
+  json->token.state = FAST_JSON_TOKEN_STATE_VALUE;
+  json->token.c = 0;
+  json->token.depth = 0;
+}
 
-  if (json) {
-    memset (json, 0, sizeof (*json));
-    json->my_malloc = malloc_fn ? malloc_fn : malloc;
-    json->my_realloc = malloc_fn ? realloc_fn : realloc;
-    json->my_free = free_fn ? free_fn : free;
-    json->decimal_point = *localeconv ()->decimal_point;
+/* Get the next character that is not white space without using it. The
+ * getc engine keeps it in token.c.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_token_peek (FAST_JSON_TYPE json, int *c)
+{
+  FAST_JSON_ERROR_ENUM error = FAST_JSON_OK;
+
+  if (json->token.string) {
+    error = fast_json_skip_whitespace2 (json, &json->token.ptr);
+    *c = *json->token.ptr ? *json->token.ptr & 0xFF : FAST_JSON_EOF;
   }
-  return json;
+  else {
+    if (json->token.c == 0) {
+      error = fast_json_skip_whitespace (json, &json->token.c);
+    }
+    *c = json->token.c;
+  }
+  return error;
 }
 
-FAST_JSON_ERROR_ENUM
-fast_json_options (FAST_JSON_TYPE json, unsigned int value)
+/* Use the character from fast_json_token_peek. */
+static void
+fast_json_token_take (FAST_JSON_TYPE json)
 {
-  FAST_JSON_ERROR_ENUM retval = FAST_JSON_VALUE_ERROR;
+  if (json->token.string) {
+    json->token.ptr++;
+  }
+  else {
+    json->token.c = 0;
+  }
+}
 
-  if (json) {
-    json->options = value;
-    if (json->options & FAST_JSON_ALLOW_JSON5) {
-      json->options |= FAST_JSON_ALLOW_OCT_HEX |
-		       FAST_JSON_INF_NAN;
-      json->options &= ~FAST_JSON_NO_COMMENT;
-    }
-    retval = FAST_JSON_OK;
+static FAST_JSON_ERROR_ENUM
+fast_json_token_error (FAST_JSON_TYPE json, FAST_JSON_ERROR_ENUM error)
+{
+  if (json->token.string) {
+    fast_json_store_error2 (json, error, json->token.ptr, ":,]}");
   }
-  return retval;
+  else {
+    fast_json_store_error (json, error, "");
+  }
+  return error;
 }
 
-unsigned int
-fast_json_get_options (FAST_JSON_TYPE json)
+/* Close the array or object on top of the container stack. */
+static void
+fast_json_token_close (FAST_JSON_TYPE json, FAST_JSON_TOKEN_TYPE * token,
+		       int close)
 {
-  return json ? json->options : 0;
+  fast_json_token_take (json);
+  json->token.depth--;
+  json->token.state = FAST_JSON_TOKEN_STATE_NEXT;
+  token->type = close == ']' ? FAST_JSON_TOKEN_END_ARRAY :
+    FAST_JSON_TOKEN_END_OBJECT;
+  token->depth = json->token.depth;
 }
 
 FAST_JSON_ERROR_ENUM
-fast_json_max_reuse (FAST_JSON_TYPE json, size_t n)
+fast_json_token_string (FAST_JSON_TYPE json, const char *json_str)
 {
-  FAST_JSON_ERROR_ENUM retval = FAST_JSON_VALUE_ERROR;
+  if (json == NULL || json_str == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  fast_json_token_init (json, 1);
+  json->u_parse.json_str = json_str;
+  json->json_end = json_str + strlen (json_str);
+  json->simd_block = NULL;
+  json->token.ptr = json_str;
+  return FAST_JSON_OK;
+}
 
-  if (json) {
-    json->max_reuse = n;
-    retval = FAST_JSON_OK;
+FAST_JSON_ERROR_ENUM
+fast_json_token_file (FAST_JSON_TYPE json, FILE * fp)
+{
+  if (json == NULL || fp == NULL) {
+    return FAST_JSON_VALUE_ERROR;
   }
-  return retval;
+  fast_json_token_init (json, 0);
+  json->getc = fast_json_getc_file;
+  json->getc_data = (void *) json;
+  json->u_parse.fp = fp;
+  return FAST_JSON_OK;
 }
 
-void
-fast_json_free (FAST_JSON_TYPE json)
+FAST_JSON_ERROR_ENUM
+fast_json_token_fd (FAST_JSON_TYPE json, int fd)
 {
-  if (json) {
-    size_t i;
-    FAST_JSON_BIG_TYPE *b;
+  if (json == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  fast_json_token_init (json, 0);
+  json->getc = fast_json_getc_fd;
+  json->getc_data = (void *) json;
+  json->u_parse.fd.fd = fd;
+  json->u_parse.fd.pos = 0;
+  json->u_parse.fd.len = 0;
+  return FAST_JSON_OK;
+}
 
-    while (json->json_reuse) {
-      FAST_JSON_DATA_TYPE next = json->json_reuse->u.next;
+FAST_JSON_ERROR_ENUM
+fast_json_token_user (FAST_JSON_TYPE json, fast_json_getc_func getc,
+		      void *getc_data)
+{
+  if (json == NULL || getc == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  fast_json_token_init (json, 0);
+  json->getc = getc;
+  json->getc_data = getc_data;
+  return FAST_JSON_OK;
+}
 
-      if (json->json_reuse->index == 0xFFFFFFFFu) {
-	(*json->my_free) (json->json_reuse);
+FAST_JSON_ERROR_ENUM
+fast_json_next_token (FAST_JSON_TYPE json, FAST_JSON_TOKEN_TYPE * token)
+{
+  struct fast_json_data_struct scalar;
+  FAST_JSON_ERROR_ENUM error;
+  size_t depth;
+  int close;
+  int c;
+
+  if (json == NULL || token == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  if (json->error != FAST_JSON_OK) {
+    return json->error;
+  }
+  token->str = NULL;
+  token->len = 0;
+  for (;;) {
+    depth = json->token.depth;
+    if (depth == 0 && json->token.state >= FAST_JSON_TOKEN_STATE_NEXT) {
+      /* End of the value. Do not read ahead if more values can follow. */
+      if (json->token.state == FAST_JSON_TOKEN_STATE_NEXT) {
+	if (json->options & FAST_JSON_NO_EOF_CHECK) {
+	  json->token.state = FAST_JSON_TOKEN_STATE_VALUE;
+	}
+	else {
+	  error = fast_json_token_peek (json, &c);
+	  if (error != FAST_JSON_OK) {
+	    return error;
+	  }
+	  if (c != FAST_JSON_EOF) {
+	    return fast_json_token_error (json, FAST_JSON_OBJECT_END_ERROR);
+	  }
+	  json->token.state = FAST_JSON_TOKEN_STATE_DONE;
+	}
       }
-      json->json_reuse = next;
+      token->type = FAST_JSON_TOKEN_END;
+      token->depth = 0;
+      return FAST_JSON_OK;
     }
-    b = json->big_malloc_free;
-    while (b) {
-      FAST_JSON_BIG_TYPE *next = b->data;
-
-      b->data = NULL;
-      b = next;
+    error = fast_json_token_peek (json, &c);
+    if (error != FAST_JSON_OK) {
+      return error;
     }
-    for (i = 0; i < json->n_big_malloc; i++) {
-      (*json->my_free) (json->big_malloc[i].data);
+    switch (json->token.state) {
+    case FAST_JSON_TOKEN_STATE_VALUE:
+      if (c == '[' || c == '{') {
+	error = fast_json_stack_check (json, depth);
+	if (error != FAST_JSON_OK) {
+	  return fast_json_token_error (json, error);
+	}
+	fast_json_token_take (json);
+	json->stack[depth].close = c == '[' ? ']' : '}';
+	json->token.depth++;
+	json->token.state = FAST_JSON_TOKEN_STATE_FIRST;
+	token->type = c == '[' ? FAST_JSON_TOKEN_START_ARRAY :
+	  FAST_JSON_TOKEN_START_OBJECT;
+	token->depth = depth;
+	return FAST_JSON_OK;
+      }
+      if (c == FAST_JSON_EOF && depth == 0) {
+	json->error = FAST_JSON_NO_DATA_ERROR;
+	return FAST_JSON_NO_DATA_ERROR;
+      }
+      if (json->token.string) {
+	error = fast_json_parse_scalar2 (json, &json->token.ptr, &scalar);
+      }
+      else {
+	json->token.c = 0;
+	error = fast_json_parse_scalar (json, c, &scalar);
+      }
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+      switch (scalar.type) {
+      case FAST_JSON_STRING:
+	token->type = FAST_JSON_TOKEN_STRING;
+	token->str = json->string;
+	token->len = json->n_string;
+	break;
+      case FAST_JSON_INTEGER:
+	token->type = FAST_JSON_TOKEN_INTEGER;
+	token->u.int_value = scalar.u.int_value;
+	break;
+      case FAST_JSON_DOUBLE:
+	token->type = FAST_JSON_TOKEN_DOUBLE;
+	token->u.double_value = scalar.u.double_value;
+	break;
+      case FAST_JSON_BOOLEAN:
+	token->type = FAST_JSON_TOKEN_BOOLEAN;
+	token->u.boolean_value = scalar.u.boolean_value;
+	break;
+      default:
+	token->type = FAST_JSON_TOKEN_NULL;
+	break;
+      }
+      json->token.state = FAST_JSON_TOKEN_STATE_NEXT;
+      token->depth = depth;
+      return FAST_JSON_OK;
+    case FAST_JSON_TOKEN_STATE_FIRST:
+      close = json->stack[depth - 1].close;
+      if (c == close) {
+	fast_json_token_close (json, token, close);
+	return FAST_JSON_OK;
+      }
+      json->token.state = close == ']' ? FAST_JSON_TOKEN_STATE_VALUE :
+	FAST_JSON_TOKEN_STATE_NAME;
+      break;
+    case FAST_JSON_TOKEN_STATE_NAME:
+      if (json->token.string) {
+	error = fast_json_check_name2 (json, &json->token.ptr);
+      }
+      else {
+	json->token.c = 0;
+	error = fast_json_check_name (json, c);
+      }
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+      error = fast_json_token_peek (json, &c);
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+      if (c != ':') {
+	return fast_json_token_error (json, FAST_JSON_OBJECT_SEPERATOR_ERROR);
+      }
+      fast_json_token_take (json);
+      json->token.state = FAST_JSON_TOKEN_STATE_VALUE;
+      token->type = FAST_JSON_TOKEN_NAME;
+      token->str = json->string;
+      token->len = json->n_string;
+      token->depth = depth;
+      return FAST_JSON_OK;
+    default:
+      close = json->stack[depth - 1].close;
+      if (c == ',') {
+	fast_json_token_take (json);
+	error = fast_json_token_peek (json, &c);
+	if (error != FAST_JSON_OK) {
+	  return error;
+	}
+	if ((json->options & FAST_JSON_ALLOW_JSON5) == 0 || c != close) {
+	  json->token.state = close == ']' ? FAST_JSON_TOKEN_STATE_VALUE :
+	    FAST_JSON_TOKEN_STATE_NAME;
+	  break;
+	}
+      }
+      if (c != close) {
+	return fast_json_token_error (json, close == ']' ?
+				      FAST_JSON_ARRAY_END_ERROR :
+				      FAST_JSON_OBJECT_END_ERROR);
+      }
+      fast_json_token_close (json, token, close);
+      return FAST_JSON_OK;
     }
-    (*json->my_free) (json->big_malloc);
-    (*json->my_free) (json->save);
-    (*json->my_free) (json);
   }
 }
 
-size_t
-fast_json_parser_line (FAST_JSON_TYPE json)
+FAST_JSON_ERROR_ENUM
+fast_json_skip_token (FAST_JSON_TYPE json)
 {
-  return json ? json->line : 0;
+  FAST_JSON_TOKEN_TYPE token;
+  FAST_JSON_ERROR_ENUM error;
+  size_t depth;
+
+  if (json == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  if (json->error != FAST_JSON_OK) {
+    return json->error;
+  }
+  depth = json->token.depth;
+  if (json->token.state == FAST_JSON_TOKEN_STATE_FIRST) {
+    /* Skip the rest of the array or object from its open bracket */
+    depth--;
+    if (json->token.string) {
+      json->token.ptr--;
+      error = fast_json_skip_value2 (json, &json->token.ptr, depth);
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+      json->token.depth = depth;
+      json->token.state = FAST_JSON_TOKEN_STATE_NEXT;
+      return FAST_JSON_OK;
+    }
+  }
+  else if (json->token.state == FAST_JSON_TOKEN_STATE_VALUE && depth) {
+    /* Skip the value of an object name */
+    if (json->token.string) {
+      error = fast_json_skip_value2 (json, &json->token.ptr, depth);
+      if (error != FAST_JSON_OK) {
+	return error;
+      }
+      json->token.state = FAST_JSON_TOKEN_STATE_NEXT;
+      return FAST_JSON_OK;
+    }
+    error = fast_json_next_token (json, &token);
+    if (error != FAST_JSON_OK) {
+      return error;
+    }
+  }
+  else {
+    return FAST_JSON_OK;
+  }
+  while (json->token.depth > depth) {
+    error = fast_json_next_token (json, &token);
+    if (error != FAST_JSON_OK) {
+      return error;
+    }
+  }
+  return FAST_JSON_OK;
 }
 
-size_t
-fast_json_parser_column (FAST_JSON_TYPE json)
+/* Make room for two tape entries and a string of len characters. */
+static FAST_JSON_ERROR_ENUM
+fast_json_tape_reserve (FAST_JSON_TYPE json, FAST_JSON_TAPE_TYPE tape,
+			size_t len)
 {
-  return json ? json->column : 0;
+  if (UNLIKELY (tape->n_tape + 2 > tape->max_tape)) {
+    size_t new_max = tape->max_tape * 2 + 2;
+    uint64_t *new_tape;
+
+    new_tape = (uint64_t *) (*json->my_realloc) (tape->tape,
+						 new_max * sizeof (uint64_t));
+    if (new_tape == NULL) {
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    tape->tape = new_tape;
+    tape->max_tape = new_max;
+  }
+  len += sizeof (size_t) + 1;
+  if (UNLIKELY (tape->n_strings + len > tape->max_strings)) {
+    size_t new_max = tape->max_strings * 2 + len;
+    char *new_strings;
+
+    new_strings = (char *) (*json->my_realloc) (tape->strings, new_max);
+    if (new_strings == NULL) {
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    tape->strings = new_strings;
+    tape->max_strings = new_max;
+  }
+  return FAST_JSON_OK;
 }
 
-size_t
-fast_json_parser_position (FAST_JSON_TYPE json)
+FAST_JSON_TAPE_TYPE
+fast_json_parse_tape (FAST_JSON_TYPE json, const char *json_str)
 {
-  return json ? json->position : 0;
+  FAST_JSON_TOKEN_TYPE token;
+  FAST_JSON_ERROR_ENUM error;
+  FAST_JSON_TAPE_TYPE tape;
+  uint64_t *t;
+  size_t open = FAST_JSON_TAPE_MASK;
+  size_t len;
+  size_t n;
+
+  if (fast_json_token_string (json, json_str) != FAST_JSON_OK) {
+    return NULL;
+  }
+  tape = (FAST_JSON_TAPE_TYPE) (*json->my_malloc) (sizeof (*tape));
+  if (tape == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    return NULL;
+  }
+  /* Start with a guess of the size from the length of the input */
+  len = json->json_end - json_str;
+  tape->n_tape = 0;
+  tape->max_tape = len / 8 + 2;
+  tape->tape =
+    (uint64_t *) (*json->my_malloc) (tape->max_tape * sizeof (uint64_t));
+  tape->n_strings = 0;
+  tape->max_strings = len / 2 + sizeof (size_t) + 1;
+  tape->strings = (char *) (*json->my_malloc) (tape->max_strings);
+  if (tape->tape == NULL || tape->strings == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    fast_json_free_tape (json, tape);
+    return NULL;
+  }
+  for (;;) {
+    error = fast_json_next_token (json, &token);
+    if (error != FAST_JSON_OK || token.type == FAST_JSON_TOKEN_END) {
+      break;
+    }
+    error = fast_json_tape_reserve (json, tape, token.len);
+    if (error != FAST_JSON_OK) {
+      fast_json_store_error (json, error, "");
+      break;
+    }
+    t = tape->tape;
+    n = tape->n_tape;
+    if (open != FAST_JSON_TAPE_MASK && token.type != FAST_JSON_TOKEN_NAME &&
+	token.type != FAST_JSON_TOKEN_END_OBJECT &&
+	token.type != FAST_JSON_TOKEN_END_ARRAY) {
+      t[open + 1]++;
+    }
+    switch (token.type) {
+    case FAST_JSON_TOKEN_START_OBJECT:
+    case FAST_JSON_TOKEN_START_ARRAY:
+      /* The start entry points to the parent until the end is found */
+      t[n] = fast_json_tape_entry (token.type == FAST_JSON_TOKEN_START_OBJECT
+				   ? FAST_JSON_OBJECT : FAST_JSON_ARRAY, open);
+      t[n + 1] = 0;
+      open = n;
+      n += 2;
+      break;
+    case FAST_JSON_TOKEN_END_OBJECT:
+    case FAST_JSON_TOKEN_END_ARRAY:
+      len = fast_json_tape_payload (t[open]);
+      t[open] = fast_json_tape_entry (fast_json_tape_type (t[open]), n);
+      t[n++] = fast_json_tape_entry (FAST_JSON_TAPE_END, open);
+      open = len;
+      break;
+    case FAST_JSON_TOKEN_NAME:
+    case FAST_JSON_TOKEN_STRING:
+      t[n++] = fast_json_tape_entry (token.type == FAST_JSON_TOKEN_NAME ?
+				     FAST_JSON_TAPE_NAME : FAST_JSON_STRING,
+				     tape->n_strings);
+      memcpy (&tape->strings[tape->n_strings], &token.len, sizeof (size_t));
+      tape->n_strings += sizeof (size_t);
+      memcpy (&tape->strings[tape->n_strings], token.str, token.len);
+      tape->n_strings += token.len;
+      tape->strings[tape->n_strings++] = '\0';
+      break;
+    case FAST_JSON_TOKEN_INTEGER:
+      t[n] = fast_json_tape_entry (FAST_JSON_INTEGER, 0);
+      t[n + 1] = (uint64_t) token.u.int_value;
+      n += 2;
+      break;
+    case FAST_JSON_TOKEN_DOUBLE:
+      t[n] = fast_json_tape_entry (FAST_JSON_DOUBLE, 0);
+      memcpy (&t[n + 1], &token.u.double_value, sizeof (double));
+      n += 2;
+      break;
+    case FAST_JSON_TOKEN_BOOLEAN:
+      t[n++] = fast_json_tape_entry (FAST_JSON_BOOLEAN,
+				     token.u.boolean_value != 0);
+      break;
+    default:
+      t[n++] = fast_json_tape_entry (FAST_JSON_NULL, 0);
+      break;
+    }
+    tape->n_tape = n;
+  }
+  if (error != FAST_JSON_OK) {
+    fast_json_free_tape (json, tape);
+    return NULL;
+  }
+
+  /* Give back the unused part of the guess */
+  t = (uint64_t *) (*json->my_realloc) (tape->tape,
+					tape->n_tape * sizeof (uint64_t));
+  if (t) {
+    tape->tape = t;
+    tape->max_tape = tape->n_tape;
+  }
+  if (tape->n_strings) {
+    char *strings =
+      (char *) (*json->my_realloc) (tape->strings, tape->n_strings);
+
+    if (strings) {
+      tape->strings = strings;
+      tape->max_strings = tape->n_strings;
+    }
+  }
+  return tape;
 }
 
-FAST_JSON_ERROR_ENUM
-fast_json_parser_error (FAST_JSON_TYPE json)
+void
+fast_json_free_tape (FAST_JSON_TYPE json, FAST_JSON_TAPE_TYPE tape)
 {
-  return json ? json->error : FAST_JSON_OK;
+  if (json && tape) {
+    if (tape->tape) {
+      (*json->my_free) (tape->tape);
+    }
+    if (tape->strings) {
+      (*json->my_free) (tape->strings);
+    }
+    (*json->my_free) (tape);
+  }
 }
 
-const char *
-fast_json_error_str (FAST_JSON_ERROR_ENUM error)
-{
-  switch (error) {
-  case FAST_JSON_OK:
-    return ("OK");
-  case FAST_JSON_MALLOC_ERROR:
-    return ("Malloc error");
-  case FAST_JSON_COMMENT_ERROR:
-    return ("Comment error");
-  case FAST_JSON_NUMBER_ERROR:
-    return ("Number error");
-  case FAST_JSON_CONTROL_CHARACTER_ERROR:
-    return ("Control character error");
-  case FAST_JSON_ESCAPE_CHARACTER_ERROR:
-    return ("Escape character error");
-  case FAST_JSON_UTF8_ERROR:
-    return ("UTF8 character error");
-  case FAST_JSON_UNICODE_ERROR:
-    return ("Unicode error");
-  case FAST_JSON_UNICODE_ESCAPE_ERROR:
-    return ("Unicode escape error");
-  case FAST_JSON_STRING_START_ERROR:
-    return ("String start error");
-  case FAST_JSON_STRING_END_ERROR:
-    return ("String end error");
-  case FAST_JSON_VALUE_ERROR:
-    return ("Value error");
-  case FAST_JSON_ARRAY_END_ERROR:
-    return ("Array end error");
-  case FAST_JSON_OBJECT_SEPERATOR_ERROR:
-    return ("Object seperator error");
-  case FAST_JSON_OBJECT_END_ERROR:
-    return ("Object end error");
-  case FAST_JSON_PARSE_ERROR:
-    return ("Parse error");
-  case FAST_JSON_NO_DATA_ERROR:
-    return ("No data error");
-  case FAST_JSON_INDEX_ERROR:
-    return ("Index error");
-  case FAST_JSON_LOOP_ERROR:
-    return ("Loop error");
+/* Position after the value at pos. */
+static ALWAYS_INLINE size_t
+fast_json_tape_skip (const uint64_t * t, size_t pos)
+{
+  switch (fast_json_tape_type (t[pos])) {
+  case FAST_JSON_OBJECT:
+  case FAST_JSON_ARRAY:
+    return fast_json_tape_payload (t[pos]) + 1;
+  case FAST_JSON_INTEGER:
+  case FAST_JSON_DOUBLE:
+    return pos + 2;
+  default:
+    return pos + 1;
   }
-  return NULL;
 }
 
-const char *
-fast_json_parser_error_str (FAST_JSON_TYPE json)
+/* Position of the name of member index of the object at pos or
+ * FAST_JSON_TAPE_NONE.
+ */
+static size_t
+fast_json_tape_member (FAST_JSON_TAPE_TYPE tape, size_t pos, size_t index)
 {
-  return json ? (const char *) json->error_str : "";
+  if (tape && pos < tape->n_tape &&
+      fast_json_tape_type (tape->tape[pos]) == FAST_JSON_OBJECT &&
+      index < tape->tape[pos + 1]) {
+    pos += 2;
+    while (index--) {
+      pos = fast_json_tape_skip (tape->tape, pos + 1);
+    }
+    return pos;
+  }
+  return FAST_JSON_TAPE_NONE;
 }
 
-static FAST_JSON_DATA_TYPE
-fast_json_parse_all (FAST_JSON_TYPE json, unsigned int next)
+FAST_JSON_VALUE_TYPE
+fast_json_tape_get_type (FAST_JSON_TAPE_TYPE tape, size_t pos)
 {
-  int c;
-  FAST_JSON_DATA_TYPE v = NULL;
+  if (tape && pos < tape->n_tape &&
+      fast_json_tape_type (tape->tape[pos]) <= FAST_JSON_NULL) {
+    return (FAST_JSON_VALUE_TYPE) fast_json_tape_type (tape->tape[pos]);
+  }
+  return FAST_JSON_NULL;
+}
 
-  if (next == 0) {
-    json->error = FAST_JSON_OK;
-    json->error_str[0] = '\0';
-    json->line = 1;
-    json->column = 0;
-    json->position = 0;
-    json->last_char = 0;
+size_t
+fast_json_tape_next (FAST_JSON_TAPE_TYPE tape, size_t pos, const char **name)
+{
+  if (name) {
+    *name = NULL;
   }
-  json->decimal_point = *localeconv ()->decimal_point;
-  if (fast_json_skip_whitespace (json, &c) == FAST_JSON_OK) {
-    if (c != FAST_JSON_EOF) {
-      v = fast_json_parse_value (json, c);
-      if (v) {
-	if ((json->options & FAST_JSON_NO_EOF_CHECK) == 0) {
-	  if (fast_json_skip_whitespace (json, &c) == FAST_JSON_OK) {
-	    fast_json_ungetc (json, c);
-	    if (c != FAST_JSON_EOF) {
-	      fast_json_store_error (json, FAST_JSON_OBJECT_END_ERROR, "");
-	      fast_json_value_free (json, v);
-	      v = NULL;
-	    }
-	  }
-	  else {
-	    fast_json_value_free (json, v);
-	    v = NULL;
-	  }
+  if (tape && pos < tape->n_tape) {
+    pos = fast_json_tape_skip (tape->tape, pos);
+    if (pos < tape->n_tape) {
+      switch (fast_json_tape_type (tape->tape[pos])) {
+      case FAST_JSON_TAPE_END:
+	break;
+      case FAST_JSON_TAPE_NAME:
+	if (name) {
+	  *name = &tape->strings[fast_json_tape_payload (tape->tape[pos]) +
+				 sizeof (size_t)];
 	}
+	return pos + 1;
+      default:
+	return pos;
       }
     }
-    else {
-      json->error = FAST_JSON_NO_DATA_ERROR;
-    }
   }
-  return v;
+  return FAST_JSON_TAPE_NONE;
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_parse_string (FAST_JSON_TYPE json, const char *json_str)
+size_t
+fast_json_tape_get_array_size (FAST_JSON_TAPE_TYPE tape, size_t pos)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
+  return tape && pos < tape->n_tape &&
+    fast_json_tape_type (tape->tape[pos]) == FAST_JSON_ARRAY ?
+    (size_t) tape->tape[pos + 1] : 0;
+}
 
-  if (json && json_str) {
-    json->getc = fast_json_getc_string;
-    json->getc_data = (void *) json;
-    json->u_parse.str.string = json_str;
-    json->u_parse.str.pos = 0;
-    v = fast_json_parse_all (json, 0);
+size_t
+fast_json_tape_get_array_data (FAST_JSON_TAPE_TYPE tape, size_t pos,
+			       size_t index)
+{
+  if (tape && pos < tape->n_tape &&
+      fast_json_tape_type (tape->tape[pos]) == FAST_JSON_ARRAY &&
+      index < tape->tape[pos + 1]) {
+    pos += 2;
+    while (index--) {
+      pos = fast_json_tape_skip (tape->tape, pos);
+    }
+    return pos;
   }
-  return v;
+  return FAST_JSON_TAPE_NONE;
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_parse_string_len (FAST_JSON_TYPE json, const char *json_str,
-			    size_t len)
+size_t
+fast_json_tape_get_object_size (FAST_JSON_TAPE_TYPE tape, size_t pos)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
+  return tape && pos < tape->n_tape &&
+    fast_json_tape_type (tape->tape[pos]) == FAST_JSON_OBJECT ?
+    (size_t) tape->tape[pos + 1] : 0;
+}
 
-  if (json && json_str) {
-    json->getc = fast_json_getc_string_len;
-    json->getc_data = (void *) json;
-    json->u_parse.str.string = json_str;
-    json->u_parse.str.pos = 0;
-    json->u_parse.str.len = len;
-    v = fast_json_parse_all (json, 0);
+const char *
+fast_json_tape_get_object_name (FAST_JSON_TAPE_TYPE tape, size_t pos,
+				size_t index)
+{
+  pos = fast_json_tape_member (tape, pos, index);
+  if (pos == FAST_JSON_TAPE_NONE) {
+    return NULL;
   }
-  return v;
+  return &tape->strings[fast_json_tape_payload (tape->tape[pos]) +
+			sizeof (size_t)];
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_parse_file (FAST_JSON_TYPE json, FILE * fp)
+size_t
+fast_json_tape_get_object_data (FAST_JSON_TAPE_TYPE tape, size_t pos,
+				size_t index)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
-
-  if (json && fp) {
-    json->getc = fast_json_getc_file;
-    json->getc_data = (void *) json;
-    json->u_parse.fp = fp;
-    v = fast_json_parse_all (json, 0);
-  }
-  return v;
+  pos = fast_json_tape_member (tape, pos, index);
+  return pos == FAST_JSON_TAPE_NONE ? pos : pos + 1;
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_parse_file_name (FAST_JSON_TYPE json, const char *name)
+size_t
+fast_json_tape_get_object_by_name (FAST_JSON_TAPE_TYPE tape, size_t pos,
+				   const char *name)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
+  if (tape && name && pos < tape->n_tape &&
+      fast_json_tape_type (tape->tape[pos]) == FAST_JSON_OBJECT) {
+    size_t len = strlen (name);
+    size_t end = fast_json_tape_payload (tape->tape[pos]);
 
-  if (json && name) {
-    FILE *fp = fopen (name, "r");
+    pos += 2;
+    while (pos < end) {
+      const char *s =
+	&tape->strings[fast_json_tape_payload (tape->tape[pos])];
+      size_t n;
 
-    if (fp) {
-      json->getc = fast_json_getc_file;
-      json->getc_data = (void *) json;
-      json->u_parse.fp = fp;
-      v = fast_json_parse_all (json, 0);
-      fclose (fp);
-      json->u_parse.fp = NULL;
+      memcpy (&n, s, sizeof (size_t));
+      if (n == len && memcmp (s + sizeof (size_t), name, len) == 0) {
+	return pos + 1;
+      }
+      pos = fast_json_tape_skip (tape->tape, pos + 1);
     }
   }
-  return v;
+  return FAST_JSON_TAPE_NONE;
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_parse_fd (FAST_JSON_TYPE json, int fd)
+fast_json_int_64
+fast_json_tape_get_integer (FAST_JSON_TAPE_TYPE tape, size_t pos)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
-
-  if (json) {
-    json->getc = fast_json_getc_fd;
-    json->getc_data = (void *) json;
-    json->u_parse.fd.fd = fd;
-    json->u_parse.fd.pos = 0;
-    json->u_parse.fd.len = 0;
-    v = fast_json_parse_all (json, 0);
-  }
-  return v;
+  return tape && pos < tape->n_tape &&
+    fast_json_tape_type (tape->tape[pos]) == FAST_JSON_INTEGER ?
+    (fast_json_int_64) tape->tape[pos + 1] : 0;
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_parse_user (FAST_JSON_TYPE json, fast_json_getc_func getc,
-		      void *user_data)
+double
+fast_json_tape_get_double (FAST_JSON_TAPE_TYPE tape, size_t pos)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
+  double d = 0.0;
 
-  if (json && getc) {
-    json->getc = getc;
-    json->getc_data = user_data;
-    v = fast_json_parse_all (json, 0);
+  if (tape && pos < tape->n_tape &&
+      fast_json_tape_type (tape->tape[pos]) == FAST_JSON_DOUBLE) {
+    memcpy (&d, &tape->tape[pos + 1], sizeof (double));
   }
-  return v;
+  return d;
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_parse_next (FAST_JSON_TYPE json)
+const char *
+fast_json_tape_get_string (FAST_JSON_TAPE_TYPE tape, size_t pos)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
+  return tape && pos < tape->n_tape &&
+    fast_json_tape_type (tape->tape[pos]) == FAST_JSON_STRING ?
+    &tape->strings[fast_json_tape_payload (tape->tape[pos]) +
+		   sizeof (size_t)] : NULL;
+}
 
-  if (json &&
-      (json->getc != NULL &&
-       (json->getc != fast_json_getc_file || json->u_parse.fp != NULL))) {
-    v = fast_json_parse_all (json, 1);
+size_t
+fast_json_tape_get_string_len (FAST_JSON_TAPE_TYPE tape, size_t pos)
+{
+  size_t len = 0;
+
+  if (tape && pos < tape->n_tape &&
+      fast_json_tape_type (tape->tape[pos]) == FAST_JSON_STRING) {
+    memcpy (&len, &tape->strings[fast_json_tape_payload (tape->tape[pos])],
+	    sizeof (size_t));
   }
-  return v;
+  return len;
 }
 
-static void
-fast_json_store_error2 (FAST_JSON_TYPE json, FAST_JSON_ERROR_ENUM error,
-			const char *cp, const char *sep)
+unsigned int
+fast_json_tape_get_boolean (FAST_JSON_TAPE_TYPE tape, size_t pos)
 {
-  int len = sizeof (json->error_str) - 1;
-  char *rp = json->error_str;
-  const char *s;
+  return tape && pos < tape->n_tape &&
+    fast_json_tape_type (tape->tape[pos]) == FAST_JSON_BOOLEAN ?
+    (unsigned int) fast_json_tape_payload (tape->tape[pos]) : 0;
+}
 
-  json->error = error;
-  while (len-- && *cp) {
-    *rp++ = *cp++;
+/* Read the next block of input into the window. The data before
+ * window.start is not needed any more and is removed first.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_window_fill (FAST_JSON_TYPE json)
+{
+  const char *block = NULL;
+  size_t n = 0;
+
+  if (json->window.start) {
+    n = json->window.len - json->window.start;
+    memmove (json->window.buffer, json->window.buffer + json->window.start, n);
+    json->window.scan -= json->window.start;
+    json->window.len = n;
+    json->window.start = 0;
   }
-  *rp = '\0';
-  rp = json->error_str;
-  while (*rp) {
-    s = sep;
-    while (*s) {
-      if (*rp == *s) {
-	*rp = '\0';
-	break;
-      }
-      s++;
+  if (json->window.block) {
+    block = json->window.block (json->window.block_data, &n);
+    if (block == NULL || n == 0) {
+      json->window.eof = 1;
+      return FAST_JSON_OK;
     }
-    if (*rp == '\0') {
-      break;
+  }
+  else {
+    n = FAST_JSON_BUFFER_SIZE;
+  }
+  if (json->window.max - json->window.len <= n) {
+    size_t new_max = json->window.max;
+    char *new_buffer;
+
+    while (new_max - json->window.len <= n) {
+      new_max *= 2;
     }
-    rp++;
+    new_buffer = (char *) json->my_realloc (json->window.buffer, new_max);
+    if (new_buffer == NULL) {
+      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    json->window.max = new_max;
+    json->window.buffer = new_buffer;
   }
-  s = json->u_parse.json_str;
-  while (s != cp) {
-    json->position++;
-    json->column += fast_json_utf8_size[*s & 0xFFu] != 0;
-    if (*s == '\n') {
-      json->line++;
-      json->column = 0;
+  if (block) {
+    memcpy (json->window.buffer + json->window.len, block, n);
+  }
+  else if (json->window.fp) {
+    n = fread (json->window.buffer + json->window.len, 1,
+	       json->window.max - json->window.len - 1, json->window.fp);
+    if (n == 0) {
+      json->window.eof = 1;
     }
-    s++;
   }
+  else {
+    int len;
+
+    do {
+      len = read (json->window.fd, json->window.buffer + json->window.len,
+		  json->window.max - json->window.len - 1);
+    } while (len < 0 && fast_json_read_again (json->window.fd));
+
+    if (len <= 0) {
+      json->window.eof = 1;
+      len = 0;
+    }
+    n = len;
+  }
+  json->window.len += n;
+  return FAST_JSON_OK;
 }
 
-static FAST_JSON_ERROR_ENUM
-fast_json_skip_whitespace2 (FAST_JSON_TYPE json, const char **buf)
+#if FAST_JSON_SIMD
+/* Return the number of bytes from ptr that the value scanner can skip.
+ * Only '\0', '"', '\'', '/', '[', '\\', ']', '{' and '}' are of interest.
+ * '|' is also reported because it is cheaper to test.
+ */
+static size_t
+fast_json_scan_plain_sse2 (const char *ptr, const char *end)
 {
-  FAST_JSON_ERROR_ENUM retval = FAST_JSON_OK;
-  const char *cp = *buf;
+  const __m128i zero = _mm_setzero_si128 ();
+  const __m128i quote = _mm_set1_epi8 ('"');
+  const __m128i squote = _mm_set1_epi8 ('\'');
+  const __m128i slash = _mm_set1_epi8 ('/');
+  const __m128i lower = _mm_set1_epi8 (0x20);
+  const __m128i open = _mm_set1_epi8 ('{');
+  const __m128i bar = _mm_set1_epi8 ('|');
+  const __m128i close = _mm_set1_epi8 ('}');
+  const char *start = ptr;
+
+  while (end - ptr >= 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) ptr);
+    __m128i l = _mm_or_si128 (v, lower);
+    __m128i s = _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (v, zero),
+					    _mm_cmpeq_epi8 (v, quote)),
+			      _mm_or_si128 (_mm_cmpeq_epi8 (v, squote),
+					    _mm_cmpeq_epi8 (v, slash)));
+    unsigned int m;
+
+    s = _mm_or_si128 (s, _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (l, open),
+						     _mm_cmpeq_epi8 (l, bar)),
+				       _mm_cmpeq_epi8 (l, close)));
+    m = _mm_movemask_epi8 (s);
+    if (m) {
+      return (ptr - start) + __builtin_ctz (m);
+    }
+    ptr += 16;
+  }
+  return ptr - start;
+}
 
-  for (;;) {
-    if ((json->options & FAST_JSON_ALLOW_JSON5)) {
-      for (;;) {
-	const unsigned char *uc = (const unsigned char *) cp;
+__attribute ((target ("avx2")))
+static size_t
+fast_json_scan_plain_avx2 (const char *ptr, const char *end)
+{
+  const __m256i zero = _mm256_setzero_si256 ();
+  const __m256i quote = _mm256_set1_epi8 ('"');
+  const __m256i squote = _mm256_set1_epi8 ('\'');
+  const __m256i slash = _mm256_set1_epi8 ('/');
+  const __m256i lower = _mm256_set1_epi8 (0x20);
+  const __m256i open = _mm256_set1_epi8 ('{');
+  const __m256i bar = _mm256_set1_epi8 ('|');
+  const __m256i close = _mm256_set1_epi8 ('}');
+  const char *start = ptr;
+
+  while (end - ptr >= 32) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) ptr);
+    __m256i l = _mm256_or_si256 (v, lower);
+    __m256i s =
+      _mm256_or_si256 (_mm256_or_si256 (_mm256_cmpeq_epi8 (v, zero),
+					_mm256_cmpeq_epi8 (v, quote)),
+		       _mm256_or_si256 (_mm256_cmpeq_epi8 (v, squote),
+					_mm256_cmpeq_epi8 (v, slash)));
+    unsigned int m;
+
+    s = _mm256_or_si256 (s,
+			 _mm256_or_si256 (_mm256_or_si256
+					  (_mm256_cmpeq_epi8 (l, open),
+					   _mm256_cmpeq_epi8 (l, bar)),
+					  _mm256_cmpeq_epi8 (l, close)));
+    m = _mm256_movemask_epi8 (s);
+    if (m) {
+      return (ptr - start) + __builtin_ctz (m);
+    }
+    ptr += 32;
+  }
+  return (ptr - start) + fast_json_scan_plain_sse2 (ptr, end);
+}
+#endif
 
-        if (fast_json5_space[*uc & 0xff] == 0) {
-	  break;
-        }
-        if (fast_json5_isspace (*uc)) {
-          cp++;
-        }
-        else if (*uc == 0xc2 && uc[1] == 0xa0) {
-          /* Non-breaking space */
-          cp += 2;
-        }
-        else if ((*uc == 0xe2 && uc[1] == 0x80 &&
-                  (uc[2] == 0xa8 || uc[2] == 0xa9)) ||
-		 (*uc == 0xef && uc[1] == 0xbb && uc[2] == 0xbf)) {
-          /* Line separator */
-          /* Paragraph separator */
-          /* Byte order mark */
-          cp += 3;
-        }
-        else {
-          break;
-        }
-      }
-    }
-    else {
-      while (fast_json_isspace (*cp)) {
-        cp++;
+/* Return the number of bytes from ptr that the value scanners can skip
+ * with simd. The remaining bytes are checked with fast_json_scan_special.
+ */
+static ALWAYS_INLINE size_t
+fast_json_scan_plain (FAST_JSON_TYPE json, const char *ptr, const char *end)
+{
+#if FAST_JSON_SIMD
+  return json->simd == 2 ? fast_json_scan_plain_avx2 (ptr, end) :
+    fast_json_scan_plain_sse2 (ptr, end);
+#else
+  (void) json;
+  (void) ptr;
+  (void) end;
+  return 0;
+#endif
+}
+
+/* Find the end of the value at window.start. Scanning continues where the
+ * previous call stopped so every byte is only looked at once. Returns 1
+ * and the end position in end if the value is complete. The value itself
+ * is checked by the parser.
+ */
+static int
+fast_json_window_scan (FAST_JSON_TYPE json, size_t *end)
+{
+  const char *buffer = json->window.buffer;
+  size_t i = json->window.scan;
+  size_t len = json->window.len;
+  size_t depth = json->window.depth;
+  int state = json->window.state;
+  int quote = json->window.quote;
+  int found = 0;
+
+  while (i < len && found == 0) {
+    int c;
+
+    /* Inside a container only quotes, brackets, '/' and '\0' matter
+     * and inside a string only the quote, '\\' and '\0'.
+     */
+    if (state == FAST_JSON_SCAN_STRING ||
+	(state == FAST_JSON_SCAN_VALUE && depth)) {
+      i += fast_json_scan_plain (json, buffer + i, buffer + len);
+      while (i < len && fast_json_scan_special[buffer[i] & 0xFFu] == 0) {
+	i++;
+      }
+      if (i == len) {
+	break;
       }
     }
-    if (UNLIKELY (*cp == '/') &&
-        LIKELY ((json->options & FAST_JSON_NO_COMMENT) == 0)) {
-      if (cp[1] == '*') {
-	cp += 2;
-	while (*cp) {
-	  if (*cp == '*' && cp[1] == '/') {
-	    cp += 2;
-	    break;
-	  }
-	  cp++;
+    c = buffer[i] & 0xFFu;
+    switch (state) {
+    case FAST_JSON_SCAN_VALUE:
+      switch (c) {
+      case '\0':
+	found = 1;
+	continue;
+      case '\'':			/* FALLTHRU */
+      case '"':
+	state = FAST_JSON_SCAN_STRING;
+	quote = c;
+	break;
+      case '[':			/* FALLTHRU */
+      case '{':
+	depth++;
+	break;
+      case ']':			/* FALLTHRU */
+      case '}':
+	if (depth) {
+	  depth--;
+	}
+	found = depth == 0;
+	break;
+      case '/':
+	if ((json->options & FAST_JSON_NO_COMMENT) == 0) {
+	  state = FAST_JSON_SCAN_SLASH;
+	  break;
 	}
-      }
-      else if (cp[1] == '/') {
-	cp += 2;
-	while (*cp) {
-	  if (*cp == '\n') {
-	    cp++;
-	    break;
-	  }
-	  cp++;
+	goto scalar;
+      case ',':			/* FALLTHRU */
+      case ':':
+	found = depth == 0;
+	break;
+      default:
+	if (fast_json_isspace (c)) {
+	  break;
+	}
+      scalar:
+	if (depth == 0) {
+	  state = FAST_JSON_SCAN_SCALAR;
 	}
+	break;
       }
-      else {
-	fast_json_store_error2 (json, FAST_JSON_COMMENT_ERROR, cp, ":,]}");
-	retval = FAST_JSON_COMMENT_ERROR;
+      break;
+    case FAST_JSON_SCAN_SCALAR:
+      if (fast_json_isdigit (c) || fast_json_isalpha (c) || c == '+' || c == '-' || c == '.') {
 	break;
       }
-    }
-    else {
+      found = 1;
+      continue;
+    case FAST_JSON_SCAN_STRING:
+      if (c == '\0') {
+	found = 1;
+	continue;
+      }
+      if (c == '\\') {
+	state = FAST_JSON_SCAN_ESCAPE;
+      }
+      else if (c == quote) {
+	state = FAST_JSON_SCAN_VALUE;
+	found = depth == 0;
+      }
+      break;
+    case FAST_JSON_SCAN_ESCAPE:
+      state = FAST_JSON_SCAN_STRING;
+      if (c == '\0') {
+	found = 1;
+	continue;
+      }
+      break;
+    case FAST_JSON_SCAN_SLASH:
+      if (c == '/') {
+	state = FAST_JSON_SCAN_LINE;
+      }
+      else if (c == '*') {
+	state = FAST_JSON_SCAN_COMMENT;
+      }
+      else {
+	/* Invalid comment. Let the parser report it. */
+	found = 1;
+	continue;
+      }
+      break;
+    case FAST_JSON_SCAN_LINE:
+      if (c == '\n') {
+	state = FAST_JSON_SCAN_VALUE;
+      }
+      break;
+    case FAST_JSON_SCAN_COMMENT:
+      if (c == '*') {
+	state = FAST_JSON_SCAN_STAR;
+      }
+      break;
+    case FAST_JSON_SCAN_STAR:
+      if (c == '/') {
+	state = FAST_JSON_SCAN_VALUE;
+      }
+      else if (c != '*') {
+	state = FAST_JSON_SCAN_COMMENT;
+      }
       break;
     }
+    i++;
   }
-  *buf = cp;
-  return retval;
+  json->window.scan = i;
+  json->window.depth = depth;
+  json->window.state = state;
+  json->window.quote = quote;
+  *end = i;
+  return found;
+}
+
+#ifndef WIN
+/* Map a regular file and parse it in place with the string parser. The
+ * mapping is followed by at least one zero byte. If the file size is a
+ * multiple of the page size an anonymous zero page is mapped after it.
+ * json_end bounds the vector loads to the file data. Returns 0 if the file
+ * can not be mapped. The caller then uses the normal file reader.
+ */
+static int
+fast_json_parse_map (FAST_JSON_TYPE json, const char *name,
+		     FAST_JSON_DATA_TYPE * v)
+{
+  int fd;
+  struct stat st;
+  size_t size;
+  size_t map_size;
+  long page = sysconf (_SC_PAGESIZE);
+  char *base;
+
+  fd = open (name, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+  if (page <= 0 || fstat (fd, &st) < 0 || !S_ISREG (st.st_mode) ||
+      st.st_size <= 0) {
+    close (fd);
+    return 0;
+  }
+  size = st.st_size;
+  map_size = (size / page + 1) * page;
+  base = (char *) mmap (NULL, map_size, PROT_READ,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    close (fd);
+    return 0;
+  }
+  if (mmap (base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) ==
+      MAP_FAILED) {
+    munmap (base, map_size);
+    close (fd);
+    return 0;
+  }
+  close (fd);
+#ifdef MADV_SEQUENTIAL
+  madvise (base, size, MADV_SEQUENTIAL);
+#endif
+  json->u_parse.json_str = base;
+  json->json_end = base + size;
+  json->simd_block = NULL;
+  json->window.active = 0;
+  *v = fast_json_parse_all2 (json, 0);
+  munmap (base, map_size);
+  json->getc = fast_json_getc_file;
+  json->u_parse.fp = NULL;
+  return 1;
 }
+#endif
 
+/* Parse the next value from the window with the string parser. Without
+ * FAST_JSON_NO_EOF_CHECK all input is read first because the parser has
+ * to check that nothing follows the value.
+ */
 static FAST_JSON_DATA_TYPE
-fast_json_parse_value2 (FAST_JSON_TYPE json, const char **buf)
+fast_json_parse_window (FAST_JSON_TYPE json, unsigned int next)
 {
-  const char *value = *buf;
   FAST_JSON_DATA_TYPE v;
+  size_t end;
+  char save;
 
-  switch (*value) {
-  case 'n':			/* FALLTHRU */
-  case 'N':
-    if (value[1] == 'u' && value[2] == 'l' && value[3] == 'l') {
-      value += strlen ("null");
-      v = fast_json_create_null (json);
-    }
-    else if ((json->options & FAST_JSON_INF_NAN) != 0 &&
-	     strncasecmp (value, "nan", strlen ("nan")) == 0) {
-      const char *cp;
-      const char *save = value;
-
-      value += strlen ("nan");
-      cp = value;
-      if (*cp == '(') {
-	cp++;
-	while (fast_json_isalpha (*cp) || fast_json_isdigit (*cp) ||
-	       *cp == '_') {
-	  cp++;
-	}
-	if (*cp != ')') {
-	  fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
-	  return NULL;
-	}
-	value = cp + 1;
-      }
-      v = fast_json_create_double_value (json, fast_json_nan (0));
-    }
-    else {
-      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
-      return NULL;
-    }
-    break;
-  case 'f':
-    if (value[1] == 'a' && value[2] == 'l' && value[3] == 's' &&
-	value[4] == 'e') {
-      value += strlen ("false");
-      v = fast_json_create_false (json);
-    }
-    else {
-      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
-      return NULL;
-    }
-    break;
-  case 't':
-    if (value[1] == 'r' && value[2] == 'u' && value[3] == 'e') {
-      value += strlen ("true");
-      v = fast_json_create_true (json);
-    }
-    else {
-      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
+  if (json->window.buffer == NULL) {
+    json->window.buffer =
+      (char *) (*json->my_malloc) (FAST_JSON_WINDOW_SIZE);
+    if (json->window.buffer == NULL) {
+      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
       return NULL;
     }
-    break;
-  case 'i':			/* FALLTHRU */
-  case 'I':
-    if ((json->options & FAST_JSON_INF_NAN) != 0 &&
-	strncasecmp (value, "inf", 3) == 0) {
-      value += strlen ("inf");
-      if (strncasecmp (value, "inity", strlen ("inity")) == 0) {
-	value += strlen ("inity");
+    json->window.max = FAST_JSON_WINDOW_SIZE;
+  }
+  if (next == 0) {
+    json->window.active = 1;
+    json->window.feed = 0;
+    json->window.array = 0;
+    json->window.eof = 0;
+    json->window.start = 0;
+    json->window.len = 0;
+    json->window.scan = 0;
+    json->window.depth = 0;
+    json->window.state = FAST_JSON_SCAN_VALUE;
+    json->error = FAST_JSON_OK;
+  }
+  if ((json->options & FAST_JSON_NO_EOF_CHECK) == 0) {
+    while (json->window.eof == 0) {
+      if (fast_json_window_fill (json) != FAST_JSON_OK) {
+	return NULL;
       }
-      v = fast_json_create_double_value (json, fast_json_inf (0));
-    }
-    else {
-      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
-      return NULL;
     }
-    break;
-  case '\'':
-  case '"':
-    {
-      char str[8];
-      char *out = &str[0];
-      const char *save;
-      int sep = *value;
-      int nq = 0;
-
-      value++;
-      save = value;
-      while (*value && *value != sep) {
-        nq += (*value == '"');
-	if (*value++ == '\\') {
-	  nq += *value == 'x' ? 2 : (*value == '0' ? 4 : 0);
-	  value++;
-	}
-      }
-      if ((value - save) + nq >= sizeof (str)) {
-	out = (char *) (*json->my_malloc) ((value - save) + nq + 1);
-	if (out == NULL) {
-	  fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, value,
-				  ":,]}");
-	  return NULL;
-	}
-      }
-      if (fast_json_check_string (json, save, value, out, sep) != FAST_JSON_OK) {
-	fast_json_store_error2 (json, json->error, save, ":,]}");
-	if (out != &str[0]) {
-	  (*json->my_free) (out);
-	}
-	return NULL;
+    end = json->window.len;
+  }
+  else {
+    while (fast_json_window_scan (json, &end) == 0) {
+      if (json->window.eof) {
+	break;
       }
-      if (*value != sep) {
-	fast_json_store_error2 (json, FAST_JSON_STRING_END_ERROR, value,
-				":,]}");
-	if (out != &str[0]) {
-	  (*json->my_free) (out);
-	}
+      if (fast_json_window_fill (json) != FAST_JSON_OK) {
 	return NULL;
       }
-      v = fast_json_data_create (json);
-      if (v) {
-	v->type = FAST_JSON_STRING;
-	v->used = 0;
-	if (out != &str[0]) {
-	  v->is_str = 0;
-	  v->u.string_value = out;
-	}
-	else {
-	  v->is_str = 1;
-	  memcpy (v->u.i_string_value, out, (value - save) + 1);
-	}
-      }
-      value++;
     }
-    break;
-  case '.':
-      if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
-        fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, value, ":,]}");
-        return NULL;
-      }
-      /* FALLTHRU */
-  case '+':			/* FALLTHRU */
-  case '-':			/* FALLTHRU */
-  case '0':			/* FALLTHRU */
-  case '1':			/* FALLTHRU */
-  case '2':			/* FALLTHRU */
-  case '3':			/* FALLTHRU */
-  case '4':			/* FALLTHRU */
-  case '5':			/* FALLTHRU */
-  case '6':			/* FALLTHRU */
-  case '7':			/* FALLTHRU */
-  case '8':			/* FALLTHRU */
-  case '9':
-    {
-      unsigned int integer = 1;
-      unsigned int hex = 0;
-      unsigned int sign = 0;
-      unsigned int ndigit = 0;
-      const char *save;
-      char *end;
-      const char *dp = NULL;
+  }
+  save = json->window.buffer[end];
+  json->window.buffer[end] = '\0';
+  json->u_parse.json_str = json->window.buffer + json->window.start;
+  json->json_end = json->window.buffer + end;
+  json->simd_block = NULL;
+  v = fast_json_parse_all2 (json, next);
+  json->window.buffer[end] = save;
+  if (v) {
+    json->window.start = json->u_parse.json_str - json->window.buffer;
+  }
+  json->window.scan = json->window.start;
+  json->window.depth = 0;
+  json->window.state = FAST_JSON_SCAN_VALUE;
+  return v;
+}
 
-      save = value;
-      if (UNLIKELY (*value == '+')) {
-	if ((json->options & FAST_JSON_INF_NAN) != 0) {
-	  value++;
-	}
-      }
-      else if (*value == '-') {
-	sign = 1;
-	value++;
-      }
-      if (*value == '0') {
-	ndigit++;
-	value++;
-	if ((json->options & FAST_JSON_ALLOW_OCT_HEX) != 0) {
-	  if (*value == 'x' || *value == 'X') {
-	    hex = 1;
-	    value++;
-	    while (fast_json_isxdigit (*value)) {
-	      ndigit++;
-	      value++;
-	    }
-	  }
-	  else {
-	    while (*value >= '0' && *value <= '7') {
-	      ndigit++;
-	      value++;
-	    }
-	  }
-	}
-      }
-      else if (LIKELY (fast_json_isdigit (*value))) {
-	do {
-	  ndigit++;
-	  value++;
-	} while (fast_json_isdigit (*value));
-      }
-      else if ((json->options & FAST_JSON_ALLOW_JSON5) && *value == '.') {
-      }
-      else {
-	if ((json->options & FAST_JSON_INF_NAN) != 0) {
-	  if (strncasecmp (value, "inf", strlen ("inf")) == 0) {
-	    value += strlen ("inf");
-	    if (strncasecmp (value, "inity", strlen ("inity")) == 0) {
-	      value += strlen ("inity");
-	    }
-	    v = fast_json_create_double_value (json, fast_json_inf (sign));
-	    break;
-	  }
-	  else if (strncasecmp (value, "nan", strlen ("nan")) == 0) {
-	    const char *cp;
+/* Parse the lines of an ndjson chunk. A line is parsed in place first. If
+ * that fails or the value does not end on the line, the line is copied and
+ * parsed on its own with fast_json_parse_string2. So the result and the
+ * error are the same as for the single line.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_ndjson_chunk (FAST_JSON_NDJSON_WORKER_TYPE * w,
+			FAST_JSON_NDJSON_CHUNK_TYPE * chunk)
+{
+  FAST_JSON_TYPE json = w->json;
+  const char *line = chunk->start;
+  const char *nl;
+  const char *cp;
+  FAST_JSON_DATA_TYPE v;
 
-	    value += strlen ("nan");
-	    cp = value;
-	    if (*cp == '(') {
-	      cp++;
-	      while (fast_json_isalpha (*cp) || fast_json_isdigit (*cp) ||
-		     *cp == '_') {
-		cp++;
-	      }
-	      if (*cp != ')') {
-		fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save,
-					":,]}");
-		return NULL;
-	      }
-	      value = cp + 1;
-	    }
-	    v = fast_json_create_double_value (json, fast_json_nan (sign));
-	    break;
-	  }
+  while (line < chunk->end) {
+    nl = (const char *) memchr (line, '\n', chunk->end - line);
+    if (nl == NULL) {
+      nl = chunk->end;
+    }
+    cp = line;
+    while (cp < nl && (*cp == ' ' || *cp == '\t' || *cp == '\r')) {
+      cp++;
+    }
+    if (cp != nl) {
+      json->error = FAST_JSON_OK;
+      json->u_parse.json_str = line;
+      json->json_end = w->nd->end;
+      json->simd_block = NULL;
+      v = fast_json_parse_value2 (json, &cp);
+      if (v) {
+	while (cp < nl && (*cp == ' ' || *cp == '\t' || *cp == '\r')) {
+	  cp++;
+	}
+	if (cp != nl) {
+	  fast_json_value_free (json, v);
+	  v = NULL;
 	}
-	fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
-	return NULL;
       }
-      if (*value == '.') {
-	dp = value++;
-	integer = 0;
-	if (UNLIKELY (hex)) {
-	  if (fast_json_isxdigit (*value)) {
-	    do {
-	      ndigit++;
-	      value++;
-	    } while (fast_json_isxdigit (*value));
-	  }
-	  else if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
-	    fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save,
-				    ":,]}");
-	    return NULL;
-	  }
-	}
-	else {
-	  if (fast_json_isdigit (*value)) {
-	    do {
-	      ndigit++;
-	      value++;
-	    } while (fast_json_isdigit (*value));
-	  }
-	  else if ((json->options & FAST_JSON_ALLOW_JSON5) == 0) {
-	    fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save,
-				    ":,]}");
-	    return NULL;
+      if (v == NULL) {
+	size_t len = nl - line;
+
+	if (len >= w->max_line) {
+	  char *new_line = (char *) (*json->my_realloc) (w->line, len + 1);
+
+	  if (new_line == NULL) {
+	    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+	    json->line = 1;
+	    json->column = 0;
+	    json->position = 0;
+	    chunk->error_line = line;
+	    chunk->error_json = json;
+	    return FAST_JSON_MALLOC_ERROR;
 	  }
+	  w->line = new_line;
+	  w->max_line = len + 1;
+	}
+	memcpy (w->line, line, len);
+	w->line[len] = '\0';
+	v = fast_json_parse_string2 (json, w->line);
+	if (v == NULL && json->error != FAST_JSON_NO_DATA_ERROR) {
+	  chunk->error_line = line;
+	  chunk->error_json = json;
+	  return json->error;
 	}
       }
-      if (*value == 'e' || *value == 'E' ||
-	  (hex && (*value == 'p' || *value == 'P'))) {
-	integer = 0;
-	value++;
-	if (*value == '+' || *value == '-') {
-	  value++;
-	}
-	if (fast_json_isdigit (*value)) {
-	  do {
-	    value++;
-	  } while (fast_json_isdigit (*value));
-	}
-	else {
-	  fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
-	  return NULL;
+      if (v && fast_json_ndjson_add (json, chunk, NULL, v) != FAST_JSON_OK) {
+	fast_json_value_free (json, v);
+	fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+	json->line = 1;
+	json->column = 0;
+	json->position = 0;
+	chunk->error_line = line;
+	chunk->error_json = json;
+	return FAST_JSON_MALLOC_ERROR;
+      }
+    }
+    chunk->lines++;
+    line = nl + 1;
+  }
+  return FAST_JSON_OK;
+}
+
+/* Parse the elements of a top level array or the members of a top level
+ * object from chunk->start up to the ',' or closing bracket at chunk->end.
+ * On error the caller parses the whole string again for the exact error.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_parallel_chunk (FAST_JSON_NDJSON_WORKER_TYPE * w,
+			  FAST_JSON_NDJSON_CHUNK_TYPE * chunk)
+{
+  FAST_JSON_TYPE json = w->json;
+  const char *cp = chunk->start;
+  FAST_JSON_DATA_TYPE v;
+  char name[16];
+  char *out = NULL;
+
+  json->error = FAST_JSON_OK;
+  json->u_parse.json_str = chunk->start;
+  json->json_end = w->nd->end;
+  json->simd_block = NULL;
+  while (cp < chunk->end) {
+    if (fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK) {
+      return json->error;
+    }
+    if (cp == chunk->end) {
+      /* Json5 trailing comma */
+      break;
+    }
+    if (w->nd->close == '}') {
+      out = fast_json_parse_name2 (json, &cp, name, sizeof (name));
+      if (out == NULL) {
+	return json->error;
+      }
+      if (out == &name[0]) {
+	out = fast_json_strdup (json, name);
+	if (out == NULL) {
+	  fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, cp, ":,]}");
+	  return FAST_JSON_MALLOC_ERROR;
 	}
       }
-      if (ndigit == 0) {
-	fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save, ":,]}");
-	return NULL;
+      if (fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK ||
+	  *cp++ != ':' ||
+	  fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK) {
+	(*json->my_free) (out);
+	return FAST_JSON_OBJECT_SEPERATOR_ERROR;
       }
-      if ((json->options & FAST_JSON_PARSE_INT_AS_DOUBLE) == 0 && integer) {
-	fast_json_int_64 int_value;
+    }
+    v = fast_json_parse_value2 (json, &cp);
+    if (v == NULL) {
+      (*json->my_free) (out);
+      return json->error;
+    }
+    if (fast_json_ndjson_add (json, chunk, out, v) != FAST_JSON_OK) {
+      (*json->my_free) (out);
+      fast_json_value_free (json, v);
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    out = NULL;
+    if (fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK) {
+      return json->error;
+    }
+    if (*cp != ',' && cp != chunk->end) {
+      return FAST_JSON_VALUE_ERROR;
+    }
+    cp++;
+  }
+  return FAST_JSON_OK;
+}
 
-	errno = 0;
-#if USE_FAST_CONVERT
-	int_value = fast_strtos64 (save, &end, 0);
-#else
-#if __WORDSIZE == 64
-	int_value = strtol (save, &end, 0);
-#else
-	int_value = strtoll (save, &end, 0);
+/* Add the value v and for objects the malloced name to chunk. */
+static FAST_JSON_ERROR_ENUM
+fast_json_ndjson_add (FAST_JSON_TYPE json,
+		      FAST_JSON_NDJSON_CHUNK_TYPE * chunk, char *name,
+		      FAST_JSON_DATA_TYPE v)
+{
+  if (chunk->n == chunk->max) {
+    size_t max = chunk->max ? chunk->max * 2 : FAST_JSON_INITIAL_SIZE;
+    FAST_JSON_DATA_TYPE *values =
+      (FAST_JSON_DATA_TYPE *) (*json->my_realloc) (chunk->values,
+						   max * sizeof (*values));
+
+    if (values == NULL) {
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    chunk->values = values;
+    if (name) {
+      char **names = (char **) (*json->my_realloc) (chunk->names,
+						    max * sizeof (*names));
+
+      if (names == NULL) {
+	return FAST_JSON_MALLOC_ERROR;
+      }
+      chunk->names = names;
+    }
+    chunk->max = max;
+  }
+  if (name) {
+    chunk->names[chunk->n] = name;
+  }
+  chunk->values[chunk->n++] = v;
+  return FAST_JSON_OK;
+}
+
+/* Thread function of fast_json_parse_ndjson. Parse chunks until all chunks
+ * are started or a chunk before the next one had an error.
+ */
+static void *
+fast_json_ndjson_worker (void *data)
+{
+  FAST_JSON_NDJSON_WORKER_TYPE *w = (FAST_JSON_NDJSON_WORKER_TYPE *) data;
+  FAST_JSON_NDJSON_TYPE *nd = w->nd;
+  size_t i;
+  int take;
+
+  for (;;) {
+#ifndef WIN
+    pthread_mutex_lock (&nd->lock);
 #endif
+    i = nd->next;
+    take = i < nd->failed;
+    if (take) {
+      nd->next++;
+    }
+#ifndef WIN
+    pthread_mutex_unlock (&nd->lock);
 #endif
-	if (end == value && errno != ERANGE) {
-	  v = fast_json_create_integer_value (json, int_value);
-	  break;
-	}
+    if (take == 0) {
+      break;
+    }
+    if ((nd->close ? fast_json_parallel_chunk (w, &nd->chunks[i]) :
+	 fast_json_ndjson_chunk (w, &nd->chunks[i])) != FAST_JSON_OK) {
+#ifndef WIN
+      pthread_mutex_lock (&nd->lock);
+#endif
+      if (i < nd->failed) {
+	nd->failed = i;
       }
-      {
-	double n;
-
-	if (dp && json->decimal_point != '.') {
-	  char e;
-	  char b[100];
-	  char *s = &b[0];
-
-	  if ((value - save) >= sizeof (b)) {
-	    s = (char *) (*json->my_malloc) ((value - save) + 1);
-	    if (s == NULL) {
-	      fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, save,
-				      ":,]}");
-	      return NULL;
-	    }
-	  }
-	  memcpy (s, save, value - save);
-	  s[value - save] = '\0';
-	  s[dp - save] = json->decimal_point;
-	  errno = 0;
-#if USE_FAST_CONVERT
-	  n = fast_strtod (s, &end);
-#else
-	  n = strtod (s, &end);
+#ifndef WIN
+      pthread_mutex_unlock (&nd->lock);
 #endif
-	  e = *end;
-	  if (s != &b[0]) {
-	    (*json->my_free) (s);
-	  }
-	  if (e != '\0' || errno == ERANGE) {
-	    fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save,
-				    ":,]}");
-	    return NULL;
-	  }
-	}
-	else {
-	  errno = 0;
-#if USE_FAST_CONVERT
-	  n = fast_strtod (save, &end);
+      break;
+    }
+  }
+  return NULL;
+}
+
+/* Return the number of threads to use. 0 is one thread per online cpu. */
+static unsigned int
+fast_json_ndjson_threads (unsigned int n_threads)
+{
+#ifdef WIN
+  n_threads = 1;
 #else
-	  n = strtod (save, &end);
+  if (n_threads == 0) {
+    long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+
+    n_threads = cpus > 0 ? (unsigned int) cpus : 1;
+  }
 #endif
-	  if (end != value || errno == ERANGE) {
-	    fast_json_store_error2 (json, FAST_JSON_NUMBER_ERROR, save,
-				    ":,]}");
-	    return NULL;
-	  }
-	}
-	v = fast_json_create_double_value (json, n);
-      }
-    }
-    break;
-  case '[':
-    value++;
-    if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
+  return n_threads;
+}
+
+/* Parse the chunks of nd with at most n_threads threads. The calling thread
+ * is worker 0. Returns the workers or NULL with a malloc error in json.
+ */
+static FAST_JSON_NDJSON_WORKER_TYPE *
+fast_json_ndjson_run (FAST_JSON_TYPE json, FAST_JSON_NDJSON_TYPE * nd,
+		      unsigned int *n_threads)
+{
+  FAST_JSON_NDJSON_WORKER_TYPE *workers;
+  size_t i;
+
+  nd->next = 0;
+  nd->failed = nd->n_chunks;
+  if (*n_threads > nd->n_chunks) {
+    *n_threads = nd->n_chunks ? (unsigned int) nd->n_chunks : 1;
+  }
+  workers =
+    (FAST_JSON_NDJSON_WORKER_TYPE *) (*json->my_malloc) (*n_threads *
+							 sizeof (*workers));
+  if (workers == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    return NULL;
+  }
+  memset (workers, 0, *n_threads * sizeof (*workers));
+  for (i = 0; i < *n_threads; i++) {
+    workers[i].nd = nd;
+    workers[i].json = fast_json_create (json->my_malloc, json->my_realloc,
+					json->my_free);
+    if (workers[i].json == NULL) {
+      fast_json_ndjson_free (json, nd, workers, *n_threads);
+      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
       return NULL;
     }
-    v = fast_json_create_array (json);
-    if (v == NULL) {
-      fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, value, ":,]}");
+    workers[i].json->options = json->options &
+      ~(FAST_JSON_BIG_ALLOC | FAST_JSON_NO_EOF_CHECK);
+    workers[i].json->max_depth = json->max_depth;
+  }
+#ifndef WIN
+  pthread_mutex_init (&nd->lock, NULL);
+  for (i = 1; i < *n_threads; i++) {
+    workers[i].started = pthread_create (&workers[i].thread, NULL,
+					 fast_json_ndjson_worker,
+					 &workers[i]) == 0;
+  }
+#endif
+  fast_json_ndjson_worker (&workers[0]);
+#ifndef WIN
+  for (i = 1; i < *n_threads; i++) {
+    if (workers[i].started) {
+      pthread_join (workers[i].thread, NULL);
+    }
+  }
+  pthread_mutex_destroy (&nd->lock);
+#endif
+  return workers;
+}
+
+/* Move the values of all chunks into a new array. */
+static FAST_JSON_DATA_TYPE
+fast_json_ndjson_array (FAST_JSON_TYPE json, FAST_JSON_NDJSON_TYPE * nd)
+{
+  FAST_JSON_DATA_TYPE v;
+  FAST_JSON_ARRAY_TYPE *a;
+  size_t total = 0;
+  size_t i;
+  size_t j;
+
+  for (i = 0; i < nd->n_chunks; i++) {
+    total += nd->chunks[i].n;
+  }
+  v = fast_json_create_array (json);
+  if (v && total) {
+    a = (FAST_JSON_ARRAY_TYPE *) fast_json_data_alloc (json, v, sizeof (*a) +
+						       (total - 1) *
+						       sizeof (a->values[0]));
+    if (a == NULL) {
+      fast_json_data_free (json, v);
       return NULL;
     }
-    if (*value == ']') {
-      value++;
-      break;
+    a->len = 0;
+    a->max = total;
+    for (i = 0; i < nd->n_chunks; i++) {
+      for (j = 0; j < nd->chunks[i].n; j++) {
+	nd->chunks[i].values[j]->used = 1;
+	a->values[a->len++] = nd->chunks[i].values[j];
+      }
+      nd->chunks[i].n = 0;
     }
-    for (;;) {
-      FAST_JSON_DATA_TYPE n = fast_json_parse_value2 (json, &value);
+    v->used = 1;
+    v->u.array = a;
+  }
+  return v;
+}
 
-      if (n == NULL) {
-	fast_json_value_free (json, v);
-	return NULL;
-      }
-      if (fast_json_add_array_end (json, v, n) != FAST_JSON_OK) {
-	fast_json_value_free (json, n);
-	fast_json_value_free (json, v);
-	return NULL;
-      }
-      if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
-	fast_json_value_free (json, v);
-	return NULL;
-      }
-      if (*value != ',') {
-	break;
-      }
-      value++;
-      if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
-	fast_json_value_free (json, v);
-	return NULL;
+/* Free the chunks with the values that were not used and the workers. */
+static void
+fast_json_ndjson_free (FAST_JSON_TYPE json, FAST_JSON_NDJSON_TYPE * nd,
+		       FAST_JSON_NDJSON_WORKER_TYPE * workers,
+		       unsigned int n_threads)
+{
+  size_t i;
+  size_t j;
+
+  for (i = 0; i < nd->n_chunks; i++) {
+    for (j = 0; j < nd->chunks[i].n; j++) {
+      fast_json_value_free (json, nd->chunks[i].values[j]);
+      if (nd->chunks[i].names) {
+	(*json->my_free) (nd->chunks[i].names[j]);
       }
-      if ((json->options & FAST_JSON_ALLOW_JSON5) && *value == ']') {
-        break;
+    }
+    (*json->my_free) (nd->chunks[i].values);
+    (*json->my_free) (nd->chunks[i].names);
+  }
+  if (workers) {
+    for (i = 0; i < n_threads; i++) {
+      (*json->my_free) (workers[i].line);
+      if (workers[i].json) {
+	/* Arena values of the workers are now values of json */
+	fast_json_arena_move (json, workers[i].json);
       }
+      fast_json_free (workers[i].json);
     }
-    if (*value != ']') {
-      fast_json_store_error2 (json, FAST_JSON_ARRAY_END_ERROR, value, ":,]}");
-      fast_json_value_free (json, v);
+    (*json->my_free) (workers);
+  }
+  (*json->my_free) (nd->chunks);
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_ndjson (FAST_JSON_TYPE json, const char *json_str,
+			unsigned int n_threads)
+{
+  FAST_JSON_NDJSON_TYPE nd;
+  FAST_JSON_NDJSON_WORKER_TYPE *workers;
+  FAST_JSON_DATA_TYPE v = NULL;
+  const char *cp;
+  size_t len;
+  size_t size;
+  size_t i;
+
+  if (json == NULL || json_str == NULL) {
+    return NULL;
+  }
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  n_threads = fast_json_ndjson_threads (n_threads);
+  len = strlen (json_str);
+  size = len / ((size_t) n_threads * 8);
+  if (size < FAST_JSON_NDJSON_CHUNK) {
+    size = FAST_JSON_NDJSON_CHUNK;
+  }
+  nd.end = json_str + len;
+  nd.close = 0;
+  nd.chunks =
+    (FAST_JSON_NDJSON_CHUNK_TYPE *) (*json->my_malloc) ((len / size + 1) *
+							sizeof (*nd.chunks));
+  if (nd.chunks == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    return NULL;
+  }
+
+  /* Split the input at the first line end after every size bytes */
+  nd.n_chunks = 0;
+  cp = json_str;
+  while (cp < nd.end) {
+    FAST_JSON_NDJSON_CHUNK_TYPE *chunk = &nd.chunks[nd.n_chunks++];
+    const char *nl = NULL;
+
+    memset (chunk, 0, sizeof (*chunk));
+    chunk->start = cp;
+    if ((size_t) (nd.end - cp) > size) {
+      nl = (const char *) memchr (cp + size, '\n', nd.end - cp - size);
+    }
+    cp = nl ? nl + 1 : nd.end;
+    chunk->end = cp;
+  }
+
+  workers = fast_json_ndjson_run (json, &nd, &n_threads);
+  if (workers == NULL) {
+    return NULL;
+  }
+  if (nd.failed == nd.n_chunks) {
+    v = fast_json_ndjson_array (json, &nd);
+    if (v == NULL) {
+      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    }
+  }
+  else {
+    FAST_JSON_NDJSON_CHUNK_TYPE *chunk = &nd.chunks[nd.failed];
+    FAST_JSON_TYPE error_json = chunk->error_json;
+
+    json->error = error_json->error;
+    memcpy (json->error_str, error_json->error_str, sizeof (json->error_str));
+    json->line = chunk->lines + error_json->line;
+    for (i = 0; i < nd.failed; i++) {
+      json->line += nd.chunks[i].lines;
+    }
+    json->column = error_json->column;
+    json->position = (chunk->error_line - json_str) + error_json->position;
+  }
+  fast_json_ndjson_free (json, &nd, workers, n_threads);
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_ndjson_fd (FAST_JSON_TYPE json, int fd,
+			   unsigned int n_threads)
+{
+  if (json == NULL) {
+    return NULL;
+  }
+  if (json->window.buffer == NULL) {
+    json->window.buffer =
+      (char *) (*json->my_malloc) (FAST_JSON_WINDOW_SIZE);
+    if (json->window.buffer == NULL) {
+      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
       return NULL;
     }
-    value++;
-    break;
-  case '{':
-    {
-      value++;
-      if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
-	return NULL;
-      }
-      v = fast_json_create_object (json);
-      if (v == NULL) {
-	fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, value, ":,]}");
-	return NULL;
+    json->window.max = FAST_JSON_WINDOW_SIZE;
+  }
+  json->window.block = NULL;
+  json->window.fp = NULL;
+  json->window.fd = fd;
+  json->window.active = 0;
+  json->window.feed = 0;
+  json->window.array = 0;
+  json->window.eof = 0;
+  json->window.start = 0;
+  json->window.len = 0;
+  json->window.scan = 0;
+  while (json->window.eof == 0) {
+    if (fast_json_window_fill (json) != FAST_JSON_OK) {
+      return NULL;
+    }
+  }
+  json->window.buffer[json->window.len] = '\0';
+  return fast_json_parse_ndjson (json, json->window.buffer, n_threads);
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_parse_parallel (FAST_JSON_TYPE json, const char *json_str,
+			  unsigned int n_threads)
+{
+  FAST_JSON_NDJSON_TYPE nd;
+  FAST_JSON_NDJSON_CHUNK_TYPE *chunk;
+  FAST_JSON_NDJSON_WORKER_TYPE *workers;
+  FAST_JSON_DATA_TYPE v = NULL;
+  const char *cp;
+  size_t len;
+  size_t size;
+  size_t n = 0;
+  size_t i;
+  size_t j;
+
+  if (json == NULL || json_str == NULL) {
+    return NULL;
+  }
+  n_threads = fast_json_ndjson_threads (n_threads);
+  len = strlen (json_str);
+  size = len / ((size_t) n_threads * 8);
+  if (size < FAST_JSON_NDJSON_CHUNK) {
+    size = FAST_JSON_NDJSON_CHUNK;
+  }
+  if (n_threads == 1 || len < 2 * size) {
+    return fast_json_parse_string2 (json, json_str);
+  }
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  json->u_parse.json_str = json_str;
+  json->json_end = json_str + len;
+  json->simd_block = NULL;
+  cp = json_str;
+  if (fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK ||
+      (*cp != '[' && *cp != '{') ||
+      fast_json_stack_check (json, 0) != FAST_JSON_OK) {
+    return fast_json_parse_string2 (json, json_str);
+  }
+  nd.end = json_str + len;
+  nd.close = *cp++ == '[' ? ']' : '}';
+  nd.chunks =
+    (FAST_JSON_NDJSON_CHUNK_TYPE *) (*json->my_malloc) ((len / size + 1) *
+							sizeof (*nd.chunks));
+  if (nd.chunks == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+    return NULL;
+  }
+
+  /* Find the top level elements with the skip scanner and split after
+   * the first element that ends after every size bytes. Anything that
+   * does not look right is left to the normal parser.
+   */
+  nd.n_chunks = 1;
+  chunk = &nd.chunks[0];
+  memset (chunk, 0, sizeof (*chunk));
+  chunk->start = cp;
+  for (;;) {
+    if (fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK) {
+      break;
+    }
+    if (*cp != nd.close ||
+	(n && (json->options & FAST_JSON_ALLOW_JSON5) == 0)) {
+      if (nd.close == '}' &&
+	  (fast_json_skip_value2 (json, &cp, 1) != FAST_JSON_OK ||
+	   fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK ||
+	   *cp++ != ':')) {
+	break;
       }
-      if (*value == '}') {
-	value++;
+      if (fast_json_skip_value2 (json, &cp, 1) != FAST_JSON_OK ||
+	  fast_json_skip_whitespace2 (json, &cp) != FAST_JSON_OK) {
 	break;
       }
-      for (;;) {
-	const char *save;
-	const char *end;
-	char name[16];
-	char *out = &name[0];
-	FAST_JSON_DATA_TYPE n;
-        unsigned int nq = 0;
-
-	if ((json->options & FAST_JSON_ALLOW_JSON5) && *value != '"') {
-	  save = value;
-	  while (*value && *value != ':') {
-	    const unsigned char *uc = (const unsigned char *) value;
-
-            if (fast_json5_isspace (*uc) ||
-		(*uc == 0xc2 && uc[1] == 0xa0) ||
-		(*uc == 0xe2 && uc[1] == 0x80 &&
-		 (uc[2] == 0xa8 || uc[2] == 0xa9)) ||
-		(*uc == 0xef && uc[1] == 0xbb && uc[2] == 0xbf)) {
-		/* Non-breaking space */
-		/* Line separator */
-		/* Paragraph separator */
-		/* Byte order mark */
-              break;
-	    }
-            nq += (*value == '"');
-	    if (*value++ == '\\') {
-	      nq += *value == 'x' ? 2 : (*value == '0' ? 4 : 0);
-	      value++;
-	    }
-	  }
-	  end = value;
-	}
-	else {
-	  if (*value++ != '"') {
-	    fast_json_store_error2 (json, FAST_JSON_STRING_START_ERROR, value,
-				    ":,]}");
-	    fast_json_value_free (json, v);
-	    return NULL;
-	  }
-	  save = value;
-	  while (*value && *value != '"') {
-            nq += (*value == '"');
-	    if (*value++ == '\\') {
-	      nq += *value == 'x' ? 2 : (*value == '0' ? 4 : 0);
-	      value++;
-	    }
-	  }
-	  if (*value != '"') {
-	    fast_json_store_error2 (json, FAST_JSON_STRING_END_ERROR, save,
-				    ":,]}");
-	    if (out != &name[0]) {
-	      (*json->my_free) (out);
-	    }
-	    fast_json_value_free (json, v);
-	    return NULL;
-	  }
-	  end = value++;
-        }
-	if ((end - save) + nq >= sizeof (name)) {
-	  out = (char *) (*json->my_malloc) ((end - save) + nq + 1);
-	  if (out == NULL) {
-	    fast_json_store_error2 (json, FAST_JSON_MALLOC_ERROR, save,
-				    ":,]}");
-	    fast_json_value_free (json, v);
-	    return NULL;
-	  }
-	}
-	if (fast_json_check_string (json, save, end, out, '"') != FAST_JSON_OK) {
-	  fast_json_store_error2 (json, json->error, save, ":,]}");
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
-	  fast_json_value_free (json, v);
-	  return NULL;
-	}
-	if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
-	  fast_json_value_free (json, v);
-	  return NULL;
-	}
-	if (*value != ':') {
-	  fast_json_store_error2 (json, FAST_JSON_OBJECT_SEPERATOR_ERROR,
-				  value, ":,]}");
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
-	  fast_json_value_free (json, v);
-	  return NULL;
-	}
-	value++;
-	if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
-	  fast_json_value_free (json, v);
-	  return NULL;
-	}
-	n = fast_json_parse_value2 (json, &value);
-	if (n == NULL) {
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
-	  fast_json_value_free (json, v);
-	  return NULL;
-	}
-	if (fast_json_add_object_end (json, v, out, n) != FAST_JSON_OK) {
-	  fast_json_value_free (json, n);
-	  if (out != &name[0]) {
-	    (*json->my_free) (out);
-	  }
-	  fast_json_value_free (json, v);
-	  return NULL;
+      n++;
+      if (*cp == ',') {
+	if ((size_t) (cp - chunk->start) >= size) {
+	  chunk->end = cp;
+	  chunk = &nd.chunks[nd.n_chunks++];
+	  memset (chunk, 0, sizeof (*chunk));
+	  chunk->start = cp + 1;
 	}
-	if (out != &name[0]) {
-	  (*json->my_free) (out);
-	}
-	if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
+	cp++;
+	continue;
+      }
+    }
+    if (*cp == nd.close) {
+      const char *end = cp++;
+
+      if (fast_json_skip_whitespace2 (json, &cp) == FAST_JSON_OK &&
+	  *cp == '\0') {
+	chunk->end = end;
+      }
+    }
+    break;
+  }
+  if (chunk->end == NULL || nd.n_chunks == 1) {
+    (*json->my_free) (nd.chunks);
+    return fast_json_parse_string2 (json, json_str);
+  }
+
+  workers = fast_json_ndjson_run (json, &nd, &n_threads);
+  if (workers == NULL) {
+    return NULL;
+  }
+  if (nd.failed != nd.n_chunks) {
+    fast_json_ndjson_free (json, &nd, workers, n_threads);
+    return fast_json_parse_string2 (json, json_str);
+  }
+  if (nd.close == ']') {
+    v = fast_json_ndjson_array (json, &nd);
+  }
+  else {
+    /* Add the members in order. Duplicate names are handled like in the
+     * normal parser.
+     */
+    v = fast_json_create_object (json);
+    for (i = 0; v && i < nd.n_chunks; i++) {
+      chunk = &nd.chunks[i];
+      for (j = 0; j < chunk->n; j++) {
+	if (fast_json_add_object_end (json, v, chunk->names[j],
+				      strlen (chunk->names[j]),
+				      chunk->values[j]) != FAST_JSON_OK) {
 	  fast_json_value_free (json, v);
-	  return NULL;
-	}
-	if (*value != ',') {
+	  v = NULL;
 	  break;
 	}
-	value++;
-	if (fast_json_skip_whitespace2 (json, &value) != FAST_JSON_OK) {
-	  fast_json_value_free (json, v);
-	  return NULL;
-	}
-        if ((json->options & FAST_JSON_ALLOW_JSON5) && *value == '}') {
-          break;
-        }
+	(*json->my_free) (chunk->names[j]);
       }
-      if (*value != '}') {
-	fast_json_store_error2 (json, FAST_JSON_OBJECT_END_ERROR, value,
-				":,]}");
-	fast_json_value_free (json, v);
-	return NULL;
+      if (j) {
+	memmove (chunk->values, chunk->values + j,
+		 (chunk->n - j) * sizeof (chunk->values[0]));
+	memmove (chunk->names, chunk->names + j,
+		 (chunk->n - j) * sizeof (chunk->names[0]));
+	chunk->n -= j;
       }
-      value++;
     }
-    break;
-  default:
-    fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR, value, ":,]}");
-    return NULL;
   }
-  *buf = value;
+  if (v == NULL) {
+    fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+  }
+  fast_json_ndjson_free (json, &nd, workers, n_threads);
   return v;
 }
 
+/* Append len bytes to the window of a push stream. Data before the start
+ * of the next value is removed first.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_feed_add (FAST_JSON_TYPE json, const char *buf, size_t len)
+{
+  if (json->window.start) {
+    size_t n = json->window.len - json->window.start;
+
+    memmove (json->window.buffer, json->window.buffer + json->window.start, n);
+    json->window.scan -= json->window.start;
+    json->window.len = n;
+    json->window.start = 0;
+  }
+  if (json->window.max - json->window.len <= len) {
+    size_t new_max = json->window.max ? json->window.max :
+      FAST_JSON_BUFFER_SIZE;
+    char *new_buffer;
+
+    while (new_max - json->window.len <= len) {
+      new_max *= 2;
+    }
+    new_buffer = (char *) json->my_realloc (json->window.buffer, new_max);
+    if (new_buffer == NULL) {
+      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    json->window.max = new_max;
+    json->window.buffer = new_buffer;
+  }
+  memcpy (json->window.buffer + json->window.len, buf, len);
+  json->window.len += len;
+  return FAST_JSON_OK;
+}
+
+/* Parse the next value of a push stream if it is complete. At eof the rest
+ * of the data is parsed.
+ */
 static FAST_JSON_DATA_TYPE
-fast_json_parse_all2 (FAST_JSON_TYPE json, unsigned int next)
+fast_json_feed_value (FAST_JSON_TYPE json, unsigned int eof)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
-  const char *json_str = json->u_parse.json_str;
+  FAST_JSON_DATA_TYPE v;
+  unsigned int options = json->options;
+  size_t end;
+  char save;
 
-  if (next == 0) {
+  if (fast_json_window_scan (json, &end) == 0) {
+    if (eof == 0) {
+      json->error = FAST_JSON_NEED_MORE_DATA;
+      return NULL;
+    }
+    if (json->window.buffer == NULL) {
+      json->error = FAST_JSON_NO_DATA_ERROR;
+      return NULL;
+    }
+    end = json->window.len;
+  }
+  save = json->window.buffer[end];
+  json->window.buffer[end] = '\0';
+  json->error = FAST_JSON_OK;
+  json->u_parse.json_str = json->window.buffer + json->window.start;
+  json->json_end = json->window.buffer + end;
+  json->simd_block = NULL;
+  json->options |= FAST_JSON_NO_EOF_CHECK;
+  v = fast_json_parse_all2 (json, 1);
+  json->options = options;
+  json->window.buffer[end] = save;
+  if (v) {
+    json->window.start = json->u_parse.json_str - json->window.buffer;
+  }
+  json->window.scan = json->window.start;
+  json->window.depth = 0;
+  json->window.state = FAST_JSON_SCAN_VALUE;
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_feed (FAST_JSON_TYPE json, const char *buf, size_t len)
+{
+  if (json == NULL || (buf == NULL && len)) {
+    return NULL;
+  }
+  if (json->window.feed == 0) {
+    json->window.feed = 1;
+    json->window.active = 0;
+    json->window.array = 0;
+    json->window.start = 0;
+    json->window.len = 0;
+    json->window.scan = 0;
+    json->window.depth = 0;
+    json->window.state = FAST_JSON_SCAN_VALUE;
     json->error = FAST_JSON_OK;
     json->error_str[0] = '\0';
     json->line = 1;
     json->column = 0;
     json->position = 0;
   }
-  json->decimal_point = *localeconv ()->decimal_point;
-  if (fast_json_skip_whitespace2 (json, &json_str) == FAST_JSON_OK) {
-    if (*json_str != '\0') {
-      v = fast_json_parse_value2 (json, &json_str);
-      if (v) {
-	if ((json->options & FAST_JSON_NO_EOF_CHECK) == 0) {
-	  if (fast_json_skip_whitespace2 (json, &json_str) == FAST_JSON_OK) {
-	    if (*json_str != '\0') {
-	      fast_json_store_error2 (json, FAST_JSON_OBJECT_END_ERROR,
-				      json_str, ":,]}");
-	      fast_json_value_free (json, v);
-	      v = NULL;
-	    }
-	    else {
-	      json->u_parse.json_str = json_str;
-	    }
-	  }
-	  else {
-	    fast_json_value_free (json, v);
-	    v = NULL;
-	  }
-	}
-	else {
-	  const char *s = json->u_parse.json_str;
-
-	  while (s != json_str) {
-	    json->position++;
-	    json->column += fast_json_utf8_size[*s & 0xFFu] != 0;
-	    if (*s == '\n') {
-	      json->line++;
-	      json->column = 0;
-	    }
-	    s++;
-	  }
-	  json->u_parse.json_str = json_str;
-	}
-      }
+  else if (json->error != FAST_JSON_OK &&
+	   json->error != FAST_JSON_NEED_MORE_DATA) {
+    return NULL;
+  }
+  if (len && fast_json_feed_add (json, buf, len) != FAST_JSON_OK) {
+    return NULL;
+  }
+  return fast_json_feed_value (json, 0);
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_feed_end (FAST_JSON_TYPE json)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  if (json && json->window.feed) {
+    if (json->error == FAST_JSON_OK ||
+	json->error == FAST_JSON_NEED_MORE_DATA) {
+      v = fast_json_feed_value (json, 1);
     }
-    else {
-      json->error = FAST_JSON_NO_DATA_ERROR;
+    if (v == NULL) {
+      json->window.feed = 0;
     }
   }
+  else if (json) {
+    json->error = FAST_JSON_NO_DATA_ERROR;
+  }
   return v;
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_parse_string2 (FAST_JSON_TYPE json, const char *json_str)
+/* Move the start of the window of an array stream to cp. */
+static void
+fast_json_array_advance (FAST_JSON_TYPE json, const char *cp)
 {
-  if (json && json_str) {
-    json->u_parse.json_str = json_str;
-    return fast_json_parse_all2 (json, 0);
+  fast_json_count_position (json,
+			    json->window.buffer + json->window.start, cp);
+  json->window.start = cp - json->window.buffer;
+}
+
+/* Skip white space and comments at the start of the window of an array
+ * stream. More data is read while the window ends in white space or in a
+ * comment and the skip starts again, because the end of a comment can not
+ * be seen in the window. Returns the next character in c or '\0' at end of
+ * file.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_array_peek (FAST_JSON_TYPE json, int *c)
+{
+  FAST_JSON_ERROR_ENUM error;
+  const char *cp;
+  const char *end;
+
+  for (;;) {
+    size_t line = json->line;
+    size_t column = json->column;
+    size_t position = json->position;
+
+    end = json->window.buffer + json->window.len;
+    json->window.buffer[json->window.len] = '\0';
+    cp = json->window.buffer + json->window.start;
+    json->u_parse.json_str = cp;
+    json->json_end = end;
+    json->simd_block = NULL;
+    error = fast_json_skip_whitespace2 (json, &cp);
+    if (error == FAST_JSON_OK &&
+	(json->window.eof ||
+	 (cp != end && (end - cp >= 3 || (*cp & 0x80) == 0)))) {
+      fast_json_array_advance (json, cp);
+      json->u_parse.json_str = cp;
+      *c = *cp & 0xFFu;
+      return FAST_JSON_OK;
+    }
+    if (error != FAST_JSON_OK && json->window.eof) {
+      return error;
+    }
+    if (error != FAST_JSON_OK) {
+      /* A '/' at the end may start a comment */
+      json->error = FAST_JSON_OK;
+      json->error_str[0] = '\0';
+      json->line = line;
+      json->column = column;
+      json->position = position;
+    }
+    if (fast_json_window_fill (json) != FAST_JSON_OK) {
+      return FAST_JSON_MALLOC_ERROR;
+    }
   }
-  return NULL;
+}
+
+/* Read the element at the start of the window of an array stream until it
+ * is complete and parse it with the string parser.
+ */
+static FAST_JSON_DATA_TYPE
+fast_json_array_element (FAST_JSON_TYPE json)
+{
+  FAST_JSON_DATA_TYPE v;
+  const char *cp;
+  size_t end;
+  char save;
+
+  json->window.scan = json->window.start;
+  json->window.depth = 0;
+  json->window.state = FAST_JSON_SCAN_VALUE;
+  while (fast_json_window_scan (json, &end) == 0) {
+    if (json->window.eof) {
+      end = json->window.len;
+      break;
+    }
+    if (fast_json_window_fill (json) != FAST_JSON_OK) {
+      return NULL;
+    }
+  }
+  save = json->window.buffer[end];
+  json->window.buffer[end] = '\0';
+  cp = json->window.buffer + json->window.start;
+  json->u_parse.json_str = cp;
+  json->json_end = json->window.buffer + end;
+  json->simd_block = NULL;
+  v = fast_json_parse_value2 (json, &cp);
+  json->window.buffer[end] = save;
+  if (v) {
+    fast_json_array_advance (json, cp);
+  }
+  return v;
+}
+
+/* Start an array stream on the window source set by the caller. The data
+ * is read up to and including the '[' of the top level array.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_array_start (FAST_JSON_TYPE json)
+{
+  int c;
+
+  json->error = FAST_JSON_OK;
+  json->error_str[0] = '\0';
+  json->line = 1;
+  json->column = 0;
+  json->position = 0;
+  if (json->window.buffer == NULL) {
+    json->window.buffer =
+      (char *) (*json->my_malloc) (FAST_JSON_WINDOW_SIZE);
+    if (json->window.buffer == NULL) {
+      fast_json_store_error (json, FAST_JSON_MALLOC_ERROR, "");
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    json->window.max = FAST_JSON_WINDOW_SIZE;
+  }
+  json->window.active = 0;
+  json->window.feed = 0;
+  json->window.array = FAST_JSON_ARRAY_STATE_FIRST;
+  json->window.eof = 0;
+  json->window.start = 0;
+  json->window.len = 0;
+  json->window.scan = 0;
+  if (fast_json_array_peek (json, &c) == FAST_JSON_OK) {
+    if (c == '[') {
+      fast_json_array_advance (json, json->u_parse.json_str + 1);
+    }
+    else if (c == '\0') {
+      json->error = FAST_JSON_NO_DATA_ERROR;
+    }
+    else {
+      fast_json_store_error2 (json, FAST_JSON_VALUE_ERROR,
+			      json->u_parse.json_str, ":,]}");
+    }
+  }
+  return json->error;
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_array_stream_fd (FAST_JSON_TYPE json, int fd)
+{
+  if (json == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  json->window.block = NULL;
+  json->window.fp = NULL;
+  json->window.fd = fd;
+  return fast_json_array_start (json);
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_array_stream_file (FAST_JSON_TYPE json, FILE * fp)
+{
+  if (json == NULL || fp == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  json->window.block = NULL;
+  json->window.fp = fp;
+  return fast_json_array_start (json);
+}
+
+FAST_JSON_ERROR_ENUM
+fast_json_array_stream_block (FAST_JSON_TYPE json,
+			      fast_json_block_func block, void *user_data)
+{
+  if (json == NULL || block == NULL) {
+    return FAST_JSON_VALUE_ERROR;
+  }
+  json->window.block = block;
+  json->window.block_data = user_data;
+  json->window.fp = NULL;
+  return fast_json_array_start (json);
 }
 
 FAST_JSON_DATA_TYPE
-fast_json_parse_string2_next (FAST_JSON_TYPE json)
+fast_json_array_stream_next (FAST_JSON_TYPE json)
 {
-  if (json) {
-    return fast_json_parse_all2 (json, 1);
+  FAST_JSON_DATA_TYPE v;
+  int element = 1;
+  int c;
+
+  if (json == NULL) {
+    return NULL;
+  }
+  if (json->window.array == 0 ||
+      json->window.array == FAST_JSON_ARRAY_STATE_DONE) {
+    json->error = FAST_JSON_NO_DATA_ERROR;
+    return NULL;
+  }
+  if (json->error != FAST_JSON_OK ||
+      fast_json_array_peek (json, &c) != FAST_JSON_OK) {
+    return NULL;
+  }
+  if (json->window.array == FAST_JSON_ARRAY_STATE_NEXT) {
+    if (c == ',') {
+      fast_json_array_advance (json, json->u_parse.json_str + 1);
+      if (fast_json_array_peek (json, &c) != FAST_JSON_OK) {
+	return NULL;
+      }
+      element = c != ']' || (json->options & FAST_JSON_ALLOW_JSON5) == 0;
+    }
+    else if (c == ']') {
+      element = 0;
+    }
+    else {
+      fast_json_store_error2 (json, FAST_JSON_ARRAY_END_ERROR,
+			      json->u_parse.json_str, ":,]}");
+      return NULL;
+    }
+  }
+  else if (c == ']') {
+    element = 0;
+  }
+  if (element) {
+    v = fast_json_array_element (json);
+    if (v) {
+      json->window.array = FAST_JSON_ARRAY_STATE_NEXT;
+    }
+    return v;
   }
+  fast_json_array_advance (json, json->u_parse.json_str + 1);
+  json->window.array = FAST_JSON_ARRAY_STATE_DONE;
+  if ((json->options & FAST_JSON_NO_EOF_CHECK) == 0) {
+    if (fast_json_array_peek (json, &c) != FAST_JSON_OK) {
+      return NULL;
+    }
+    if (c != '\0') {
+      fast_json_store_error2 (json, FAST_JSON_OBJECT_END_ERROR,
+			      json->u_parse.json_str, ":,]}");
+      return NULL;
+    }
+  }
+  json->error = FAST_JSON_NO_DATA_ERROR;
   return NULL;
 }
-
-int
-fast_json_value_equal (FAST_JSON_DATA_TYPE value1, FAST_JSON_DATA_TYPE value2)
+
+/* Compare two values without their elements. Arrays and objects are equal
+ * here if they have the same number of elements.
+ */
+static int
+fast_json_value_equal_one (FAST_JSON_DATA_TYPE value1,
+			   FAST_JSON_DATA_TYPE value2)
 {
   if (value1 && value2 && value1->type == value2->type) {
     switch (value1->type) {
@@ -2705,18 +9740,8 @@ fast_json_value_equal (FAST_JSON_DATA_TYPE value1, FAST_JSON_DATA_TYPE value2)
 	FAST_JSON_OBJECT_TYPE *o1 = value1->u.object;
 	FAST_JSON_OBJECT_TYPE *o2 = value2->u.object;
 
-	if (o1 && o2 && o1->len == o2->len) {
-	  size_t i;
-
-	  for (i = 0; i < o1->len; i++) {
-	    if (fast_json_value_equal (o1->data[i].value,
-				       o2->data[i].value) == 0) {
-	      return 0;
-	    }
-	  }
-	}
-	else if ((o1 == NULL && o2) || (o1 && o2 == NULL) ||
-		 (o1 && o2 && o1->len != o2->len)) {
+	if ((o1 == NULL && o2) || (o1 && o2 == NULL) ||
+	    (o1 && o2 && o1->len != o2->len)) {
 	  return 0;
 	}
       }
@@ -2726,17 +9751,8 @@ fast_json_value_equal (FAST_JSON_DATA_TYPE value1, FAST_JSON_DATA_TYPE value2)
 	FAST_JSON_ARRAY_TYPE *a1 = value1->u.array;
 	FAST_JSON_ARRAY_TYPE *a2 = value2->u.array;
 
-	if (a1 && a2 && a1->len == a2->len) {
-	  size_t i;
-
-	  for (i = 0; i < a1->len; i++) {
-	    if (fast_json_value_equal (a1->values[i], a2->values[i]) == 0) {
-	      return 0;
-	    }
-	  }
-	}
-	else if ((a1 == NULL && a2) || (a1 && a2 == NULL) ||
-		 (a1 && a2 && a1->len != a2->len)) {
+	if ((a1 == NULL && a2) || (a1 && a2 == NULL) ||
+	    (a1 && a2 && a1->len != a2->len)) {
 	  return 0;
 	}
       }
@@ -2753,12 +9769,12 @@ fast_json_value_equal (FAST_JSON_DATA_TYPE value1, FAST_JSON_DATA_TYPE value2)
       break;
     case FAST_JSON_STRING:
       {
-	char *str1 = value1->is_str ? &value1->u.i_string_value[0]
-	  : value1->u.string_value;
-	char *str2 = value2->is_str ? &value2->u.i_string_value[0]
-	  : value2->u.string_value;
+	size_t len1;
+	size_t len2;
+	const char *str1 = fast_json_str (value1, &len1);
+	const char *str2 = fast_json_str (value2, &len2);
 
-	if (str1[0] != str2[0] || strcmp (&str1[1], &str2[1]) != 0) {
+	if (len1 != len2 || memcmp (str1, str2, len1) != 0) {
 	  return 0;
 	}
       }
@@ -2780,148 +9796,261 @@ fast_json_value_equal (FAST_JSON_DATA_TYPE value1, FAST_JSON_DATA_TYPE value2)
   return 1;
 }
 
-FAST_JSON_DATA_TYPE
-fast_json_value_copy (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value)
+int
+fast_json_value_equal (FAST_JSON_DATA_TYPE value1, FAST_JSON_DATA_TYPE value2)
 {
-  FAST_JSON_DATA_TYPE v = NULL;
-
-  if (json && value) {
-    FAST_JSON_DATA_TYPE nv;
+  /* There is no json object here, so a deeper stack than the local one is
+   * allocated with malloc.
+   */
+  FAST_JSON_WALK_TYPE local[FAST_JSON_STACK_SIZE];
+  FAST_JSON_WALK_TYPE *walk = local;
+  size_t max_walk = FAST_JSON_STACK_SIZE;
+  size_t depth = 0;
+  int retval = 1;
 
-    switch (value->type) {
-    case FAST_JSON_OBJECT:
-      {
-	FAST_JSON_OBJECT_TYPE *o = value->u.object;
+  for (;;) {
+    if (fast_json_value_equal_one (value1, value2) == 0) {
+      retval = 0;
+      break;
+    }
+    if (value1 && fast_json_container_len (value1)) {
+      if (UNLIKELY (depth == max_walk)) {
+	FAST_JSON_WALK_TYPE *new_walk;
 
-	v = fast_json_create_object (json);
-	if (v && o) {
-	  size_t i;
-
-	  for (i = 0; i < o->len; i++) {
-	    nv = fast_json_value_copy (json, o->data[i].value);
-	    if (nv) {
-	      if (fast_json_add_object_end (json, v, o->data[i].name, nv) !=
-		  FAST_JSON_OK) {
-		fast_json_value_free (json, v);
-		v = NULL;
-		break;
-	      }
-	    }
-	    else {
-	      fast_json_value_free (json, v);
-	      v = NULL;
-	      break;
-	    }
+	if (walk == local) {
+	  new_walk = (FAST_JSON_WALK_TYPE *)
+	    malloc (2 * max_walk * sizeof (FAST_JSON_WALK_TYPE));
+	  if (new_walk) {
+	    memcpy (new_walk, local, sizeof (local));
 	  }
 	}
-      }
-      break;
-    case FAST_JSON_ARRAY:
-      {
-	FAST_JSON_ARRAY_TYPE *a = value->u.array;
-
-	v = fast_json_create_array (json);
-	if (v && a) {
-	  size_t i;
-
-	  for (i = 0; i < a->len; i++) {
-	    nv = fast_json_value_copy (json, a->values[i]);
-	    if (nv) {
-	      if (fast_json_add_array_end (json, v, nv) != FAST_JSON_OK) {
-		fast_json_value_free (json, v);
-		v = NULL;
-		break;
-	      }
-	    }
-	    else {
-	      fast_json_value_free (json, v);
-	      v = NULL;
-	      break;
-	    }
-	  }
+	else {
+	  new_walk = (FAST_JSON_WALK_TYPE *)
+	    realloc (walk, 2 * max_walk * sizeof (FAST_JSON_WALK_TYPE));
+	}
+	if (new_walk == NULL) {
+	  retval = 0;
+	  break;
 	}
+	walk = new_walk;
+	max_walk *= 2;
       }
+      walk[depth].value = value1;
+      walk[depth].u.other = value2;
+      walk[depth].index = 0;
+      depth++;
+    }
+    value1 = NULL;
+    while (depth) {
+      FAST_JSON_WALK_TYPE *w = &walk[depth - 1];
+
+      if (w->index < fast_json_container_len (w->value)) {
+	value1 = fast_json_container_element (w->value, w->index);
+	value2 = fast_json_container_element (w->u.other, w->index);
+	w->index++;
+	break;
+      }
+      depth--;
+    }
+    if (value1 == NULL) {
       break;
-    case FAST_JSON_INTEGER:
-      v = fast_json_create_integer_value (json, value->u.int_value);
-      break;
-    case FAST_JSON_DOUBLE:
-      v = fast_json_create_double_value (json, value->u.double_value);
+    }
+  }
+  if (walk != local) {
+    free (walk);
+  }
+  return retval;
+}
+
+/* Copy a value without its elements. Arrays and objects are copied empty. */
+static FAST_JSON_DATA_TYPE
+fast_json_value_copy_one (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value)
+{
+  FAST_JSON_DATA_TYPE v = NULL;
+
+  switch (value->type) {
+  case FAST_JSON_OBJECT:
+    v = fast_json_create_object (json);
+    break;
+  case FAST_JSON_ARRAY:
+    v = fast_json_create_array (json);
+    break;
+  case FAST_JSON_INTEGER:
+    v = fast_json_create_integer_value (json, value->u.int_value);
+    break;
+  case FAST_JSON_DOUBLE:
+    v = fast_json_create_double_value (json, value->u.double_value);
+    break;
+  case FAST_JSON_STRING:
+    if (value->is_str == FAST_JSON_STR_INLINE) {
+      v = fast_json_create_string (json, fast_json_inline (value));
+    }
+    else {
+      v = fast_json_create_string (json, value->u.string_value);
+    }
+    break;
+  case FAST_JSON_BOOLEAN:
+    v = fast_json_create_boolean_value (json, value->u.boolean_value);
+    break;
+  case FAST_JSON_NULL:
+    v = fast_json_create_null (json);
+    break;
+  }
+  return v;
+}
+
+FAST_JSON_DATA_TYPE
+fast_json_value_copy (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value)
+{
+  FAST_JSON_DATA_TYPE root = NULL;
+  size_t depth = 0;
+
+  if (json == NULL || value == NULL) {
+    return NULL;
+  }
+  /* Open arrays and objects and their copies are kept on the walk stack */
+  for (;;) {
+    FAST_JSON_DATA_TYPE v = fast_json_value_copy_one (json, value);
+
+    if (v == NULL) {
       break;
-    case FAST_JSON_STRING:
-      if (value->is_str) {
-	v = fast_json_create_string (json, &value->u.i_string_value[0]);
+    }
+    if (depth == 0) {
+      root = v;
+    }
+    else {
+      FAST_JSON_WALK_TYPE *w = &json->walk[depth - 1];
+      FAST_JSON_ERROR_ENUM error;
+
+      if (w->value->type == FAST_JSON_ARRAY) {
+	error = fast_json_add_array_end (json, w->u.other, v);
       }
       else {
-	v = fast_json_create_string (json, value->u.string_value);
+	FAST_JSON_NAME_VALUE_TYPE *m = &w->value->u.object->data[w->index - 1];
+
+	error = fast_json_add_object_end (json, w->u.other,
+					  fast_json_name (m), m->len, v);
       }
-      break;
-    case FAST_JSON_BOOLEAN:
-      v = fast_json_create_boolean_value (json, value->u.boolean_value);
-      break;
-    case FAST_JSON_NULL:
-      v = fast_json_create_null (json);
-      break;
+      if (error != FAST_JSON_OK) {
+	fast_json_value_free (json, v);
+	break;
+      }
+    }
+    if (fast_json_container_len (value)) {
+      if (fast_json_walk_check (json, depth) != FAST_JSON_OK) {
+	break;
+      }
+      json->walk[depth].value = value;
+      json->walk[depth].u.other = v;
+      json->walk[depth].index = 0;
+      depth++;
+    }
+    value = NULL;
+    while (depth) {
+      FAST_JSON_WALK_TYPE *w = &json->walk[depth - 1];
+
+      if (w->index < fast_json_container_len (w->value)) {
+	value = fast_json_container_element (w->value, w->index);
+	w->index++;
+	break;
+      }
+      depth--;
+    }
+    if (value == NULL) {
+      return root;
     }
   }
-  return v;
+  fast_json_value_free (json, root);
+  return NULL;
 }
 
-void
-fast_json_value_free (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value)
+/* Free value if it is not an array or object with elements. Such an array
+ * or object is put on the pending list instead. The list is linked through
+ * the first element, so the first element is taken off and handled next.
+ * Nested values are freed this way without recursion and without a stack.
+ */
+static void
+fast_json_value_free_push (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value,
+			   FAST_JSON_DATA_TYPE * pending)
 {
-  if (json && value) {
+  while (value && value->alloc != FAST_JSON_ALLOC_ARENA) {
+    FAST_JSON_DATA_TYPE *first = NULL;
+    FAST_JSON_DATA_TYPE next;
+
     switch (value->type) {
     case FAST_JSON_OBJECT:
-      {
-	FAST_JSON_OBJECT_TYPE *o = value->u.object;
-
-	if (LIKELY (o != NULL)) {
-	  size_t i;
-
-	  for (i = 0; i < o->len; i++) {
-	    (*json->my_free) (o->data[i].name);
-	    fast_json_value_free (json, o->data[i].value);
-	  }
-	  (*json->my_free) (o);
-	}
-	fast_json_data_free (json, value);
+      if (value->u.object && value->u.object->len) {
+	first = &value->u.object->data[0].value;
+      }
+      else {
+	(*json->my_free) (value->u.object);
       }
       break;
     case FAST_JSON_ARRAY:
-      {
-	FAST_JSON_ARRAY_TYPE *a = value->u.array;
-
-	if (LIKELY (a != NULL)) {
-	  size_t i;
-
-	  for (i = 0; i < a->len; i++) {
-	    fast_json_value_free (json, a->values[i]);
-	  }
-	}
-	(*json->my_free) (a);
-	fast_json_data_free (json, value);
+      if (value->u.array && value->u.array->len) {
+	first = &value->u.array->values[0];
+      }
+      else {
+	(*json->my_free) (value->u.array);
       }
-      break;
-    case FAST_JSON_INTEGER:
-      fast_json_data_free (json, value);
-      break;
-    case FAST_JSON_DOUBLE:
-      fast_json_data_free (json, value);
       break;
     case FAST_JSON_STRING:
-      if (value->is_str == 0) {
+      if (value->is_str == FAST_JSON_STR_MALLOC) {
 	(*json->my_free) (value->u.string_value);
       }
-      fast_json_data_free (json, value);
       break;
-    case FAST_JSON_BOOLEAN:
-      fast_json_data_free (json, value);
+    default:
       break;
-    case FAST_JSON_NULL:
+    }
+    if (first == NULL) {
       fast_json_data_free (json, value);
-      break;
+      return;
+    }
+    next = *first;
+    *first = *pending;
+    *pending = value;
+    value = next;
+  }
+}
+
+void
+fast_json_value_free (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value)
+{
+  FAST_JSON_DATA_TYPE pending = NULL;
+
+  if (json == NULL) {
+    return;
+  }
+  fast_json_value_free_push (json, value, &pending);
+  while (pending) {
+    FAST_JSON_DATA_TYPE container = pending;
+    size_t i;
+
+    if (container->type == FAST_JSON_OBJECT) {
+      FAST_JSON_OBJECT_TYPE *o = container->u.object;
+
+      pending = o->data[0].value;
+      for (i = 0; i < o->len; i++) {
+	if (container->is_str != FAST_JSON_STR_INSITU &&
+	    o->data[i].len >= FAST_JSON_NAME_INLINE) {
+	  (*json->my_free) (o->data[i].u.name);
+	}
+	if (i) {
+	  fast_json_value_free_push (json, o->data[i].value, &pending);
+	}
+      }
+      (*json->my_free) (o);
+    }
+    else {
+      FAST_JSON_ARRAY_TYPE *a = container->u.array;
+
+      pending = a->values[0];
+      for (i = 1; i < a->len; i++) {
+	fast_json_value_free_push (json, a->values[i], &pending);
+      }
+      (*json->my_free) (a);
     }
+    fast_json_data_free (json, container);
   }
 }
 
@@ -3031,15 +10160,19 @@ fast_json_last_puts (FAST_JSON_TYPE json, const char *str, unsigned int len)
 }
 
 static int
-fast_json_print_string_value (FAST_JSON_TYPE json, const char *s)
+fast_json_print_string_value (FAST_JSON_TYPE json, const char *s,
+			      size_t len)
 {
   if (fast_json_puts (json, "\"", 1)) {
     return -1;
   }
   if (s) {
     const char *last = NULL;
+    const char *e = s + len;
+    unsigned int escape =
+      (json->options & FAST_JSON_PRINT_UNICODE_ESCAPE) != 0;
 
-    while (*s) {
+    while (s != e) {
       static const char special[256] = {
 	1, 1, 1, 1, 1, 1, 1, 1, 'b', 't', 'n', 1, 'f', 'r', 1, 1,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -3059,7 +10192,10 @@ fast_json_print_string_value (FAST_JSON_TYPE json, const char *s)
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
       };
 
-      if (UNLIKELY (special[*s & 0xFFu])) {
+      /* Strings are valid utf8, so utf8 is only special for unicode
+       * escapes.
+       */
+      if (UNLIKELY (special[*s & 0xFFu]) && ((*s & 0x80u) == 0 || escape)) {
 	static const char hex[16] = {
 	  '0', '1', '2', '3', '4', '5', '6', '7',
 	  '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
@@ -3074,105 +10210,68 @@ fast_json_print_string_value (FAST_JSON_TYPE json, const char *s)
 	  last = NULL;
 	}
 	if ((*s & 0x80u) != 0) {
+	  unsigned char u = (unsigned char) *s;
+	  unsigned int uc;
+
 	  size = 0;
-	  if (json->options & FAST_JSON_PRINT_UNICODE_ESCAPE) {
-	    unsigned char u = (unsigned char) *s;
-	    unsigned int uc;
-
-	    switch (fast_json_utf8_size[u]) {
-	    case 0:		/* FALLTHRU */
-	    case 1:
-	      /* Should never happen */
-	      break;
-	    case 2:
-	      if (s[1]) {
-		uc = ((s[0] & 0x1Fu) << 6) | (s[1] & 0x3Fu);
-		v[0] = '\\';
-		v[1] = 'u';
-		v[2] = hex[(uc >> 12) & 0xFu];
-		v[3] = hex[(uc >> 8) & 0xFu];
-		v[4] = hex[(uc >> 4) & 0xFu];
-		v[5] = hex[(uc >> 0) & 0xFu];
-		size = 6;
-		s += 2;
-	      }
-	      break;
-	    case 3:
-	      if (s[1] && s[2]) {
-		uc =
-		  ((s[0] & 0x0Fu) << 12) | ((s[1] & 0x3Fu) << 6) | (s[2] &
-								    0x3Fu);
-		v[0] = '\\';
-		v[1] = 'u';
-		v[2] = hex[(uc >> 12) & 0xFu];
-		v[3] = hex[(uc >> 8) & 0xFu];
-		v[4] = hex[(uc >> 4) & 0xFu];
-		v[5] = hex[(uc >> 0) & 0xFu];
-		size = 6;
-		s += 3;
-	      }
-	      break;
-	    case 4:
-	      if (s[1] && s[2] && s[3]) {
-		unsigned int n;
-
-		uc = ((s[0] & 0x7u) << 18) | ((s[1] & 0x3Fu) << 12) |
-		  ((s[2] & 0x3Fu) << 6) | (s[3] & 0x3Fu);
-		uc -= 0x10000u;
-		n = ((uc >> 10) & 0x3FFu) + 0xD800u;
-		v[0] = '\\';
-		v[1] = 'u';
-		v[2] = hex[(n >> 12) & 0xFu];
-		v[3] = hex[(n >> 8) & 0xFu];
-		v[4] = hex[(n >> 4) & 0xFu];
-		v[5] = hex[(n >> 0) & 0xFu];
-		n = (uc & 0x3FFu) + 0xDC00u;
-		v[6] = '\\';
-		v[7] = 'u';
-		v[8] = hex[(n >> 12) & 0xFu];
-		v[9] = hex[(n >> 8) & 0xFu];
-		v[10] = hex[(n >> 4) & 0xFu];
-		v[11] = hex[(n >> 0) & 0xFu];
-		size = 12;
-		s += 4;
-	      }
-	      break;
+	  switch (fast_json_utf8_size[u]) {
+	  case 0:		/* FALLTHRU */
+	  case 1:
+	    /* Should never happen */
+	    break;
+	  case 2:
+	    if (s[1]) {
+	      uc = ((s[0] & 0x1Fu) << 6) | (s[1] & 0x3Fu);
+	      v[0] = '\\';
+	      v[1] = 'u';
+	      v[2] = hex[(uc >> 12) & 0xFu];
+	      v[3] = hex[(uc >> 8) & 0xFu];
+	      v[4] = hex[(uc >> 4) & 0xFu];
+	      v[5] = hex[(uc >> 0) & 0xFu];
+	      size = 6;
+	      s += 2;
 	    }
-	  }
-	  else {
-	    switch (fast_json_utf8_size[*s & 0xFFu]) {
-	    case 0:		/* FALLTHRU */
-	    case 1:
-	      /* Should never happen */
-	      break;
-	    case 2:
-	      if (s[1]) {
-		v[0] = s[0];
-		v[1] = s[1];
-		size = 2;
-		s += 2;
-	      }
-	      break;
-	    case 3:
-	      if (s[1] && s[2]) {
-		v[0] = s[0];
-		v[1] = s[1];
-		v[2] = s[2];
-		size = 3;
-		s += 3;
-	      }
-	      break;
-	    case 4:
-	      if (s[1] && s[2] && s[3]) {
-		v[0] = s[0];
-		v[1] = s[1];
-		v[2] = s[2];
-		v[3] = s[3];
-		size = 4;
-		s += 4;
-	      }
-	      break;
+	    break;
+	  case 3:
+	    if (s[1] && s[2]) {
+	      uc =
+		((s[0] & 0x0Fu) << 12) | ((s[1] & 0x3Fu) << 6) | (s[2] &
+								  0x3Fu);
+	      v[0] = '\\';
+	      v[1] = 'u';
+	      v[2] = hex[(uc >> 12) & 0xFu];
+	      v[3] = hex[(uc >> 8) & 0xFu];
+	      v[4] = hex[(uc >> 4) & 0xFu];
+	      v[5] = hex[(uc >> 0) & 0xFu];
+	      size = 6;
+	      s += 3;
 	    }
+	    break;
+	  case 4:
+	    if (s[1] && s[2] && s[3]) {
+	      unsigned int n;
+
+	      uc = ((s[0] & 0x7u) << 18) | ((s[1] & 0x3Fu) << 12) |
+		((s[2] & 0x3Fu) << 6) | (s[3] & 0x3Fu);
+	      uc -= 0x10000u;
+	      n = ((uc >> 10) & 0x3FFu) + 0xD800u;
+	      v[0] = '\\';
+	      v[1] = 'u';
+	      v[2] = hex[(n >> 12) & 0xFu];
+	      v[3] = hex[(n >> 8) & 0xFu];
+	      v[4] = hex[(n >> 4) & 0xFu];
+	      v[5] = hex[(n >> 0) & 0xFu];
+	      n = (uc & 0x3FFu) + 0xDC00u;
+	      v[6] = '\\';
+	      v[7] = 'u';
+	      v[8] = hex[(n >> 12) & 0xFu];
+	      v[9] = hex[(n >> 8) & 0xFu];
+	      v[10] = hex[(n >> 4) & 0xFu];
+	      v[11] = hex[(n >> 0) & 0xFu];
+	      size = 12;
+	      s += 4;
+	    }
+	    break;
 	  }
 	  if (size == 0) {
 	    /* Should never happen */
@@ -3204,6 +10303,12 @@ fast_json_print_string_value (FAST_JSON_TYPE json, const char *s)
 	if (last == NULL) {
 	  last = s;
 	}
+#if FAST_JSON_SIMD
+	if (e - s >= 16) {
+	  s += fast_json_print_plain_sse2 (s, e, escape);
+	  continue;
+	}
+#endif
 	s++;
       }
     }
@@ -3249,158 +10354,160 @@ fast_json_compare_object (const void *a, const void *b)
   const FAST_JSON_NAME_VALUE_TYPE *na = (const FAST_JSON_NAME_VALUE_TYPE *) a;
   const FAST_JSON_NAME_VALUE_TYPE *nb = (const FAST_JSON_NAME_VALUE_TYPE *) b;
 
-  return strcmp (na->name, nb->name);
+  return strcmp (fast_json_name (na), fast_json_name (nb));
 }
 
+/* Print an array or object open bracket or a value that is not an array or
+ * object.
+ */
 static int
-fast_json_print_buffer (FAST_JSON_TYPE json,
-			FAST_JSON_DATA_TYPE value, unsigned int n,
-			unsigned int nice)
+fast_json_print_one (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value,
+		     unsigned int nice)
 {
-  if (value) {
-    switch (value->type) {
-    case FAST_JSON_OBJECT:
-      {
-	FAST_JSON_OBJECT_TYPE *o;
+  switch (value->type) {
+  case FAST_JSON_OBJECT:
+    return fast_json_puts (json, "{\n", nice ? 2 : 1);
+  case FAST_JSON_ARRAY:
+    return fast_json_puts (json, "[\n", nice ? 2 : 1);
+  case FAST_JSON_INTEGER:
+    {
+      char v[FAST_JSON_INT_SIZE];
 
-	n++;
-	if (fast_json_puts (json, "{\n", nice ? 2 : 1)) {
-	  return -1;
-	}
-	o = value->u.object;
-	if (LIKELY (o != NULL)) {
-	  size_t i;
-	  FAST_JSON_NAME_VALUE_TYPE *p = NULL;
-	  FAST_JSON_NAME_VALUE_TYPE *d = o->data;
-
-	  if (json->options & FAST_JSON_SORT_OBJECTS) {
-	    size_t s = o->len * sizeof (FAST_JSON_NAME_VALUE_TYPE);
-
-	    p = (FAST_JSON_NAME_VALUE_TYPE *) json->my_malloc (s);
-	    if (p) {
-	      memcpy (p, o->data, s);
-	      SSORT (p, o->len, sizeof (FAST_JSON_NAME_VALUE_TYPE),
-		     fast_json_compare_object);
-	      d = p;
-	    }
-	  }
+      if (LIKELY (json->puts_len + FAST_JSON_INT_SIZE <=
+		  sizeof (json->puts_buf))) {
+	json->puts_len += fast_json_itoa (value->u.int_value,
+					  json->puts_buf + json->puts_len);
+	return 0;
+      }
+      return fast_json_puts (json, v,
+			     fast_json_itoa (value->u.int_value, v));
+    }
+  case FAST_JSON_DOUBLE:
+    {
+      char v[100];
+      unsigned int len;
 
-	  for (i = 0; i < o->len; i++) {
-	    if ((nice && fast_json_print_spaces (json, n)) ||
-		fast_json_print_string_value (json, d[i].name) ||
-		fast_json_puts (json, ": ", nice ? 2 : 1) ||
-		fast_json_print_buffer (json, d[i].value, n, nice) ||
-		((i + 1) < o->len &&
-		 fast_json_puts (json, ",\n", nice ? 2 : 1))) {
-	      return -1;
-	    }
-	  }
-	  if (p) {
-	    json->my_free (p);
-	  }
-	}
-	n--;
-	if ((nice && (fast_json_puts (json, "\n", 1) ||
-		      fast_json_print_spaces (json, n))) ||
-	    fast_json_puts (json, "}", 1)) {
-	  return -1;
-	}
+      len = fast_json_dtoa (value->u.double_value, v);
+      if (v[len - 1] == 'f' && (json->options & FAST_JSON_ALLOW_JSON5)) {
+	strcpy (&v[len], "inity");
+	len += 5;
       }
-      break;
-    case FAST_JSON_ARRAY:
-      {
-	FAST_JSON_ARRAY_TYPE *a;
+      return fast_json_puts (json, v, len);
+    }
+  case FAST_JSON_STRING:
+    {
+      size_t len;
+      const char *str = fast_json_str (value, &len);
 
-	n++;
-	if (fast_json_puts (json, "[\n", nice ? 2 : 1)) {
-	  return -1;
-	}
-	a = value->u.array;
-	if (LIKELY (a != NULL)) {
-	  size_t i;
+      return fast_json_print_string_value (json, str, len);
+    }
+  case FAST_JSON_BOOLEAN:
+    if (value->u.boolean_value) {
+      return fast_json_puts (json, "true", strlen ("true"));
+    }
+    else {
+      return fast_json_puts (json, "false", strlen ("false"));
+    }
+  case FAST_JSON_NULL:
+    return fast_json_puts (json, "null", strlen ("null"));
+  }
+  return 0;
+}
 
-	  for (i = 0; i < a->len; i++) {
-	    if ((nice && fast_json_print_spaces (json, n)) ||
-		fast_json_print_buffer (json, a->values[i], n, nice) ||
-		((i + 1) < a->len &&
-		 fast_json_puts (json, ",\n", nice ? 2 : 1))) {
-	      return -1;
-	    }
-	  }
-	}
-	n--;
-	if ((nice && (fast_json_puts (json, "\n", 1) ||
-		      fast_json_print_spaces (json, n))) ||
-	    fast_json_puts (json, "]", 1)) {
-	  return -1;
-	}
-      }
+/* Print value. Open arrays and objects are kept on the walk stack. */
+static int
+fast_json_print_buffer (FAST_JSON_TYPE json,
+			FAST_JSON_DATA_TYPE value, unsigned int nice)
+{
+  size_t depth = 0;
+  int retval = 0;
+
+  if (value == NULL) {
+    return 0;
+  }
+  for (;;) {
+    if (fast_json_print_one (json, value, nice)) {
+      retval = -1;
       break;
-    case FAST_JSON_INTEGER:
-      {
-	char v[100];
-	unsigned int len;
+    }
+    if (value->type == FAST_JSON_OBJECT || value->type == FAST_JSON_ARRAY) {
+      if (fast_json_walk_check (json, depth) != FAST_JSON_OK) {
+	retval = -1;
+	break;
+      }
+      json->walk[depth].value = value;
+      json->walk[depth].u.sorted = NULL;
+      json->walk[depth].index = 0;
+      if (value->type == FAST_JSON_OBJECT &&
+	  (json->options & FAST_JSON_SORT_OBJECTS) &&
+	  fast_json_container_len (value)) {
+	FAST_JSON_OBJECT_TYPE *o = value->u.object;
+	size_t size = o->len * sizeof (FAST_JSON_NAME_VALUE_TYPE);
+	FAST_JSON_NAME_VALUE_TYPE *p;
 
-#if USE_FAST_CONVERT
-	len = fast_sint64 (value->u.int_value, v);
-#else
-	len =
-	  snprintf (v, sizeof (v), "%" FAST_JSON_FMT_INT, value->u.int_value);
-#endif
-	return fast_json_puts (json, v, len);
+	p = (FAST_JSON_NAME_VALUE_TYPE *) json->my_malloc (size);
+	if (p) {
+	  memcpy (p, o->data, size);
+	  SSORT (p, o->len, sizeof (FAST_JSON_NAME_VALUE_TYPE),
+		 fast_json_compare_object);
+	  json->walk[depth].u.sorted = p;
+	}
       }
-    case FAST_JSON_DOUBLE:
-      {
-	char *cp;
-	char v[100];
-	unsigned int len;
+      depth++;
+    }
+    value = NULL;
+    while (depth) {
+      FAST_JSON_WALK_TYPE *w = &json->walk[depth - 1];
+      size_t len = fast_json_container_len (w->value);
 
-#if USE_FAST_CONVERT
-	len = fast_dtoa (value->u.double_value, PREC_DBL_NR, v);
-#else
-	len = snprintf (v, sizeof (v), "%.17g", value->u.double_value);
-#endif
-	cp = v;
-	if (*cp == '-' || *cp == '+') {
-	  cp++;
+      if (w->index < len) {
+	if ((w->index && fast_json_puts (json, ",\n", nice ? 2 : 1)) ||
+	    (nice && fast_json_print_spaces (json, (unsigned int) depth))) {
+	  retval = -1;
+	  break;
 	}
-	if (*cp == 'i' && cp[1] == 'n' && cp[2] == 'f' && cp[3] == 0 &&
-	    (json->options & FAST_JSON_ALLOW_JSON5)) {
-          strcpy(&cp[3], "inity");
-	  len += 5;
-        }
-        else {
-	  while (fast_json_isdigit (*cp)) {
-	    cp++;
-	  }
-	  if (*cp == json->decimal_point) {
-	    *cp = '.';
-	  }
-	  else if (*cp == '\0') {
-	    *cp++ = '.';
-	    *cp = '0';
-	    len += 2;
+	if (w->value->type == FAST_JSON_OBJECT) {
+	  FAST_JSON_NAME_VALUE_TYPE *d = w->u.sorted ? w->u.sorted :
+	    w->value->u.object->data;
+
+	  d += w->index;
+	  if (fast_json_print_string_value (json, fast_json_name (d),
+					    d->len) ||
+	      fast_json_puts (json, ": ", nice ? 2 : 1)) {
+	    retval = -1;
+	    break;
 	  }
-        }
-	return fast_json_puts (json, v, len);
+	  value = d->value;
+	}
+	else {
+	  value = w->value->u.array->values[w->index];
+	}
+	w->index++;
+	break;
       }
-    case FAST_JSON_STRING:
-      return fast_json_print_string_value (json,
-					   value->is_str
-					   ? &value->u.i_string_value[0]
-					   : value->u.string_value);
-    case FAST_JSON_BOOLEAN:
-      if (value->u.boolean_value) {
-	return fast_json_puts (json, "true", strlen ("true"));
+      if (w->value->type == FAST_JSON_OBJECT && w->u.sorted) {
+	json->my_free (w->u.sorted);
       }
-      else {
-	return fast_json_puts (json, "false", strlen ("false"));
+      depth--;
+      if ((nice && (fast_json_puts (json, "\n", 1) ||
+		    fast_json_print_spaces (json, (unsigned int) depth))) ||
+	  fast_json_puts (json,
+			  w->value->type == FAST_JSON_OBJECT ? "}" : "]", 1)) {
+	retval = -1;
+	break;
       }
-    case FAST_JSON_NULL:
-      return fast_json_puts (json, "null", strlen ("null"));
+    }
+    if (retval || value == NULL) {
+      break;
     }
   }
-  return 0;
+  while (depth--) {
+    if (json->walk[depth].value->type == FAST_JSON_OBJECT &&
+	json->walk[depth].u.sorted) {
+      json->my_free (json->walk[depth].u.sorted);
+    }
+  }
+  return retval;
 }
 
 char *
@@ -3414,8 +10521,7 @@ fast_json_print_string (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value,
     json->u_print.buf.len = 0;
     json->u_print.buf.max = 0;
     json->u_print.buf.txt = NULL;
-    json->decimal_point = *localeconv ()->decimal_point;
-    if (fast_json_print_buffer (json, value, 0, nice)) {
+    if (fast_json_print_buffer (json, value, nice)) {
       (*json->my_free) (json->u_print.buf.txt);
       return NULL;
     }
@@ -3439,8 +10545,7 @@ fast_json_print_string_len (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value,
     json->u_print.buf.len = 0;
     json->u_print.buf.max = len;
     json->u_print.buf.txt = str;
-    json->decimal_point = *localeconv ()->decimal_point;
-    if (fast_json_print_buffer (json, value, 0, nice)) {
+    if (fast_json_print_buffer (json, value, nice)) {
       return -1;
     }
     if (fast_json_last_puts (json, nice ? "\n" : "", nice ? 2 : 1)) {
@@ -3460,8 +10565,7 @@ fast_json_print_file (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value,
     json->puts_data = (void *) json;
     json->puts_len = 0;
     json->u_print.fp = fp;
-    json->decimal_point = *localeconv ()->decimal_point;
-    if (fast_json_print_buffer (json, value, 0, nice)) {
+    if (fast_json_print_buffer (json, value, nice)) {
       return -1;
     }
     if (fast_json_last_puts (json, "\n", nice ? 1 : 0)) {
@@ -3486,8 +10590,7 @@ fast_json_print_file_name (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value,
       json->puts_data = (void *) json;
       json->puts_len = 0;
       json->u_print.fp = fp;
-      json->decimal_point = *localeconv ()->decimal_point;
-      retval = fast_json_print_buffer (json, value, 0, nice);
+      retval = fast_json_print_buffer (json, value, nice);
       if (retval == 0) {
 	retval = fast_json_last_puts (json, "\n", nice ? 1 : 0);
       }
@@ -3506,8 +10609,7 @@ fast_json_print_fd (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value,
     json->puts_data = (void *) json;
     json->puts_len = 0;
     json->u_print.fd = fd;
-    json->decimal_point = *localeconv ()->decimal_point;
-    if (fast_json_print_buffer (json, value, 0, nice)) {
+    if (fast_json_print_buffer (json, value, nice)) {
       return -1;
     }
     if (fast_json_last_puts (json, "\n", nice ? 1 : 0)) {
@@ -3527,7 +10629,7 @@ fast_json_print_user (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE value,
     json->puts = puts;
     json->puts_data = user_data;
     json->puts_len = 0;
-    if (fast_json_print_buffer (json, value, 0, nice)) {
+    if (fast_json_print_buffer (json, value, nice)) {
       return -1;
     }
     if (fast_json_last_puts (json, "\n", nice ? 1 : 0)) {
@@ -3650,47 +10752,15 @@ fast_json_create_string (FAST_JSON_TYPE json, const char *value)
   FAST_JSON_DATA_TYPE item = NULL;
 
   if (json && value) {
-    int len = 0;
-    char str[8];
-    char *new_value = &str[0];
-    const char *cp;
-
-    cp = value;
-    while (*cp) {
-      len += (*cp == '"') + 1;
-      if (*cp++ == '\\') {
-        len += *cp == 'x' ? 2 : (*cp == '0' ? 4 : 0);
-	cp++;
-      }
-    }
-    if (len >= sizeof (str)) {
-      new_value = fast_json_strdup (json, value);
-    }
-    else {
-      memcpy (str, value, len + 1);
-    }
-    if (new_value) {
-      if (fast_json_check_string (json, value, value + len, new_value, '"') ==
-	  FAST_JSON_OK) {
-	item = fast_json_data_create (json);
-	if (item) {
-	  item->type = FAST_JSON_STRING;
-	  item->used = 0;
-	  if (len >= sizeof (str)) {
-	    item->is_str = 0;
-	    item->u.string_value = new_value;
-	  }
-	  else {
-	    item->is_str = 1;
-	    memcpy (item->u.i_string_value, new_value, len + 1);
-	  }
-	}
-	else if (new_value != &str[0]) {
-	  (*json->my_free) (new_value);
-	}
+    const char *cp = value;
+
+    if (fast_json_check_string (json, &cp, value + strlen (value), '"') ==
+	FAST_JSON_OK) {
+      if (*cp) {
+	fast_json_store_error (json, FAST_JSON_ESCAPE_CHARACTER_ERROR, cp);
       }
-      else if (new_value != &str[0]) {
-	(*json->my_free) (new_value);
+      else {
+	item = fast_json_string_value (json);
       }
     }
   }
@@ -3721,6 +10791,7 @@ fast_json_create_object (FAST_JSON_TYPE json)
 
     if (item) {
       item->type = FAST_JSON_OBJECT;
+      item->is_str = FAST_JSON_STR_MALLOC;
       item->used = 0;
       item->u.object = NULL;
     }
@@ -3848,47 +10919,43 @@ fast_json_create_string_array (FAST_JSON_TYPE json, const char **strings,
   return NULL;
 }
 
+/* Return 1 if data is value or one of the values in it. Open arrays and
+ * objects are kept on the walk stack. Without memory for the stack 1 is
+ * returned, so the value is not added.
+ */
 static unsigned int
-fast_json_check_loop (FAST_JSON_DATA_TYPE data, FAST_JSON_DATA_TYPE value)
+fast_json_check_loop (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE data,
+		      FAST_JSON_DATA_TYPE value)
 {
-  if (data == value) {
-    return 1;
-  }
-  if (value->type == FAST_JSON_ARRAY) {
-    FAST_JSON_ARRAY_TYPE *a = value->u.array;
-
-    if (LIKELY (a != NULL)) {
-      size_t i;
+  size_t depth = 0;
 
-      for (i = 0; i < a->len; i++) {
-	FAST_JSON_DATA_TYPE v = a->values[i];
-
-	if (data == v ||
-	    ((v->type == FAST_JSON_ARRAY || v->type == FAST_JSON_OBJECT) &&
-	     fast_json_check_loop (data, v))) {
-	  return 1;
-	}
+  for (;;) {
+    if (data == value) {
+      return 1;
+    }
+    if (fast_json_container_len (value)) {
+      if (fast_json_walk_check (json, depth) != FAST_JSON_OK) {
+	return 1;
       }
+      json->walk[depth].value = value;
+      json->walk[depth].index = 0;
+      depth++;
     }
-  }
-  else if (value->type == FAST_JSON_OBJECT) {
-    FAST_JSON_OBJECT_TYPE *o = value->u.object;
-
-    if (LIKELY (o != NULL)) {
-      size_t i;
+    value = NULL;
+    while (depth) {
+      FAST_JSON_WALK_TYPE *w = &json->walk[depth - 1];
 
-      for (i = 0; i < o->len; i++) {
-	FAST_JSON_DATA_TYPE v = o->data[i].value;
-
-	if (data == v ||
-	    ((v->type == FAST_JSON_ARRAY || v->type == FAST_JSON_OBJECT) &&
-	     fast_json_check_loop (data, v))) {
-	  return 1;
-	}
+      if (w->index < fast_json_container_len (w->value)) {
+	value = fast_json_container_element (w->value, w->index);
+	w->index++;
+	break;
       }
+      depth--;
+    }
+    if (value == NULL) {
+      return 0;
     }
   }
-  return 0;
 }
 
 static FAST_JSON_ERROR_ENUM
@@ -3902,7 +10969,8 @@ fast_json_add_array_end (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE array,
     size_t size = sizeof (FAST_JSON_ARRAY_TYPE) +
       (FAST_JSON_INITIAL_SIZE - 1) * sizeof (FAST_JSON_DATA_TYPE);
 
-    a = array->u.array = (FAST_JSON_ARRAY_TYPE *) (*json->my_malloc) (size);
+    a = array->u.array =
+      (FAST_JSON_ARRAY_TYPE *) fast_json_data_alloc (json, array, size);
     if (LIKELY (a != NULL)) {
       a->len = 0;
       a->max = FAST_JSON_INITIAL_SIZE;
@@ -3914,7 +10982,11 @@ fast_json_add_array_end (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE array,
       size_t size = sizeof (FAST_JSON_ARRAY_TYPE) +
 	(l - 1) * sizeof (FAST_JSON_DATA_TYPE);
       FAST_JSON_ARRAY_TYPE *na =
-	(FAST_JSON_ARRAY_TYPE *) (*json->my_realloc) (a, size);
+	(FAST_JSON_ARRAY_TYPE *) fast_json_data_realloc (json, array, a,
+							 sizeof (*a) +
+							 (a->max - 1) *
+							 sizeof (a->values[0]),
+							 size);
 
       if (LIKELY (na != NULL)) {
 	a = array->u.array = na;
@@ -3940,8 +11012,8 @@ fast_json_add_array (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE array,
   if (json && array && array->type == FAST_JSON_ARRAY && value) {
     if ((json->options & FAST_JSON_NO_CHECK_LOOP) ||
 	array->used == 0 || value->used == 0 ||
-	(fast_json_check_loop (array, value) == 0 &&
-	 fast_json_check_loop (value, array) == 0)) {
+	(fast_json_check_loop (json, array, value) == 0 &&
+	 fast_json_check_loop (json, value, array) == 0)) {
       retval = fast_json_add_array_end (json, array, value);
     }
     else {
@@ -3959,55 +11031,112 @@ fast_json_init_hash (FAST_JSON_OBJECT_TYPE * o)
   FAST_JSON_NAME_VALUE_TYPE *data = &o->data[0];
 
   for (i = 0; i < o->max; i++) {
-    data[i].hash_table = NULL;
+    data[i].hash_table = 0;
   }
   for (i = 0; i < o->len; i++) {
     uint64_t hash = UINT64_C (0xFFFFFFFFFFFFFFFF);
 
-    fast_json_update_crc64 (&hash, data[i].name);
+    fast_json_update_crc64 (&hash, fast_json_name (&data[i]), data[i].len);
     hash = (hash ^ UINT64_C (0xFFFFFFFFFFFFFFFF)) & mask;
     data[i].next = data[hash].hash_table;
-    data[hash].hash_table = &data[i];
+    data[hash].hash_table = (unsigned int) (i + 1);
+  }
+}
+
+/* Allocate the long names of an object from fast_json_parse_insitu before
+ * it is changed. Then the names no longer point into the parsed buffer.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_object_own_names (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE object)
+{
+  FAST_JSON_OBJECT_TYPE *o = object->u.object;
+  char **names;
+  size_t i;
+
+  if (o && o->len) {
+    names = (char **) (*json->my_malloc) (o->len * sizeof (*names));
+    if (names == NULL) {
+      return FAST_JSON_MALLOC_ERROR;
+    }
+    for (i = 0; i < o->len; i++) {
+      names[i] = NULL;
+      if (o->data[i].len >= FAST_JSON_NAME_INLINE) {
+	names[i] = fast_json_data_memdup (json, object, o->data[i].u.name,
+					  o->data[i].len);
+	if (names[i] == NULL) {
+	  while (i--) {
+	    if (names[i]) {
+	      fast_json_data_release (json, object, names[i]);
+	    }
+	  }
+	  (*json->my_free) (names);
+	  return FAST_JSON_MALLOC_ERROR;
+	}
+      }
+    }
+    for (i = 0; i < o->len; i++) {
+      if (names[i]) {
+	o->data[i].u.name = names[i];
+      }
+    }
+    (*json->my_free) (names);
   }
+  object->is_str = FAST_JSON_STR_MALLOC;
+  return FAST_JSON_OK;
 }
 
 static FAST_JSON_ERROR_ENUM
 fast_json_add_object_end (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE object,
-			  const char *name, FAST_JSON_DATA_TYPE value)
+			  const char *name, size_t len,
+			  FAST_JSON_DATA_TYPE value)
 {
   FAST_JSON_ERROR_ENUM retval = FAST_JSON_MALLOC_ERROR;
   FAST_JSON_OBJECT_TYPE *o = object->u.object;
   uint64_t hash = UINT64_C (0xFFFFFFFFFFFFFFFF);
+  char i_name[FAST_JSON_NAME_INLINE];
 
-  fast_json_update_crc64 (&hash, name);
+  if (len < FAST_JSON_NAME_INLINE) {
+    /* name can be in this object and the members can move */
+    memcpy (i_name, name, len);
+    i_name[len] = '\0';
+    name = i_name;
+  }
+  if (UNLIKELY (object->is_str == FAST_JSON_STR_INSITU) &&
+      json->insitu == 0 &&
+      fast_json_object_own_names (json, object) != FAST_JSON_OK) {
+    return FAST_JSON_MALLOC_ERROR;
+  }
+  fast_json_update_crc64 (&hash, name, len);
   hash = hash ^ UINT64_C (0xFFFFFFFFFFFFFFFF);
   if (UNLIKELY (o == NULL)) {
     size_t size = sizeof (FAST_JSON_OBJECT_TYPE) +
       (FAST_JSON_INITIAL_SIZE - 1) * sizeof (FAST_JSON_NAME_VALUE_TYPE);
 
     o = object->u.object =
-      (FAST_JSON_OBJECT_TYPE *) (*json->my_malloc) (size);
+      (FAST_JSON_OBJECT_TYPE *) fast_json_data_alloc (json, object, size);
     if (LIKELY (o != NULL)) {
       size_t i;
 
       o->len = 0;
       o->max = FAST_JSON_INITIAL_SIZE;
       for (i = 0; i < o->max; i++) {
-	o->data[i].hash_table = NULL;
+	o->data[i].hash_table = 0;
       }
     }
   }
   else if ((json->options & FAST_JSON_NO_DUPLICATE_CHECK) == 0) {
-    FAST_JSON_NAME_VALUE_TYPE *obj = o->data[hash & (o->max - 1)].hash_table;
+    size_t i = o->data[hash & (o->max - 1)].hash_table;
+
+    while (i) {
+      FAST_JSON_NAME_VALUE_TYPE *obj = &o->data[i - 1];
 
-    while (obj) {
-      if (obj->name[0] == name[0] && strcmp (&obj->name[1], &name[1]) == 0) {
+      if (obj->len == len && memcmp (fast_json_name (obj), name, len) == 0) {
 	fast_json_value_free (json, obj->value);
 	obj->value = value;
 	retval = FAST_JSON_OK;
 	return retval;
       }
-      obj = obj->next;
+      i = obj->next;
     }
   }
   if (LIKELY (o != NULL)) {
@@ -4017,7 +11146,10 @@ fast_json_add_object_end (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE object,
 	(new_max - 1) * sizeof (FAST_JSON_NAME_VALUE_TYPE);
       FAST_JSON_OBJECT_TYPE *no;
 
-      no = (FAST_JSON_OBJECT_TYPE *) (*json->my_realloc) (o, size);
+      no = (FAST_JSON_OBJECT_TYPE *)
+	fast_json_data_realloc (json, object, o,
+				sizeof (*o) + (o->max - 1) * sizeof (o->data[0]),
+				size);
       if (LIKELY (no != NULL)) {
 	o = object->u.object = no;
 	o->max = new_max;
@@ -4025,15 +11157,24 @@ fast_json_add_object_end (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE object,
       }
     }
     if (LIKELY (o->len != o->max)) {
-      o->data[o->len].name = fast_json_strdup (json, name);
-      if (o->data[o->len].name != NULL) {
+      FAST_JSON_NAME_VALUE_TYPE *obj = &o->data[o->len];
+
+      if (len < FAST_JSON_NAME_INLINE) {
+	memcpy (obj->u.i_name, name, len + 1);
+      }
+      else {
+	obj->u.name = object->is_str == FAST_JSON_STR_INSITU ?
+	  (char *) name : fast_json_data_memdup (json, object, name, len);
+      }
+      if (len < FAST_JSON_NAME_INLINE || obj->u.name != NULL) {
+	obj->len = len;
 	object->used = 1;
 	value->used = 1;
-	o->data[o->len].value = value;
+	obj->value = value;
 	hash &= o->max - 1;
-	o->data[o->len].next = o->data[hash].hash_table;
-	o->data[hash].hash_table = &o->data[o->len];
+	obj->next = o->data[hash].hash_table;
 	o->len++;
+	o->data[hash].hash_table = (unsigned int) o->len;
 	retval = FAST_JSON_OK;
       }
     }
@@ -4050,9 +11191,10 @@ fast_json_add_object (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE object,
   if (json && object && object->type == FAST_JSON_OBJECT && name && value) {
     if ((json->options & FAST_JSON_NO_CHECK_LOOP) ||
 	object->used == 0 || value->used == 0 ||
-	(fast_json_check_loop (object, value) == 0 &&
-	 fast_json_check_loop (value, object) == 0)) {
-      retval = fast_json_add_object_end (json, object, name, value);
+	(fast_json_check_loop (json, object, value) == 0 &&
+	 fast_json_check_loop (json, value, object) == 0)) {
+      retval = fast_json_add_object_end (json, object, name, strlen (name),
+					 value);
     }
     else {
       retval = FAST_JSON_LOOP_ERROR;
@@ -4071,8 +11213,8 @@ fast_json_patch_array (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE array,
       array->u.array && index < array->u.array->len) {
     if ((json->options & FAST_JSON_NO_CHECK_LOOP) ||
 	array->used == 0 || value->used == 0 ||
-	(fast_json_check_loop (array, value) == 0 &&
-	 fast_json_check_loop (value, array) == 0)) {
+	(fast_json_check_loop (json, array, value) == 0 &&
+	 fast_json_check_loop (json, value, array) == 0)) {
       array->used = 1;
       value->used = 1;
       fast_json_value_free (json, array->u.array->values[index]);
@@ -4096,8 +11238,8 @@ fast_json_insert_array (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE array,
       array->u.array && index < array->u.array->len) {
     if ((json->options & FAST_JSON_NO_CHECK_LOOP) ||
 	array->used == 0 || value->used == 0 ||
-	(fast_json_check_loop (array, value) == 0 &&
-	 fast_json_check_loop (value, array) == 0)) {
+	(fast_json_check_loop (json, array, value) == 0 &&
+	 fast_json_check_loop (json, value, array) == 0)) {
       retval = fast_json_add_array_end (json, array, value);
       if (retval == FAST_JSON_OK) {
 	size_t i;
@@ -4149,8 +11291,8 @@ fast_json_patch_object (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE object,
       object->u.object && index < object->u.object->len) {
     if (((json->options & FAST_JSON_NO_CHECK_LOOP) ||
 	 object->used == 0 || value->used == 0 ||
-	 (fast_json_check_loop (object, value) == 0 &&
-	  fast_json_check_loop (value, object) == 0))) {
+	 (fast_json_check_loop (json, object, value) == 0 &&
+	  fast_json_check_loop (json, value, object) == 0))) {
       object->used = 1;
       value->used = 1;
       fast_json_value_free (json, object->u.object->data[index].value);
@@ -4175,9 +11317,10 @@ fast_json_insert_object (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE object,
       object->u.object && index < object->u.object->len) {
     if (((json->options & FAST_JSON_NO_CHECK_LOOP) ||
 	 object->used == 0 || value->used == 0 ||
-	 (fast_json_check_loop (object, value) == 0 &&
-	  fast_json_check_loop (value, object) == 0))) {
-      retval = fast_json_add_object_end (json, object, name, value);
+	 (fast_json_check_loop (json, object, value) == 0 &&
+	  fast_json_check_loop (json, value, object) == 0))) {
+      retval = fast_json_add_object_end (json, object, name, strlen (name),
+					 value);
       if (retval == FAST_JSON_OK) {
 	size_t i;
 	FAST_JSON_OBJECT_TYPE *o = object->u.object;
@@ -4212,7 +11355,10 @@ fast_json_remove_object (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE object,
     FAST_JSON_OBJECT_TYPE *o = object->u.object;
     FAST_JSON_NAME_VALUE_TYPE *data = &o->data[0];
 
-    (*json->my_free) (data[index].name);
+    if (object->is_str != FAST_JSON_STR_INSITU &&
+	data[index].len >= FAST_JSON_NAME_INLINE) {
+      fast_json_data_release (json, object, data[index].u.name);
+    }
     fast_json_value_free (json, data[index].value);
     object->u.object->len--;
     for (i = index; i < object->u.object->len; i++) {
@@ -4259,11 +11405,21 @@ fast_json_get_object_name (FAST_JSON_DATA_TYPE data, size_t index)
 {
   if (data && data->type == FAST_JSON_OBJECT &&
       data->u.object && index < data->u.object->len) {
-    return data->u.object->data[index].name;
+    return fast_json_name (&data->u.object->data[index]);
   }
   return NULL;
 }
 
+size_t
+fast_json_get_object_name_len (FAST_JSON_DATA_TYPE data, size_t index)
+{
+  if (data && data->type == FAST_JSON_OBJECT &&
+      data->u.object && index < data->u.object->len) {
+    return data->u.object->data[index].len;
+  }
+  return 0;
+}
+
 FAST_JSON_DATA_TYPE
 fast_json_get_object_data (FAST_JSON_DATA_TYPE data, size_t index)
 {
@@ -4281,17 +11437,21 @@ fast_json_get_object_by_name (FAST_JSON_DATA_TYPE object, const char *name)
     FAST_JSON_OBJECT_TYPE *o = object->u.object;
 
     if (LIKELY (o != NULL)) {
-      FAST_JSON_NAME_VALUE_TYPE *obj;
+      size_t i;
       uint64_t hash = UINT64_C (0xFFFFFFFFFFFFFFFF);
 
-      fast_json_update_crc64 (&hash, name);
+      size_t len = strlen (name);
+
+      fast_json_update_crc64 (&hash, name, len);
       hash = hash ^ UINT64_C (0xFFFFFFFFFFFFFFFF);
-      obj = o->data[hash & (o->max - 1)].hash_table;
-      while (obj) {
-	if (obj->name[0] == name[0] && strcmp (&obj->name[1], &name[1]) == 0) {
+      i = o->data[hash & (o->max - 1)].hash_table;
+      while (i) {
+	FAST_JSON_NAME_VALUE_TYPE *obj = &o->data[i - 1];
+
+	if (obj->len == len && memcmp (fast_json_name (obj), name, len) == 0) {
 	  return (obj->value);
 	}
-	obj = obj->next;
+	i = obj->next;
       }
     }
   }
@@ -4314,10 +11474,22 @@ char *
 fast_json_get_string (FAST_JSON_DATA_TYPE data)
 {
   return data && data->type == FAST_JSON_STRING
-    ? (data->is_str ? &data->u.i_string_value[0] : data->u.string_value)
+    ? (data->is_str == FAST_JSON_STR_INLINE ? fast_json_inline (data)
+       : data->u.string_value)
     : NULL;
 }
 
+size_t
+fast_json_get_string_len (FAST_JSON_DATA_TYPE data)
+{
+  size_t len = 0;
+
+  if (data && data->type == FAST_JSON_STRING) {
+    fast_json_str (data, &len);
+  }
+  return len;
+}
+
 unsigned int
 fast_json_get_boolean (FAST_JSON_DATA_TYPE data)
 {
@@ -4359,43 +11531,15 @@ fast_json_set_string (FAST_JSON_TYPE json, FAST_JSON_DATA_TYPE data,
   FAST_JSON_ERROR_ENUM retval = FAST_JSON_VALUE_ERROR;
 
   if (json && data && data->type == FAST_JSON_STRING && value) {
-    int len = 0;
-    char str[8];
-    char *new_value;
-    const char *cp;
-
-    cp = value;
-    while (*cp) { 
-      len += (*cp == '"') + 1;
-      if (*cp++ == '\\') {
-        len += *cp == 'x' ? 2 : (*cp == '0' ? 4 : 0);
-	cp++;
-      }
-    }
-    if (len >= sizeof (str)) {
-      new_value = fast_json_strdup (json, value);
-    }
-    else {
-      new_value = memcpy (str, value, len + 1);
-    }
-    if (new_value) {
-      if (fast_json_check_string (json, value, value + len, new_value, '"') ==
-	  FAST_JSON_OK) {
-	if (data->is_str == 0) {
-	  (*json->my_free) (data->u.string_value);
-	}
-	if (len >= sizeof (str)) {
-	  data->is_str = 0;
-	  data->u.string_value = new_value;
-	}
-	else {
-	  data->is_str = 1;
-	  memcpy (data->u.i_string_value, new_value, len + 1);
-	}
-	retval = FAST_JSON_OK;
+    const char *cp = value;
+
+    if (fast_json_check_string (json, &cp, value + strlen (value), '"') ==
+	FAST_JSON_OK) {
+      if (*cp) {
+	fast_json_store_error (json, FAST_JSON_ESCAPE_CHARACTER_ERROR, cp);
       }
-      else if (len >= sizeof (str)) {
-	(*json->my_free) (new_value);
+      else {
+	retval = fast_json_string_store (json, data);
       }
     }
   }
@@ -4570,11 +11714,12 @@ static const uint64_t fast_json_crctab64[256] = {
 };
 
 static void
-fast_json_update_crc64 (uint64_t * crc, const char *str)
+fast_json_update_crc64 (uint64_t * crc, const char *str, size_t len)
 {
   uint64_t temp = *crc;
+  const char *end = str + len;
 
-  while (*str) {
+  while (str != end) {
     temp = (temp >> 8) ^ fast_json_crctab64[(temp ^ *str++) & 0xFFu];
   }
   *crc = temp;
@@ -4685,7 +11830,6 @@ fast_json_update_crc32 (unsigned int *crc, const char *str)
 static FAST_JSON_ERROR_ENUM
 fast_json_parse_crc (FAST_JSON_TYPE json, unsigned int *crc, int c)
 {
-  FAST_JSON_ERROR_ENUM error;
   char *save;
 
   fast_json_getc_save_start (json, c);
@@ -4932,127 +12076,156 @@ fast_json_parse_crc (FAST_JSON_TYPE json, unsigned int *crc, int c)
       fast_json_update_crc32 (crc, save);
     }
     break;
-  case '[':
-    error = fast_json_skip_whitespace (json, &c);
-    if (error != FAST_JSON_OK) {
-      return error;
-    }
-    if (c == ']') {
-      break;
+  case '[':			/* FALLTHRU */
+  case '{':
+    return fast_json_parse_crc_nested (json, crc, c);
+  default:
+    save = fast_json_ungetc_save (json, 0);
+    fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
+    return FAST_JSON_VALUE_ERROR;
+  }
+  return FAST_JSON_OK;
+}
+
+/* Add the object name that starts with c to the crc. */
+static FAST_JSON_ERROR_ENUM
+fast_json_parse_crc_name (FAST_JSON_TYPE json, unsigned int *crc, int c)
+{
+  char *save;
+
+  if ((json->options & FAST_JSON_ALLOW_JSON5) && c != '"') {
+    fast_json_getc_save_start (json, c);
+    while (c > 0 && c != ':') {
+      if (c == '\\') {
+	fast_json_getc_save (json);
+      }
+      if (fast_json5_isspace (c)) {
+	break;
+      }
+      else if (c == 0xc2) {
+	c = fast_json_getc_save (json);
+	if (c == 0xa0) {	/* Non-breaking space */
+	  c = ' ';
+	  json->n_save--;
+	  break;
+	}
+      }
+      else if (c == 0xe2) {
+	c = fast_json_getc_save (json);
+	if (c == 0x80) {
+	  c = fast_json_getc_save (json);
+	  if (c == 0xa8 || c == 0xa9) {
+	    /* Line separator */
+	    /* Paragraph separator */
+	    c = ' ';
+	    json->n_save -= 2;
+	    break;
+	  }
+	}
+      }
+      else if (c == 0xef) {
+	c = fast_json_getc_save (json);
+	if (c == 0xbb) {
+	  c = fast_json_getc_save (json);
+	  if (c == 0xbf) {	/* Byte order mark */
+	    c = ' ';
+	    json->n_save -= 2;
+	    break;
+	  }
+	}
+      }
+      c = fast_json_getc_save (json);
     }
-    for (;;) {
-      error = fast_json_parse_crc (json, crc, c);
-      if (error != FAST_JSON_OK) {
-	return error;
+    save = fast_json_ungetc_save (json, c);
+  }
+  else {
+    if (c != '"') {
+      fast_json_store_error (json, FAST_JSON_STRING_START_ERROR, "");
+      return FAST_JSON_STRING_START_ERROR;
+    }
+    c = fast_json_getc (json);
+    fast_json_getc_save_start (json, c);
+    while (c > 0 && c != '"') {
+      if (c == '\\') {
+	fast_json_getc_save (json);
       }
-      error = fast_json_skip_whitespace (json, &c);
+      c = fast_json_getc_save (json);
+    }
+    save = fast_json_ungetc_save (json, c);
+    c = fast_json_getc (json);
+    if (c != '"') {
+      fast_json_store_error (json, FAST_JSON_STRING_END_ERROR, save);
+      return FAST_JSON_STRING_END_ERROR;
+    }
+  }
+  fast_json_update_crc32 (crc, save);
+  return FAST_JSON_OK;
+}
+
+/* Add the array or object that starts with c to the crc. The closing
+ * character of each open array and object is kept on the container stack.
+ */
+static FAST_JSON_ERROR_ENUM
+fast_json_parse_crc_nested (FAST_JSON_TYPE json, unsigned int *crc, int c)
+{
+  FAST_JSON_ERROR_ENUM error;
+  size_t depth = 0;
+  int close;
+
+  for (;;) {
+    /* Parse the value that starts with c */
+    close = c == '[' ? ']' : c == '{' ? '}' : 0;
+    if (close) {
+      error = fast_json_stack_check (json, depth);
       if (error != FAST_JSON_OK) {
+	fast_json_store_error (json, error, "");
 	return error;
       }
-      if (c != ',') {
-	break;
-      }
-      error = fast_json_skip_whitespace (json, &c);
+      json->stack[depth++].close = close;
+    }
+    else {
+      error = fast_json_parse_crc (json, crc, c);
       if (error != FAST_JSON_OK) {
 	return error;
       }
-      if ((json->options & FAST_JSON_ALLOW_JSON5) && c == ']') {
-        break;
-      }
     }
-    if (c != ']') {
-      fast_json_store_error (json, FAST_JSON_ARRAY_END_ERROR, "");
-      return FAST_JSON_ARRAY_END_ERROR;
-    }
-    break;
-  case '{':
     error = fast_json_skip_whitespace (json, &c);
     if (error != FAST_JSON_OK) {
       return error;
     }
-    if (c == '}') {
-      break;
-    }
-    for (;;) {
-      if ((json->options & FAST_JSON_ALLOW_JSON5) && c != '"') {
-        fast_json_getc_save_start (json, c);
-        while (c > 0 && c != ':') {
-          if (c == '\\') {
-            fast_json_getc_save (json);
-          }
-          if (fast_json5_isspace (c)) {
-            break;
-          }
-          else if (c == 0xc2) {
-            c = fast_json_getc_save (json);
-            if (c == 0xa0) { /* Non-breaking space */
-	      c = ' ';
-	      json->n_save--;
-              break;
-            }
-          }
-          else if (c == 0xe2) {
-            c = fast_json_getc_save (json);
-            if (c == 0x80) {
-              c = fast_json_getc_save (json);
-              if (c == 0xa8 || c == 0xa9) {
-		/* Line separator */
-		/* Paragraph separator */
-	        c = ' ';
-	        json->n_save -= 2;
-                break;
-              }
-            }
-          }
-          else if (c == 0xef) {
-            c = fast_json_getc_save (json);
-            if (c == 0xbb) {
-              c = fast_json_getc_save (json);
-              if (c == 0xbf) { /* Byte order mark */
-	        c = ' ';
-	        json->n_save -= 2;
-                break;
-              }
-            }
-          }
-          c = fast_json_getc_save (json);
-        }
-        save = fast_json_ungetc_save (json, c);
-      }
-      else {
-        if (c != '"') {
-	  fast_json_store_error (json, FAST_JSON_STRING_START_ERROR, "");
-	  return FAST_JSON_STRING_START_ERROR;
-        }
-        c = fast_json_getc (json);
-        fast_json_getc_save_start (json, c);
-        while (c > 0 && c != '"') {
-	  if (c == '\\') {
-	    fast_json_getc_save (json);
+
+    /* Close arrays and objects until the next element is found */
+    if (close == 0 || c == close) {
+      for (;;) {
+	close = json->stack[depth - 1].close;
+	if (c == ',') {
+	  error = fast_json_skip_whitespace (json, &c);
+	  if (error != FAST_JSON_OK) {
+	    return error;
 	  }
-	  c = fast_json_getc_save (json);
-        }
-        save = fast_json_ungetc_save (json, c);
-        c = fast_json_getc (json);
-        if (c != '"') {
-  	  fast_json_store_error (json, FAST_JSON_STRING_END_ERROR, save);
-	  return FAST_JSON_STRING_END_ERROR;
-        }
-      }
-      fast_json_update_crc32 (crc, save);
-      error = fast_json_skip_whitespace (json, &c);
-      if (error != FAST_JSON_OK) {
-	return error;
-      }
-      if (c != ':') {
-	fast_json_store_error (json, FAST_JSON_OBJECT_SEPERATOR_ERROR, "");
-	return FAST_JSON_OBJECT_SEPERATOR_ERROR;
-      }
-      error = fast_json_skip_whitespace (json, &c);
-      if (error != FAST_JSON_OK) {
-	return error;
+	  if ((json->options & FAST_JSON_ALLOW_JSON5) == 0 || c != close) {
+	    break;
+	  }
+	}
+	if (c != close) {
+	  error = close == ']' ? FAST_JSON_ARRAY_END_ERROR :
+	    FAST_JSON_OBJECT_END_ERROR;
+	  fast_json_store_error (json, error, "");
+	  return error;
+	}
+	if (--depth == 0) {
+	  return FAST_JSON_OK;
+	}
+	error = fast_json_skip_whitespace (json, &c);
+	if (error != FAST_JSON_OK) {
+	  return error;
+	}
       }
-      error = fast_json_parse_crc (json, crc, c);
+    }
+
+    /* c starts the next element of the container on top of the stack */
+    if (json->stack[depth - 1].close == '}') {
+      error = fast_json_parse_crc_name (json, crc, c);
       if (error != FAST_JSON_OK) {
 	return error;
       }
@@ -5060,28 +12233,16 @@ fast_json_parse_crc (FAST_JSON_TYPE json, unsigned int *crc, int c)
       if (error != FAST_JSON_OK) {
 	return error;
       }
-      if (c != ',') {
-	break;
+      if (c != ':') {
+	fast_json_store_error (json, FAST_JSON_OBJECT_SEPERATOR_ERROR, "");
+	return FAST_JSON_OBJECT_SEPERATOR_ERROR;
       }
       error = fast_json_skip_whitespace (json, &c);
       if (error != FAST_JSON_OK) {
 	return error;
       }
-      if ((json->options & FAST_JSON_ALLOW_JSON5) && c == '}') {
-        break;
-      }
-    }
-    if (c != '}') {
-      fast_json_store_error (json, FAST_JSON_OBJECT_END_ERROR, "");
-      return FAST_JSON_OBJECT_END_ERROR;
     }
-    break;
-  default:
-    save = fast_json_ungetc_save (json, 0);
-    fast_json_store_error (json, FAST_JSON_VALUE_ERROR, save);
-    return FAST_JSON_VALUE_ERROR;
   }
-  return FAST_JSON_OK;
 }
 
 static FAST_JSON_ERROR_ENUM
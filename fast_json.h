@@ -165,6 +165,9 @@ extern "C"
 /** Allow json5 */
 #define	FAST_JSON_ALLOW_JSON5		(0x400)
 
+/** Allocate values in an arena that is freed with fast_json_arena_free */
+#define	FAST_JSON_ARENA			(0x800)
+
 /** Json value type */
   typedef enum fast_json_value_enum
   {
@@ -198,7 +201,10 @@ extern "C"
     FAST_JSON_PARSE_ERROR,
     FAST_JSON_NO_DATA_ERROR,
     FAST_JSON_INDEX_ERROR,
-    FAST_JSON_LOOP_ERROR
+    FAST_JSON_LOOP_ERROR,
+    FAST_JSON_DEPTH_ERROR,
+    FAST_JSON_USER_ERROR,
+    FAST_JSON_NEED_MORE_DATA
   } FAST_JSON_ERROR_ENUM;
 
 /** Json data type. All values are returned in this type. */
@@ -212,9 +218,87 @@ extern "C"
   typedef void *(*fast_json_realloc_type) (void *, size_t);
   typedef void (*fast_json_free_type) (void *);
 
+/** On demand cursor into a json string. See \ref fast_json_cursor_start.
+ *  The members are only used by the library. */
+  typedef struct fast_json_cursor_struct
+  {
+    const char *doc;
+    const char *end;
+    const char *value;
+    const char *next;
+    const char *name;
+    const char *start;
+    struct fast_json_cursor_struct *parent;
+    int close;
+  } FAST_JSON_CURSOR_TYPE;
+
+/** Event callbacks for \ref fast_json_parse_events_string. Each callback
+ *  gets the user data and returns 0 to continue or non zero to stop with
+ *  FAST_JSON_USER_ERROR. Callbacks can be NULL. Names and strings are
+ *  only valid during the call. */
+  typedef struct fast_json_events_struct
+  {
+    int (*start_object) (void *user_data);
+    int (*end_object) (void *user_data);
+    int (*start_array) (void *user_data);
+    int (*end_array) (void *user_data);
+    int (*key) (void *user_data, const char *name, size_t len);
+    int (*string_value) (void *user_data, const char *str, size_t len);
+    int (*integer_value) (void *user_data, fast_json_int_64 value);
+    int (*double_value) (void *user_data, double value);
+    int (*boolean_value) (void *user_data, unsigned int value);
+    int (*null_value) (void *user_data);
+  } FAST_JSON_EVENTS_TYPE;
+
+/** Compiled key paths for \ref fast_json_parse_paths. */
+  typedef struct fast_json_path_struct *FAST_JSON_PATHS_TYPE;
+
+/** Flat tape from \ref fast_json_parse_tape. */
+  typedef struct fast_json_tape_struct *FAST_JSON_TAPE_TYPE;
+
+/** Position returned by the tape functions if there is no value */
+#define	FAST_JSON_TAPE_NONE		((size_t) -1)
+
+/** Token type of \ref fast_json_next_token */
+  typedef enum fast_json_token_enum
+  {
+    FAST_JSON_TOKEN_START_OBJECT,
+    FAST_JSON_TOKEN_END_OBJECT,
+    FAST_JSON_TOKEN_START_ARRAY,
+    FAST_JSON_TOKEN_END_ARRAY,
+    FAST_JSON_TOKEN_NAME,
+    FAST_JSON_TOKEN_STRING,
+    FAST_JSON_TOKEN_INTEGER,
+    FAST_JSON_TOKEN_DOUBLE,
+    FAST_JSON_TOKEN_BOOLEAN,
+    FAST_JSON_TOKEN_NULL,
+    FAST_JSON_TOKEN_END
+  } FAST_JSON_TOKEN_ENUM;
+
+/** Token returned by \ref fast_json_next_token. depth is the number of
+ *  open arrays and objects around the token. str and len are set for
+ *  names and strings and are valid until the next call with json. */
+  typedef struct fast_json_token_struct
+  {
+    FAST_JSON_TOKEN_ENUM type;
+    size_t depth;
+    const char *str;
+    size_t len;
+    union
+    {
+      fast_json_int_64 int_value;
+      double double_value;
+      unsigned int boolean_value;
+    } u;
+  } FAST_JSON_TOKEN_TYPE;
+
 /** User get character function */
   typedef int (*fast_json_getc_func) (void *user_data);
 
+/** User block read function. Returns next block and its length in len or
+ *  NULL at end of file. The block must stay valid until the next call. */
+  typedef const char *(*fast_json_block_func) (void *user_data, size_t *len);
+
 /** User put string function */
   typedef int (*fast_json_puts_func) (void *user_data, const char *str,
 				      unsigned int len);
@@ -254,6 +338,19 @@ extern "C"
   extern FAST_JSON_ERROR_ENUM fast_json_max_reuse (FAST_JSON_TYPE json,
 						   size_t n);
 
+/**
+ * \b Description
+ *
+ * Set the maximum nesting depth of arrays and objects during parsing.
+ * Deeper input gives a FAST_JSON_DEPTH_ERROR. The default 0 means no limit.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param depth Maximum nesting depth.
+ * \return Error if json is not valid.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_max_depth (FAST_JSON_TYPE json,
+						   size_t depth);
+
 /**
  * \b Description
  *
@@ -286,6 +383,20 @@ extern "C"
  */
   extern unsigned int fast_json_get_options (FAST_JSON_TYPE json);
 
+/**
+ * \b Description
+ *
+ * Free all values allocated with FAST_JSON_ARENA at once.
+ * With FAST_JSON_ARENA values, strings, names, arrays and objects are
+ * allocated from large chunks. \ref fast_json_value_free does nothing for
+ * these values. Values that are added to an arena value must also be
+ * arena values of the same json object, otherwise they are not freed.
+ * One chunk is kept for the next document. \ref fast_json_free frees all.
+ *
+ * \param json Json object from \ref fast_json_create.
+ */
+  extern void fast_json_arena_free (FAST_JSON_TYPE json);
+
 /**
  * \b Description
  *
@@ -388,6 +499,8 @@ extern "C"
  * \b Description
  *
  * Parse a file name to json type.
+ * Regular files are mapped in memory and parsed in place with the same code
+ * as \ref fast_json_parse_string2.
  *
  * \param json Json object from \ref fast_json_create.
  * \param name File name to read from.
@@ -421,6 +534,24 @@ extern "C"
 						   fast_json_getc_func getc,
 						   void *user_data);
 
+/**
+ * \b Description
+ *
+ * Parse json data supplied in blocks by a user function.
+ * The blocks are collected in a window and each value is parsed with the
+ * same code as \ref fast_json_parse_string2 once it is complete.
+ * If FAST_JSON_NO_EOF_CHECK is set no more blocks are read than needed
+ * for the value. Use \ref fast_json_parse_next for the next value.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param block User block function.
+ * \param user_data User data supplied to block function.
+ * \return Parsed data or NULL in case of error.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_parse_block (FAST_JSON_TYPE json,
+						    fast_json_block_func block,
+						    void *user_data);
+
 /**
  * \b Description
  *
@@ -431,6 +562,87 @@ extern "C"
  */
   extern FAST_JSON_DATA_TYPE fast_json_parse_next (FAST_JSON_TYPE json);
 
+/**
+ * \b Description
+ *
+ * Parse a string and call the event callbacks instead of building json
+ * values.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param events Event callbacks.
+ * \param user_data User data for the callbacks.
+ * \param json_str String to parse.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_parse_events_string (FAST_JSON_TYPE
+							     json,
+							     const
+							     FAST_JSON_EVENTS_TYPE
+							     * events,
+							     void *user_data,
+							     const char
+							     *json_str);
+
+/**
+ * \b Description
+ *
+ * Parse a file and call the event callbacks instead of building json
+ * values.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param events Event callbacks.
+ * \param user_data User data for the callbacks.
+ * \param fp File pointer to parse.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_parse_events_file (FAST_JSON_TYPE json,
+							   const
+							   FAST_JSON_EVENTS_TYPE
+							   * events,
+							   void *user_data,
+							   FILE * fp);
+
+/**
+ * \b Description
+ *
+ * Parse a file descriptor and call the event callbacks instead of building
+ * json values.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param events Event callbacks.
+ * \param user_data User data for the callbacks.
+ * \param fd File descriptor to parse.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_parse_events_fd (FAST_JSON_TYPE json,
+							 const
+							 FAST_JSON_EVENTS_TYPE
+							 * events,
+							 void *user_data,
+							 int fd);
+
+/**
+ * \b Description
+ *
+ * Parse with a user get character function and call the event callbacks
+ * instead of building json values.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param events Event callbacks.
+ * \param user_data User data for the callbacks.
+ * \param getc User get character function.
+ * \param getc_data User data for getc.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_parse_events_user (FAST_JSON_TYPE json,
+							   const
+							   FAST_JSON_EVENTS_TYPE
+							   * events,
+							   void *user_data,
+							   fast_json_getc_func
+							   getc,
+							   void *getc_data);
+
 /**
  * \b Description
  *
@@ -456,6 +668,661 @@ extern "C"
   extern FAST_JSON_DATA_TYPE fast_json_parse_string2_next (FAST_JSON_TYPE
 							   json);
 
+/**
+ * \b Description
+ *
+ * Parse a buffer in place. Works like \ref fast_json_parse_string2 but
+ * strings and object names are unescaped inside buf and the values point
+ * into buf. So buf is changed and must not be freed or changed before the
+ * values are freed. Changing an object copies its names.
+ * The column, line and postion of an error are counted on the changed
+ * buffer.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param buf Buffer to parse. buf[len] must be 0.
+ * \param len Length of buf.
+ * \return Parsed data or NULL in case of error.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_parse_insitu (FAST_JSON_TYPE json,
+						     char *buf, size_t len);
+
+/**
+ * \b Description
+ *
+ * Parse newline delimited json (one value per line) with several threads.
+ * The string is split in chunks at line ends and every thread parses
+ * chunks with the fast string parser and its own json object. Empty lines
+ * are skipped. The memory functions of json must be thread safe.
+ * In case of an error the line, column and position of the first bad
+ * line in the string are set. The threads are not used on windows.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param json_str String to parse.
+ * \param n_threads Number of threads. 0 uses one thread per online cpu.
+ * \return Array with the values in input order or NULL in case of error.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_parse_ndjson (FAST_JSON_TYPE json,
+						     const char *json_str,
+						     unsigned int n_threads);
+
+/**
+ * \b Description
+ *
+ * Read a file descriptor until end of file and parse it with
+ * \ref fast_json_parse_ndjson.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param fd File descriptor to parse.
+ * \param n_threads Number of threads. 0 uses one thread per online cpu.
+ * \return Array with the values in input order or NULL in case of error.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_parse_ndjson_fd (FAST_JSON_TYPE json,
+							int fd,
+							unsigned int
+							n_threads);
+
+/**
+ * \b Description
+ *
+ * Parse a large string with a top level array or object with several
+ * threads. The top level elements are found with the scanner of
+ * \ref fast_json_skip_value and the string is split in chunks of elements.
+ * Every thread parses chunks with the fast string parser and its own json
+ * object and the values are added to one array or object in input order.
+ * Small strings and other values are parsed with
+ * \ref fast_json_parse_string2. In case of an error the string is parsed
+ * again with \ref fast_json_parse_string2 to set the error information.
+ * The memory functions of json must be thread safe. The threads are not
+ * used on windows.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param json_str String to parse.
+ * \param n_threads Number of threads. 0 uses one thread per online cpu.
+ * \return Parsed data or NULL in case of error.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_parse_parallel (FAST_JSON_TYPE json,
+						       const char *json_str,
+						       unsigned int
+						       n_threads);
+
+/**
+ * \b Description
+ *
+ * Push data of a stream to the parser. The data is copied into the json
+ * object and is kept until a complete value is available. So the parser
+ * never has to wait and can be used with non blocking sockets. Use one
+ * json object per stream. The first call starts a new stream.
+ * Only one value is returned per call. Call again with len 0 until NULL
+ * is returned to get the other complete values. A number at the top level
+ * is only complete when a character follows it. The line, column and
+ * position count from the start of the stream.
+ * After an error the stream must be ended with \ref fast_json_feed_end.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param buf Data to add. Can be NULL if len is 0.
+ * \param len Length of buf.
+ * \return Parsed data or NULL. The error is FAST_JSON_NEED_MORE_DATA if
+ *         no complete value is available yet.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_feed (FAST_JSON_TYPE json,
+					     const char *buf, size_t len);
+
+/**
+ * \b Description
+ *
+ * End the stream of \ref fast_json_feed. The data that is left is parsed.
+ * Call again until NULL is returned. The error is then
+ * FAST_JSON_NO_DATA_ERROR if the stream ended after a complete value.
+ * The next call to \ref fast_json_feed starts a new stream.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \return Parsed data or NULL.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_feed_end (FAST_JSON_TYPE json);
+
+/**
+ * \b Description
+ *
+ * Start reading the elements of a top level array from a file descriptor
+ * one at a time with \ref fast_json_array_stream_next. Only the data of
+ * the current element is kept in memory.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param fd File descriptor to read.
+ * \return Enum with error information. FAST_JSON_VALUE_ERROR if the data
+ *         does not start with an array.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_array_stream_fd (FAST_JSON_TYPE
+							 json, int fd);
+
+/**
+ * \b Description
+ *
+ * Start reading the elements of a top level array from a file one at a
+ * time with \ref fast_json_array_stream_next.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param fp File pointer to read.
+ * \return Enum with error information. FAST_JSON_VALUE_ERROR if the data
+ *         does not start with an array.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_array_stream_file (FAST_JSON_TYPE
+							   json, FILE * fp);
+
+/**
+ * \b Description
+ *
+ * Start reading the elements of a top level array from a user block read
+ * function one at a time with \ref fast_json_array_stream_next.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param block User block read function.
+ * \param user_data User data for block.
+ * \return Enum with error information. FAST_JSON_VALUE_ERROR if the data
+ *         does not start with an array.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_array_stream_block (FAST_JSON_TYPE
+							    json,
+							    fast_json_block_func
+							    block,
+							    void *user_data);
+
+/**
+ * \b Description
+ *
+ * Parse the next element of an array stream. Each element is returned as
+ * soon as it is read and can be freed before the next call. After the
+ * last element the rest of the data is checked unless
+ * FAST_JSON_NO_EOF_CHECK is set.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \return Parsed element or NULL. The error is FAST_JSON_NO_DATA_ERROR
+ *         after the last element.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_array_stream_next (FAST_JSON_TYPE
+							  json);
+
+/**
+ * \b Description
+ *
+ * Skip the json value at the start of a string without building it.
+ * Strings and numbers are not decoded. Only quotes, escapes, comments
+ * and matching brackets are checked. The bytes in between are skipped
+ * with simd if available.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param json_str String with the value.
+ * \param json_end End of the string (the null character) or NULL.
+ *        Pass it when many values of one large string are skipped so the
+ *        length is not calculated each time.
+ * \return Position after the value or NULL in case of error.
+ */
+  extern const char *fast_json_skip_value (FAST_JSON_TYPE json,
+					   const char *json_str,
+					   const char *json_end);
+
+/**
+ * \b Description
+ *
+ * Compile key paths for \ref fast_json_parse_paths. Names are separated
+ * by '.' and array elements are selected with [n] or [*], for example
+ * "user.id" or "items[*].price". If an element is selected by [n] and by
+ * [*] only the [n] path is used for it.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param paths Array of key paths.
+ * \param n Number of key paths.
+ * \return Compiled key paths or NULL in case of a malloc or syntax error.
+ *         A syntax error is FAST_JSON_PARSE_ERROR with the bad path in
+ *         \ref fast_json_parser_error_str and the offset of the error in
+ *         \ref fast_json_parser_column.
+ */
+  extern FAST_JSON_PATHS_TYPE fast_json_create_paths (FAST_JSON_TYPE json,
+						      const char **paths,
+						      size_t n);
+
+/**
+ * \b Description
+ *
+ * Free key paths from \ref fast_json_create_paths.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param paths Compiled key paths.
+ */
+  extern void fast_json_free_paths (FAST_JSON_TYPE json,
+				    FAST_JSON_PATHS_TYPE paths);
+
+/**
+ * \b Description
+ *
+ * Parse a string with the fast string parser and keep only the values
+ * selected by the key paths. Objects and arrays on the paths keep only the
+ * selected members and elements. Everything else is skipped like
+ * \ref fast_json_skip_value and is only checked for matching quotes and
+ * brackets. Values that do not have the type the path needs are left out.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param paths Compiled key paths.
+ * \param json_str String to parse.
+ * \return Parsed data or NULL in case of error. The error is
+ *         FAST_JSON_NO_DATA_ERROR if the value does not fit the paths.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_parse_paths (FAST_JSON_TYPE json,
+						    FAST_JSON_PATHS_TYPE paths,
+						    const char *json_str);
+
+/**
+ * \b Description
+ *
+ * Start on demand parsing of a string. Nothing is parsed until a value is
+ * asked for. Values that are passed over are only checked for matching
+ * quotes and brackets. The string must stay valid while cursors into it
+ * are used. The json object can be used for other calls in between.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param json_str String to parse.
+ * \param cursor Returned cursor at the first value.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_cursor_start (FAST_JSON_TYPE json,
+						      const char *json_str,
+						      FAST_JSON_CURSOR_TYPE *
+						      cursor);
+
+/**
+ * \b Description
+ *
+ * Get the type of the value at a cursor.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param cursor Cursor.
+ * \return Type of the value. FAST_JSON_NULL in case of error.
+ */
+  extern FAST_JSON_VALUE_TYPE fast_json_cursor_type (FAST_JSON_TYPE json,
+						     FAST_JSON_CURSOR_TYPE *
+						     cursor);
+
+/**
+ * \b Description
+ *
+ * Set child to the first element of the array or object at cursor.
+ * The cursor must stay valid while the child is used.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param cursor Cursor at an array or object.
+ * \param child Returned cursor at the first element.
+ * \return Enum with error information. FAST_JSON_NO_DATA_ERROR if the
+ *         array or object is empty.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_cursor_child (FAST_JSON_TYPE json,
+						      FAST_JSON_CURSOR_TYPE *
+						      cursor,
+						      FAST_JSON_CURSOR_TYPE *
+						      child);
+
+/**
+ * \b Description
+ *
+ * Move a cursor to the next array or object element. The current value is
+ * skipped if it was not parsed.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param cursor Cursor from \ref fast_json_cursor_child.
+ * \return Enum with error information. FAST_JSON_NO_DATA_ERROR if there
+ *         are no more elements.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_cursor_next (FAST_JSON_TYPE json,
+						     FAST_JSON_CURSOR_TYPE *
+						     cursor);
+
+/**
+ * \b Description
+ *
+ * Get the name of the object element at a cursor.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param cursor Cursor at an object element.
+ * \return Name or NULL if cursor is not at an object element. The name is
+ *         valid until the next call with json.
+ */
+  extern const char *fast_json_cursor_name (FAST_JSON_TYPE json,
+					    const FAST_JSON_CURSOR_TYPE *
+					    cursor);
+
+/**
+ * \b Description
+ *
+ * Find an object element by name. Elements before it are skipped.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param cursor Cursor at an object.
+ * \param name Name to find.
+ * \param child Returned cursor at the element.
+ * \return Enum with error information. FAST_JSON_NO_DATA_ERROR if the
+ *         name is not found.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_cursor_find (FAST_JSON_TYPE json,
+						     FAST_JSON_CURSOR_TYPE *
+						     cursor,
+						     const char *name,
+						     FAST_JSON_CURSOR_TYPE *
+						     child);
+
+/**
+ * \b Description
+ *
+ * Parse the value at a cursor. The result can be used with all other
+ * functions and must be freed with \ref fast_json_value_free.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param cursor Cursor.
+ * \return Parsed data or NULL in case of error.
+ */
+  extern FAST_JSON_DATA_TYPE fast_json_cursor_value (FAST_JSON_TYPE json,
+						     FAST_JSON_CURSOR_TYPE *
+						     cursor);
+
+/**
+ * \b Description
+ *
+ * Get the string at a cursor without creating a value.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param cursor Cursor at a string.
+ * \return String or NULL in case of error. The string is valid until the
+ *         next call with json.
+ */
+  extern const char *fast_json_cursor_get_string (FAST_JSON_TYPE json,
+						  FAST_JSON_CURSOR_TYPE *
+						  cursor);
+
+/**
+ * \b Description
+ *
+ * Start pull parsing of a string with the fast string parser. Get the
+ * tokens with \ref fast_json_next_token. The string must stay valid
+ * until the last token is read.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param json_str String to parse.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_token_string (FAST_JSON_TYPE json,
+						      const char *json_str);
+
+/**
+ * \b Description
+ *
+ * Start pull parsing of a file. Get the tokens with
+ * \ref fast_json_next_token.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param fp File pointer to parse.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_token_file (FAST_JSON_TYPE json,
+						    FILE * fp);
+
+/**
+ * \b Description
+ *
+ * Start pull parsing of a file descriptor. Get the tokens with
+ * \ref fast_json_next_token.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param fd File descriptor to parse.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_token_fd (FAST_JSON_TYPE json,
+						  int fd);
+
+/**
+ * \b Description
+ *
+ * Start pull parsing with a user get character function. Get the tokens
+ * with \ref fast_json_next_token.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param getc User get character function.
+ * \param getc_data User data for getc.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_token_user (FAST_JSON_TYPE json,
+						    fast_json_getc_func getc,
+						    void *getc_data);
+
+/**
+ * \b Description
+ *
+ * Get the next token. Only the open arrays and objects are kept, so the
+ * memory use does not depend on the size of the input. After the last
+ * value FAST_JSON_TOKEN_END is returned. With FAST_JSON_NO_EOF_CHECK the
+ * next call starts the next value and FAST_JSON_NO_DATA_ERROR is returned
+ * when there are no more values. Do not use json for other parse calls
+ * until the last token is read.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param token Returned token.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_next_token (FAST_JSON_TYPE json,
+						    FAST_JSON_TOKEN_TYPE *
+						    token);
+
+/**
+ * \b Description
+ *
+ * Skip the value after the last token. After a start array or start object
+ * token the rest of the array or object is skipped including its end token.
+ * After a name token the value of the name is skipped. Nothing is done
+ * after other tokens. Skipped values of a string are only checked for
+ * matching quotes and brackets.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \return Enum with error information.
+ */
+  extern FAST_JSON_ERROR_ENUM fast_json_skip_token (FAST_JSON_TYPE json);
+
+/**
+ * \b Description
+ *
+ * Parse a string with the fast string parser into a flat tape instead of
+ * values. The tape is one array of 64 bit entries and one buffer with all
+ * strings and names, so it needs a few large allocations and much less
+ * memory than values. Arrays and objects know where they end so they are
+ * skipped in one step. Values are read with the fast_json_tape functions
+ * and are given by their position in the tape. The root value is at
+ * position 0. Duplicate object names are not checked.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param json_str String to parse.
+ * \return Tape or NULL in case of error.
+ */
+  extern FAST_JSON_TAPE_TYPE fast_json_parse_tape (FAST_JSON_TYPE json,
+						   const char *json_str);
+
+/**
+ * \b Description
+ *
+ * Free a tape from \ref fast_json_parse_tape.
+ *
+ * \param json Json object from \ref fast_json_create.
+ * \param tape Tape to free.
+ */
+  extern void fast_json_free_tape (FAST_JSON_TYPE json,
+				   FAST_JSON_TAPE_TYPE tape);
+
+/**
+ * \b Description
+ *
+ * Get the type of a tape value.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the value.
+ * \return Json type or FAST_JSON_NULL if pos is FAST_JSON_TAPE_NONE.
+ */
+  extern FAST_JSON_VALUE_TYPE fast_json_tape_get_type (FAST_JSON_TAPE_TYPE
+						       tape, size_t pos);
+
+/**
+ * \b Description
+ *
+ * Get the next element of the array or object that holds the tape value
+ * at pos. Together with \ref fast_json_tape_get_array_data or
+ * \ref fast_json_tape_get_object_data for index 0 this walks all
+ * elements in order.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of an element.
+ * \param name Returns the name of the next element of an object or NULL.
+ *             Can be NULL.
+ * \return Position of the next element or FAST_JSON_TAPE_NONE after the
+ *         last element.
+ */
+  extern size_t fast_json_tape_next (FAST_JSON_TAPE_TYPE tape, size_t pos,
+				     const char **name);
+
+/**
+ * \b Description
+ *
+ * Get the number of elements of a tape array.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the array.
+ * \return Size of array or 0 if pos is not an array.
+ */
+  extern size_t fast_json_tape_get_array_size (FAST_JSON_TAPE_TYPE tape,
+					       size_t pos);
+
+/**
+ * \b Description
+ *
+ * Get an element of a tape array. Elements before index are skipped one
+ * step each.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the array.
+ * \param index Index in the array.
+ * \return Position of the element or FAST_JSON_TAPE_NONE.
+ */
+  extern size_t fast_json_tape_get_array_data (FAST_JSON_TAPE_TYPE tape,
+					       size_t pos, size_t index);
+
+/**
+ * \b Description
+ *
+ * Get the number of members of a tape object.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the object.
+ * \return Size of object or 0 if pos is not an object.
+ */
+  extern size_t fast_json_tape_get_object_size (FAST_JSON_TAPE_TYPE tape,
+						size_t pos);
+
+/**
+ * \b Description
+ *
+ * Get the name of a member of a tape object.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the object.
+ * \param index Index in the object.
+ * \return Name or NULL.
+ */
+  extern const char *fast_json_tape_get_object_name (FAST_JSON_TAPE_TYPE
+						     tape, size_t pos,
+						     size_t index);
+
+/**
+ * \b Description
+ *
+ * Get the value of a member of a tape object.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the object.
+ * \param index Index in the object.
+ * \return Position of the value or FAST_JSON_TAPE_NONE.
+ */
+  extern size_t fast_json_tape_get_object_data (FAST_JSON_TAPE_TYPE tape,
+						size_t pos, size_t index);
+
+/**
+ * \b Description
+ *
+ * Find a member of a tape object by name. There is no hash table so the
+ * names are compared in order.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the object.
+ * \param name Name to find.
+ * \return Position of the value or FAST_JSON_TAPE_NONE.
+ */
+  extern size_t fast_json_tape_get_object_by_name (FAST_JSON_TAPE_TYPE tape,
+						   size_t pos,
+						   const char *name);
+
+/**
+ * \b Description
+ *
+ * Get the integer value of a tape value.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the value.
+ * \return Integer value or 0 if pos is not an integer.
+ */
+  extern fast_json_int_64 fast_json_tape_get_integer (FAST_JSON_TAPE_TYPE
+						      tape, size_t pos);
+
+/**
+ * \b Description
+ *
+ * Get the double value of a tape value.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the value.
+ * \return Double value or 0.0 if pos is not a double.
+ */
+  extern double fast_json_tape_get_double (FAST_JSON_TAPE_TYPE tape,
+					   size_t pos);
+
+/**
+ * \b Description
+ *
+ * Get the string value of a tape value. The string is valid until the
+ * tape is freed.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the value.
+ * \return String value or NULL if pos is not a string.
+ */
+  extern const char *fast_json_tape_get_string (FAST_JSON_TAPE_TYPE tape,
+						size_t pos);
+
+/**
+ * \b Description
+ *
+ * Get the length of the string value of a tape value.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the value.
+ * \return Length of the string or 0 if pos is not a string.
+ */
+  extern size_t fast_json_tape_get_string_len (FAST_JSON_TAPE_TYPE tape,
+					       size_t pos);
+
+/**
+ * \b Description
+ *
+ * Get the boolean value of a tape value.
+ *
+ * \param tape Tape from \ref fast_json_parse_tape.
+ * \param pos Position of the value.
+ * \return Boolean value or 0 if pos is not a boolean.
+ */
+  extern unsigned int fast_json_tape_get_boolean (FAST_JSON_TAPE_TYPE tape,
+						  size_t pos);
+
 /**
  * \b Description
  *
@@ -463,7 +1330,8 @@ extern "C"
  *
  * \param value1 Json data1 to compare.
  * \param value2 Json data 2 to compare.
- * \return 1 if equal. 0 if not equal.
+ * \return 1 if equal. 0 if not equal or if there is no memory to compare
+ *         deeply nested values.
  */
   extern int fast_json_value_equal (FAST_JSON_DATA_TYPE value1,
 				    FAST_JSON_DATA_TYPE value2);
@@ -938,6 +1806,8 @@ extern "C"
  * \b Description
  *
  * Get json object name at index.
+ * Short names are stored in the object. The name is valid until the
+ * object is changed.
  *
  * \param data Json object data type.
  * \param index Index in object.
@@ -945,6 +1815,19 @@ extern "C"
  */
   extern char *fast_json_get_object_name (FAST_JSON_DATA_TYPE data,
 					  size_t index);
+
+/**
+ * \b Description
+ *
+ * Get the length of the json object name at index without scanning it.
+ *
+ * \param data Json object data type.
+ * \param index Index in object.
+ * \return Length of the name at index or 0 if there is no name.
+ */
+  extern size_t fast_json_get_object_name_len (FAST_JSON_DATA_TYPE data,
+					       size_t index);
+
 /**
  * \b Description
  *
@@ -999,6 +1882,16 @@ extern "C"
  */
   extern char *fast_json_get_string (FAST_JSON_DATA_TYPE data);
 
+/**
+ * \b Description
+ *
+ * Get the length of a json string without scanning it.
+ *
+ * \param data Json string data type.
+ * \return Length of the string value or 0 if data is not a string.
+ */
+  extern size_t fast_json_get_string_len (FAST_JSON_DATA_TYPE data);
+
 /**
  * \b Description
  *
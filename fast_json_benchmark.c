@@ -144,28 +144,23 @@ sender (void *data)
 }
 
 #ifdef WIN
-static int u_pos = 0;
-static int u_len = 0;
 static char u_buffer[BUFSIZ];
 
-static int
-user_getc (void *user_data)
+static const char *
+user_block (void *user_data, size_t *len)
 {
-  if (u_pos >= u_len) {
-    int len;
-    int fd = *(int *) user_data;
+  int n;
+  int fd = *(int *) user_data;
 
-    do {
-      len = recv (fd, u_buffer, sizeof (u_buffer), 0);
-    } while (len < 0 && GetLastError() == WSAEWOULDBLOCK);
+  do {
+    n = recv (fd, u_buffer, sizeof (u_buffer), 0);
+  } while (n < 0 && GetLastError() == WSAEWOULDBLOCK);
 
-    if (len <= 0) {
-      return -1;
-    }
-    u_len = len;
-    u_pos = 0;
+  if (n <= 0) {
+    return NULL;
   }
-  return u_buffer[u_pos++] & 0xFFu;
+  *len = n;
+  return u_buffer;
 }
 #endif
 
@@ -189,7 +184,7 @@ receiver (void *data)
 #ifndef WIN
       n = fast_json_parse_fd (json, sockets[1]);
 #else
-      n = fast_json_parse_user (json, user_getc, &sockets[1]);
+      n = fast_json_parse_block (json, user_block, &sockets[1]);
 #endif
     }
     else {
@@ -360,6 +355,8 @@ main (int argc, char **argv)
   unsigned int print = 0;
   unsigned int print_help = 0;
   char *name = NULL;
+  uint64_t value_size;
+  uint64_t value_n_malloc;
 
   for (i = 1; i < argc; i++) {
     if (strncmp (argv[i], "--count=", strlen ("--count=")) == 0) {
@@ -386,6 +383,9 @@ main (int argc, char **argv)
     else if (strcmp (argv[i], "--big") == 0) {
       options |= FAST_JSON_BIG_ALLOC;
     }
+    else if (strcmp (argv[i], "--arena") == 0) {
+      options |= FAST_JSON_ARENA;
+    }
     else if (strcmp (argv[i], "--no_duplicate") == 0) {
       options |= FAST_JSON_NO_DUPLICATE_CHECK;
     }
@@ -429,6 +429,7 @@ main (int argc, char **argv)
     printf ("--hex:            Allow oct and hex numbers\n");
     printf ("--infnan:         Allow inf and nan\n");
     printf ("--big:            Use big allocs\n");
+    printf ("--arena:          Use an arena for values\n");
     printf ("--no_duplicate:   Do not check duplicate object names\n");
     printf ("--no_comment:     Do not allow comments\n");
     printf ("--allow_json5:    Allow json5\n");
@@ -457,6 +458,8 @@ main (int argc, char **argv)
   }
   fast_json_max_reuse (json, reuse);
   fast_json_options (json, options);
+  value_size = malloc_size;
+  value_n_malloc = malloc_n_malloc;
 
   if (name) {
     o = fast_json_parse_file_name (json, name);
@@ -523,6 +526,10 @@ main (int argc, char **argv)
     fast_json_add_object (json, o, "string", a);
   }
 
+  /* Memory of the values and the parser buffers */
+  value_size = malloc_size - value_size;
+  value_n_malloc = malloc_n_malloc - value_n_malloc;
+
   if (print) {
     s = fast_json_print_string (json, o, print_nice);
     fast_json_value_free (json, o);
@@ -582,6 +589,9 @@ main (int argc, char **argv)
 	break;
       }
       fast_json_value_free (json, o);
+      if (options & FAST_JSON_ARENA) {
+	fast_json_arena_free (json);
+      }
     }
     if (stream_time) {
       o = fast_json_parse_string2 (json, s);
@@ -653,6 +663,8 @@ main (int argc, char **argv)
 	     ", Free %" PRId64 "\n",
 	     malloc_size, malloc_max_size,
 	     malloc_n_malloc, malloc_n_realloc, malloc_n_free);
+    fprintf (stderr, "Value usage: %" PRId64 ", Value malloc %" PRId64 "\n",
+	     value_size, value_n_malloc);
   }
 
   return 0;
@@ -15,9 +15,6 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <locale.h>
-#if USE_FAST_CONVERT
-#include "fast_convert.h"
-#endif
 #include "fast_json.h"
 
 #define	TEST1_FILE	"test1.json"
@@ -142,6 +139,27 @@ user_getc (void *user_data)
   return data->str[data->pos++] & 0xFFu;
 }
 
+typedef struct
+{
+  size_t pos;
+  size_t size;
+  const char *str;
+} block_user_data;
+
+static const char *
+user_block (void *user_data, size_t *len)
+{
+  block_user_data *data = (block_user_data *) user_data;
+  const char *str = data->str + data->pos;
+
+  *len = strlen (str);
+  if (*len > data->size) {
+    *len = data->size;
+  }
+  data->pos += *len;
+  return *len ? str : NULL;
+}
+
 typedef struct
 {
   size_t size;
@@ -162,6 +180,154 @@ user_puts (void *user_data, const char *str, unsigned int len)
   return 0;
 }
 
+static int
+event_add (void *user_data, const char *str)
+{
+  strcat ((char *) user_data, str);
+  strcat ((char *) user_data, " ");
+  return strlen ((char *) user_data) > 900;
+}
+
+static int
+event_start_object (void *user_data)
+{
+  return event_add (user_data, "{");
+}
+
+static int
+event_end_object (void *user_data)
+{
+  return event_add (user_data, "}");
+}
+
+static int
+event_start_array (void *user_data)
+{
+  return event_add (user_data, "[");
+}
+
+static int
+event_end_array (void *user_data)
+{
+  return event_add (user_data, "]");
+}
+
+static int
+event_key (void *user_data, const char *name, size_t len)
+{
+  strcat ((char *) user_data, name);
+  return event_add (user_data, len == strlen (name) ? ":" : "?");
+}
+
+static int
+event_string (void *user_data, const char *str, size_t len)
+{
+  strcat ((char *) user_data, "'");
+  strcat ((char *) user_data, str);
+  return event_add (user_data, len == strlen (str) ? "'" : "?");
+}
+
+static int
+event_integer (void *user_data, fast_json_int_64 value)
+{
+  char str[100];
+
+  snprintf (str, sizeof (str), "%" FAST_JSON_FMT_INT, value);
+  return event_add (user_data, str);
+}
+
+static int
+event_double (void *user_data, double value)
+{
+  char str[100];
+
+  snprintf (str, sizeof (str), "%g", value);
+  return event_add (user_data, str);
+}
+
+static int
+event_boolean (void *user_data, unsigned int value)
+{
+  return event_add (user_data, value ? "true" : "false");
+}
+
+static int
+event_null (void *user_data)
+{
+  return event_add (user_data, "null");
+}
+
+static const FAST_JSON_EVENTS_TYPE events = {
+  event_start_object, event_end_object, event_start_array, event_end_array,
+  event_key, event_string, event_integer, event_double, event_boolean,
+  event_null
+};
+
+/* Pull the tokens until the end of the value and write them like the
+ * event callbacks. depth is the depth of the first token.
+ */
+static FAST_JSON_ERROR_ENUM
+token_events (FAST_JSON_TYPE json, char *result, size_t depth)
+{
+  FAST_JSON_TOKEN_TYPE token;
+  FAST_JSON_ERROR_ENUM e;
+
+  while ((e = fast_json_next_token (json, &token)) == FAST_JSON_OK &&
+	 token.type != FAST_JSON_TOKEN_END) {
+    if (token.type == FAST_JSON_TOKEN_END_OBJECT ||
+	token.type == FAST_JSON_TOKEN_END_ARRAY) {
+      depth--;
+    }
+    if (token.depth != depth) {
+      event_add (result, "?");
+    }
+    switch (token.type) {
+    case FAST_JSON_TOKEN_START_OBJECT:
+      event_start_object (result);
+      depth++;
+      break;
+    case FAST_JSON_TOKEN_END_OBJECT:
+      event_end_object (result);
+      break;
+    case FAST_JSON_TOKEN_START_ARRAY:
+      event_start_array (result);
+      depth++;
+      break;
+    case FAST_JSON_TOKEN_END_ARRAY:
+      event_end_array (result);
+      break;
+    case FAST_JSON_TOKEN_NAME:
+      event_key (result, token.str, token.len);
+      break;
+    case FAST_JSON_TOKEN_STRING:
+      event_string (result, token.str, token.len);
+      break;
+    case FAST_JSON_TOKEN_INTEGER:
+      event_integer (result, token.u.int_value);
+      break;
+    case FAST_JSON_TOKEN_DOUBLE:
+      event_double (result, token.u.double_value);
+      break;
+    case FAST_JSON_TOKEN_BOOLEAN:
+      event_boolean (result, token.u.boolean_value);
+      break;
+    default:
+      event_null (result);
+      break;
+    }
+  }
+  return e;
+}
+
+/* The threads of fast_json_parse_ndjson and fast_json_parse_parallel call
+ * the memory functions at the same time.
+ */
+#if defined(__GNUC__)
+#define	COUNT_ADD(v, n)	__sync_add_and_fetch (&(v), (n))
+#else
+#define	COUNT_ADD(v, n)	((v) += (n))
+#endif
+
 static uint64_t malloc_n_malloc = 0;
 static uint64_t malloc_n_free = 0;
 static uint64_t malloc_n_realloc = 0;
@@ -173,11 +339,12 @@ my_malloc (size_t size)
 {
   void *ptr = malloc (size + 8);
 
-  malloc_n_malloc++;
+  COUNT_ADD (malloc_n_malloc, 1);
   if (ptr) {
-    malloc_size += size;
-    if (malloc_size > malloc_max_size) {
-      malloc_max_size = malloc_size;
+    uint64_t cur = COUNT_ADD (malloc_size, size);
+
+    if (cur > malloc_max_size) {
+      malloc_max_size = cur;
     }
     *((size_t *) ptr) = size;
     return (char *) ptr + 8;
@@ -190,22 +357,23 @@ my_realloc (void *ptr, size_t new_size)
 {
   void *new_ptr;
 
-  malloc_n_realloc++;
+  COUNT_ADD (malloc_n_realloc, 1);
   if (ptr) {
     size_t size;
 
     ptr = (void *) ((char *) ptr - 8);
     size = *((size_t *) ptr);
-    malloc_size -= size;
+    COUNT_ADD (malloc_size, -(uint64_t) size);
     new_ptr = realloc (ptr, new_size + 8);
   }
   else {
     new_ptr = malloc (new_size + 8);
   }
   if (new_ptr) {
-    malloc_size += new_size;
-    if (malloc_size > malloc_max_size) {
-      malloc_max_size = malloc_size;
+    uint64_t cur = COUNT_ADD (malloc_size, new_size);
+
+    if (cur > malloc_max_size) {
+      malloc_max_size = cur;
     }
     *((size_t *) new_ptr) = new_size;
     return (char *) new_ptr + 8;
@@ -216,14 +384,14 @@ my_realloc (void *ptr, size_t new_size)
 static void
 my_free (void *ptr)
 {
-  malloc_n_free++;
+  COUNT_ADD (malloc_n_free, 1);
   if (ptr) {
     size_t size;
     volatile char *p;
 
     ptr = (void *) ((char *) ptr - 8);
     size = *((size_t *) ptr);
-    malloc_size -= size;
+    COUNT_ADD (malloc_size, -(uint64_t) size);
     p = (volatile char *) ptr;
     while (size--) {
       *p++ = 0;
@@ -333,6 +501,9 @@ main (void)
   tst_error (fast_json_error_str (FAST_JSON_PARSE_ERROR), "Parse error");
   tst_error (fast_json_error_str (FAST_JSON_NO_DATA_ERROR), "No data error");
   tst_error (fast_json_error_str (FAST_JSON_LOOP_ERROR), "Loop error");
+  tst_error (fast_json_error_str (FAST_JSON_DEPTH_ERROR), "Depth error");
+  tst_error (fast_json_error_str (FAST_JSON_USER_ERROR), "User error");
+  tst_error (fast_json_error_str (FAST_JSON_NEED_MORE_DATA), "Need more data");
   tst_error (fast_json_error_str (FAST_JSON_INDEX_ERROR), "Index error");
   if (fast_json_error_str ((FAST_JSON_ERROR_ENUM) - 1) != NULL) {
     fprintf (stderr, "Unexpected error\n");
@@ -1339,6 +1510,115 @@ main (void)
     exit (1);
   }
 
+  /* Integer limits */
+  for (j = 0; j < 2; j++) {
+    static const char *limits =
+      "[ 9223372036854775807, -9223372036854775808, 9223372036854775808,"
+      " -9223372036854775809, 123456789012345678901, -0,"
+      " 0x7fffffffffffffff, -0x8000000000000000, 0x10000000000000000,"
+      " 0777, 0777777777777777777777, 01000000000000000000000 ]";
+
+    v = j ? fast_json_parse_string2 (json, limits) :
+      fast_json_parse_string (json, limits);
+    if (v == NULL ||
+	fast_json_get_integer (fast_json_get_array_data (v, 0)) !=
+	(fast_json_int_64) INT64_MAX ||
+	fast_json_get_integer (fast_json_get_array_data (v, 1)) !=
+	(fast_json_int_64) INT64_MIN ||
+	fast_json_get_type (fast_json_get_array_data (v, 2)) !=
+	FAST_JSON_DOUBLE ||
+	fast_json_get_type (fast_json_get_array_data (v, 3)) !=
+	FAST_JSON_DOUBLE ||
+	fast_json_get_type (fast_json_get_array_data (v, 4)) !=
+	FAST_JSON_DOUBLE ||
+	fast_json_get_integer (fast_json_get_array_data (v, 5)) != 0 ||
+	fast_json_get_integer (fast_json_get_array_data (v, 6)) !=
+	(fast_json_int_64) INT64_MAX ||
+	fast_json_get_integer (fast_json_get_array_data (v, 7)) !=
+	(fast_json_int_64) INT64_MIN ||
+	fast_json_get_type (fast_json_get_array_data (v, 8)) !=
+	FAST_JSON_DOUBLE ||
+	fast_json_get_integer (fast_json_get_array_data (v, 9)) != 0777 ||
+	fast_json_get_integer (fast_json_get_array_data (v, 10)) !=
+	(fast_json_int_64) INT64_MAX ||
+	fast_json_get_type (fast_json_get_array_data (v, 11)) !=
+	FAST_JSON_DOUBLE) {
+      fprintf (stderr, "Integer limits failed\n");
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+  }
+
+  /* Correctly rounded doubles */
+  for (j = 0; j < 2; j++) {
+    static const char *doubles =
+      "[ 1.7976931348623157e308, 2.2250738585072014e-308, 0.1,"
+      " 9007199254740993.0, 1.00000000000000011102230246251565404236316680908203125,"
+      " 1.00000000000000011102230246251565404236316680908203125001,"
+      " 7.2057594037927933e16, 0x1.8p-3 ]";
+    static const double expected[] = {
+      1.7976931348623157e308, 2.2250738585072014e-308, 0.1,
+      9007199254740992.0, 1.0, 1.0000000000000002,
+      72057594037927936.0, 0.1875
+    };
+
+    v = j ? fast_json_parse_string2 (json, doubles) :
+      fast_json_parse_string (json, doubles);
+    for (i = 0; i < sizeof (expected) / sizeof (expected[0]); i++) {
+      if (v == NULL ||
+	  fast_json_get_double (fast_json_get_array_data (v, i)) !=
+	  expected[i]) {
+	fprintf (stderr, "Double %u failed\n", i);
+	exit (1);
+      }
+    }
+    fast_json_value_free (json, v);
+    for (i = 0; i < 3; i++) {
+      static const char *range[] = { "1e309", "-1.8e308", "1e-310" };
+
+      if ((j ? fast_json_parse_string2 (json, range[i]) :
+	   fast_json_parse_string (json, range[i])) != NULL ||
+	  fast_json_parser_error (json) != FAST_JSON_NUMBER_ERROR) {
+	fprintf (stderr, "Number error expected for %s\n", range[i]);
+	exit (1);
+      }
+    }
+  }
+
+  /* Integer printing */
+  v = fast_json_parse_string (json, "[ 9223372036854775807, "
+			      "-9223372036854775808, 0, -1, 9, 10, 99, 100, "
+			      "-1000000000000000000 ]");
+  cp = fast_json_print_string (json, v, 0);
+  if (cp == NULL ||
+      strcmp (cp, "[9223372036854775807,-9223372036854775808,0,-1,9,10,"
+	      "99,100,-1000000000000000000]") != 0) {
+    fprintf (stderr, "Unexpected value %s\n", cp ? cp : "");
+    exit (1);
+  }
+  fast_json_release_print_value (json, cp);
+  fast_json_value_free (json, v);
+
+  /* Shortest double printing */
+  {
+    static const double numbers[] = {
+      0.1, 1e21, 1.7976931348623157e308, -0.0, 100.0, 1.5e-7,
+      4.9406564584124654e-324, 0.1 + 0.2
+    };
+
+    v = fast_json_create_double_array (json, numbers,
+				       sizeof (numbers) / sizeof (numbers[0]));
+  }
+  cp = fast_json_print_string (json, v, 0);
+  if (cp == NULL ||
+      strcmp (cp, "[0.1,1e+21,1.7976931348623157e+308,-0.0,100.0,1.5e-07,"
+	      "5e-324,0.30000000000000004]") != 0) {
+    fprintf (stderr, "Unexpected value %s\n", cp ? cp : "");
+    exit (1);
+  }
+  fast_json_release_print_value (json, cp);
+  fast_json_value_free (json, v);
+
   fast_json_options (json, FAST_JSON_INF_NAN);
   e = fast_json_calc_crc_string (json, "{\"name\": \"abc\"}", &i);
   if (e != FAST_JSON_OK || i != 0x22721824) {
@@ -1458,6 +1738,19 @@ main (void)
   fast_json_value_free (json, n);
   close (fd);
 
+  {
+    FAST_JSON_EVENTS_TYPE no_events;
+
+    memset (&no_events, 0, sizeof (no_events));
+    fd = open (TEST1_FILE, O_RDONLY);
+    if (fast_json_parse_events_fd (json, &no_events, NULL, fd) !=
+	FAST_JSON_OK) {
+      fprintf (stderr, "Event fd parser failed\n");
+      exit (1);
+    }
+    close (fd);
+  }
+
   fast_json_calc_crc_string (json, cp, &i);
 
   fast_json_calc_crc_string_len (json, cp, strlen (cp), &j);
@@ -1501,6 +1794,29 @@ main (void)
 
   fast_json_value_free (json, v);
 
+  /* File that ends exactly at a page boundary */
+  fp = fopen ("/tmp/file4.json", "w");
+  fputc ('"', fp);
+  for (i = 0; i < 4094; i++) {
+    fputc ('a' + i % 26, fp);
+  }
+  fputc ('"', fp);
+  fclose (fp);
+  v = fast_json_parse_file_name (json, "/tmp/file4.json");
+  if (v == NULL || strlen (fast_json_get_string (v)) != 4094) {
+    fprintf (stderr, "Page size file failed\n");
+    exit (1);
+  }
+  fast_json_value_free (json, v);
+  fp = fopen ("/tmp/file4.json", "a");
+  fputc (',', fp);
+  fclose (fp);
+  if (fast_json_parse_file_name (json, "/tmp/file4.json") != NULL ||
+      fast_json_parser_error (json) != FAST_JSON_OBJECT_END_ERROR) {
+    fprintf (stderr, "Page size file error failed\n");
+    exit (1);
+  }
+
   fast_json_options (json, FAST_JSON_NO_EOF_CHECK);
   fp = fopen (TEST2_FILE, "r");
   n = fast_json_parse_file (json, fp);
@@ -1655,6 +1971,33 @@ main (void)
     exit (1);
   }
 
+  /* Long utf8 strings with an error at every position */
+  for (i = 0; i < 60; i++) {
+    static const char *bad_utf8[] =
+      { "\300\200", "\340\200\200", "\355\240\200", "\364\220\200\200",
+      "\377", "\344\270\"", "\370\210\200\200\200"
+    };
+
+    strcpy (str, "\"");
+    for (j = 0; j < 20; j++) {
+      strcat (str, j % 3 ? "\344\270\255" : "\303\251x");
+    }
+    strcat (str, "\"");
+    n = fast_json_parse_string2 (json, str);
+    if (n == NULL || strlen (fast_json_get_string (n)) != strlen (str) - 2 ||
+	memcmp (fast_json_get_string (n), str + 1, strlen (str) - 2) != 0) {
+      fprintf (stderr, "utf8 long string failed\n");
+      exit (1);
+    }
+    fast_json_value_free (json, n);
+    memcpy (str + 1 + i, bad_utf8[i % 7], strlen (bad_utf8[i % 7]));
+    if (fast_json_parse_string2 (json, str) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_UTF8_ERROR) {
+      fprintf (stderr, "utf8 long string error expected: %u\n", i);
+      exit (1);
+    }
+  }
+
   strcpy (str, "\"\\uD834\\pDB1E\"");
   fast_json_parse_string (json, str);
   if (fast_json_parser_error (json) != FAST_JSON_UNICODE_ERROR) {
@@ -1728,6 +2071,224 @@ main (void)
   free (puts_data.str);
   fast_json_value_free (json, v);
 
+  /* Event parser */
+  {
+    static const char *event_json =
+      "{\"a\": [1, -2.5, \"x\\u0041\", true, false, null], \"b\": {},"
+      " \"c\": [[]]}";
+    static const char *event_result =
+      "{ a: [ 1 -2.5 'xA' true false null ] b: { } c: [ [ ] ] } ";
+    getc_user_data event_data = { 0, NULL };
+    char result[1000];
+
+    event_data.str = event_json;
+    result[0] = '\0';
+    e = fast_json_parse_events_string (json, &events, result, event_json);
+    if (e != FAST_JSON_OK || strcmp (result, event_result) != 0) {
+      fprintf (stderr, "Event parser failed: %s\n", result);
+      exit (1);
+    }
+    result[0] = '\0';
+    e = fast_json_parse_events_user (json, &events, result, user_getc,
+				     &event_data);
+    if (e != FAST_JSON_OK || strcmp (result, event_result) != 0) {
+      fprintf (stderr, "Event user parser failed: %s\n", result);
+      exit (1);
+    }
+    result[0] = '\0';
+    e = fast_json_parse_events_string (json, &events, result, "[1, 2}");
+    if (e != FAST_JSON_ARRAY_END_ERROR || strcmp (result, "[ 1 2 ") != 0) {
+      fprintf (stderr, "Event parser error failed: %s\n", result);
+      exit (1);
+    }
+    memset (result, 'x', 900);
+    result[900] = '\0';
+    e = fast_json_parse_events_string (json, &events, result, "[1, 2]");
+    if (e != FAST_JSON_USER_ERROR) {
+      fprintf (stderr, "Event parser stop failed\n");
+      exit (1);
+    }
+  }
+
+  /* Pull tokenizer */
+  {
+    static const char *token_json =
+      "{\"a\": [1, -2.5, \"x\\u0041\", true, false, null], \"b\": {},"
+      " \"c\": [[]]}";
+    static const char *token_result =
+      "{ a: [ 1 -2.5 'xA' true false null ] b: { } c: [ [ ] ] } ";
+    getc_user_data token_data = { 0, NULL };
+    FAST_JSON_TOKEN_TYPE token;
+    char result[1000];
+
+    token_data.str = token_json;
+    result[0] = '\0';
+    fast_json_token_string (json, token_json);
+    e = token_events (json, result, 0);
+    if (e != FAST_JSON_OK || strcmp (result, token_result) != 0) {
+      fprintf (stderr, "Tokenizer failed: %s\n", result);
+      exit (1);
+    }
+    result[0] = '\0';
+    fast_json_token_user (json, user_getc, &token_data);
+    e = token_events (json, result, 0);
+    if (e != FAST_JSON_OK || strcmp (result, token_result) != 0) {
+      fprintf (stderr, "Tokenizer user failed: %s\n", result);
+      exit (1);
+    }
+    for (i = 0; i < 2; i++) {
+      static const char *skip_json =
+	"{\"a\": [1, {\"x\": \"]\"}], \"b\": [2, [3]], \"c\": 4}";
+
+      token_data.str = skip_json;
+      token_data.pos = 0;
+      if (i == 0) {
+	fast_json_token_string (json, skip_json);
+      }
+      else {
+	fast_json_token_user (json, user_getc, &token_data);
+      }
+      result[0] = '\0';
+      if (fast_json_next_token (json, &token) != FAST_JSON_OK ||
+	  fast_json_next_token (json, &token) != FAST_JSON_OK ||
+	  fast_json_skip_token (json) != FAST_JSON_OK ||
+	  fast_json_next_token (json, &token) != FAST_JSON_OK ||
+	  fast_json_next_token (json, &token) != FAST_JSON_OK ||
+	  token.type != FAST_JSON_TOKEN_START_ARRAY ||
+	  fast_json_next_token (json, &token) != FAST_JSON_OK ||
+	  fast_json_next_token (json, &token) != FAST_JSON_OK ||
+	  fast_json_skip_token (json) != FAST_JSON_OK ||
+	  token_events (json, result, 2) != FAST_JSON_OK ||
+	  strcmp (result, "] c: 4 } ") != 0) {
+	fprintf (stderr, "Tokenizer skip failed: %s\n", result);
+	exit (1);
+      }
+    }
+    fast_json_options (json, FAST_JSON_NO_EOF_CHECK);
+    result[0] = '\0';
+    fast_json_token_string (json, "[1] \"a\" {}");
+    e = token_events (json, result, 0);
+    e = e == FAST_JSON_OK ? token_events (json, result, 0) : e;
+    e = e == FAST_JSON_OK ? token_events (json, result, 0) : e;
+    if (e != FAST_JSON_OK || strcmp (result, "[ 1 ] 'a' { } ") != 0 ||
+	token_events (json, result, 0) != FAST_JSON_NO_DATA_ERROR) {
+      fprintf (stderr, "Tokenizer next value failed: %s\n", result);
+      exit (1);
+    }
+    fast_json_options (json, 0);
+    result[0] = '\0';
+    fast_json_token_string (json, "[1, 2}");
+    if (token_events (json, result, 0) != FAST_JSON_ARRAY_END_ERROR ||
+	strcmp (result, "[ 1 2 ") != 0) {
+      fprintf (stderr, "Tokenizer error failed: %s\n", result);
+      exit (1);
+    }
+  }
+
+  /* Truncated input on a new json object (the save buffer is not yet
+   * allocated)
+   */
+  {
+    static const char *truncated[] = { "[", "[[", "{\"a\":[", "{", "{a" };
+    static const FAST_JSON_ERROR_ENUM truncated_error[2][5] = {
+      {FAST_JSON_VALUE_ERROR, FAST_JSON_VALUE_ERROR, FAST_JSON_VALUE_ERROR,
+       FAST_JSON_STRING_START_ERROR, FAST_JSON_STRING_START_ERROR},
+      {FAST_JSON_VALUE_ERROR, FAST_JSON_VALUE_ERROR, FAST_JSON_VALUE_ERROR,
+       FAST_JSON_OBJECT_SEPERATOR_ERROR, FAST_JSON_OBJECT_SEPERATOR_ERROR}
+    };
+    FAST_JSON_EVENTS_TYPE no_events;
+    FAST_JSON_TOKEN_TYPE token;
+    unsigned int k;
+
+    memset (&no_events, 0, sizeof (no_events));
+    for (i = 0; i < 2; i++) {
+      for (k = 0; k < 5; k++) {
+	FAST_JSON_ERROR_ENUM expected = truncated_error[i][k];
+	getc_user_data token_data = { 0, NULL };
+	FAST_JSON_TYPE tj;
+
+	token_data.str = truncated[k];
+	for (j = 0; j < 3; j++) {
+	  tj = fast_json_create (my_malloc, my_realloc, my_free);
+	  fast_json_options (tj, i ? FAST_JSON_ALLOW_JSON5 : 0);
+	  if (j == 0) {
+	    e = fast_json_parse_string (tj, truncated[k]) == NULL ?
+	      fast_json_parser_error (tj) : FAST_JSON_OK;
+	  }
+	  else if (j == 1) {
+	    e = fast_json_parse_events_string (tj, &no_events, NULL,
+					       truncated[k]);
+	  }
+	  else {
+	    token_data.pos = 0;
+	    e = fast_json_token_user (tj, user_getc, &token_data);
+	    while (e == FAST_JSON_OK &&
+		   (e = fast_json_next_token (tj, &token)) == FAST_JSON_OK &&
+		   token.type != FAST_JSON_TOKEN_END) {
+	    }
+	  }
+	  fast_json_free (tj);
+	  if (e != expected) {
+	    fprintf (stderr, "Truncated input failed: %s %u %u %s\n",
+		     truncated[k], i, j, fast_json_error_str (e));
+	    exit (1);
+	  }
+	}
+      }
+    }
+  }
+
+  /* Values and tokens that cross block boundaries */
+  for (j = 1; j < 6; j++) {
+    block_user_data block_data = { 0, 0, NULL };
+    static const char *block_values[] =
+      { "[ \"a\\\"b\", /* ] */ {\"c\" : [1, 2.5e3]} // }\n ]",
+      "\"x\\\\\"", "42", "true"
+    };
+    FAST_JSON_DATA_TYPE block_read[4];
+
+    block_data.size = j;
+    block_data.str = "[ \"a\\\"b\", /* ] */ {\"c\" : [1, 2.5e3]} // }\n ]"
+      "\"x\\\\\"42\ntrue";
+    fast_json_options (json, FAST_JSON_NO_EOF_CHECK);
+    for (i = 0; i < 4; i++) {
+      block_read[i] = i ? fast_json_parse_next (json) :
+	fast_json_parse_block (json, user_block, &block_data);
+    }
+    if (fast_json_parse_next (json) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_NO_DATA_ERROR) {
+      fprintf (stderr, "Block read end failed: %u\n", j);
+      exit (1);
+    }
+    for (i = 0; i < 4; i++) {
+      n = fast_json_parse_string2 (json, block_values[i]);
+      if (block_read[i] == NULL ||
+	  fast_json_value_equal (block_read[i], n) == 0) {
+	fprintf (stderr, "Block read failed: %u %u\n", i, j);
+	exit (1);
+      }
+      fast_json_value_free (json, block_read[i]);
+      fast_json_value_free (json, n);
+    }
+    fast_json_options (json, 0);
+    block_data.pos = 0;
+    if (fast_json_parse_block (json, user_block, &block_data) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_OBJECT_END_ERROR) {
+      fprintf (stderr, "Block read eof check failed: %u\n", j);
+      exit (1);
+    }
+    block_data.pos = 0;
+    block_data.str = block_values[0];
+    v = fast_json_parse_block (json, user_block, &block_data);
+    n = fast_json_parse_string (json, block_values[0]);
+    if (v == NULL || fast_json_value_equal (v, n) == 0) {
+      fprintf (stderr, "Block read single value failed: %u\n", j);
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    fast_json_value_free (json, n);
+  }
+
   j = 10000;
   cp = (char *) malloc (j * 10);
   np = cp;
@@ -1769,8 +2330,513 @@ main (void)
     exit (1);
   }
   fast_json_value_free (json, n);
+
+  /* Nesting depth is j + 1 */
+  fast_json_max_depth (json, j);
+  if (fast_json_parse_string (json, cp) != NULL ||
+      fast_json_parser_error (json) != FAST_JSON_DEPTH_ERROR ||
+      fast_json_parse_string2 (json, cp) != NULL ||
+      fast_json_parser_error (json) != FAST_JSON_DEPTH_ERROR ||
+      fast_json_calc_crc_string (json, cp, &i) != FAST_JSON_DEPTH_ERROR) {
+    fprintf (stderr, "Max depth not detected\n");
+    exit (1);
+  }
+  fast_json_max_depth (json, j + 1);
+  n = fast_json_parse_string2 (json, cp);
+  if (n == NULL || fast_json_calc_crc_string (json, cp, &i) != FAST_JSON_OK) {
+    fprintf (stderr, "Max depth failed. %s\n",
+	     fast_json_error_str (fast_json_parser_error (json)));
+    exit (1);
+  }
+  fast_json_value_free (json, n);
+  fast_json_max_depth (json, 0);
   free (cp);
 
+  /* Printing, copying, comparing and freeing do not recurse */
+  {
+    FAST_JSON_DATA_TYPE c;
+    char *s;
+
+    j = 1000000;
+    cp = (char *) malloc (j * 2 + 1);
+    memset (cp, '[', j);
+    memset (cp + j, ']', j);
+    cp[j * 2] = '\0';
+    n = fast_json_parse_string2 (json, cp);
+    c = fast_json_value_copy (json, n);
+    s = fast_json_print_string (json, c, 0);
+    if (n == NULL || c == NULL || fast_json_value_equal (n, c) == 0 ||
+	s == NULL || strcmp (s, cp) != 0) {
+      fprintf (stderr, "Deep nesting failed\n");
+      exit (1);
+    }
+    fast_json_release_print_value (json, s);
+    fast_json_value_free (json, c);
+    fast_json_value_free (json, n);
+    free (cp);
+  }
+
+  /* On demand parsing */
+  {
+    FAST_JSON_CURSOR_TYPE root;
+    FAST_JSON_CURSOR_TYPE elem;
+    FAST_JSON_CURSOR_TYPE item;
+
+    e = fast_json_cursor_start (json, "{\"skip\": [1, {\"a\": \"]\\\"}\"}, "
+				"[[]]], \"n\": 12, \"list\": [\"x\", "
+				"\"y\\u0041\", 2.5], \"e\": {}}", &root);
+    if (e != FAST_JSON_OK ||
+	fast_json_cursor_type (json, &root) != FAST_JSON_OBJECT ||
+	fast_json_cursor_find (json, &root, "n", &elem) != FAST_JSON_OK ||
+	fast_json_cursor_type (json, &elem) != FAST_JSON_INTEGER) {
+      fprintf (stderr, "Cursor find failed\n");
+      exit (1);
+    }
+    v = fast_json_cursor_value (json, &elem);
+    if (v == NULL || fast_json_get_integer (v) != 12 ||
+	fast_json_cursor_next (json, &elem) != FAST_JSON_OK ||
+	strcmp (fast_json_cursor_name (json, &elem), "list") != 0 ||
+	fast_json_cursor_child (json, &elem, &item) != FAST_JSON_OK ||
+	strcmp (fast_json_cursor_get_string (json, &item), "x") != 0 ||
+	fast_json_cursor_next (json, &item) != FAST_JSON_OK ||
+	strcmp (fast_json_cursor_get_string (json, &item), "yA") != 0 ||
+	fast_json_cursor_next (json, &item) != FAST_JSON_OK ||
+	fast_json_cursor_type (json, &item) != FAST_JSON_DOUBLE ||
+	fast_json_cursor_next (json, &item) != FAST_JSON_NO_DATA_ERROR ||
+	fast_json_cursor_next (json, &elem) != FAST_JSON_OK ||
+	fast_json_cursor_child (json, &elem, &item) != FAST_JSON_NO_DATA_ERROR ||
+	fast_json_cursor_next (json, &elem) != FAST_JSON_NO_DATA_ERROR ||
+	fast_json_cursor_find (json, &root, "none", &elem) !=
+	FAST_JSON_NO_DATA_ERROR) {
+      fprintf (stderr, "Cursor iteration failed. %s\n",
+	       fast_json_error_str (fast_json_parser_error (json)));
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    if (fast_json_cursor_start (json, "[[1, \"a}], 2]", &root) !=
+	FAST_JSON_OK ||
+	fast_json_cursor_child (json, &root, &elem) != FAST_JSON_OK ||
+	fast_json_cursor_next (json, &elem) != FAST_JSON_STRING_END_ERROR) {
+      fprintf (stderr, "Cursor error not detected\n");
+      exit (1);
+    }
+  }
+
+  /* Skip values */
+  {
+    static const char *skip_json =
+      " [1, {\"a\": \"]\\\"} and a string longer than a simd block\"},"
+      " /* ] */ [[], {}], 2.5e3]  2";
+    const char *end = fast_json_skip_value (json, skip_json, NULL);
+
+    if (end == NULL || strcmp (end, "  2") != 0 ||
+	(end = fast_json_skip_value (json, end, NULL)) == NULL || *end ||
+	fast_json_skip_value (json, "{\"a\": [1, 2}", NULL) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ARRAY_END_ERROR ||
+	fast_json_skip_value (json, "[\"a]", NULL) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_STRING_END_ERROR) {
+      fprintf (stderr, "Skip value failed\n");
+      exit (1);
+    }
+  }
+
+  /* Key path projection */
+  {
+    static const char *path_names[] =
+      { "user.id", "items[*].price", "items[1]" };
+    static const char *bad_path[] = { "a..b", "a[" };
+    FAST_JSON_PATHS_TYPE paths = fast_json_create_paths (json, path_names, 3);
+    char *s;
+
+    v = fast_json_parse_paths (json, paths,
+			       "{\"user\": {\"id\": 7, \"name\": \"x\"}, "
+			       "\"items\": [{\"price\": 1.5, \"n\": 1}, "
+			       "{\"n\": 2}, 3, {\"price\": 2}], \"other\": 1}");
+    s = fast_json_print_string (json, v, 0);
+    if (paths == NULL || s == NULL ||
+	strcmp (s, "{\"user\":{\"id\":7},\"items\":[{\"price\":1.5},"
+		"{\"n\":2},{\"price\":2}]}") != 0 ||
+	fast_json_create_paths (json, bad_path, 1) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_PARSE_ERROR ||
+	strcmp (fast_json_parser_error_str (json), "a..b") != 0 ||
+	fast_json_parser_column (json) != 2 ||
+	fast_json_create_paths (json, &bad_path[1], 1) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_PARSE_ERROR) {
+      fprintf (stderr, "Path projection failed: %s\n", s ? s : "NULL");
+      exit (1);
+    }
+    fast_json_release_print_value (json, s);
+    fast_json_value_free (json, v);
+    if (fast_json_parse_paths (json, paths,
+			       "{\"other\": [1, }, \"user\": {}}") != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ARRAY_END_ERROR) {
+      fprintf (stderr, "Path projection error not detected\n");
+      exit (1);
+    }
+    fast_json_free_paths (json, paths);
+  }
+
+  /* Newline delimited json with threads */
+  {
+    size_t len = 0;
+    char *nd = (char *) malloc (20000 * 16);
+
+    for (i = 0; i < 20000; i++) {
+      len += sprintf (nd + len, i % 100 == 0 ? "\r\n" : "{\"n\": %u}\n",
+		      i);
+    }
+    v = fast_json_parse_ndjson (json, nd, 4);
+    if (v == NULL || fast_json_get_array_size (v) != 19800 ||
+	fast_json_get_integer (fast_json_get_object_by_name
+			       (fast_json_get_array_data (v, 19799), "n"))
+	!= 19999) {
+      fprintf (stderr, "Ndjson parse failed\n");
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    fd = open ("/tmp/file5.json", O_CREAT | O_WRONLY | O_TRUNC, 0666);
+    if (write (fd, nd, len) != (ssize_t) len) {
+      fprintf (stderr, "Ndjson write failed\n");
+      exit (1);
+    }
+    close (fd);
+    fd = open ("/tmp/file5.json", O_RDONLY);
+    v = fast_json_parse_ndjson_fd (json, fd, 0);
+    close (fd);
+    if (v == NULL || fast_json_get_array_size (v) != 19800) {
+      fprintf (stderr, "Ndjson fd parse failed\n");
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    memcpy (strstr (nd, "{\"n\": 15001}"), "{\"n\": 15001]", 12);
+    v = fast_json_parse_ndjson (json, nd, 4);
+    if (v != NULL || fast_json_parser_error (json) != FAST_JSON_OBJECT_END_ERROR
+	|| fast_json_parser_line (json) != 15002 ||
+	fast_json_parser_column (json) != 12) {
+      fprintf (stderr, "Ndjson error not detected %s %zu %zu\n",
+	       fast_json_error_str (fast_json_parser_error (json)),
+	       fast_json_parser_line (json), fast_json_parser_column (json));
+      exit (1);
+    }
+    free (nd);
+  }
+
+  /* Parallel parse of one large array and object */
+  for (j = 0; j < 2; j++) {
+    size_t len = 0;
+    size_t line;
+    char *big = (char *) malloc (40000 * 48);
+
+    big[len++] = j ? '{' : '[';
+    for (i = 0; i < 40000; i++) {
+      len += j ? sprintf (big + len, "%s\"k%u\": {\"n\": [%u, \"]}\"]}",
+			  i ? ",\n" : "", i % 39000, i) :
+	sprintf (big + len, "%s{\"n\": [%u, \"]}\"]}", i ? ",\n" : "", i);
+    }
+    strcpy (big + len, j ? "}" : "]");
+    v = fast_json_parse_parallel (json, big, 4);
+    n = fast_json_parse_string2 (json, big);
+    if (v == NULL || fast_json_value_equal (v, n) == 0 ||
+	(j ? fast_json_get_object_size (v) : fast_json_get_array_size (v)) !=
+	(j ? 39000 : 40000)) {
+      fprintf (stderr, "Parallel parse failed: %u\n", j);
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    fast_json_value_free (json, n);
+    memcpy (strstr (big, "[30001,"), "[30001:", 7);
+    fast_json_parse_string2 (json, big);
+    line = fast_json_parser_line (json);
+    if (fast_json_parse_parallel (json, big, 4) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ARRAY_END_ERROR ||
+	fast_json_parser_line (json) != line || line < 30002) {
+      fprintf (stderr, "Parallel parse error not detected: %u\n", j);
+      exit (1);
+    }
+    free (big);
+  }
+
+  /* Push parser */
+  {
+    static const char *feed_json = "{\"a\": [1, \"]\"]} 12 [true] 3";
+    size_t len = strlen (feed_json);
+    unsigned int n_values = 0;
+
+    for (i = 0; i < len; i += 2) {
+      v = fast_json_feed (json, feed_json + i, len - i < 2 ? len - i : 2);
+      while (v) {
+	n_values++;
+	fast_json_value_free (json, v);
+	v = fast_json_feed (json, NULL, 0);
+      }
+      if (fast_json_parser_error (json) != FAST_JSON_NEED_MORE_DATA) {
+	fprintf (stderr, "Feed failed %s\n",
+		 fast_json_error_str (fast_json_parser_error (json)));
+	exit (1);
+      }
+    }
+    v = fast_json_feed_end (json);
+    if (n_values != 3 || v == NULL || fast_json_get_integer (v) != 3 ||
+	fast_json_feed_end (json) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_NO_DATA_ERROR) {
+      fprintf (stderr, "Feed end failed\n");
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    if (fast_json_feed (json, "[1, 2", 5) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_NEED_MORE_DATA ||
+	fast_json_feed (json, "}", 1) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ARRAY_END_ERROR ||
+	fast_json_feed (json, "]", 1) != NULL ||
+	fast_json_feed_end (json) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ARRAY_END_ERROR) {
+      fprintf (stderr, "Feed error not detected\n");
+      exit (1);
+    }
+  }
+
+  /* Array stream */
+  for (j = 1; j < 6; j++) {
+    block_user_data block_data = { 0, 0, NULL };
+    static const FAST_JSON_VALUE_TYPE stream_types[] =
+      { FAST_JSON_INTEGER, FAST_JSON_OBJECT, FAST_JSON_STRING,
+      FAST_JSON_ARRAY
+    };
+
+    block_data.size = j;
+    block_data.str = " [1, {\"a\": [2, \"]\"]}, \"x\" /* ] */ , [] ] ";
+    if (fast_json_array_stream_block (json, user_block, &block_data) !=
+	FAST_JSON_OK) {
+      fprintf (stderr, "Array stream start failed: %u\n", j);
+      exit (1);
+    }
+    for (i = 0; (v = fast_json_array_stream_next (json)) != NULL; i++) {
+      if (i >= 4 || fast_json_get_type (v) != stream_types[i]) {
+	fprintf (stderr, "Array stream failed: %u %u\n", i, j);
+	exit (1);
+      }
+      fast_json_value_free (json, v);
+    }
+    if (i != 4 || fast_json_parser_error (json) != FAST_JSON_NO_DATA_ERROR) {
+      fprintf (stderr, "Array stream end failed: %u\n", j);
+      exit (1);
+    }
+    block_data.pos = 0;
+    block_data.str = "[1 2]";
+    if (fast_json_array_stream_block (json, user_block, &block_data) !=
+	FAST_JSON_OK || (v = fast_json_array_stream_next (json)) == NULL ||
+	fast_json_array_stream_next (json) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ARRAY_END_ERROR) {
+      fprintf (stderr, "Array stream error not detected: %u\n", j);
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    block_data.pos = 0;
+    block_data.str = "{}";
+    if (fast_json_array_stream_block (json, user_block, &block_data) !=
+	FAST_JSON_VALUE_ERROR) {
+      fprintf (stderr, "Array stream object not detected: %u\n", j);
+      exit (1);
+    }
+  }
+
+  /* In place parse */
+  {
+    static const char insitu_json[] =
+      "{\"a\\n\": [\"\\u00e9\\u0000 a string longer than a simd block\"],"
+      " \"name\": \"\\\"\", \"a\\n\": 'x\\0\"'}";
+    char buf[sizeof (insitu_json)];
+    FAST_JSON_DATA_TYPE c;
+    char *s;
+
+    memcpy (buf, insitu_json, sizeof (buf));
+    fast_json_options (json, FAST_JSON_ALLOW_JSON5);
+    v = fast_json_parse_insitu (json, buf, sizeof (buf) - 1);
+    c = fast_json_value_copy (json, v);
+    if (v == NULL || c == NULL ||
+	fast_json_add_object (json, v, "b", fast_json_create_null (json)) !=
+	FAST_JSON_OK || fast_json_remove_object (json, v, 0) != FAST_JSON_OK) {
+      fprintf (stderr, "In place parse failed\n");
+      exit (1);
+    }
+    memset (buf, ' ', sizeof (buf) - 1);
+    s = fast_json_print_string (json, c, 0);
+    if (s == NULL ||
+	strcmp (s, "{\"a\\n\":\"x\\u0000\\\"\",\"name\":\"\\\"\"}") != 0) {
+      fprintf (stderr, "In place parse copy failed: %s\n", s ? s : "NULL");
+      exit (1);
+    }
+    fast_json_release_print_value (json, s);
+    fast_json_value_free (json, c);
+    fast_json_value_free (json, v);
+    memcpy (buf, "[\"a\", 1 2]", 11);
+    if (fast_json_parse_insitu (json, buf, 10) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ARRAY_END_ERROR) {
+      fprintf (stderr, "In place parse error not detected\n");
+      exit (1);
+    }
+    fast_json_options (json, 0);
+  }
+
+  /* String lengths */
+  {
+    FAST_JSON_DATA_TYPE s1;
+    FAST_JSON_DATA_TYPE s2;
+
+    v = fast_json_parse_string2 (json, "{\"a\\u00e9\": \"x\\u0000y\","
+				 " \"b\": \"a string longer than inline\"}");
+    s1 = fast_json_get_object_data (v, 0);
+    s2 = fast_json_get_object_data (v, 1);
+    if (v == NULL || fast_json_get_object_name_len (v, 0) != 3 ||
+	fast_json_get_object_name_len (v, 2) != 0 ||
+	fast_json_get_string_len (s1) != strlen (fast_json_get_string (s1)) ||
+	fast_json_get_string_len (s2) != 27 ||
+	fast_json_get_string_len (v) != 0 ||
+	fast_json_set_string (json, s2, "x\\u0000y") != FAST_JSON_OK ||
+	fast_json_get_string_len (s2) != 8 ||
+	fast_json_value_equal (s1, s2) == 0 ||
+	fast_json_set_string (json, s2, "x\\u0000") != FAST_JSON_OK ||
+	fast_json_value_equal (s1, s2)) {
+      fprintf (stderr, "String length failed\n");
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+  }
+
+  /* Arena */
+  {
+    FAST_JSON_DATA_TYPE a;
+    char ibuf[] = "{\"name\": \"in place\", \"list\": [1, 2.5, null]}";
+
+    fast_json_options (json, FAST_JSON_ARENA);
+    v = fast_json_parse_string2 (json, "{\"a\": [true, \"a string longer "
+				 "than inline\"], \"b\": {\"c\": 1}}");
+    a = fast_json_create_array (json);
+    for (i = 0; i < 1000; i++) {
+      fast_json_add_array (json, a, fast_json_create_integer_value (json, i));
+    }
+    if (v == NULL ||
+	fast_json_add_object (json, v, "d", a) != FAST_JSON_OK ||
+	fast_json_remove_object (json, v, 1) != FAST_JSON_OK ||
+	fast_json_set_string (json, fast_json_get_array_data
+			      (fast_json_get_object_data (v, 0), 1),
+			      "changed") != FAST_JSON_OK ||
+	fast_json_get_array_size (fast_json_get_object_data (v, 1)) != 1000 ||
+	(cp = fast_json_print_string (json, fast_json_get_object_data (v, 0),
+				      0)) == NULL ||
+	strcmp (cp, "[true,\"changed\"]") != 0) {
+      fprintf (stderr, "Arena failed\n");
+      exit (1);
+    }
+    fast_json_release_print_value (json, cp);
+    fast_json_value_free (json, v);
+    fast_json_arena_free (json);
+    v = fast_json_parse_insitu (json, ibuf, strlen (ibuf));
+    if (v == NULL ||
+	fast_json_add_object (json, v, "more", fast_json_create_null (json))
+	!= FAST_JSON_OK ||
+	(cp = fast_json_print_string (json, v, 0)) == NULL ||
+	strcmp (cp, "{\"name\":\"in place\",\"list\":[1,2.5,null],"
+		"\"more\":null}") != 0) {
+      fprintf (stderr, "Arena insitu failed\n");
+      exit (1);
+    }
+    fast_json_release_print_value (json, cp);
+    fast_json_arena_free (json);
+    fast_json_options (json, 0);
+  }
+
+  /* Tape */
+  {
+    FAST_JSON_TAPE_TYPE tape;
+    const char *name;
+    size_t a;
+    size_t pos;
+
+    tape = fast_json_parse_tape (json, "{\"a\": [1, 2.5, \"x\\u00e9\", "
+				 "true, null, {}], \"b\": {\"c\": -3}}");
+    a = fast_json_tape_get_object_by_name (tape, 0, "a");
+    pos = fast_json_tape_get_object_by_name (tape, 0, "b");
+    if (tape == NULL || fast_json_tape_get_type (tape, 0) != FAST_JSON_OBJECT ||
+	fast_json_tape_get_object_size (tape, 0) != 2 ||
+	strcmp (fast_json_tape_get_object_name (tape, 0, 1), "b") != 0 ||
+	fast_json_tape_get_object_data (tape, 0, 0) != a ||
+	fast_json_tape_next (tape, a, &name) != pos ||
+	strcmp (name, "b") != 0 ||
+	fast_json_tape_next (tape, pos, &name) != FAST_JSON_TAPE_NONE ||
+	fast_json_tape_get_integer (tape, fast_json_tape_get_object_by_name
+				    (tape, pos, "c")) != (fast_json_int_64) -3 ||
+	fast_json_tape_get_object_by_name (tape, pos, "d") !=
+	FAST_JSON_TAPE_NONE ||
+	fast_json_tape_get_array_size (tape, a) != 6 ||
+	fast_json_tape_get_integer (tape, fast_json_tape_get_array_data
+				    (tape, a, 0)) != 1 ||
+	fast_json_tape_get_double (tape, fast_json_tape_get_array_data
+				   (tape, a, 1)) != 2.5 ||
+	strcmp (fast_json_tape_get_string (tape, fast_json_tape_get_array_data
+					   (tape, a, 2)), "x\303\251") != 0 ||
+	fast_json_tape_get_string_len (tape, fast_json_tape_get_array_data
+				       (tape, a, 2)) != 3 ||
+	fast_json_tape_get_boolean (tape, fast_json_tape_get_array_data
+				    (tape, a, 3)) != 1 ||
+	fast_json_tape_get_type (tape, fast_json_tape_get_array_data
+				 (tape, a, 4)) != FAST_JSON_NULL ||
+	fast_json_tape_get_object_size (tape, fast_json_tape_get_array_data
+					(tape, a, 5)) != 0 ||
+	fast_json_tape_get_array_data (tape, a, 6) != FAST_JSON_TAPE_NONE) {
+      fprintf (stderr, "Tape failed\n");
+      exit (1);
+    }
+    fast_json_free_tape (json, tape);
+    if (fast_json_parse_tape (json, "[1, 2") != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ARRAY_END_ERROR) {
+      fprintf (stderr, "Tape error failed\n");
+      exit (1);
+    }
+  }
+
+  /* Inline strings and names */
+  {
+    FAST_JSON_DATA_TYPE c;
+
+    fast_json_options (json, FAST_JSON_BIG_ALLOC);
+    v = fast_json_parse_string2 (json, "{\"short\": \"14 characters.\", "
+				 "\"fifteen chars..\": \"15 characters..\", "
+				 "\"a name of sixteen\": \"\"}");
+    if (v == NULL ||
+	fast_json_get_string_len (fast_json_get_object_data (v, 0)) != 14 ||
+	fast_json_get_string_len (fast_json_get_object_data (v, 1)) != 15 ||
+	strcmp (fast_json_get_string (fast_json_get_object_data (v, 1)),
+		"15 characters..") != 0 ||
+	fast_json_get_object_by_name (v, "fifteen chars..") !=
+	fast_json_get_object_data (v, 1) ||
+	fast_json_get_object_by_name (v, "a name of sixteen") !=
+	fast_json_get_object_data (v, 2) ||
+	fast_json_remove_object (json, v, 0) != FAST_JSON_OK ||
+	fast_json_add_object (json, v, "short",
+			      fast_json_create_string (json, "again"))
+	!= FAST_JSON_OK ||
+	fast_json_add_object (json, v, "fifteen chars..",
+			      fast_json_create_null (json)) != FAST_JSON_OK ||
+	fast_json_get_object_size (v) != 3 ||
+	strcmp (fast_json_get_object_name (v, 2), "short") != 0 ||
+	(c = fast_json_value_copy (json, v)) == NULL) {
+      fprintf (stderr, "Inline strings failed\n");
+      exit (1);
+    }
+    if (fast_json_value_equal (v, c) != 1 ||
+	(cp = fast_json_print_string (json, c, 0)) == NULL ||
+	strcmp (cp, "{\"fifteen chars..\":null,\"a name of sixteen\":\"\","
+		"\"short\":\"again\"}") != 0) {
+      fprintf (stderr, "Inline strings copy failed\n");
+      exit (1);
+    }
+    fast_json_release_print_value (json, cp);
+    fast_json_value_free (json, c);
+    fast_json_value_free (json, v);
+    fast_json_options (json, 0);
+  }
+
   parser_check_error (json, "[ /* */ ]", FAST_JSON_OK, 1, 1, "", "");
   parser_check_error (json, "[ //\n]", FAST_JSON_OK, 2, 1, "", "");
   fast_json_options (json, FAST_JSON_NO_COMMENT);
@@ -1889,25 +2955,125 @@ main (void)
   }
   fast_json_options (json, 0);
 
+  /* Long strings and white space that cross simd blocks */
+  {
+    char big[1000];
+    char *bp = &big[0];
+
+    *bp++ = '[';
+    for (i = 0; i < 150; i++) {
+      *bp++ = i & 1 ? ' ' : '\t';
+    }
+    for (j = 0; j < 3; j++) {
+      *bp++ = '"';
+      for (i = 0; i < 60 + j; i++) {
+	*bp++ = 'a' + j;
+      }
+      *bp++ = '\\';
+      *bp++ = j == 1 ? '"' : 'n';
+      for (i = 0; i < 70; i++) {
+	*bp++ = '0' + i % 10;
+      }
+      *bp++ = '"';
+      for (i = 0; i < 64 + j; i++) {
+	*bp++ = '\n';
+      }
+      *bp++ = ',';
+    }
+    strcpy (bp, " { \"key\" :\t\t\t\t\"\\u00e9\" } ]");
+    v = fast_json_parse_string (json, big);
+    n = fast_json_parse_string2 (json, big);
+    if (v == NULL || n == NULL || fast_json_value_equal (v, n) == 0 ||
+	fast_json_get_array_size (n) != 4 ||
+	strlen (fast_json_get_string (fast_json_get_array_data (n, 2))) !=
+	62 + 1 + 70) {
+      fprintf (stderr, "Simd block parse failed\n");
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    fast_json_value_free (json, n);
+    strcpy (bp, " \"abc\\");
+    if (fast_json_parse_string2 (json, big) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_ESCAPE_CHARACTER_ERROR) {
+      fprintf (stderr, "Simd block string end failed\n");
+      exit (1);
+    }
+    strcpy (bp, " \"0123456789012345678901234567890123456789\t\" ]");
+    if (fast_json_parse_string (json, big) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_CONTROL_CHARACTER_ERROR ||
+	fast_json_parse_string2 (json, big) != NULL ||
+	fast_json_parser_error (json) != FAST_JSON_CONTROL_CHARACTER_ERROR) {
+      fprintf (stderr, "Simd control character failed\n");
+      exit (1);
+    }
+  }
+
+  /* Escapes in created strings */
+  v = fast_json_create_string (json, "a\\nb");
+  if (v == NULL || strcmp (fast_json_get_string (v), "a\nb") != 0) {
+    fprintf (stderr, "Create string escape failed\n");
+    exit (1);
+  }
+  if (fast_json_set_string (json, v,
+			    "0123456789abcdef0123456789abcdef\\u00e9\\t"
+			    "0123456789abcdef0123456789abcdef") != FAST_JSON_OK
+      || strcmp (fast_json_get_string (v),
+		 "0123456789abcdef0123456789abcdef\303\251\t"
+		 "0123456789abcdef0123456789abcdef") != 0) {
+    fprintf (stderr, "Set string escape failed\n");
+    exit (1);
+  }
+  fast_json_value_free (json, v);
+
+  /* Strings larger than the string buffer */
+  cp = (char *) malloc (6 * BUFSIZ + 20);
+  if (cp) {
+    np = cp;
+    *np++ = '{';
+    for (j = 0; j < 2; j++) {
+      *np++ = '"';
+      for (i = 0; i < 3 * BUFSIZ - 4; i++) {
+	*np++ = i % 7 ? 'a' + i % 26 : '\\';
+	if (i % 7 == 0) {
+	  *np++ = 'u';
+	  *np++ = '0';
+	  *np++ = '0';
+	  *np++ = 'e';
+	  *np++ = '9';
+	  i += 5;
+	}
+      }
+      *np++ = '"';
+      *np++ = j ? '}' : ':';
+    }
+    *np = '\0';
+    v = fast_json_parse_string (json, cp);
+    n = fast_json_parse_string2 (json, cp);
+    if (v == NULL || n == NULL || fast_json_value_equal (v, n) == 0 ||
+	fast_json_get_object_size (n) != 1 ||
+	strlen (fast_json_get_object_name (n, 0)) !=
+	strlen (fast_json_get_string (fast_json_get_object_data (n, 0))) ||
+	strncmp (fast_json_get_object_name (n, 0), "\303\251g\303\251n",
+		 6) != 0) {
+      fprintf (stderr, "Large string failed\n");
+      exit (1);
+    }
+    fast_json_value_free (json, v);
+    fast_json_value_free (json, n);
+    free (cp);
+  }
+
 #if !defined(WIN) && !defined(__TINYC__)
   setlocale (LC_ALL, "nl_NL.UTF-8");
   localeconv ();		/* will normally be called in parser */
-#if USE_FAST_CONVERT
-  fast_dtoa (12.34, PREC_DBL_NR, str);
-#else
   snprintf (str, sizeof (str), "%g", 12.34);
-#endif
   if (strchr (str, ',') == NULL) {
     fprintf (stderr, "Locale does not work '%s'\n", str);
     exit (1);
   }
   {
     double dval;
-#if USE_FAST_CONVERT
-    dval = fast_strtod (str, NULL);
-#else
     dval = strtod (str, NULL);
-#endif
     if (dval != 12.34) {
       fprintf (stderr, "Locale does not work '%g'\n", dval);
       exit (1);